@@ -149,6 +149,11 @@ bool SupportsLatencyControl(std::string_view backend)
   return backend == BACKEND_OPENAL || backend == BACKEND_WASAPI;
 }
 
+bool SupportsLowLatencyMode(std::string_view backend)
+{
+  return backend == BACKEND_CUBEB;
+}
+
 bool SupportsVolumeChanges(std::string_view backend)
 {
   // FIXME: this one should ask the backend whether it supports it.
@@ -28,6 +28,7 @@ std::vector<std::string> GetSoundBackends();
 DPL2Quality GetDefaultDPL2Quality();
 bool SupportsDPL2Decoder(std::string_view backend);
 bool SupportsLatencyControl(std::string_view backend);
+bool SupportsLowLatencyMode(std::string_view backend);
 bool SupportsVolumeChanges(std::string_view backend);
 void UpdateSoundStream(Core::System& system);
 void SetSoundStreamRunning(Core::System& system, bool running);
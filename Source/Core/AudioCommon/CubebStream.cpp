@@ -3,6 +3,8 @@
 
 #include "AudioCommon/CubebStream.h"
 
+#include <algorithm>
+
 #include <cubeb/cubeb.h>
 
 #include "AudioCommon/CubebUtils.h"
@@ -19,6 +21,9 @@
 
 // ~10 ms - needs to be at least 240 for surround
 constexpr u32 BUFFER_SAMPLES = 512;
+// Smallest period allowed in low latency mode
+constexpr u32 MIN_LOW_LATENCY_SAMPLES = 32;
+constexpr u32 MIN_SURROUND_SAMPLES = 240;
 
 long CubebStream::DataCallback(cubeb_stream* stream, void* user_data, const void* /*input_buffer*/,
                                void* output_buffer, long num_frames)
@@ -91,10 +96,21 @@ bool CubebStream::Init()
         ERROR_LOG_FMT(AUDIO, "Error getting minimum latency");
       INFO_LOG_FMT(AUDIO, "Minimum latency: {} frames", minimum_latency);
 
-      return_value =
-          cubeb_stream_init(m_ctx.get(), &m_stream, "Dolphin Audio Output", nullptr, nullptr,
-                            nullptr, &params, std::max(BUFFER_SAMPLES, minimum_latency),
-                            DataCallback, StateCallback, this) == CUBEB_OK;
+      // Low latency mode asks for a shorter period, which makes the callback run more often with
+      // fewer frames. How low the backend actually goes is still limited by its minimum latency.
+      u32 buffer_samples = BUFFER_SAMPLES;
+      if (Config::Get(Config::MAIN_AUDIO_LOW_LATENCY))
+      {
+        buffer_samples = std::clamp<u32>(
+            Config::Get(Config::MAIN_AUDIO_LOW_LATENCY_PERIOD),
+            m_stereo ? MIN_LOW_LATENCY_SAMPLES : MIN_SURROUND_SAMPLES, BUFFER_SAMPLES);
+      }
+      buffer_samples = std::max(buffer_samples, minimum_latency);
+      INFO_LOG_FMT(AUDIO, "Period: {} frames", buffer_samples);
+
+      return_value = cubeb_stream_init(m_ctx.get(), &m_stream, "Dolphin Audio Output", nullptr,
+                                       nullptr, nullptr, &params, buffer_samples, DataCallback,
+                                       StateCallback, this) == CUBEB_OK;
     }
 
 #ifdef _WIN32
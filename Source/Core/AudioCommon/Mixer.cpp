@@ -16,6 +16,10 @@
 #include "Core/ConfigManager.h"
 #include "VideoCommon/PerformanceMetrics.h"
 
+#ifdef _M_X86_64
+#include <emmintrin.h>
+#endif
+
 static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
 {
   switch (quality)
@@ -57,26 +61,96 @@ void Mixer::DoState(PointerWrap& p)
     mixer.DoState(p);
 }
 
+// Linearly interpolates stereo frames out of input and adds them to accumulator, scaled by the
+// volumes (0-256). Output frame i is interpolated at (frac + i * ratio) / 0x10000 frames into
+// input. The channels are swapped, since the fifos store them in the opposite order of the output.
+static void ResampleAndAdd(s32* accumulator, const short* input, u32 count, u32 frac, u32 ratio,
+                           s32 lvolume, s32 rvolume)
+{
+  u32 i = 0;
+
+#ifdef _M_X86_64
+  const __m128i volumes = _mm_set_epi32(lvolume, rvolume, lvolume, rvolume);
+  for (; i + 1 < count; i += 2)
+  {
+    const u64 position0 = frac + u64(i) * ratio;
+    const u64 position1 = position0 + ratio;
+    const auto load_frames = [input](u64 position) {
+      // The current and next frame, reordered to (L, L next, R, R next)
+      const __m128i frames =
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + (position >> 16) * 2));
+      return _mm_shufflelo_epi16(frames, _MM_SHUFFLE(3, 1, 2, 0));
+    };
+    const __m128i frames = _mm_unpacklo_epi64(load_frames(position0), load_frames(position1));
+
+    // current * 0x10000 + (next - current) * frac doesn't fit in a 16-bit multiply, so frac is
+    // split into frac / 2, which madd can multiply the difference with, and the lowest bit.
+    // The result fits in 32 bits, so the intermediate steps are allowed to wrap around.
+    const s16 half0 = static_cast<s16>((position0 & 0xFFFF) >> 1);
+    const s16 half1 = static_cast<s16>((position1 & 0xFFFF) >> 1);
+    const s32 odd0 = -static_cast<s32>(position0 & 1);
+    const s32 odd1 = -static_cast<s32>(position1 & 1);
+    const __m128i halves =
+        _mm_set_epi16(half1, -half1, half1, -half1, half0, -half0, half0, -half0);
+    const __m128i current = _mm_srai_epi32(_mm_slli_epi32(frames, 16), 16);
+    const __m128i next = _mm_srai_epi32(frames, 16);
+    const __m128i odd_difference =
+        _mm_and_si128(_mm_sub_epi32(next, current), _mm_set_epi32(odd1, odd1, odd0, odd0));
+    __m128i sum = _mm_slli_epi32(_mm_madd_epi16(frames, halves), 1);
+    sum = _mm_add_epi32(sum, _mm_add_epi32(odd_difference, _mm_slli_epi32(current, 16)));
+    const __m128i interpolated = _mm_srai_epi32(sum, 16);
+
+    // The interpolated samples fit in 16 bits, so madd can scale them by the volumes exactly
+    const __m128i swapped = _mm_shuffle_epi32(interpolated, _MM_SHUFFLE(2, 3, 0, 1));
+    const __m128i scaled = _mm_srai_epi32(_mm_madd_epi16(swapped, volumes), 8);
+
+    __m128i* out = reinterpret_cast<__m128i*>(accumulator + i * 2);
+    _mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), scaled));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const u64 position = frac + u64(i) * ratio;
+    const short* frame = input + (position >> 16) * 2;
+    const s64 current_frac = position & 0xFFFF;
+
+    const s32 sample_l = s32(((s64(frame[0]) << 16) + (frame[2] - frame[0]) * current_frac) >> 16);
+    const s32 sample_r = s32(((s64(frame[1]) << 16) + (frame[3] - frame[1]) * current_frac) >> 16);
+    accumulator[i * 2] += (sample_r * rvolume) >> 8;
+    accumulator[i * 2 + 1] += (sample_l * lvolume) >> 8;
+  }
+}
+
+// Clamps the sum of all sources to 16 bits
+static void ClampSamples(short* out, const s32* accumulator, u32 count)
+{
+  u32 i = 0;
+
+#ifdef _M_X86_64
+  const __m128i min = _mm_set1_epi16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i + 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm_max_epi16(_mm_packs_epi32(low, high), min));
+  }
+#endif
+
+  for (; i < count; ++i)
+    out[i] = static_cast<short>(std::clamp(accumulator[i], -32767, 32767));
+}
+
 // Executed from sound stream thread
-unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
+unsigned int Mixer::MixerFifo::Mix(s32* accumulator, unsigned int num_samples,
                                    bool consider_framelimit, float emulationspeed,
                                    int timing_variance)
 {
-  unsigned int currentSample = 0;
-
-  // Cache access in non-volatile variable
-  // This is the only function changing the read value, so it's safe to
-  // cache it locally although it's written here.
-  // The writing pointer will be modified outside, but it will only increase,
-  // so we will just ignore new written data while interpolating.
-  // Without this cache, the compiler wouldn't be allowed to optimize the
-  // interpolation loop.
-  u32 indexR = m_indexR.load();
-  u32 indexW = m_indexW.load();
-
-  // render numleft sample pairs to samples[]
-  // advance indexR with sample position
-  // remember fractional offset
+  // This is the only function changing the read index. The write index only ever increases, so
+  // samples that get pushed while mixing are simply left for the next call.
+  u32 indexR = m_indexR.load(std::memory_order_relaxed);
+  const u32 indexW = m_indexW.load(std::memory_order_acquire);
 
   float aid_sample_rate =
       FIXED_SAMPLE_RATE_DIVIDEND / static_cast<float>(m_input_sample_rate_divisor);
@@ -103,69 +177,79 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   s32 lvolume = m_LVolume.load();
   s32 rvolume = m_RVolume.load();
 
-  const auto read_buffer = [this](auto index) {
-    return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
-  };
-
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  // Every output sample is interpolated between two input samples, so the last input sample can
+  // only be used once the one after it has been pushed
+  const u32 available_frames = ((indexW - indexR) & INDEX_MASK) / 2;
+  u32 count = 0;
+  if (available_frames >= 2)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    const u64 last_position = (u64(available_frames - 2) << 16) | 0xFFFF;
+    count = ratio == 0 ? num_samples :
+                         static_cast<u32>(std::min<u64>(num_samples,
+                                                        (last_position - m_frac) / ratio + 1));
   }
 
-  // Actual number of samples written to the buffer without padding.
-  unsigned int actual_sample_count = currentSample / 2;
+  if (count != 0)
+  {
+    const u64 last_position = m_frac + u64(count - 1) * ratio;
+    short* const input = m_mixer->m_source_buffer.data();
+    ReadSamples(input, indexR, ((last_position >> 16) + 2) * 2);
+
+    ResampleAndAdd(accumulator, input, count, m_frac, ratio, lvolume, rvolume);
+
+    const u64 end_position = m_frac + u64(count) * ratio;
+    indexR += 2 * static_cast<u32>(end_position >> 16);
+    m_frac = end_position & 0xFFFF;
+  }
 
   // Padding
-  short s[2];
-  s[0] = read_buffer((indexR - 1) & INDEX_MASK);
-  s[1] = read_buffer((indexR - 2) & INDEX_MASK);
-  s[0] = (s[0] * rvolume) >> 8;
-  s[1] = (s[1] * lvolume) >> 8;
-  for (; currentSample < numSamples * 2; currentSample += 2)
+  short last_frame[2];
+  ReadSamples(last_frame, indexR - 2, 2);
+  const short padding_r = (last_frame[1] * rvolume) >> 8;
+  const short padding_l = (last_frame[0] * lvolume) >> 8;
+  if (padding_r != 0 || padding_l != 0)
   {
-    int sampleR = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
-    int sampleL = std::clamp(s[1] + samples[currentSample + 1], -32767, 32767);
-
-    samples[currentSample + 0] = sampleR;
-    samples[currentSample + 1] = sampleL;
+    for (u32 i = count; i < num_samples; ++i)
+    {
+      accumulator[i * 2] += padding_r;
+      accumulator[i * 2 + 1] += padding_l;
+    }
   }
 
-  // Flush cached variable
-  m_indexR.store(indexR);
+  m_indexR.store(indexR, std::memory_order_release);
 
-  return actual_sample_count;
+  return count;
 }
 
-unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
+void Mixer::MixSources(short* samples, unsigned int num_samples, bool consider_framelimit)
 {
-  if (!samples)
-    return 0;
-
-  memset(samples, 0, num_samples * 2 * sizeof(short));
-
   // TODO: Determine how emulation speed will be used in audio
   // const float emulation_speed = g_perf_metrics.GetSpeed();
   const float emulation_speed = m_config_emulation_speed;
   const int timing_variance = m_config_timing_variance;
+
+  // Sources that have no samples left to play and are silent leave the accumulator untouched,
+  // which keeps the unused GBA, Wii Remote and Skylander portal fifos close to free
+  std::fill_n(m_accumulator.begin(), num_samples * 2, 0);
+  const auto mix = [&](MixerFifo& fifo) {
+    fifo.Mix(m_accumulator.data(), num_samples, consider_framelimit, emulation_speed,
+             timing_variance);
+  };
+  mix(m_dma_mixer);
+  mix(m_streaming_mixer);
+  mix(m_wiimote_speaker_mixer);
+  mix(m_skylander_portal_mixer);
+  for (auto& mixer : m_gba_mixers)
+    mix(mixer);
+
+  ClampSamples(samples, m_accumulator.data(), num_samples * 2);
+}
+
+unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
+{
+  if (!samples)
+    return 0;
+
   if (m_config_audio_stretch)
   {
     unsigned int available_samples =
@@ -175,22 +259,9 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
                "Audio stretching would overflow m_scratch_buffer: min({}, {}) -> {} > {} ({})",
                m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples(),
                available_samples, MAX_SAMPLES, num_samples);
+    available_samples = std::min(available_samples, MAX_SAMPLES);
 
-    m_scratch_buffer.fill(0);
-
-    m_dma_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                    timing_variance);
-    m_streaming_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                          timing_variance);
-    m_wiimote_speaker_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                timing_variance);
-    m_skylander_portal_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                 timing_variance);
-    for (auto& mixer : m_gba_mixers)
-    {
-      mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                timing_variance);
-    }
+    MixSources(m_scratch_buffer.data(), available_samples, false);
 
     if (!m_is_stretching)
     {
@@ -202,12 +273,8 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_skylander_portal_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    for (auto& mixer : m_gba_mixers)
-      mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    for (unsigned int offset = 0; offset < num_samples; offset += MAX_SAMPLES)
+      MixSources(samples + offset * 2, std::min(num_samples - offset, MAX_SAMPLES), true);
     m_is_stretching = false;
   }
 
@@ -245,15 +312,20 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 
 void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_samples)
 {
-  // Cache access in non-volatile variable
-  // indexR isn't allowed to cache in the audio throttling loop as it
-  // needs to get updates to not deadlock.
-  u32 indexW = m_indexW.load();
+  if (m_mixer->m_input_suppressed.load(std::memory_order_relaxed))
+    return;
+
+  // This is the only function changing the write index. The read index needs to be loaded
+  // every time, since it's what makes room in the buffer.
+  const u32 indexW = m_indexW.load(std::memory_order_relaxed);
 
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  if (num_samples * 2 + ((indexW - m_indexR.load(std::memory_order_acquire)) & INDEX_MASK) >=
+      MAX_SAMPLES * 2)
+  {
     return;
+  }
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
   // to alleviate the workload on main thread
@@ -269,7 +341,21 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
     memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
   }
 
-  m_indexW.fetch_add(num_samples * 2);
+  m_indexW.store(indexW + num_samples * 2, std::memory_order_release);
+}
+
+void Mixer::MixerFifo::ReadSamples(short* out, u32 index, u32 num_shorts) const
+{
+  const u32 start = index & INDEX_MASK;
+  const u32 first = std::min(num_shorts, MAX_SAMPLES * 2 - start);
+  std::copy_n(&m_buffer[start], first, out);
+  std::copy_n(&m_buffer[0], num_shorts - first, out + first);
+
+  if (!m_little_endian)
+  {
+    for (u32 i = 0; i < num_shorts; ++i)
+      out[i] = Common::swap16(out[i]);
+  }
 }
 
 void Mixer::PushSamples(const short* samples, unsigned int num_samples)
@@ -349,6 +435,11 @@ void Mixer::PushGBASamples(int device_number, const short* samples, unsigned int
   m_gba_mixers[device_number].PushSamples(samples, num_samples);
 }
 
+void Mixer::SetInputSuppressed(bool suppressed)
+{
+  m_input_suppressed.store(suppressed, std::memory_order_relaxed);
+}
+
 void Mixer::SetDMAInputSampleRateDivisor(unsigned int rate_divisor)
 {
   m_dma_mixer.SetInputSampleRateDivisor(rate_divisor);
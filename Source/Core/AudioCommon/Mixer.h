@@ -44,6 +44,10 @@ public:
   void SetWiimoteSpeakerVolume(unsigned int lvolume, unsigned int rvolume);
   void SetGBAVolume(int device_number, unsigned int lvolume, unsigned int rvolume);
 
+  // Drops all pushed samples while set. Used by NetPlay rollback to keep re-simulated frames
+  // from being heard a second time.
+  void SetInputSuppressed(bool suppressed);
+
   void StartLogDTKAudio(const std::string& filename);
   void StopLogDTKAudio();
 
@@ -72,7 +76,8 @@ private:
     }
     void DoState(PointerWrap& p);
     void PushSamples(const short* samples, unsigned int num_samples);
-    unsigned int Mix(short* samples, unsigned int numSamples, bool consider_framelimit,
+    // Resamples to the output rate and adds the result to accumulator, without clamping.
+    unsigned int Mix(s32* accumulator, unsigned int num_samples, bool consider_framelimit,
                      float emulationspeed, int timing_variance);
     void SetInputSampleRateDivisor(unsigned int rate_divisor);
     unsigned int GetInputSampleRateDivisor() const;
@@ -81,12 +86,17 @@ private:
     unsigned int AvailableSamples() const;
 
   private:
+    // Copies num_shorts samples starting at index out of the ring buffer, in host byte order
+    void ReadSamples(short* out, u32 index, u32 num_shorts) const;
+
     Mixer* m_mixer;
     unsigned m_input_sample_rate_divisor;
     bool m_little_endian;
     std::array<short, MAX_SAMPLES * 2> m_buffer{};
-    std::atomic<u32> m_indexW{0};
-    std::atomic<u32> m_indexR{0};
+    // Only written by PushSamples (m_indexW) and Mix (m_indexR), which run on different threads.
+    // Kept on separate cache lines so that the threads don't keep taking them from each other.
+    alignas(64) std::atomic<u32> m_indexW{0};
+    alignas(64) std::atomic<u32> m_indexR{0};
     // Volume ranges from 0-256
     std::atomic<s32> m_LVolume{256};
     std::atomic<s32> m_RVolume{256};
@@ -94,6 +104,9 @@ private:
     u32 m_frac = 0;
   };
 
+  // Mixes num_samples (at most MAX_SAMPLES) from every source into samples
+  void MixSources(short* samples, unsigned int num_samples, bool consider_framelimit);
+
   void RefreshConfig();
 
   MixerFifo m_dma_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 32000, false};
@@ -110,6 +123,10 @@ private:
   AudioCommon::AudioStretcher m_stretcher;
   AudioCommon::SurroundDecoder m_surround_decoder;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
+  // The sum of all sources, before it gets clamped to 16 bits
+  std::array<s32, MAX_SAMPLES * 2> m_accumulator{};
+  // The input of the source that is currently being resampled, unwrapped from its ring buffer
+  std::array<short, MAX_SAMPLES * 2> m_source_buffer{};
 
   WaveFileWriter m_wave_writer_dtk;
   WaveFileWriter m_wave_writer_dsp;
@@ -117,6 +134,8 @@ private:
   bool m_log_dtk_audio = false;
   bool m_log_dsp_audio = false;
 
+  std::atomic<bool> m_input_suppressed{false};
+
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
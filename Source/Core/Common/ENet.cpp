@@ -26,6 +26,17 @@ void WakeupThread(ENetHost* host)
   enet_socket_send(host->socket, &address, &buf, 1);
 }
 
+void HostWakeup::Request(ENetHost* host)
+{
+  if (!m_pending.exchange(true, std::memory_order_acq_rel))
+    WakeupThread(host);
+}
+
+void HostWakeup::Reset()
+{
+  m_pending.store(false, std::memory_order_release);
+}
+
 int ENET_CALLBACK InterceptCallback(ENetHost* host, ENetEvent* event)
 {
   // wakeup packet received
@@ -37,7 +48,7 @@ int ENET_CALLBACK InterceptCallback(ENetHost* host, ENetEvent* event)
   return 0;
 }
 
-bool SendPacket(ENetPeer* socket, const sf::Packet& packet, u8 channel_id)
+bool SendPacket(ENetPeer* socket, const sf::Packet& packet, u8 channel_id, bool reliable)
 {
   if (!socket)
   {
@@ -45,8 +56,8 @@ bool SendPacket(ENetPeer* socket, const sf::Packet& packet, u8 channel_id)
     return false;
   }
 
-  ENetPacket* epac =
-      enet_packet_create(packet.getData(), packet.getDataSize(), ENET_PACKET_FLAG_RELIABLE);
+  ENetPacket* epac = enet_packet_create(packet.getData(), packet.getDataSize(),
+                                        reliable ? ENET_PACKET_FLAG_RELIABLE : 0);
   if (!epac)
   {
     ERROR_LOG_FMT(NETPLAY, "Failed to create ENetPacket ({} bytes).", packet.getDataSize());
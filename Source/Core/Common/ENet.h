@@ -3,6 +3,7 @@
 //
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <SFML/Network/Packet.hpp>
@@ -19,8 +20,24 @@ struct ENetHostDeleter
 using ENetHostPtr = std::unique_ptr<ENetHost, ENetHostDeleter>;
 
 void WakeupThread(ENetHost* host);
+
+// Wakes up the thread servicing a host, e.g. after queuing packets for it to send. Requests made
+// before that thread calls Reset() share one wakeup packet, so queuing several packets in a row
+// costs a single wakeup.
+class HostWakeup
+{
+public:
+  void Request(ENetHost* host);
+  // Called by the thread servicing the host every time enet_host_service returns, before it looks
+  // at what was queued for it.
+  void Reset();
+
+private:
+  std::atomic_bool m_pending = false;
+};
+
 int ENET_CALLBACK InterceptCallback(ENetHost* host, ENetEvent* event);
-bool SendPacket(ENetPeer* socket, const sf::Packet& packet, u8 channel_id);
+bool SendPacket(ENetPeer* socket, const sf::Packet& packet, u8 channel_id, bool reliable = true);
 
 // used for traversal packets and wake-up packets
 constexpr int SKIPPABLE_EVENT = 42;
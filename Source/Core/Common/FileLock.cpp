@@ -0,0 +1,99 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/FileLock.h"
+
+#ifdef _WIN32
+#include <windows.h>
+
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "Common/FileUtil.h"
+
+namespace File
+{
+FileLock::FileLock() = default;
+
+FileLock::~FileLock()
+{
+  Unlock();
+}
+
+#ifdef _WIN32
+
+bool FileLock::TryLock(const std::string& filename)
+{
+  Unlock();
+
+  CreateFullPath(filename);
+  const HANDLE file = CreateFileW(UTF8ToWString(filename).c_str(), GENERIC_READ | GENERIC_WRITE,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                  OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  OVERLAPPED overlapped = {};
+  if (!LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, 1, 0, &overlapped))
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  m_handle = file;
+  return true;
+}
+
+void FileLock::Unlock()
+{
+  // Closing the handle releases the lock.
+  if (m_handle)
+    CloseHandle(m_handle);
+  m_handle = nullptr;
+}
+
+bool FileLock::IsLocked() const
+{
+  return m_handle != nullptr;
+}
+
+#else
+
+bool FileLock::TryLock(const std::string& filename)
+{
+  Unlock();
+
+  CreateFullPath(filename);
+  const int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0)
+    return false;
+
+  if (flock(fd, LOCK_EX | LOCK_NB) != 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  m_fd = fd;
+  return true;
+}
+
+void FileLock::Unlock()
+{
+  // Closing the file releases the lock.
+  if (m_fd >= 0)
+    close(m_fd);
+  m_fd = -1;
+}
+
+bool FileLock::IsLocked() const
+{
+  return m_fd >= 0;
+}
+
+#endif
+}  // namespace File
@@ -0,0 +1,36 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+namespace File
+{
+// Exclusive advisory lock on a file, which is created if it doesn't exist. The lock is held by the
+// open file rather than by the process, so a second FileLock on the same file fails to lock it
+// even within one process. The lock file is left behind when unlocking, since deleting it could
+// race with another process that is about to lock it.
+class FileLock
+{
+public:
+  FileLock();
+  ~FileLock();
+
+  FileLock(const FileLock&) = delete;
+  FileLock& operator=(const FileLock&) = delete;
+
+  // Returns false without waiting if the file is already locked.
+  bool TryLock(const std::string& filename);
+  void Unlock();
+
+  bool IsLocked() const;
+
+private:
+#ifdef _WIN32
+  void* m_handle = nullptr;
+#else
+  int m_fd = -1;
+#endif
+};
+}  // namespace File
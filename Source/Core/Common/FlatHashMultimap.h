@@ -0,0 +1,254 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// Refers to an element of a FlatHashMultimap. Handles stay valid while other elements are added
+// or removed, and become stale once their element is erased, since the slot's generation changes.
+struct FlatHashMultimapHandle
+{
+  static constexpr u32 INVALID_INDEX = 0xFFFFFFFF;
+
+  u32 index = INVALID_INDEX;
+  u32 generation = 0;
+
+  bool IsValid() const { return index != INVALID_INDEX; }
+  bool operator==(const FlatHashMultimapHandle&) const = default;
+};
+
+// Hash multimap using open addressing with linear probing, for lookup-heavy indexes where
+// std::multimap and std::unordered_multimap spend most of their time chasing nodes.
+//
+// Elements live in a contiguous array and keep their index for as long as they exist, the probe
+// table only stores those indices. Growing the array moves the elements, so pointers to values are
+// only valid until the next Insert. Erasing uses backward shift deletion, so there are no
+// tombstones to clean up. Elements with the same key are visited in no particular order.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMultimap
+{
+public:
+  using Handle = FlatHashMultimapHandle;
+
+  FlatHashMultimap() = default;
+
+  FlatHashMultimap(const FlatHashMultimap&) = delete;
+  FlatHashMultimap& operator=(const FlatHashMultimap&) = delete;
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  Handle Insert(const Key& key, Value value)
+  {
+    if ((m_size + 1) * 2 > m_table.size())
+      Grow();
+
+    u32 index;
+    if (m_free_list.empty())
+    {
+      index = static_cast<u32>(m_elements.size());
+      m_elements.emplace_back();
+    }
+    else
+    {
+      index = m_free_list.back();
+      m_free_list.pop_back();
+    }
+
+    Element& element = m_elements[index];
+    element.hash = Hash{}(key);
+    element.key = key;
+    element.value.emplace(std::move(value));
+
+    size_t slot = GetHomeSlot(element.hash);
+    while (m_table[slot] != EMPTY_SLOT)
+      slot = (slot + 1) & (m_table.size() - 1);
+    m_table[slot] = index;
+
+    m_size++;
+    return {index, element.generation};
+  }
+
+  // Returns false if the handle is stale.
+  bool Erase(Handle handle)
+  {
+    if (!Get(handle))
+      return false;
+
+    Element& element = m_elements[handle.index];
+    const size_t mask = m_table.size() - 1;
+    size_t hole = GetHomeSlot(element.hash);
+    while (m_table[hole] != handle.index)
+      hole = (hole + 1) & mask;
+
+    // Move later elements of the cluster back into the hole, unless that would put them in front
+    // of their home slot.
+    for (size_t slot = (hole + 1) & mask; m_table[slot] != EMPTY_SLOT; slot = (slot + 1) & mask)
+    {
+      const size_t home = GetHomeSlot(m_elements[m_table[slot]].hash);
+      if (((slot - home) & mask) >= ((slot - hole) & mask))
+      {
+        m_table[hole] = m_table[slot];
+        hole = slot;
+      }
+    }
+    m_table[hole] = EMPTY_SLOT;
+
+    // Destroying the value may call back into the owner, so it is moved out here and only destroyed
+    // on return, once the map is consistent.
+    [[maybe_unused]] const std::optional<Value> value = std::exchange(element.value, std::nullopt);
+    element.generation++;
+    m_free_list.push_back(handle.index);
+    m_size--;
+    return true;
+  }
+
+  Value* Get(Handle handle)
+  {
+    if (handle.index >= m_elements.size())
+      return nullptr;
+
+    Element& element = m_elements[handle.index];
+    if (element.generation != handle.generation || !element.value)
+      return nullptr;
+    return &*element.value;
+  }
+
+  // Calls func(handle, value) for every element with the given key, until it returns false.
+  // The map must not be modified while the function runs.
+  template <typename Func>
+  void ForEachEqual(const Key& key, Func&& func)
+  {
+    if (m_size == 0)
+      return;
+
+    const size_t hash = Hash{}(key);
+    const size_t mask = m_table.size() - 1;
+    for (size_t slot = GetHomeSlot(hash); m_table[slot] != EMPTY_SLOT; slot = (slot + 1) & mask)
+    {
+      const u32 index = m_table[slot];
+      Element& element = m_elements[index];
+      if (element.hash == hash && element.key == key &&
+          !func(Handle{index, element.generation}, *element.value))
+      {
+        return;
+      }
+    }
+  }
+
+  // Returns the first element with the given key which matches the predicate.
+  template <typename Predicate>
+  Handle FindIf(const Key& key, Predicate&& predicate)
+  {
+    Handle result;
+    ForEachEqual(key, [&](Handle handle, Value& value) {
+      if (!predicate(value))
+        return true;
+      result = handle;
+      return false;
+    });
+    return result;
+  }
+
+  // Calls func(key, value) for every element, in a stable order. The map must not be modified
+  // while the function runs.
+  template <typename Func>
+  void ForEach(Func&& func)
+  {
+    for (Element& element : m_elements)
+    {
+      if (element.value)
+        func(std::as_const(element.key), *element.value);
+    }
+  }
+
+  // Erases all elements for which predicate(key, value) returns true.
+  template <typename Predicate>
+  void EraseIf(Predicate&& predicate)
+  {
+    for (u32 index = 0; index < m_elements.size(); index++)
+    {
+      Element& element = m_elements[index];
+      if (element.value && predicate(std::as_const(element.key), *element.value))
+        Erase({index, element.generation});
+    }
+  }
+
+  void Clear()
+  {
+    // The values are destroyed after the map is empty, in case that calls back into the owner.
+    // The elements themselves are kept, so that existing handles stay stale.
+    std::vector<Value> values;
+    values.reserve(m_size);
+    m_free_list.clear();
+    for (u32 index = 0; index < m_elements.size(); index++)
+    {
+      Element& element = m_elements[index];
+      if (element.value)
+      {
+        values.push_back(std::move(*element.value));
+        element.value.reset();
+        element.generation++;
+      }
+      m_free_list.push_back(index);
+    }
+    std::fill(m_table.begin(), m_table.end(), EMPTY_SLOT);
+    m_size = 0;
+  }
+
+private:
+  static constexpr u32 EMPTY_SLOT = 0xFFFFFFFF;
+  static constexpr size_t MIN_TABLE_SIZE = 16;
+
+  struct Element
+  {
+    size_t hash = 0;
+    Key key{};
+    std::optional<Value> value;
+    u32 generation = 0;
+  };
+
+  size_t GetHomeSlot(size_t hash) const
+  {
+    // Fibonacci hashing, as std::hash is the identity function for integers on some platforms.
+    const u64 mixed = static_cast<u64>(hash) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(mixed >> m_shift);
+  }
+
+  void Grow()
+  {
+    const size_t new_size = std::max(MIN_TABLE_SIZE, m_table.size() * 2);
+    m_shift = 64 - std::countr_zero(new_size);
+    m_table.assign(new_size, EMPTY_SLOT);
+
+    const size_t mask = new_size - 1;
+    for (u32 index = 0; index < m_elements.size(); index++)
+    {
+      if (!m_elements[index].value)
+        continue;
+
+      size_t slot = GetHomeSlot(m_elements[index].hash);
+      while (m_table[slot] != EMPTY_SLOT)
+        slot = (slot + 1) & mask;
+      m_table[slot] = index;
+    }
+  }
+
+  std::vector<Element> m_elements;
+  std::vector<u32> m_free_list;
+  std::vector<u32> m_table;
+  size_t m_size = 0;
+  int m_shift = 64;
+};
+}  // namespace Common
@@ -6,16 +6,26 @@
 #include <cstddef>
 #include <cstdio>
 #include <string>
+#include <string_view>
+
+#include <fmt/format.h>
 
 #ifdef _WIN32
+#include <fcntl.h>
 #include <io.h>
+#include <windows.h>
 
 #include "Common/CommonFuncs.h"
 #include "Common/StringUtil.h"
 #else
+#include <fcntl.h>
 #include <unistd.h>
 #endif
 
+#ifdef __APPLE__
+#include <sys/param.h>
+#endif
+
 #ifdef ANDROID
 #include <algorithm>
 
@@ -103,10 +113,44 @@ bool IOFile::Close()
 
 IOFile IOFile::Duplicate(const char openmode[]) const
 {
+  // Where possible, the file is opened again rather than having its descriptor duplicated.
+  // Duplicated descriptors share their file position, so using the original and the duplicate
+  // on different threads could make either one of them read from the wrong offset.
+  const bool read_only = std::string_view(openmode).find_first_of("wa+") == std::string_view::npos;
+
 #ifdef _WIN32
+  if (read_only)
+  {
+    const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file)));
+    const HANDLE new_handle =
+        ReOpenFile(handle, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 0);
+    if (new_handle != INVALID_HANDLE_VALUE)
+    {
+      const int fd = _open_osfhandle(reinterpret_cast<intptr_t>(new_handle), _O_RDONLY);
+      if (fd != -1)
+        return IOFile(_fdopen(fd, openmode));
+      CloseHandle(new_handle);
+    }
+  }
+
   return IOFile(_fdopen(_dup(_fileno(m_file)), openmode));
 #else   // _WIN32
-  return IOFile(fdopen(dup(fileno(m_file)), openmode));
+  const int fd = fileno(m_file);
+  if (read_only)
+  {
+#if defined(__linux__)
+    const int new_fd = open(fmt::format("/proc/self/fd/{}", fd).c_str(), O_RDONLY | O_CLOEXEC);
+#elif defined(__APPLE__)
+    char path[MAXPATHLEN];
+    const int new_fd = fcntl(fd, F_GETPATH, path) != -1 ? open(path, O_RDONLY | O_CLOEXEC) : -1;
+#else
+    const int new_fd = -1;
+#endif
+    if (new_fd != -1)
+      return IOFile(fdopen(new_fd, openmode));
+  }
+
+  return IOFile(fdopen(dup(fd), openmode));
 #endif  // _WIN32
 }
 
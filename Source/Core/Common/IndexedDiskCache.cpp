@@ -0,0 +1,500 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/IndexedDiskCache.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <xxhash.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
+#include "Common/Version.h"
+
+namespace Common
+{
+namespace
+{
+constexpr u32 COMPACTED_FILE_ID = 0x58494344;  // "DCIX"
+constexpr u32 JOURNAL_FILE_ID = 0x4A494344;    // "DCIJ"
+constexpr u32 MIN_INDEX_CAPACITY = 16;
+
+struct Header
+{
+  u32 id;
+  u16 key_size;
+  u16 value_type_size;
+  char version[40];
+  u32 entry_count;
+  u32 index_capacity;
+  u64 index_offset;
+};
+static_assert(sizeof(Header) == 64);
+
+struct RecordHeader
+{
+  u32 value_size;
+  u32 reserved;
+  u64 checksum;
+};
+static_assert(sizeof(RecordHeader) == 16);
+
+struct IndexSlot
+{
+  u64 key_hash;
+  u64 record_offset;
+};
+static_assert(sizeof(IndexSlot) == 16);
+
+Header MakeHeader(u32 id, u16 key_size, u16 value_type_size)
+{
+  Header header = {};
+  header.id = id;
+  header.key_size = key_size;
+  header.value_type_size = value_type_size;
+  // Null-terminator is intentionally not copied.
+  const std::string& version = GetScmRevGitStr();
+  std::memcpy(header.version, version.data(), std::min(version.size(), sizeof(header.version)));
+  return header;
+}
+
+bool IsCompatibleHeader(const Header& header, const Header& expected)
+{
+  return header.id == expected.id && header.key_size == expected.key_size &&
+         header.value_type_size == expected.value_type_size &&
+         std::memcmp(header.version, expected.version, sizeof(header.version)) == 0;
+}
+
+struct RecordView
+{
+  const u8* key;
+  const u8* value;
+  u32 value_size;
+  u64 checksum;
+  // Offset of the next record
+  u64 end;
+};
+
+// Parses the record at offset, making sure it lies within [offset, limit).
+bool ReadRecord(const u8* data, u64 offset, u64 limit, u16 key_size, u16 value_type_size,
+                RecordView* record)
+{
+  if (offset > limit || limit - offset < sizeof(RecordHeader) + key_size)
+    return false;
+
+  RecordHeader header;
+  std::memcpy(&header, data + offset, sizeof(header));
+  const u64 value_offset = offset + sizeof(RecordHeader) + key_size;
+  if (header.value_size % value_type_size != 0 || limit - value_offset < header.value_size)
+    return false;
+
+  record->key = data + offset + sizeof(RecordHeader);
+  record->value = data + value_offset;
+  record->value_size = header.value_size;
+  record->checksum = header.checksum;
+  record->end = value_offset + header.value_size;
+  return true;
+}
+
+u64 HashKey(const void* key, u16 key_size)
+{
+  return XXH3_64bits(key, key_size);
+}
+
+u64 ChecksumValue(const void* value, u32 value_size, u64 key_hash)
+{
+  return XXH3_64bits_withSeed(value, value_size, key_hash);
+}
+
+bool IsRecordValid(const RecordView& record, u16 key_size)
+{
+  return ChecksumValue(record.value, record.value_size, HashKey(record.key, key_size)) ==
+         record.checksum;
+}
+
+std::string GetJournalFileName(const std::string& filename)
+{
+  return filename + ".journal";
+}
+
+std::string GetLockFileName(const std::string& filename)
+{
+  return filename + ".lock";
+}
+}  // Anonymous namespace
+
+IndexedDiskCacheFile::IndexedDiskCacheFile(u16 key_size, u16 value_type_size)
+    : m_key_size(key_size), m_value_type_size(value_type_size)
+{
+}
+
+IndexedDiskCacheFile::~IndexedDiskCacheFile()
+{
+  Close();
+}
+
+u32 IndexedDiskCacheFile::Open(const std::string& filename, bool read_only)
+{
+  Close();
+  m_filename = filename;
+  m_read_only = read_only;
+
+  // Another writer could be appending to the journal or compacting at any moment, so only one
+  // instance gets to write.
+  if (!m_read_only && !m_writer_lock.TryLock(GetLockFileName(filename)))
+  {
+    INFO_LOG_FMT(COMMON, "{} is being written by another instance, opening it read-only",
+                 filename);
+    m_read_only = true;
+  }
+
+  // A journal left behind by a crash or by a failed compaction gets merged before mapping, so
+  // that its entries are visible to Lookup().
+  if (!m_read_only && File::Exists(GetJournalFileName(filename)))
+    CompactLocked(filename, m_key_size, m_value_type_size);
+
+  if (!MapCompactedFile())
+    return 0;
+  return m_entry_count;
+}
+
+bool IndexedDiskCacheFile::MapCompactedFile()
+{
+  if (!m_mapping.Open(m_filename))
+    return false;
+
+  const u8* data = m_mapping.GetData();
+  const u64 size = m_mapping.GetSize();
+  Header header;
+  if (size < sizeof(header))
+  {
+    m_mapping.Close();
+    return false;
+  }
+
+  std::memcpy(&header, data, sizeof(header));
+  const Header expected = MakeHeader(COMPACTED_FILE_ID, m_key_size, m_value_type_size);
+  if (!IsCompatibleHeader(header, expected) || !MathUtil::IsPow2(header.index_capacity) ||
+      header.index_offset < sizeof(Header) || header.index_offset % alignof(IndexSlot) != 0 ||
+      header.index_offset > size ||
+      (size - header.index_offset) / sizeof(IndexSlot) < header.index_capacity)
+  {
+    WARN_LOG_FMT(COMMON, "Ignoring outdated or damaged cache file {}", m_filename);
+    m_mapping.Close();
+    return false;
+  }
+
+  m_entry_count = header.entry_count;
+  m_index_capacity = header.index_capacity;
+  m_index_offset = header.index_offset;
+  return true;
+}
+
+void IndexedDiskCacheFile::Close()
+{
+  const bool compact = !m_read_only && m_journal_entries != 0;
+  m_journal.Close();
+  m_mapping.Close();
+  if (compact)
+    CompactLocked(m_filename, m_key_size, m_value_type_size);
+  m_writer_lock.Unlock();
+
+  m_filename.clear();
+  m_entry_count = 0;
+  m_index_capacity = 0;
+  m_index_offset = 0;
+  m_journal_entries = 0;
+}
+
+void IndexedDiskCacheFile::Sync()
+{
+  if (m_journal.IsOpen())
+    m_journal.Flush();
+}
+
+u32 IndexedDiskCacheFile::ForEachEntry(const EntryCallback& callback) const
+{
+  if (!m_mapping.IsOpen())
+    return 0;
+
+  const u8* data = m_mapping.GetData();
+  u64 offset = sizeof(Header);
+  u32 count = 0;
+  RecordView record;
+  for (u32 i = 0; i < m_entry_count; i++)
+  {
+    if (!ReadRecord(data, offset, m_index_offset, m_key_size, m_value_type_size, &record))
+      break;
+
+    offset = record.end;
+    if (!IsRecordValid(record, m_key_size))
+      continue;
+
+    callback(record.key, record.value, record.value_size);
+    count++;
+  }
+  return count;
+}
+
+u64 IndexedDiskCacheFile::FindRecord(const void* key, u64 key_hash) const
+{
+  if (!m_mapping.IsOpen())
+    return 0;
+
+  const u8* data = m_mapping.GetData();
+  const u32 mask = m_index_capacity - 1;
+  for (u32 i = 0; i < m_index_capacity; i++)
+  {
+    IndexSlot slot;
+    std::memcpy(&slot, data + m_index_offset + u64((key_hash + i) & mask) * sizeof(IndexSlot),
+                sizeof(slot));
+    if (slot.record_offset == 0)
+      return 0;
+    if (slot.key_hash != key_hash || slot.record_offset < sizeof(Header) ||
+        slot.record_offset > m_index_offset ||
+        m_index_offset - slot.record_offset < sizeof(RecordHeader) + m_key_size)
+    {
+      continue;
+    }
+
+    if (std::memcmp(data + slot.record_offset + sizeof(RecordHeader), key, m_key_size) == 0)
+      return slot.record_offset;
+  }
+  return 0;
+}
+
+const u8* IndexedDiskCacheFile::Lookup(const void* key, u32* value_size) const
+{
+  const u64 offset = FindRecord(key, HashKey(key, m_key_size));
+  RecordView record;
+  if (offset == 0 || !ReadRecord(m_mapping.GetData(), offset, m_index_offset, m_key_size,
+                                 m_value_type_size, &record))
+  {
+    return nullptr;
+  }
+
+  if (!IsRecordValid(record, m_key_size))
+  {
+    WARN_LOG_FMT(COMMON, "Checksum mismatch for the entry at {:#x} of {}", offset, m_filename);
+    return nullptr;
+  }
+
+  *value_size = record.value_size;
+  return record.value;
+}
+
+bool IndexedDiskCacheFile::Contains(const void* key) const
+{
+  return FindRecord(key, HashKey(key, m_key_size)) != 0;
+}
+
+bool IndexedDiskCacheFile::OpenJournal()
+{
+  const std::string journal_filename = GetJournalFileName(m_filename);
+  const Header expected = MakeHeader(JOURNAL_FILE_ID, m_key_size, m_value_type_size);
+
+  // Only reached if compacting at Open() failed, in which case the new entries go after the
+  // ones which are still waiting to be merged.
+  if (m_journal.Open(journal_filename, "r+b"))
+  {
+    Header header;
+    if (m_journal.ReadArray(&header, 1) && IsCompatibleHeader(header, expected) &&
+        m_journal.Seek(0, File::SeekOrigin::End))
+    {
+      return true;
+    }
+    m_journal.Close();
+  }
+
+  File::CreateFullPath(journal_filename);
+  return m_journal.Open(journal_filename, "wb") && m_journal.WriteArray(&expected, 1);
+}
+
+void IndexedDiskCacheFile::Append(const void* key, const void* value, u32 value_size)
+{
+  if (m_read_only || !IsOpen())
+    return;
+
+  // Entries which were stored before with the same value don't need to be written again.
+  u32 existing_size;
+  const u8* existing = Lookup(key, &existing_size);
+  if (existing && existing_size == value_size && std::memcmp(existing, value, value_size) == 0)
+    return;
+
+  if (!m_journal.IsOpen() && !OpenJournal())
+  {
+    WARN_LOG_FMT(COMMON, "Failed to open the journal of {}", m_filename);
+    m_read_only = true;
+    return;
+  }
+
+  const RecordHeader header{value_size, 0,
+                            ChecksumValue(value, value_size, HashKey(key, m_key_size))};
+  m_journal.WriteArray(&header, 1);
+  m_journal.WriteBytes(key, m_key_size);
+  m_journal.WriteBytes(value, value_size);
+  m_journal_entries++;
+}
+
+bool IndexedDiskCacheFile::Compact(const std::string& filename, u16 key_size,
+                                   u16 value_type_size)
+{
+  File::FileLock lock;
+  if (!lock.TryLock(GetLockFileName(filename)))
+    return false;
+
+  return CompactLocked(filename, key_size, value_type_size);
+}
+
+bool IndexedDiskCacheFile::CompactLocked(const std::string& filename, u16 key_size,
+                                         u16 value_type_size)
+{
+  const std::string journal_filename = GetJournalFileName(filename);
+  std::string journal;
+  if (!File::ReadFileToString(journal_filename, journal))
+    return true;
+
+  const Header journal_header = MakeHeader(JOURNAL_FILE_ID, key_size, value_type_size);
+  Header header;
+  if (journal.size() >= sizeof(header))
+    std::memcpy(&header, journal.data(), sizeof(header));
+  if (journal.size() < sizeof(header) || !IsCompatibleHeader(header, journal_header))
+  {
+    File::Delete(journal_filename);
+    return true;
+  }
+
+  std::vector<RecordView> records;
+
+  // Records of the existing compacted file come first, so the journal overrides them.
+  File::MappedFile mapping;
+  if (mapping.Open(filename) && mapping.GetSize() >= sizeof(header))
+  {
+    std::memcpy(&header, mapping.GetData(), sizeof(header));
+    if (IsCompatibleHeader(header, MakeHeader(COMPACTED_FILE_ID, key_size, value_type_size)) &&
+        header.index_offset <= mapping.GetSize())
+    {
+      u64 offset = sizeof(Header);
+      RecordView record;
+      for (u32 i = 0; i < header.entry_count; i++)
+      {
+        if (!ReadRecord(mapping.GetData(), offset, header.index_offset, key_size, value_type_size,
+                        &record))
+        {
+          break;
+        }
+        offset = record.end;
+        if (IsRecordValid(record, key_size))
+          records.push_back(record);
+      }
+    }
+  }
+
+  // Anything after the first damaged record of the journal is lost, e.g. after a crash.
+  const size_t existing_records = records.size();
+  const u8* journal_data = reinterpret_cast<const u8*>(journal.data());
+  u64 offset = sizeof(Header);
+  RecordView record;
+  while (ReadRecord(journal_data, offset, journal.size(), key_size, value_type_size, &record) &&
+         IsRecordValid(record, key_size))
+  {
+    offset = record.end;
+    records.push_back(record);
+  }
+
+  if (records.size() == existing_records)
+  {
+    mapping.Close();
+    File::Delete(journal_filename);
+    return true;
+  }
+
+  // Build the index in memory first, with slots pointing at records + 1. Later records replace
+  // earlier ones with the same key.
+  const u32 capacity = std::max(
+      MIN_INDEX_CAPACITY, MathUtil::NextPowerOf2(static_cast<u32>(records.size() * 2)));
+  std::vector<u64> slot_hashes(capacity);
+  std::vector<u32> slot_records(capacity);
+  for (u32 i = 0; i < records.size(); i++)
+  {
+    const u64 key_hash = HashKey(records[i].key, key_size);
+    for (u32 probe = 0;; probe++)
+    {
+      const u32 slot = static_cast<u32>((key_hash + probe) & (capacity - 1));
+      if (slot_records[slot] == 0 ||
+          (slot_hashes[slot] == key_hash &&
+           std::memcmp(records[slot_records[slot] - 1].key, records[i].key, key_size) == 0))
+      {
+        slot_hashes[slot] = key_hash;
+        slot_records[slot] = i + 1;
+        break;
+      }
+    }
+  }
+
+  // Write out the surviving records in their original order.
+  std::vector<u8> is_live(records.size());
+  u32 live_count = 0;
+  for (const u32 slot_record : slot_records)
+  {
+    if (slot_record != 0)
+    {
+      is_live[slot_record - 1] = 1;
+      live_count++;
+    }
+  }
+
+  const std::string temp_filename = filename + ".tmp";
+  File::IOFile file(temp_filename, "wb");
+  header = MakeHeader(COMPACTED_FILE_ID, key_size, value_type_size);
+  header.entry_count = live_count;
+  header.index_capacity = capacity;
+  bool success = file.WriteArray(&header, 1);
+
+  std::vector<u64> record_offsets(records.size());
+  u64 file_offset = sizeof(Header);
+  for (u32 i = 0; i < records.size() && success; i++)
+  {
+    if (!is_live[i])
+      continue;
+
+    const RecordHeader record_header{records[i].value_size, 0, records[i].checksum};
+    success = file.WriteArray(&record_header, 1) && file.WriteBytes(records[i].key, key_size) &&
+              file.WriteBytes(records[i].value, records[i].value_size);
+    record_offsets[i] = file_offset;
+    file_offset += sizeof(RecordHeader) + key_size + records[i].value_size;
+  }
+
+  const u64 padding = (alignof(IndexSlot) - file_offset % alignof(IndexSlot)) % alignof(IndexSlot);
+  static constexpr u8 zeroes[alignof(IndexSlot)] = {};
+  header.index_offset = file_offset + padding;
+
+  std::vector<IndexSlot> index(capacity);
+  for (u32 slot = 0; slot < capacity; slot++)
+  {
+    if (slot_records[slot] != 0)
+      index[slot] = {slot_hashes[slot], record_offsets[slot_records[slot] - 1]};
+  }
+
+  success = success && file.WriteBytes(zeroes, padding) &&
+            file.WriteArray(index.data(), capacity) && file.Seek(0, File::SeekOrigin::Begin) &&
+            file.WriteArray(&header, 1);
+  file.Close();
+
+  // The old records point into the mapping, so it can only be released here. On Windows, the
+  // rename fails while another process still has the old file mapped.
+  mapping.Close();
+  if (!success || !File::Rename(temp_filename, filename))
+  {
+    WARN_LOG_FMT(COMMON, "Failed to compact {}, keeping the journal", filename);
+    File::Delete(temp_filename);
+    return false;
+  }
+
+  File::Delete(journal_filename);
+  INFO_LOG_FMT(COMMON, "Compacted {} entries into {}", live_count, filename);
+  return true;
+}
+}  // namespace Common
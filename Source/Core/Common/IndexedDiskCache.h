@@ -0,0 +1,179 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileLock.h"
+#include "Common/IOFile.h"
+#include "Common/LinearDiskCache.h"
+#include "Common/MappedFile.h"
+
+// On disk format of the compacted file:
+// header{
+// u32 'DCIX';
+// u16 sizeof(key_type);
+// u16 sizeof(value_type);
+// char version[40];  // scm rev
+// u32 entry_count;
+// u32 index_capacity;  // power of two
+// u64 index_offset;
+//}
+//
+// record[entry_count]{
+// u32 value_size;
+// u32 reserved;
+// u64 checksum;  // XXH3 of the value, seeded with the key hash
+// key_type   key;
+// value_type[value_size]   value;
+//}
+//
+// index_slot[index_capacity]{  // at index_offset, open addressing with linear probing
+// u64 key_hash;
+// u64 record_offset;  // 0 for empty slots
+//}
+//
+// New entries are appended to "<filename>.journal", which uses the same header with the id
+// 'DCIJ' and no index, followed by records. The journal is merged into the compacted file by
+// Compact(), which a writable cache does when it is closed or when it finds a stale journal.
+//
+// Only the holder of a lock on "<filename>.lock" writes the journal or compacts. A cache that is
+// opened for writing while another instance holds the lock is opened read-only instead.
+
+namespace Common
+{
+// Untyped implementation of IndexedDiskCache. Keys and values are handled as bytes.
+class IndexedDiskCacheFile
+{
+public:
+  using EntryCallback = std::function<void(const u8* key, const u8* value, u32 value_size)>;
+
+  IndexedDiskCacheFile(u16 key_size, u16 value_type_size);
+  ~IndexedDiskCacheFile();
+
+  IndexedDiskCacheFile(const IndexedDiskCacheFile&) = delete;
+  IndexedDiskCacheFile& operator=(const IndexedDiskCacheFile&) = delete;
+
+  // Returns the number of entries in the compacted file. Falls back to read-only if another
+  // writable instance of the same cache is open.
+  u32 Open(const std::string& filename, bool read_only);
+  void Close();
+  void Sync();
+
+  bool IsOpen() const { return !m_filename.empty(); }
+  bool IsReadOnly() const { return m_read_only; }
+
+  // Passes every valid entry of the compacted file to the callback, in file order.
+  u32 ForEachEntry(const EntryCallback& callback) const;
+
+  // Returns a pointer into the mapping, which stays valid until the cache is closed.
+  // value_size is in bytes. Entries which fail the checksum are treated as missing.
+  const u8* Lookup(const void* key, u32* value_size) const;
+  bool Contains(const void* key) const;
+
+  // Does nothing for read-only caches and for entries which the compacted file already contains
+  // with the same value. A different value replaces the old one when the journal is merged.
+  void Append(const void* key, const void* value, u32 value_size);
+
+  // Merges the journal of a cache into its compacted file. Returns false if a writable instance
+  // of the same cache is open or if the compacted file couldn't be replaced, in which case the
+  // journal is kept.
+  static bool Compact(const std::string& filename, u16 key_size, u16 value_type_size);
+
+private:
+  // Compact() for when the writer lock is already held
+  static bool CompactLocked(const std::string& filename, u16 key_size, u16 value_type_size);
+
+  bool MapCompactedFile();
+  u64 FindRecord(const void* key, u64 key_hash) const;
+  bool OpenJournal();
+
+  u16 m_key_size;
+  u16 m_value_type_size;
+  std::string m_filename;
+  bool m_read_only = false;
+  File::FileLock m_writer_lock;
+
+  File::MappedFile m_mapping;
+  u32 m_entry_count = 0;
+  u32 m_index_capacity = 0;
+  u64 m_index_offset = 0;
+
+  File::IOFile m_journal;
+  u32 m_journal_entries = 0;
+};
+
+// Key-value store for data which is mostly read, like shader and pipeline binaries.
+//
+// Unlike LinearDiskCache, entries are served straight from a memory mapping, either all at once
+// through OpenAndRead() or one at a time through Lookup(), which finds them in an on-disk hash
+// index without reading the rest of the file. A cache opened read-only never modifies anything
+// on disk, so several instances can share one cache file. Only one of them can write to it at a
+// time, and the others become read-only.
+//
+// K and V are some POD type
+// K : the key type
+// V : value array type
+template <typename K, typename V>
+class IndexedDiskCache
+{
+public:
+  // Values are handed out as pointers into the mapping.
+  static_assert(alignof(V) == 1, "V must not require alignment");
+  static_assert(std::is_trivially_copyable_v<K>, "K must be a trivially copyable type");
+
+  IndexedDiskCache() : m_file(sizeof(K), sizeof(V)) {}
+
+  // return number of read entries
+  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader,
+                  bool read_only = false)
+  {
+    Open(filename, read_only);
+    return m_file.ForEachEntry([&reader](const u8* key_data, const u8* value, u32 value_size) {
+      K key;
+      std::memcpy(&key, key_data, sizeof(K));
+      reader.Read(key, reinterpret_cast<const V*>(value), value_size / sizeof(V));
+    });
+  }
+
+  // Opens the cache without reading anything, for use with Lookup().
+  u32 Open(const std::string& filename, bool read_only = false)
+  {
+    return m_file.Open(filename, read_only);
+  }
+
+  void Sync() { m_file.Sync(); }
+  void Close() { m_file.Close(); }
+
+  bool IsReadOnly() const { return m_file.IsReadOnly(); }
+
+  // Can be called from any thread while the cache is open.
+  const V* Lookup(const K& key, u32* value_size) const
+  {
+    const u8* value = m_file.Lookup(&key, value_size);
+    if (value)
+      *value_size /= sizeof(V);
+    return reinterpret_cast<const V*>(value);
+  }
+  bool Contains(const K& key) const { return m_file.Contains(&key); }
+
+  // Appends a key-value pair to the journal.
+  void Append(const K& key, const V* value, u32 value_size)
+  {
+    m_file.Append(&key, value, value_size * sizeof(V));
+  }
+
+  static bool Compact(const std::string& filename)
+  {
+    return IndexedDiskCacheFile::Compact(filename, sizeof(K), sizeof(V));
+  }
+
+private:
+  IndexedDiskCacheFile m_file;
+};
+}  // namespace Common
@@ -3,18 +3,30 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#ifdef _M_X86_64
+#include <emmintrin.h>
+#endif
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/Config/AchievementSettings.h"
 #include "Core/Core.h"
@@ -103,115 +115,480 @@ std::vector<u8> Cheats::GetValueAsByteVector(const Cheats::SearchValue& value)
 namespace
 {
 template <typename T>
-static std::optional<PowerPC::ReadResult<T>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space);
+T ReadValue(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
+}
 
-template <>
-std::optional<PowerPC::ReadResult<u8>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+// Sets bits [begin, end) to value
+void FillBits(std::vector<u64>* bits, size_t begin, size_t end, bool value)
 {
-  return PowerPC::MMU::HostTryReadU8(guard, addr, space);
+  while (begin < end)
+  {
+    const size_t bit = begin % 64;
+    const size_t count = std::min<size_t>(64 - bit, end - begin);
+    const u64 mask = (count == 64 ? ~u64{0} : (u64{1} << count) - 1) << bit;
+    u64& word = (*bits)[begin / 64];
+    word = value ? word | mask : word & ~mask;
+    begin += count;
+  }
 }
 
-template <>
-std::optional<PowerPC::ReadResult<u16>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+// Calls f with the function object that compares values of type T like compare_type says
+template <typename T, typename F>
+void WithComparison(Cheats::CompareType compare_type, F&& f)
 {
-  return PowerPC::MMU::HostTryReadU16(guard, addr, space);
+  switch (compare_type)
+  {
+  case Cheats::CompareType::Equal:
+    return f(std::equal_to<T>());
+  case Cheats::CompareType::NotEqual:
+    return f(std::not_equal_to<T>());
+  case Cheats::CompareType::Less:
+    return f(std::less<T>());
+  case Cheats::CompareType::LessOrEqual:
+    return f(std::less_equal<T>());
+  case Cheats::CompareType::Greater:
+    return f(std::greater<T>());
+  case Cheats::CompareType::GreaterOrEqual:
+    return f(std::greater_equal<T>());
+  default:
+    DEBUG_ASSERT(false);
+  }
 }
 
-template <>
-std::optional<PowerPC::ReadResult<u32>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T, typename Compare>
+void CompareValuesScalar(const u8* data, const u8* last_data, T specific_value, u32 stride,
+                         u32 begin, u32 count, u64* out, Compare compare)
 {
-  return PowerPC::MMU::HostTryReadU32(guard, addr, space);
+  for (u32 i = begin; i < count; i += 64)
+  {
+    u64 word = 0;
+    const u32 values_in_word = std::min<u32>(64, count - i);
+    for (u32 j = 0; j < values_in_word; ++j)
+    {
+      const u32 offset = (i + j) * stride;
+      const T other_value = last_data ? ReadValue<T>(last_data + offset) : specific_value;
+      word |= u64{compare(ReadValue<T>(data + offset), other_value)} << j;
+    }
+    out[i / 64] = word;
+  }
 }
 
-template <>
-std::optional<PowerPC::ReadResult<u64>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+#ifdef _M_X86_64
+// SSE2 has no 64-bit integer comparisons
+template <typename T>
+constexpr bool IS_VECTORIZED = std::is_floating_point_v<T> || sizeof(T) <= 4;
+
+template <typename T>
+__m128i SignBits()
 {
-  return PowerPC::MMU::HostTryReadU64(guard, addr, space);
+  if constexpr (sizeof(T) == 1)
+    return _mm_set1_epi8(static_cast<char>(0x80));
+  else if constexpr (sizeof(T) == 2)
+    return _mm_set1_epi16(static_cast<short>(0x8000));
+  else
+    return _mm_set1_epi32(static_cast<int>(0x80000000));
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s8>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+// Loads 16 bytes of big endian values, byteswapped to what the comparisons below expect
+template <typename T>
+auto LoadVector(const u8* data)
 {
-  auto tmp = PowerPC::MMU::HostTryReadU8(guard, addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s8>(tmp->translated, Common::BitCast<s8>(tmp->value));
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  if constexpr (sizeof(T) >= 2)
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+  if constexpr (sizeof(T) == 4)
+    v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+  else if constexpr (sizeof(T) == 8)
+    v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+
+  if constexpr (std::is_same_v<T, float>)
+    return _mm_castsi128_ps(v);
+  else if constexpr (std::is_same_v<T, double>)
+    return _mm_castsi128_pd(v);
+  else if constexpr (std::is_unsigned_v<T>)
+    // Only signed comparisons exist, and flipping the sign bits makes them order unsigned values
+    return _mm_xor_si128(v, SignBits<T>());
+  else
+    return v;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s16>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+auto BroadcastVector(T value)
 {
-  auto tmp = PowerPC::MMU::HostTryReadU16(guard, addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s16>(tmp->translated, Common::BitCast<s16>(tmp->value));
+  std::array<u8, 16> data;
+  for (size_t i = 0; i < data.size(); i += sizeof(T))
+  {
+    const T big_endian_value = Common::FromBigEndian(value);
+    std::memcpy(&data[i], &big_endian_value, sizeof(T));
+  }
+  return LoadVector<T>(data.data());
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s32>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+u32 MoveMask(__m128i v)
 {
-  auto tmp = PowerPC::MMU::HostTryReadU32(guard, addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s32>(tmp->translated, Common::BitCast<s32>(tmp->value));
+  if constexpr (sizeof(T) == 1)
+    return _mm_movemask_epi8(v);
+  else if constexpr (sizeof(T) == 2)
+    return _mm_movemask_epi8(_mm_packs_epi16(v, _mm_setzero_si128()));
+  else
+    return _mm_movemask_ps(_mm_castsi128_ps(v));
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s64>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+__m128i CompareEqual(__m128i a, __m128i b)
 {
-  auto tmp = PowerPC::MMU::HostTryReadU64(guard, addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s64>(tmp->translated, Common::BitCast<s64>(tmp->value));
+  if constexpr (sizeof(T) == 1)
+    return _mm_cmpeq_epi8(a, b);
+  else if constexpr (sizeof(T) == 2)
+    return _mm_cmpeq_epi16(a, b);
+  else
+    return _mm_cmpeq_epi32(a, b);
 }
 
-template <>
-std::optional<PowerPC::ReadResult<float>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+__m128i CompareGreater(__m128i a, __m128i b)
 {
-  return PowerPC::MMU::HostTryReadF32(guard, addr, space);
+  if constexpr (sizeof(T) == 1)
+    return _mm_cmpgt_epi8(a, b);
+  else if constexpr (sizeof(T) == 2)
+    return _mm_cmpgt_epi16(a, b);
+  else
+    return _mm_cmpgt_epi32(a, b);
+}
+
+// Returns a bit for each value in a for which compare(a, b) is true
+template <typename T, typename Compare>
+u32 CompareVectors(__m128i a, __m128i b)
+{
+  // Integers only have == and >, and the other comparisons are made from them
+  constexpr u32 ALL = (1u << (16 / sizeof(T))) - 1;
+  if constexpr (std::is_same_v<Compare, std::equal_to<T>>)
+    return MoveMask<T>(CompareEqual<T>(a, b));
+  else if constexpr (std::is_same_v<Compare, std::not_equal_to<T>>)
+    return MoveMask<T>(CompareEqual<T>(a, b)) ^ ALL;
+  else if constexpr (std::is_same_v<Compare, std::less<T>>)
+    return MoveMask<T>(CompareGreater<T>(b, a));
+  else if constexpr (std::is_same_v<Compare, std::less_equal<T>>)
+    return MoveMask<T>(CompareGreater<T>(a, b)) ^ ALL;
+  else if constexpr (std::is_same_v<Compare, std::greater<T>>)
+    return MoveMask<T>(CompareGreater<T>(a, b));
+  else
+    return MoveMask<T>(CompareGreater<T>(b, a)) ^ ALL;
+}
+
+// Unlike the integer comparisons, these can't be made from each other because of NaN
+template <typename T, typename Compare>
+u32 CompareVectors(__m128 a, __m128 b)
+{
+  if constexpr (std::is_same_v<Compare, std::equal_to<T>>)
+    return _mm_movemask_ps(_mm_cmpeq_ps(a, b));
+  else if constexpr (std::is_same_v<Compare, std::not_equal_to<T>>)
+    return _mm_movemask_ps(_mm_cmpneq_ps(a, b));
+  else if constexpr (std::is_same_v<Compare, std::less<T>>)
+    return _mm_movemask_ps(_mm_cmplt_ps(a, b));
+  else if constexpr (std::is_same_v<Compare, std::less_equal<T>>)
+    return _mm_movemask_ps(_mm_cmple_ps(a, b));
+  else if constexpr (std::is_same_v<Compare, std::greater<T>>)
+    return _mm_movemask_ps(_mm_cmpgt_ps(a, b));
+  else
+    return _mm_movemask_ps(_mm_cmpge_ps(a, b));
+}
+
+template <typename T, typename Compare>
+u32 CompareVectors(__m128d a, __m128d b)
+{
+  if constexpr (std::is_same_v<Compare, std::equal_to<T>>)
+    return _mm_movemask_pd(_mm_cmpeq_pd(a, b));
+  else if constexpr (std::is_same_v<Compare, std::not_equal_to<T>>)
+    return _mm_movemask_pd(_mm_cmpneq_pd(a, b));
+  else if constexpr (std::is_same_v<Compare, std::less<T>>)
+    return _mm_movemask_pd(_mm_cmplt_pd(a, b));
+  else if constexpr (std::is_same_v<Compare, std::less_equal<T>>)
+    return _mm_movemask_pd(_mm_cmple_pd(a, b));
+  else if constexpr (std::is_same_v<Compare, std::greater<T>>)
+    return _mm_movemask_pd(_mm_cmpgt_pd(a, b));
+  else
+    return _mm_movemask_pd(_mm_cmpge_pd(a, b));
 }
+#endif
 
-template <>
-std::optional<PowerPC::ReadResult<double>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+// Sets bit i of out to compare(value i, value i of last_data or specific_value) for count values
+// in data, which are sizeof(T) bytes apart if aligned and 1 byte apart otherwise
+template <typename T, typename Compare>
+void CompareValues(const u8* data, const u8* last_data, T specific_value, bool aligned, u32 count,
+                   u64* out, Compare compare)
 {
-  return PowerPC::MMU::HostTryReadF64(guard, addr, space);
+  u32 vectorized_count = 0;
+#ifdef _M_X86_64
+  if constexpr (IS_VECTORIZED<T>)
+  {
+    if (aligned)
+    {
+      constexpr u32 LANES = 16 / sizeof(T);
+      const auto specific_vector = BroadcastVector(specific_value);
+      vectorized_count = count & ~63u;
+      for (u32 i = 0; i < vectorized_count; i += 64)
+      {
+        u64 word = 0;
+        for (u32 j = 0; j < 64; j += LANES)
+        {
+          const u32 offset = (i + j) * sizeof(T);
+          const auto other = last_data ? LoadVector<T>(last_data + offset) : specific_vector;
+          word |= u64{CompareVectors<T, Compare>(LoadVector<T>(data + offset), other)} << j;
+        }
+        out[i / 64] = word;
+      }
+    }
+  }
+#endif
+
+  CompareValuesScalar(data, last_data, specific_value, aligned ? sizeof(T) : 1, vectorized_count,
+                      count, out, compare);
+}
+
+// Copies the pages from emulated memory. This needs the CPU thread guard, so unlike the
+// comparisons it isn't split across threads, but it only has one MMU lookup per page.
+template <typename T>
+void ReadPages(const Core::CPUThreadGuard& guard, PowerPC::RequestedAddressSpace address_space,
+               bool aligned, std::vector<typename Cheats::SearchResults<T>::Page>* pages)
+{
+  constexpr u32 PAGE_SIZE = Cheats::SearchResults<T>::PAGE_SIZE;
+  const u32 data_size = Cheats::SearchResults<T>::GetDataSize(aligned);
+  for (auto& page : *pages)
+  {
+    page.data.assign(data_size, 0);
+    page.valid_size = 0;
+    if (!PowerPC::MMU::HostTryReadBlock(guard, page.address, page.data.data(), PAGE_SIZE,
+                                        address_space))
+    {
+      continue;
+    }
+    page.valid_size = PAGE_SIZE;
+
+    if (data_size != PAGE_SIZE &&
+        PowerPC::MMU::HostTryReadBlock(guard, page.address + PAGE_SIZE,
+                                       page.data.data() + PAGE_SIZE, data_size - PAGE_SIZE,
+                                       address_space))
+    {
+      page.valid_size = data_size;
+    }
+  }
+}
+
+// Only keeps the results in page that pass the filter. last_page is the same page from the last
+// search, if there was one. Results that can't be compared because their value can't be read
+// now or couldn't be read then are dropped in new searches and kept in next searches.
+template <typename T>
+void FilterPage(typename Cheats::SearchResults<T>::Page* page,
+                const typename Cheats::SearchResults<T>::Page* last_page, bool aligned,
+                Cheats::FilterType filter_type, Cheats::CompareType compare_type,
+                T specific_value, std::vector<u64>* mask)
+{
+  using Results = Cheats::SearchResults<T>;
+
+  const u32 bit_count = Results::GetBitsPerPage(aligned);
+  u32 comparable_count = Results::GetValidBitCount(page->valid_size, aligned);
+  if (last_page)
+    comparable_count =
+        std::min(comparable_count, Results::GetValidBitCount(last_page->valid_size, aligned));
+
+  mask->resize(bit_count / 64);
+  if (filter_type == Cheats::FilterType::DoNotFilter)
+  {
+    std::fill(mask->begin(), mask->end(), ~u64{0});
+  }
+  else
+  {
+    const u8* last_data =
+        filter_type == Cheats::FilterType::CompareAgainstLastValue ? last_page->data.data() :
+                                                                     nullptr;
+    WithComparison<T>(compare_type, [&](auto compare) {
+      CompareValues(page->data.data(), last_data, specific_value, aligned, bit_count,
+                    mask->data(), compare);
+    });
+  }
+  FillBits(mask, comparable_count, bit_count, last_page != nullptr);
+
+  for (size_t i = 0; i < mask->size(); ++i)
+    page->bits[i] &= (*mask)[i];
+}
+
+template <typename T>
+void FilterPages(std::vector<typename Cheats::SearchResults<T>::Page>* pages,
+                 const std::vector<typename Cheats::SearchResults<T>::Page>* last_pages,
+                 bool aligned, Cheats::FilterType filter_type, Cheats::CompareType compare_type,
+                 T specific_value)
+{
+  const auto filter = [&](size_t begin, size_t end) {
+    std::vector<u64> mask;
+    for (size_t i = begin; i < end; ++i)
+    {
+      FilterPage<T>(&(*pages)[i], last_pages ? &(*last_pages)[i] : nullptr, aligned, filter_type,
+                    compare_type, specific_value, &mask);
+    }
+  };
+
+  // Searches that are narrowed down to a few pages are done before threads would have started
+  constexpr size_t MIN_PAGES_PER_THREAD = 256;
+  const size_t thread_count = std::clamp<size_t>(pages->size() / MIN_PAGES_PER_THREAD, 1,
+                                                 std::max(1u, std::thread::hardware_concurrency()));
+  if (thread_count == 1)
+  {
+    filter(0, pages->size());
+    return;
+  }
+
+  std::vector<std::future<void>> futures(thread_count);
+  for (size_t i = 0; i < thread_count; ++i)
+  {
+    futures[i] = std::async(std::launch::async, filter, i * pages->size() / thread_count,
+                            (i + 1) * pages->size() / thread_count);
+  }
+  for (std::future<void>& future : futures)
+    future.wait();
+}
+
+bool IsTranslated(const Core::CPUThreadGuard& guard, PowerPC::RequestedAddressSpace address_space)
+{
+  switch (address_space)
+  {
+  case PowerPC::RequestedAddressSpace::Effective:
+    return guard.GetSystem().GetPPCState().msr.DR;
+  case PowerPC::RequestedAddressSpace::Virtual:
+    return true;
+  default:
+    return false;
+  }
 }
 }  // namespace
 
 template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+Cheats::SearchResults<T>::SearchResults(std::vector<Page> pages, bool aligned, bool translated)
+    : m_pages(std::move(pages)), m_aligned(aligned), m_translated(translated)
+{
+  std::erase_if(m_pages, [](const Page& page) {
+    return std::all_of(page.bits.begin(), page.bits.end(), [](u64 word) { return word == 0; });
+  });
+
+  size_t end_index = 0;
+  for (Page& page : m_pages)
+  {
+    for (const u64 word : page.bits)
+      end_index += std::popcount(word);
+    page.end_index = end_index;
+  }
+}
+
+template <typename T>
+u32 Cheats::SearchResults<T>::GetValidBitCount(u32 valid_size, bool aligned)
+{
+  if (valid_size < sizeof(T))
+    return 0;
+
+  const u32 stride = aligned ? sizeof(T) : 1;
+  return std::min<u32>((valid_size - sizeof(T)) / stride + 1, GetBitsPerPage(aligned));
+}
+
+template <typename T>
+size_t Cheats::SearchResults<T>::GetValidValueCount() const
+{
+  size_t count = 0;
+  for (const Page& page : m_pages)
+  {
+    const u32 valid_bit_count = GetValidBitCount(page.valid_size, m_aligned);
+    for (u32 i = 0; i < page.bits.size() && i * 64 < valid_bit_count; ++i)
+    {
+      const u32 bits_left = valid_bit_count - i * 64;
+      const u64 mask = bits_left >= 64 ? ~u64{0} : (u64{1} << bits_left) - 1;
+      count += std::popcount(page.bits[i] & mask);
+    }
+  }
+  return count;
+}
+
+template <typename T>
+std::pair<const typename Cheats::SearchResults<T>::Page*, u32>
+Cheats::SearchResults<T>::Find(size_t index) const
+{
+  const auto page = std::upper_bound(
+      m_pages.begin(), m_pages.end(), index,
+      [](size_t i, const Page& other_page) { return i < other_page.end_index; });
+  ASSERT(page != m_pages.end());
+
+  size_t index_in_page = index - (page == m_pages.begin() ? 0 : std::prev(page)->end_index);
+  for (u32 i = 0;; ++i)
+  {
+    u64 word = page->bits[i];
+    const size_t count = std::popcount(word);
+    if (index_in_page < count)
+    {
+      for (; index_in_page != 0; --index_in_page)
+        word &= word - 1;
+      return {&*page, i * 64 + std::countr_zero(word)};
+    }
+    index_in_page -= count;
+  }
+}
+
+template <typename T>
+Cheats::SearchResult<T> Cheats::SearchResults<T>::Get(size_t index) const
+{
+  const auto [page, bit] = Find(index);
+  const u32 offset = bit * (m_aligned ? sizeof(T) : 1);
+
+  SearchResult<T> result;
+  result.m_address = page->address + offset;
+  if (bit < GetValidBitCount(page->valid_size, m_aligned))
+  {
+    result.m_value = ReadValue<T>(page->data.data() + offset);
+    result.m_value_state = m_translated ? SearchResultValueState::ValueFromVirtualMemory :
+                                          SearchResultValueState::ValueFromPhysicalMemory;
+  }
+  else
+  {
+    result.m_value = T(0);
+    result.m_value_state = SearchResultValueState::AddressNotAccessible;
+  }
+  return result;
+}
+
+template <typename T>
+Cheats::SearchResults<T> Cheats::SearchResults<T>::Slice(size_t begin_index,
+                                                         size_t end_index) const
+{
+  end_index = std::min(end_index, GetCount());
+  if (begin_index >= end_index)
+    return SearchResults({}, m_aligned, m_translated);
+
+  const auto [first_page, first_bit] = Find(begin_index);
+  const auto [last_page, last_bit] = Find(end_index - 1);
+  std::vector<Page> pages(m_pages.begin() + (first_page - m_pages.data()),
+                          m_pages.begin() + (last_page - m_pages.data()) + 1);
+  FillBits(&pages.front().bits, 0, first_bit, false);
+  FillBits(&pages.back().bits, last_bit + 1, pages.back().bits.size() * 64, false);
+  return SearchResults(std::move(pages), m_aligned, m_translated);
+}
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
 Cheats::NewSearch(const Core::CPUThreadGuard& guard,
                   const std::vector<Cheats::MemoryRange>& memory_ranges,
                   PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
+                  Cheats::FilterType filter_type, Cheats::CompareType compare_type,
+                  T specific_value)
 {
 #ifdef USE_RETRO_ACHIEVEMENTS
   if (Config::Get(Config::RA_HARDCORE_ENABLED))
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
 #endif  // USE_RETRO_ACHIEVEMENTS
-  std::vector<Cheats::SearchResult<T>> results;
+  if (filter_type == Cheats::FilterType::CompareAgainstLastValue)
+    return Cheats::SearchErrorCode::InvalidParameters;
+
   const Core::State core_state = Core::GetState();
   if (core_state != Core::State::Running && core_state != Core::State::Paused)
     return Cheats::SearchErrorCode::NoEmulationActive;
@@ -220,52 +597,69 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
     return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
+  using Page = typename Cheats::SearchResults<T>::Page;
+  constexpr u32 PAGE_SIZE = Cheats::SearchResults<T>::PAGE_SIZE;
+  const u32 bits_per_page = Cheats::SearchResults<T>::GetBitsPerPage(aligned);
+  const u32 stride = aligned ? sizeof(T) : 1;
+
+  std::vector<Page> pages;
   for (const Cheats::MemoryRange& range : memory_ranges)
   {
     if (range.m_length < sizeof(T))
       continue;
 
-    const u32 increment_per_loop = aligned ? sizeof(T) : 1;
     const u32 start_address = aligned ? Common::AlignUp(range.m_start, sizeof(T)) : range.m_start;
     const u64 aligned_length = range.m_length - (start_address - range.m_start);
 
     if (aligned_length < sizeof(T))
       continue;
 
-    const u64 length = aligned_length - (sizeof(T) - 1);
-    for (u64 i = 0; i < length; i += increment_per_loop)
+    // The first and the last address that a value can start at
+    const u64 first_address = start_address;
+    const u64 last_address = first_address + aligned_length - sizeof(T);
+    for (u64 page_address = first_address & ~u64{PAGE_SIZE - 1}; page_address <= last_address;
+         page_address += PAGE_SIZE)
     {
-      const u32 addr = start_address + i;
-      const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-      if (!current_value)
-        continue;
-
-      if (validator(current_value->value))
-      {
-        auto& r = results.emplace_back();
-        r.m_value = current_value->value;
-        r.m_value_state = current_value->translated ?
-                              Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                              Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-        r.m_address = addr;
-      }
+      Page& page = pages.emplace_back();
+      page.address = static_cast<u32>(page_address);
+      page.bits.resize(bits_per_page / 64);
+
+      const u64 begin = (std::max(first_address, page_address) - page_address) / stride;
+      const u64 end =
+          (std::min(last_address, page_address + PAGE_SIZE - 1) - page_address) / stride + 1;
+      FillBits(&page.bits, begin, end, true);
     }
   }
-  return results;
+
+  // Every page must only be read once, even if ranges overlap
+  std::sort(pages.begin(), pages.end(),
+            [](const Page& a, const Page& b) { return a.address < b.address; });
+  for (size_t i = 1; i < pages.size(); ++i)
+  {
+    if (pages[i].address != pages[i - 1].address)
+      continue;
+    for (size_t j = 0; j < pages[i].bits.size(); ++j)
+      pages[i].bits[j] |= pages[i - 1].bits[j];
+    pages[i - 1].bits.clear();
+  }
+  std::erase_if(pages, [](const Page& page) { return page.bits.empty(); });
+
+  ReadPages<T>(guard, address_space, aligned, &pages);
+  FilterPages<T>(&pages, nullptr, aligned, filter_type, compare_type, specific_value);
+  return Cheats::SearchResults<T>(std::move(pages), aligned, IsTranslated(guard, address_space));
 }
 
 template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
 Cheats::NextSearch(const Core::CPUThreadGuard& guard,
-                   const std::vector<Cheats::SearchResult<T>>& previous_results,
-                   PowerPC::RequestedAddressSpace address_space,
-                   const std::function<bool(const T& new_value, const T& old_value)>& validator)
+                   const Cheats::SearchResults<T>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space, Cheats::FilterType filter_type,
+                   Cheats::CompareType compare_type, T specific_value)
 {
 #ifdef USE_RETRO_ACHIEVEMENTS
   if (Config::Get(Config::RA_HARDCORE_ENABLED))
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
 #endif  // USE_RETRO_ACHIEVEMENTS
-  std::vector<Cheats::SearchResult<T>> results;
   const Core::State core_state = Core::GetState();
   if (core_state != Core::State::Running && core_state != Core::State::Paused)
     return Cheats::SearchErrorCode::NoEmulationActive;
@@ -274,31 +668,20 @@ Cheats::NextSearch(const Core::CPUThreadGuard& guard,
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
     return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
-  for (const auto& previous_result : previous_results)
-  {
-    const u32 addr = previous_result.m_address;
-    const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-    if (!current_value)
-    {
-      auto& r = results.emplace_back();
-      r.m_address = addr;
-      r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
-      continue;
-    }
+  using Page = typename Cheats::SearchResults<T>::Page;
+  const bool aligned = previous_results.IsAligned();
+  const std::vector<Page>& previous_pages = previous_results.GetPages();
 
-    // if the previous state was invalid we always update the value to avoid getting stuck in an
-    // invalid state
-    if (!previous_result.IsValueValid() || validator(current_value->value, previous_result.m_value))
-    {
-      auto& r = results.emplace_back();
-      r.m_value = current_value->value;
-      r.m_value_state = current_value->translated ?
-                            Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                            Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-      r.m_address = addr;
-    }
+  std::vector<Page> pages(previous_pages.size());
+  for (size_t i = 0; i < pages.size(); ++i)
+  {
+    pages[i].address = previous_pages[i].address;
+    pages[i].bits = previous_pages[i].bits;
   }
-  return results;
+
+  ReadPages<T>(guard, address_space, aligned, &pages);
+  FilterPages<T>(&pages, &previous_pages, aligned, filter_type, compare_type, specific_value);
+  return Cheats::SearchResults<T>(std::move(pages), aligned, IsTranslated(guard, address_space));
 }
 
 Cheats::CheatSearchSessionBase::~CheatSearchSessionBase() = default;
@@ -373,55 +756,7 @@ template <typename T>
 void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
-  m_search_results.clear();
-}
-
-template <typename T>
-static std::function<bool(const T& new_value)>
-MakeCompareFunctionForSpecificValue(Cheats::CompareType op, const T& old_value)
-{
-  switch (op)
-  {
-  case Cheats::CompareType::Equal:
-    return [&](const T& new_value) { return new_value == old_value; };
-  case Cheats::CompareType::NotEqual:
-    return [&](const T& new_value) { return new_value != old_value; };
-  case Cheats::CompareType::Less:
-    return [&](const T& new_value) { return new_value < old_value; };
-  case Cheats::CompareType::LessOrEqual:
-    return [&](const T& new_value) { return new_value <= old_value; };
-  case Cheats::CompareType::Greater:
-    return [&](const T& new_value) { return new_value > old_value; };
-  case Cheats::CompareType::GreaterOrEqual:
-    return [&](const T& new_value) { return new_value >= old_value; };
-  default:
-    DEBUG_ASSERT(false);
-    return nullptr;
-  }
-}
-
-template <typename T>
-static std::function<bool(const T& old_value, const T& new_value)>
-MakeCompareFunctionForLastValue(Cheats::CompareType op)
-{
-  switch (op)
-  {
-  case Cheats::CompareType::Equal:
-    return std::equal_to<T>();
-  case Cheats::CompareType::NotEqual:
-    return std::not_equal_to<T>();
-  case Cheats::CompareType::Less:
-    return std::less<T>();
-  case Cheats::CompareType::LessOrEqual:
-    return std::less_equal<T>();
-  case Cheats::CompareType::Greater:
-    return std::greater<T>();
-  case Cheats::CompareType::GreaterOrEqual:
-    return std::greater_equal<T>();
-  default:
-    DEBUG_ASSERT(false);
-    return nullptr;
-  }
+  m_search_results = {};
 }
 
 template <typename T>
@@ -431,45 +766,23 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPU
   if (Config::Get(Config::RA_HARDCORE_ENABLED))
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
 #endif  // USE_RETRO_ACHIEVEMENTS
-  Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
+  if (m_filter_type == FilterType::CompareAgainstSpecificValue && !m_value)
+    return Cheats::SearchErrorCode::InvalidParameters;
+  if (m_filter_type == FilterType::CompareAgainstLastValue && !m_first_search_done)
+    return Cheats::SearchErrorCode::InvalidParameters;
+
+  const T specific_value = m_value.value_or(T(0));
+  Common::Result<SearchErrorCode, SearchResults<T>> result =
       Cheats::SearchErrorCode::InvalidParameters;
-  if (m_filter_type == FilterType::CompareAgainstSpecificValue)
+  if (m_first_search_done)
   {
-    if (!m_value)
-      return Cheats::SearchErrorCode::InvalidParameters;
-
-    auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(
-          guard, m_search_results, m_address_space,
-          [&func](const T& new_value, const T& old_value) { return func(new_value); });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, func);
-    }
+    result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space, m_filter_type,
+                                   m_compare_type, specific_value);
   }
-  else if (m_filter_type == FilterType::CompareAgainstLastValue)
-  {
-    if (!m_first_search_done)
-      return Cheats::SearchErrorCode::InvalidParameters;
-
-    result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                   MakeCompareFunctionForLastValue<T>(m_compare_type));
-  }
-  else if (m_filter_type == FilterType::DoNotFilter)
+  else
   {
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                     [](const T& v1, const T& v2) { return true; });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
-                                    [](const T& v) { return true; });
-    }
+    result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
+                                  m_filter_type, m_compare_type, specific_value);
   }
 
   if (result.Succeeded())
@@ -527,38 +840,31 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
-  return m_search_results.size();
+  return m_search_results.GetCount();
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
-  const auto& results = m_search_results;
-  size_t count = 0;
-  for (const auto& r : results)
-  {
-    if (r.IsValueValid())
-      ++count;
-  }
-  return count;
+  return m_search_results.GetValidValueCount();
 }
 
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
-  return m_search_results[index].m_address;
+  return m_search_results.Get(index).m_address;
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
-  return m_search_results[index].m_value;
+  return m_search_results.Get(index).m_value;
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{GetResultValue(index)};
 }
 
 template <typename T>
@@ -570,21 +876,21 @@ std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index,
   if (hex)
   {
     if constexpr (std::is_same_v<T, float>)
-      return fmt::format("0x{0:08x}", Common::BitCast<u32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", Common::BitCast<u32>(GetResultValue(index)));
     else if constexpr (std::is_same_v<T, double>)
-      return fmt::format("0x{0:016x}", Common::BitCast<u64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", Common::BitCast<u64>(GetResultValue(index)));
     else
-      return fmt::format("0x{0:0{1}x}", m_search_results[index].m_value, sizeof(T) * 2);
+      return fmt::format("0x{0:0{1}x}", GetResultValue(index), sizeof(T) * 2);
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", GetResultValue(index));
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
-  return m_search_results[index].m_value_state;
+  return m_search_results.Get(index).m_value_state;
 }
 
 template <typename T>
@@ -603,13 +909,12 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size_t end_index) const
 {
-  if (begin_index == 0 && end_index >= m_search_results.size())
+  if (begin_index == 0 && end_index >= m_search_results.GetCount())
     return Clone();
 
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
-  c->m_search_results.assign(m_search_results.begin() + begin_index,
-                             m_search_results.begin() + end_index);
+  c->m_search_results = m_search_results.Slice(begin_index, end_index);
   c->m_compare_type = this->m_compare_type;
   c->m_filter_type = this->m_filter_type;
   c->m_value = this->m_value;
@@ -617,6 +922,17 @@ Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size
   return c;
 }
 
+template class Cheats::SearchResults<u8>;
+template class Cheats::SearchResults<u16>;
+template class Cheats::SearchResults<u32>;
+template class Cheats::SearchResults<u64>;
+template class Cheats::SearchResults<s8>;
+template class Cheats::SearchResults<s16>;
+template class Cheats::SearchResults<s32>;
+template class Cheats::SearchResults<s64>;
+template class Cheats::SearchResults<float>;
+template class Cheats::SearchResults<double>;
+
 template class Cheats::CheatSearchSession<u8>;
 template class Cheats::CheatSearchSession<u16>;
 template class Cheats::CheatSearchSession<u32>;
@@ -3,10 +3,10 @@
 
 #pragma once
 
-#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -114,21 +114,77 @@ DataType GetDataType(const SearchValue& value);
 // patches or action replay codes.
 std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 
-// Do a new search across the given memory region in the given address space, only keeping values
-// for which the given validator returns true.
+// The results of a search. Emulated memory is split into pages, and only the pages that still
+// contain results are kept. Each of them has a bitmap with a bit for every address in it that a
+// value can be at, and a copy of the page from the last search, which holds the values. This
+// keeps searches that match most of memory small, and makes them fast to narrow down.
 template <typename T>
-Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
+class SearchResults
+{
+public:
+  static constexpr u32 PAGE_SIZE = 0x1000;
+
+  struct Page
+  {
+    u32 address = 0;
+    // The number of bytes at the start of data that could be read. Results with values that
+    // don't fit in this are AddressNotAccessible.
+    u32 valid_size = 0;
+    // The number of results in this page and all of the pages before it
+    size_t end_index = 0;
+    // Bit i is set if there is a result at address + i * (aligned ? sizeof(T) : 1)
+    std::vector<u64> bits;
+    // The page followed by the start of the next one, so that unaligned values at the end of the
+    // page can be read. Big endian, as in emulated memory.
+    std::vector<u8> data;
+  };
+
+  SearchResults() = default;
+  // Empty pages in pages are dropped
+  SearchResults(std::vector<Page> pages, bool aligned, bool translated);
+
+  static u32 GetBitsPerPage(bool aligned) { return aligned ? PAGE_SIZE / sizeof(T) : PAGE_SIZE; }
+  static u32 GetDataSize(bool aligned) { return aligned ? PAGE_SIZE : PAGE_SIZE + sizeof(T) - 1; }
+  // Returns how many of the bits in a page have values that fit in valid_size
+  static u32 GetValidBitCount(u32 valid_size, bool aligned);
+
+  const std::vector<Page>& GetPages() const { return m_pages; }
+  bool IsAligned() const { return m_aligned; }
+  size_t GetCount() const { return m_pages.empty() ? 0 : m_pages.back().end_index; }
+  size_t GetValidValueCount() const;
+  SearchResult<T> Get(size_t index) const;
+
+  // Returns the results with indices in [begin_index, end_index)
+  SearchResults Slice(size_t begin_index, size_t end_index) const;
+
+private:
+  // Returns the page that the result is in and its bit in that page
+  std::pair<const Page*, u32> Find(size_t index) const;
+
+  std::vector<Page> m_pages;
+  bool m_aligned = true;
+  bool m_translated = false;
+};
+
+// Do a new search across the given memory region in the given address space. The memory is copied
+// a page at a time and compared on multiple threads. filter_type can be DoNotFilter, which keeps
+// every value, or CompareAgainstSpecificValue, which keeps the values for which
+// "value compare_type specific_value" is true.
+template <typename T>
+Common::Result<SearchErrorCode, SearchResults<T>>
 NewSearch(const Core::CPUThreadGuard& guard, const std::vector<MemoryRange>& memory_ranges,
-          PowerPC::RequestedAddressSpace address_space, bool aligned,
-          const std::function<bool(const T& value)>& validator);
+          PowerPC::RequestedAddressSpace address_space, bool aligned, FilterType filter_type,
+          CompareType compare_type, T specific_value);
 
 // Refresh the values for the given results in the given address space, only keeping values for
-// which the given validator returns true.
+// which "new_value compare_type specific_value" or "new_value compare_type old_value" is true,
+// depending on filter_type. Values that can't be compared because they were or are inaccessible
+// are always kept.
 template <typename T>
-Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
-NextSearch(const Core::CPUThreadGuard& guard, const std::vector<SearchResult<T>>& previous_results,
-           PowerPC::RequestedAddressSpace address_space,
-           const std::function<bool(const T& new_value, const T& old_value)>& validator);
+Common::Result<SearchErrorCode, SearchResults<T>>
+NextSearch(const Core::CPUThreadGuard& guard, const SearchResults<T>& previous_results,
+           PowerPC::RequestedAddressSpace address_space, FilterType filter_type,
+           CompareType compare_type, T specific_value);
 
 class CheatSearchSessionBase
 {
@@ -219,7 +275,7 @@ public:
                                                        size_t end_index) const override;
 
 private:
-  std::vector<SearchResult<T>> m_search_results;
+  SearchResults<T> m_search_results;
   std::vector<MemoryRange> m_memory_ranges;
   PowerPC::RequestedAddressSpace m_address_space;
   CompareType m_compare_type = CompareType::Equal;
@@ -96,6 +96,10 @@ const Info<int> GFX_COMMAND_BUFFER_EXECUTE_INTERVAL{
     {System::GFX, "Settings", "CommandBufferExecuteInterval"}, 100};
 
 const Info<bool> GFX_SHADER_CACHE{{System::GFX, "Settings", "ShaderCache"}, true};
+const Info<bool> GFX_SHADER_CACHE_LAZY_LOAD{
+    {System::GFX, "Settings", "ShaderCacheLazyLoad"}, false};
+const Info<bool> GFX_SHADER_CACHE_READ_ONLY{
+    {System::GFX, "Settings", "ShaderCacheReadOnly"}, false};
 const Info<bool> GFX_WAIT_FOR_SHADERS_BEFORE_STARTING{
     {System::GFX, "Settings", "WaitForShadersBeforeStarting"}, false};
 const Info<ShaderCompilationMode> GFX_SHADER_COMPILATION_MODE{
@@ -27,6 +27,11 @@ namespace PowerPC
 enum class CPUCore;
 }
 
+namespace CoreTiming
+{
+enum class EventQueueType;
+}
+
 namespace AudioCommon
 {
 enum class DPL2Quality;
@@ -55,6 +60,7 @@ namespace Config
 extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+extern const Info<bool> MAIN_JIT_BLOCK_PROFILE;
 extern const Info<bool> MAIN_FASTMEM;
 extern const Info<bool> MAIN_FASTMEM_ARENA;
 extern const Info<bool> MAIN_LARGE_ENTRY_POINTS_MAP;
@@ -65,6 +71,7 @@ extern const Info<int> MAIN_MAX_FALLBACK;
 extern const Info<int> MAIN_TIMING_VARIANCE;
 extern const Info<bool> MAIN_CPU_THREAD;
 extern const Info<bool> MAIN_SYNC_ON_SKIP_IDLE;
+extern const Info<CoreTiming::EventQueueType> MAIN_CORE_TIMING_EVENT_QUEUE;
 extern const Info<std::string> MAIN_DEFAULT_ISO;
 extern const Info<bool> MAIN_ENABLE_CHEATS;
 extern const Info<int> MAIN_GC_LANGUAGE;
@@ -72,6 +79,8 @@ extern const Info<bool> MAIN_OVERRIDE_REGION_SETTINGS;
 extern const Info<bool> MAIN_DPL2_DECODER;
 extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
 extern const Info<int> MAIN_AUDIO_LATENCY;
+extern const Info<bool> MAIN_AUDIO_LOW_LATENCY;
+extern const Info<int> MAIN_AUDIO_LOW_LATENCY_PERIOD;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
@@ -116,6 +125,7 @@ extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
+extern const Info<bool> MAIN_DVD_READ_AHEAD;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
 extern const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS;
@@ -150,6 +160,10 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+// 0 compresses savestates with LZ4. Anything higher uses zstd at that level instead, which is
+// slower to save but gives much smaller files.
+extern const Info<int> MAIN_SAVESTATE_ZSTD_LEVEL;
+extern const Info<bool> MAIN_MEMORY_WATCHER_BINARY;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
@@ -300,6 +314,7 @@ extern const Info<bool> MAIN_GAMELIST_COLUMN_TAGS;
 
 extern const Info<bool> MAIN_FIFOPLAYER_LOOP_REPLAY;
 extern const Info<bool> MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES;
+extern const Info<bool> MAIN_FIFOPLAYER_COMPRESS_FRAMES;
 
 // Main.AutoUpdate
 
@@ -312,6 +327,7 @@ extern const Info<bool> MAIN_MOVIE_PAUSE_MOVIE;
 extern const Info<std::string> MAIN_MOVIE_MOVIE_AUTHOR;
 extern const Info<bool> MAIN_MOVIE_DUMP_FRAMES;
 extern const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT;
+extern const Info<bool> MAIN_MOVIE_CHUNKED_FORMAT;
 extern const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY;
 extern const Info<bool> MAIN_MOVIE_SHOW_RTC;
 extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
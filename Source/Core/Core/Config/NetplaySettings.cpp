@@ -36,6 +36,7 @@ const Info<u16> NETPLAY_LISTEN_PORT{{System::Main, "NetPlay", "ListenPort"}, DEF
 
 const Info<std::string> NETPLAY_NICKNAME{{System::Main, "NetPlay", "Nickname"}, "Player"};
 const Info<bool> NETPLAY_USE_UPNP{{System::Main, "NetPlay", "UseUPNP"}, false};
+const Info<bool> NETPLAY_JOIN_AS_SPECTATOR{{System::Main, "NetPlay", "JoinAsSpectator"}, false};
 
 const Info<bool> NETPLAY_ENABLE_QOS{{System::Main, "NetPlay", "EnableQoS"}, true};
 
@@ -57,5 +58,9 @@ const Info<std::string> NETPLAY_NETWORK_MODE{{System::Main, "NetPlay", "NetworkM
                                              "fixeddelay"};
 const Info<bool> NETPLAY_GOLF_MODE_OVERLAY{{System::Main, "NetPlay", "GolfModeOverlay"}, true};
 const Info<bool> NETPLAY_HIDE_REMOTE_GBAS{{System::Main, "NetPlay", "HideRemoteGBAs"}, false};
+const Info<u32> NETPLAY_ROLLBACK_MAX_FRAMES{{System::Main, "NetPlay", "RollbackMaxFrames"}, 8};
+const Info<bool> NETPLAY_AUTO_PAD_BUFFER{{System::Main, "NetPlay", "AutoPadBuffer"}, false};
+const Info<bool> NETPLAY_RAM_HASH_DESYNC_DETECTION{
+    {System::Main, "NetPlay", "RAMHashDesyncDetection"}, false};
 
 }  // namespace Config
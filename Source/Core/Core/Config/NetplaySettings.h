@@ -28,6 +28,7 @@ extern const Info<u16> NETPLAY_LISTEN_PORT;
 
 extern const Info<std::string> NETPLAY_NICKNAME;
 extern const Info<bool> NETPLAY_USE_UPNP;
+extern const Info<bool> NETPLAY_JOIN_AS_SPECTATOR;
 
 extern const Info<bool> NETPLAY_ENABLE_QOS;
 
@@ -51,5 +52,8 @@ extern const Info<bool> NETPLAY_STRICT_SETTINGS_SYNC;
 extern const Info<std::string> NETPLAY_NETWORK_MODE;
 extern const Info<bool> NETPLAY_GOLF_MODE_OVERLAY;
 extern const Info<bool> NETPLAY_HIDE_REMOTE_GBAS;
+extern const Info<u32> NETPLAY_ROLLBACK_MAX_FRAMES;
+extern const Info<bool> NETPLAY_AUTO_PAD_BUFFER;
+extern const Info<bool> NETPLAY_RAM_HASH_DESYNC_DETECTION;
 
 }  // namespace Config
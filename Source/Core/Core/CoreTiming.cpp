@@ -7,6 +7,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -32,23 +33,14 @@
 
 namespace CoreTiming
 {
-// Sort by time, unless the times are the same, in which case sort by the order added to the queue
-static bool operator>(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-}
-static bool operator<(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
-}
-
 static constexpr int MAX_SLICE_LENGTH = 20000;
 
 static void EmptyTimedCallback(Core::System& system, u64 userdata, s64 cyclesLate)
 {
 }
 
-CoreTimingManager::CoreTimingManager(Core::System& system) : m_system(system)
+CoreTimingManager::CoreTimingManager(Core::System& system)
+    : m_system(system), m_event_queue(CreateEventQueue(EventQueueType::Heap))
 {
 }
 
@@ -86,7 +78,7 @@ EventType* CoreTimingManager::RegisterEvent(const std::string& name, TimedCallba
 
 void CoreTimingManager::UnregisterAllEvents()
 {
-  ASSERT_MSG(POWERPC, m_event_queue.empty(), "Cannot unregister events with events pending");
+  ASSERT_MSG(POWERPC, m_event_queue->IsEmpty(), "Cannot unregister events with events pending");
   m_event_types.clear();
 }
 
@@ -96,6 +88,10 @@ void CoreTimingManager::Init()
       CPUThreadConfigCallback::AddConfigChangedCallback([this]() { RefreshConfig(); });
   RefreshConfig();
 
+  auto event_queue = CreateEventQueue(Config::Get(Config::MAIN_CORE_TIMING_EVENT_QUEUE));
+  event_queue->SetEvents(m_event_queue->GetEvents());
+  m_event_queue = std::move(event_queue);
+
   m_last_oc_factor = m_config_oc_factor;
   m_globals.last_OC_factor_inverted = m_config_oc_inv_factor;
   m_system.GetPPCState().downcount = CyclesToDowncount(MAX_SLICE_LENGTH);
@@ -123,6 +119,8 @@ void CoreTimingManager::Shutdown()
   ClearPendingEvents();
   UnregisterAllEvents();
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_registered_config_callback_id);
+  m_advance_callback = {};
+  m_throttle_suspended = false;
 }
 
 void CoreTimingManager::RefreshConfig()
@@ -169,7 +167,16 @@ void CoreTimingManager::DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
-  p.DoEachElement(m_event_queue, [this](PointerWrap& pw, Event& ev) {
+
+  // Saving the events sorted keeps the state independent of how the queue stores them.
+  std::vector<Event> events;
+  if (!p.IsReadMode())
+  {
+    events = m_event_queue->GetEvents();
+    std::sort(events.begin(), events.end());
+  }
+
+  p.DoEachElement(events, [this](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
 
@@ -205,9 +212,8 @@ void CoreTimingManager::DoState(PointerWrap& p)
   if (p.IsReadMode())
   {
     // When loading from a save state, we must assume the Event order is random and meaningless.
-    // The exact layout of the heap in memory is implementation defined, therefore it is platform
-    // and library version specific.
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    // Older states stored the exact layout of the heap in memory, which is implementation defined.
+    m_event_queue->SetEvents(std::move(events));
 
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
@@ -235,7 +241,7 @@ u64 CoreTimingManager::GetIdleTicks() const
 
 void CoreTimingManager::ClearPendingEvents()
 {
-  m_event_queue.clear();
+  m_event_queue->Clear();
 }
 
 void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
@@ -264,8 +270,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue->Push(Event{timeout, m_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -284,15 +289,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
 
 void CoreTimingManager::RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(m_event_queue.begin(), m_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != m_event_queue.end())
-  {
-    m_event_queue.erase(itr, m_event_queue.end());
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-  }
+  m_event_queue->RemoveAll(event_type);
 }
 
 void CoreTimingManager::RemoveAllEvents(EventType* event_type)
@@ -319,8 +316,7 @@ void CoreTimingManager::MoveEvents()
   for (Event ev; m_ts_queue.Pop(ev);)
   {
     ev.fifo_order = m_event_fifo_id++;
-    m_event_queue.emplace_back(std::move(ev));
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue->Push(ev);
   }
 }
 
@@ -341,11 +337,10 @@ void CoreTimingManager::Advance()
 
   m_is_global_timer_sane = true;
 
-  while (!m_event_queue.empty() && m_event_queue.front().time <= m_globals.global_timer)
+  while (!m_event_queue->IsEmpty() && m_event_queue->GetFirst().time <= m_globals.global_timer)
   {
-    Event evt = std::move(m_event_queue.front());
-    std::pop_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-    m_event_queue.pop_back();
+    const Event evt = m_event_queue->GetFirst();
+    m_event_queue->PopFirst();
 
     Throttle(evt.time);
     evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
@@ -354,10 +349,10 @@ void CoreTimingManager::Advance()
   m_is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
-  if (!m_event_queue.empty())
+  if (!m_event_queue->IsEmpty())
   {
     m_globals.slice_length = static_cast<int>(
-        std::min<s64>(m_event_queue.front().time - m_globals.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(m_event_queue->GetFirst().time - m_globals.global_timer, MAX_SLICE_LENGTH));
   }
 
   ppc_state.downcount = CyclesToDowncount(m_globals.slice_length);
@@ -367,10 +362,21 @@ void CoreTimingManager::Advance()
   // until the next slice:
   //        Pokemon Box refuses to boot if the first exception from the audio DMA is received late
   power_pc.CheckExternalExceptions();
+
+  if (m_advance_callback)
+    m_advance_callback();
+}
+
+void CoreTimingManager::SetAdvanceCallback(std::function<void()> callback)
+{
+  m_advance_callback = std::move(callback);
 }
 
 void CoreTimingManager::Throttle(const s64 target_cycle)
 {
+  if (m_throttle_suspended)
+    return;
+
   // Based on number of cycles and emulation speed, increase the target deadline
   const s64 cycles = target_cycle - m_throttle_last_cycle;
 
@@ -418,6 +424,14 @@ void CoreTimingManager::Throttle(const s64 target_cycle)
   }
 }
 
+void CoreTimingManager::SetThrottleSuspended(bool suspended)
+{
+  if (m_throttle_suspended && !suspended)
+    ResetThrottle(m_globals.global_timer);
+
+  m_throttle_suspended = suspended;
+}
+
 void CoreTimingManager::ResetThrottle(s64 cycle)
 {
   m_throttle_last_cycle = cycle;
@@ -442,7 +456,7 @@ bool CoreTimingManager::UseSyncOnSkipIdle() const
 
 void CoreTimingManager::LogPendingEvents() const
 {
-  auto clone = m_event_queue;
+  auto clone = m_event_queue->GetEvents();
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -457,11 +471,13 @@ void CoreTimingManager::AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clo
   m_throttle_clock_per_sec = new_ppc_clock;
   m_throttle_min_clock_per_sleep = new_ppc_clock / 1200;
 
-  for (Event& ev : m_event_queue)
+  std::vector<Event> events = m_event_queue->GetEvents();
+  for (Event& ev : events)
   {
     const s64 ticks = (ev.time - m_globals.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = m_globals.global_timer + ticks;
   }
+  m_event_queue->SetEvents(std::move(events));
 }
 
 void CoreTimingManager::Idle()
@@ -485,7 +501,7 @@ std::string CoreTimingManager::GetScheduledEventsSummary() const
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = m_event_queue;
+  auto clone = m_event_queue->GetEvents();
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -16,6 +16,8 @@
 // inside callback:
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -24,6 +26,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/SPSCQueue.h"
 #include "Core/CPUThreadConfigCallback.h"
+#include "Core/CoreTimingQueue.h"
 
 class PointerWrap;
 
@@ -44,22 +47,6 @@ struct Globals
   float last_OC_factor_inverted = 0.0f;
 };
 
-typedef void (*TimedCallback)(Core::System& system, u64 userdata, s64 cyclesLate);
-
-struct EventType
-{
-  TimedCallback callback;
-  const std::string* name;
-};
-
-struct Event
-{
-  s64 time;
-  u64 fifo_order;
-  u64 userdata;
-  EventType* type;
-};
-
 enum class FromThread
 {
   CPU,
@@ -117,6 +104,11 @@ public:
   void Advance();
   void MoveEvents();
 
+  // Sets a function to be called at the very end of Advance(), once the new slice has been set up
+  // and external exceptions have been checked. No emulated code is on the stack at that point, so
+  // it is safe to save or load a state from it. Pass an empty function to clear it.
+  void SetAdvanceCallback(std::function<void()> callback);
+
   // Pretend that the main CPU has executed enough cycles to reach the next event.
   void Idle();
 
@@ -148,6 +140,10 @@ public:
   // in order to allow custom throttling implementations to be tested.
   void Throttle(const s64 target_cycle);
 
+  // While suspended, Throttle() never sleeps. Resuming restarts throttling from the current time so
+  // that the suspended period isn't made up for by running slower afterwards.
+  void SetThrottleSuspended(bool suspended);
+
   TimePoint GetCPUTimePoint(s64 cyclesLate) const;  // Used by Dolphin Analytics
   bool GetVISkip() const;                           // Used By VideoInterface
 
@@ -163,11 +159,8 @@ private:
   std::unordered_map<std::string, EventType> m_event_types;
 
   // STATE_TO_SAVE
-  // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-  // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-  // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-  // by the standard adaptor class.
-  std::vector<Event> m_event_queue;
+  // The implementation is picked by Config::MAIN_CORE_TIMING_EVENT_QUEUE on Init().
+  std::unique_ptr<EventQueue> m_event_queue;
   u64 m_event_fifo_id = 0;
   std::mutex m_ts_write_lock;
   Common::SPSCQueue<Event, false> m_ts_queue;
@@ -193,6 +186,9 @@ private:
   s64 m_throttle_clock_per_sec = 0;
   s64 m_throttle_min_clock_per_sleep = 0;
   bool m_throttle_disable_vi_int = false;
+  bool m_throttle_suspended = false;
+
+  std::function<void()> m_advance_callback;
 
   DT m_max_fallback = {};
   DT m_max_variance = {};
@@ -0,0 +1,392 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/CoreTimingQueue.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+#include "Common/Assert.h"
+
+namespace CoreTiming
+{
+bool operator>(const Event& left, const Event& right)
+{
+  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
+}
+
+bool operator<(const Event& left, const Event& right)
+{
+  return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
+}
+
+std::unique_ptr<EventQueue> CreateEventQueue(EventQueueType type)
+{
+  switch (type)
+  {
+  case EventQueueType::TimingWheel:
+    return std::make_unique<TimingWheelEventQueue>();
+  case EventQueueType::Heap:
+  default:
+    return std::make_unique<HeapEventQueue>();
+  }
+}
+
+void HeapEventQueue::PopFirst()
+{
+  std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Event>());
+  m_heap.pop_back();
+}
+
+void HeapEventQueue::Push(const Event& event)
+{
+  m_heap.push_back(event);
+  std::push_heap(m_heap.begin(), m_heap.end(), std::greater<Event>());
+}
+
+void HeapEventQueue::RemoveAll(const EventType* type)
+{
+  auto itr = std::remove_if(m_heap.begin(), m_heap.end(),
+                            [&](const Event& e) { return e.type == type; });
+
+  // Removing random items breaks the invariant so we have to re-establish it.
+  if (itr != m_heap.end())
+  {
+    m_heap.erase(itr, m_heap.end());
+    std::make_heap(m_heap.begin(), m_heap.end(), std::greater<Event>());
+  }
+}
+
+void HeapEventQueue::SetEvents(std::vector<Event> events)
+{
+  m_heap = std::move(events);
+  std::make_heap(m_heap.begin(), m_heap.end(), std::greater<Event>());
+}
+
+std::array<TimingWheelEventQueue::Level, TimingWheelEventQueue::LEVEL_COUNT>
+TimingWheelEventQueue::InitialLevels()
+{
+  std::array<Level, LEVEL_COUNT> levels;
+  for (Level& level : levels)
+  {
+    level.heads.fill(NO_NODE);
+    level.tails.fill(NO_NODE);
+    level.used.fill(0);
+  }
+  return levels;
+}
+
+const Event& TimingWheelEventQueue::GetFirst()
+{
+  ASSERT(m_size != 0);
+  if (m_first == NO_NODE)
+    m_first = FindFirst();
+  return m_nodes[m_first].event;
+}
+
+void TimingWheelEventQueue::PopFirst()
+{
+  ASSERT(m_size != 0);
+  const u32 index = m_first != NO_NODE ? m_first : FindFirst();
+  Unlink(index);
+  FreeNode(index);
+}
+
+void TimingWheelEventQueue::Push(const Event& event)
+{
+  // Without any pending events, the wheel can start over right at the new one.
+  if (m_size == 0)
+    m_base = event.time;
+
+  const u32 index = AllocateNode(event);
+
+  auto [type_head, inserted] = m_type_heads.try_emplace(event.type, NO_NODE);
+  Node& node = m_nodes[index];
+  node.type_prev = NO_NODE;
+  node.type_next = type_head->second;
+  if (type_head->second != NO_NODE)
+    m_nodes[type_head->second].type_prev = index;
+  type_head->second = index;
+
+  Insert(index);
+
+  if (m_first != NO_NODE && event < m_nodes[m_first].event)
+    m_first = index;
+}
+
+void TimingWheelEventQueue::RemoveAll(const EventType* type)
+{
+  const auto type_head = m_type_heads.find(type);
+  if (type_head == m_type_heads.end())
+    return;
+
+  u32 index = type_head->second;
+  while (index != NO_NODE)
+  {
+    const u32 next = m_nodes[index].type_next;
+    Unlink(index);
+    FreeNode(index);
+    index = next;
+  }
+}
+
+void TimingWheelEventQueue::Clear()
+{
+  m_nodes.clear();
+  m_free_list = NO_NODE;
+  m_size = 0;
+  m_levels = InitialLevels();
+  m_early.clear();
+  m_far.clear();
+  m_type_heads.clear();
+  m_first = NO_NODE;
+}
+
+std::vector<Event> TimingWheelEventQueue::GetEvents() const
+{
+  std::vector<Event> events;
+  events.reserve(m_size);
+  for (const Node& node : m_nodes)
+  {
+    if (node.location != Location::Free)
+      events.push_back(node.event);
+  }
+  return events;
+}
+
+void TimingWheelEventQueue::SetEvents(std::vector<Event> events)
+{
+  Clear();
+
+  // Starting at the earliest event keeps all of them out of the early list.
+  std::sort(events.begin(), events.end());
+  for (const Event& event : events)
+    Push(event);
+}
+
+u32 TimingWheelEventQueue::AllocateNode(const Event& event)
+{
+  u32 index;
+  if (m_free_list != NO_NODE)
+  {
+    index = m_free_list;
+    m_free_list = m_nodes[index].next;
+  }
+  else
+  {
+    index = static_cast<u32>(m_nodes.size());
+    m_nodes.emplace_back();
+  }
+
+  m_nodes[index].event = event;
+  ++m_size;
+  return index;
+}
+
+void TimingWheelEventQueue::FreeNode(u32 index)
+{
+  Node& node = m_nodes[index];
+  node.location = Location::Free;
+  node.next = m_free_list;
+  m_free_list = index;
+  --m_size;
+}
+
+void TimingWheelEventQueue::Insert(u32 index)
+{
+  Node& node = m_nodes[index];
+  const s64 time = node.event.time;
+  if (time < m_base)
+  {
+    node.location = Location::Early;
+    InsertSorted(m_early, index);
+    return;
+  }
+
+  const u64 diff = static_cast<u64>(time) ^ static_cast<u64>(m_base);
+  if ((diff >> (SLOT_BITS * LEVEL_COUNT)) != 0)
+  {
+    node.location = Location::Far;
+    InsertSorted(m_far, index);
+    return;
+  }
+
+  // The highest bit that differs from m_base decides the level.
+  const u32 level = diff == 0 ? 0 : (63 - std::countl_zero(diff)) / SLOT_BITS;
+  const u32 slot = static_cast<u32>(time >> (level * SLOT_BITS)) & (SLOTS_PER_LEVEL - 1);
+  InsertIntoSlot(index, level, slot);
+}
+
+void TimingWheelEventQueue::InsertIntoSlot(u32 index, u32 level, u32 slot)
+{
+  Node& node = m_nodes[index];
+  node.location = Location::Wheel;
+  node.level = static_cast<u8>(level);
+  node.slot = static_cast<u16>(slot);
+
+  Level& wheel_level = m_levels[level];
+
+  // All events of a slot on the lowest level are due at the same time, so they are kept sorted by
+  // fifo_order to be handed out in the right order. New events almost always go to the end.
+  u32 prev = wheel_level.tails[slot];
+  if (level == 0)
+  {
+    while (prev != NO_NODE && m_nodes[prev].event.fifo_order > node.event.fifo_order)
+      prev = m_nodes[prev].prev;
+  }
+
+  const u32 next = prev != NO_NODE ? m_nodes[prev].next : wheel_level.heads[slot];
+  node.prev = prev;
+  node.next = next;
+  if (prev != NO_NODE)
+    m_nodes[prev].next = index;
+  else
+    wheel_level.heads[slot] = index;
+  if (next != NO_NODE)
+    m_nodes[next].prev = index;
+  else
+    wheel_level.tails[slot] = index;
+
+  wheel_level.used[slot / 64] |= u64(1) << (slot % 64);
+}
+
+void TimingWheelEventQueue::Unlink(u32 index)
+{
+  Node& node = m_nodes[index];
+
+  switch (node.location)
+  {
+  case Location::Wheel:
+  {
+    Level& level = m_levels[node.level];
+    if (node.prev != NO_NODE)
+      m_nodes[node.prev].next = node.next;
+    else
+      level.heads[node.slot] = node.next;
+    if (node.next != NO_NODE)
+      m_nodes[node.next].prev = node.prev;
+    else
+      level.tails[node.slot] = node.prev;
+
+    if (level.heads[node.slot] == NO_NODE)
+      level.used[node.slot / 64] &= ~(u64(1) << (node.slot % 64));
+    break;
+  }
+  case Location::Early:
+    m_early.erase(std::find(m_early.begin(), m_early.end(), index));
+    break;
+  case Location::Far:
+    m_far.erase(std::find(m_far.begin(), m_far.end(), index));
+    break;
+  case Location::Free:
+    ASSERT(false);
+    return;
+  }
+
+  if (node.type_prev != NO_NODE)
+    m_nodes[node.type_prev].type_next = node.type_next;
+  else
+    m_type_heads[node.event.type] = node.type_next;
+  if (node.type_next != NO_NODE)
+    m_nodes[node.type_next].type_prev = node.type_prev;
+
+  if (m_first == index)
+    m_first = NO_NODE;
+}
+
+void TimingWheelEventQueue::InsertSorted(std::vector<u32>& list, u32 index)
+{
+  const Event& event = m_nodes[index].event;
+  const auto position = std::upper_bound(
+      list.begin(), list.end(), event,
+      [this](const Event& lhs, u32 rhs) { return lhs < m_nodes[rhs].event; });
+  list.insert(position, index);
+}
+
+u32 TimingWheelEventQueue::FindFirst()
+{
+  // Everything in the early list is due before anything in the wheel.
+  if (!m_early.empty())
+    return m_early.front();
+  return FindFirstInWheel();
+}
+
+u32 TimingWheelEventQueue::FindFirstInWheel()
+{
+  while (true)
+  {
+    const u32 cursor = static_cast<u32>(m_base) & (SLOTS_PER_LEVEL - 1);
+    const int slot = FindUsedSlot(m_levels[0], cursor);
+    if (slot >= 0)
+      return m_levels[0].heads[slot];
+
+    bool cascaded = false;
+    for (u32 level = 1; level < LEVEL_COUNT; ++level)
+    {
+      const u32 shift = level * SLOT_BITS;
+      const u32 level_cursor = static_cast<u32>(m_base >> shift) & (SLOTS_PER_LEVEL - 1);
+      const int level_slot = FindUsedSlot(m_levels[level], level_cursor + 1);
+      if (level_slot < 0)
+        continue;
+
+      // Jump to the start of that slot. The lower levels are all empty at this point.
+      const u64 lower_bits_mask = (u64(1) << (shift + SLOT_BITS)) - 1;
+      m_base = static_cast<s64>((static_cast<u64>(m_base) & ~lower_bits_mask) |
+                                (static_cast<u64>(level_slot) << shift));
+      Cascade(level, static_cast<u32>(level_slot));
+      cascaded = true;
+      break;
+    }
+
+    if (!cascaded)
+    {
+      if (m_far.empty())
+        return NO_NODE;
+      RefillFromFar();
+    }
+  }
+}
+
+void TimingWheelEventQueue::Cascade(u32 level, u32 slot)
+{
+  Level& wheel_level = m_levels[level];
+  u32 index = wheel_level.heads[slot];
+  wheel_level.heads[slot] = NO_NODE;
+  wheel_level.tails[slot] = NO_NODE;
+  wheel_level.used[slot / 64] &= ~(u64(1) << (slot % 64));
+
+  while (index != NO_NODE)
+  {
+    const u32 next = m_nodes[index].next;
+    Insert(index);
+    index = next;
+  }
+}
+
+void TimingWheelEventQueue::RefillFromFar()
+{
+  // The wheel is empty, so it can be moved to the first far event.
+  m_base = m_nodes[m_far.front()].event.time;
+
+  std::vector<u32> far = std::move(m_far);
+  m_far.clear();
+  for (u32 index : far)
+    Insert(index);
+}
+
+int TimingWheelEventQueue::FindUsedSlot(const Level& level, u32 first_slot)
+{
+  for (u32 word = first_slot / 64; word < level.used.size(); ++word)
+  {
+    u64 bits = level.used[word];
+    if (word == first_slot / 64)
+      bits &= ~u64(0) << (first_slot % 64);
+    if (bits != 0)
+      return static_cast<int>(word * 64 + std::countr_zero(bits));
+  }
+  return -1;
+}
+}  // namespace CoreTiming
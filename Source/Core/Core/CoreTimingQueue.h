@@ -0,0 +1,180 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Core
+{
+class System;
+}
+
+namespace CoreTiming
+{
+typedef void (*TimedCallback)(Core::System& system, u64 userdata, s64 cyclesLate);
+
+struct EventType
+{
+  TimedCallback callback;
+  const std::string* name;
+};
+
+struct Event
+{
+  s64 time;
+  u64 fifo_order;
+  u64 userdata;
+  EventType* type;
+};
+
+// Sort by time, unless the times are the same, in which case sort by the order added to the queue
+bool operator<(const Event& left, const Event& right);
+bool operator>(const Event& left, const Event& right);
+
+enum class EventQueueType
+{
+  Heap,
+  TimingWheel,
+};
+
+// Storage for the pending events of CoreTimingManager.
+//
+// fifo_order is unique among the pending events, so (time, fifo_order) is a total order and every
+// implementation hands out events in exactly the same order. Which one is in use therefore can't
+// cause desyncs.
+class EventQueue
+{
+public:
+  virtual ~EventQueue() = default;
+
+  virtual bool IsEmpty() const = 0;
+  // Returns the event that is due first. The queue must not be empty.
+  virtual const Event& GetFirst() = 0;
+  virtual void PopFirst() = 0;
+  virtual void Push(const Event& event) = 0;
+  virtual void RemoveAll(const EventType* type) = 0;
+  virtual void Clear() = 0;
+
+  // Returns all pending events in unspecified order.
+  virtual std::vector<Event> GetEvents() const = 0;
+  // Replaces all pending events with the given ones, which don't have to be in any order.
+  virtual void SetEvents(std::vector<Event> events) = 0;
+};
+
+std::unique_ptr<EventQueue> CreateEventQueue(EventQueueType type);
+
+// A min-heap using std::make_heap/push_heap/pop_heap.
+// Removing events requires going through the whole heap and rebuilding it.
+class HeapEventQueue final : public EventQueue
+{
+public:
+  bool IsEmpty() const override { return m_heap.empty(); }
+  const Event& GetFirst() override { return m_heap.front(); }
+  void PopFirst() override;
+  void Push(const Event& event) override;
+  void RemoveAll(const EventType* type) override;
+  void Clear() override { m_heap.clear(); }
+
+  std::vector<Event> GetEvents() const override { return m_heap; }
+  void SetEvents(std::vector<Event> events) override;
+
+private:
+  std::vector<Event> m_heap;
+};
+
+// A hierarchical timing wheel keyed on the absolute event time. Level n has a slot for every
+// possible value of bits [8n, 8n + 8) of the time and holds the events which match m_base in all
+// bits above those, so pushing and removing an event only has to link or unlink it. Looking for
+// the first event moves the events of the next used slot of a higher level down once the lower
+// levels run dry. Events that are too far away for the wheel, as well as events scheduled before
+// m_base, are kept in small sorted side lists.
+class TimingWheelEventQueue final : public EventQueue
+{
+public:
+  bool IsEmpty() const override { return m_size == 0; }
+  const Event& GetFirst() override;
+  void PopFirst() override;
+  void Push(const Event& event) override;
+  void RemoveAll(const EventType* type) override;
+  void Clear() override;
+
+  std::vector<Event> GetEvents() const override;
+  void SetEvents(std::vector<Event> events) override;
+
+private:
+  static constexpr u32 SLOT_BITS = 8;
+  static constexpr u32 SLOTS_PER_LEVEL = 1 << SLOT_BITS;
+  static constexpr u32 LEVEL_COUNT = 4;
+  static constexpr u32 NO_NODE = 0xFFFFFFFF;
+
+  enum class Location : u8
+  {
+    Free,
+    Wheel,
+    Early,
+    Far,
+  };
+
+  struct Node
+  {
+    Event event;
+    Location location;
+    u8 level;
+    u16 slot;
+    // Neighbors in the wheel slot, or the next free node
+    u32 prev;
+    u32 next;
+    // Neighbors among the pending events of the same type
+    u32 type_prev;
+    u32 type_next;
+  };
+
+  struct Level
+  {
+    std::array<u32, SLOTS_PER_LEVEL> heads;
+    std::array<u32, SLOTS_PER_LEVEL> tails;
+    std::array<u64, SLOTS_PER_LEVEL / 64> used;
+  };
+
+  u32 AllocateNode(const Event& event);
+  void FreeNode(u32 index);
+
+  void Insert(u32 index);
+  void InsertIntoSlot(u32 index, u32 level, u32 slot);
+  void Unlink(u32 index);
+  void InsertSorted(std::vector<u32>& list, u32 index);
+
+  // Returns the first event of the wheel, cascading slots of higher levels down as needed.
+  u32 FindFirstInWheel();
+  u32 FindFirst();
+  void Cascade(u32 level, u32 slot);
+  void RefillFromFar();
+
+  static int FindUsedSlot(const Level& level, u32 first_slot);
+
+  std::vector<Node> m_nodes;
+  u32 m_free_list = NO_NODE;
+  size_t m_size = 0;
+
+  // Every event in the wheel is at or after this time.
+  s64 m_base = 0;
+  std::array<Level, LEVEL_COUNT> m_levels = InitialLevels();
+
+  // Node indices sorted by (time, fifo_order)
+  std::vector<u32> m_early;
+  std::vector<u32> m_far;
+
+  std::unordered_map<const EventType*, u32> m_type_heads;
+
+  u32 m_first = NO_NODE;
+
+  static std::array<Level, LEVEL_COUNT> InitialLevels();
+};
+}  // namespace CoreTiming
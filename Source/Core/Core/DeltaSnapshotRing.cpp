@@ -0,0 +1,199 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/DeltaSnapshotRing.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <xxhash.h>
+
+#include "Common/Assert.h"
+#include "Common/Logging/Log.h"
+#include "Core/HW/HW.h"
+#include "Core/State.h"
+
+namespace State
+{
+static u64 HashPage(const u8* data, size_t size)
+{
+  return XXH3_64bits(data, size);
+}
+
+void DeltaSnapshotRing::Snapshot::ClearUndo()
+{
+  undo_pages.clear();
+  undo_hashes.clear();
+  undo_data.clear();
+}
+
+DeltaSnapshotRing::DeltaSnapshotRing(size_t capacity) : m_capacity(std::max<size_t>(capacity, 1))
+{
+}
+
+void DeltaSnapshotRing::Save(Core::System& system, u64 id)
+{
+  ASSERT(m_snapshots.empty() || id > m_snapshots.back().id);
+
+  // Reuse the allocations of the oldest snapshot once the ring is full.
+  Snapshot snapshot;
+  if (m_snapshots.size() >= m_capacity)
+  {
+    snapshot = std::move(m_snapshots.front());
+    m_snapshots.pop_front();
+    snapshot.ClearUndo();
+  }
+  snapshot.id = id;
+
+  // The video backend may write back to RAM while its state is saved, so the memory regions have to
+  // be looked at afterwards.
+  SaveToBufferWithoutBulkMemory(system, snapshot.state);
+
+  const std::vector<std::span<u8>> regions = HW::GetBulkMemoryRegions(system);
+  if (!IsLayoutCurrent(regions))
+  {
+    // The memory was reinitialized, so none of the older snapshots can be restored anymore.
+    m_snapshots.clear();
+    ResetLayout(regions);
+    m_last_dirty_page_count = m_pages.size();
+    m_snapshots.push_back(std::move(snapshot));
+    return;
+  }
+
+  Snapshot* previous = m_snapshots.empty() ? nullptr : &m_snapshots.back();
+  size_t dirty_page_count = 0;
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    const Page& page = m_pages[i];
+    const u64 hash = HashPage(page.ptr, page.size);
+    if (hash == m_shadow_hashes[i])
+      continue;
+
+    u8* const shadow = &m_shadow[i * PAGE_SIZE];
+    if (previous)
+    {
+      previous->undo_pages.push_back(static_cast<u32>(i));
+      previous->undo_hashes.push_back(m_shadow_hashes[i]);
+      previous->undo_data.insert(previous->undo_data.end(), shadow, shadow + page.size);
+    }
+
+    std::memcpy(shadow, page.ptr, page.size);
+    m_shadow_hashes[i] = hash;
+    ++dirty_page_count;
+  }
+
+  m_last_dirty_page_count = dirty_page_count;
+  m_snapshots.push_back(std::move(snapshot));
+}
+
+bool DeltaSnapshotRing::Load(Core::System& system, u64 id)
+{
+  const auto it = std::find_if(m_snapshots.begin(), m_snapshots.end(),
+                               [id](const Snapshot& snapshot) { return snapshot.id == id; });
+  if (it == m_snapshots.end())
+    return false;
+
+  if (!IsLayoutCurrent(HW::GetBulkMemoryRegions(system)))
+  {
+    ERROR_LOG_FMT(CORE, "Memory layout changed, can't restore snapshot {}", id);
+    return false;
+  }
+
+  // Like for saving, anything the video backend writes back to RAM while loading has to be undone.
+  if (!LoadFromBufferWithoutBulkMemory(system, it->state))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to restore snapshot {}", id);
+    return false;
+  }
+
+  // First bring the memory back to the newest snapshot, then walk back to the requested one.
+  RestoreNewest();
+  const auto index = static_cast<size_t>(it - m_snapshots.begin());
+  for (size_t i = m_snapshots.size() - 1; i > index; --i)
+    ApplyUndo(m_snapshots[i - 1]);
+
+  m_snapshots.erase(m_snapshots.begin() + index + 1, m_snapshots.end());
+  m_snapshots.back().ClearUndo();
+  return true;
+}
+
+bool DeltaSnapshotRing::Contains(u64 id) const
+{
+  return std::any_of(m_snapshots.begin(), m_snapshots.end(),
+                     [id](const Snapshot& snapshot) { return snapshot.id == id; });
+}
+
+void DeltaSnapshotRing::Clear()
+{
+  m_snapshots.clear();
+}
+
+size_t DeltaSnapshotRing::GetMemoryUsage() const
+{
+  size_t usage = m_shadow.capacity() + m_shadow_hashes.capacity() * sizeof(u64);
+  for (const Snapshot& snapshot : m_snapshots)
+  {
+    usage += snapshot.state.capacity() + snapshot.undo_data.capacity() +
+             snapshot.undo_pages.capacity() * sizeof(u32) +
+             snapshot.undo_hashes.capacity() * sizeof(u64);
+  }
+  return usage;
+}
+
+bool DeltaSnapshotRing::IsLayoutCurrent(const std::vector<std::span<u8>>& regions) const
+{
+  return std::equal(regions.begin(), regions.end(), m_regions.begin(), m_regions.end(),
+                    [](std::span<u8> a, std::span<u8> b) {
+                      return a.data() == b.data() && a.size() == b.size();
+                    });
+}
+
+void DeltaSnapshotRing::ResetLayout(const std::vector<std::span<u8>>& regions)
+{
+  m_regions = regions;
+  m_pages.clear();
+  for (const std::span<u8> region : regions)
+  {
+    for (size_t offset = 0; offset < region.size(); offset += PAGE_SIZE)
+    {
+      const size_t size = std::min(PAGE_SIZE, region.size() - offset);
+      m_pages.push_back({region.data() + offset, static_cast<u32>(size)});
+    }
+  }
+
+  m_shadow.resize(m_pages.size() * PAGE_SIZE);
+  m_shadow_hashes.resize(m_pages.size());
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    const Page& page = m_pages[i];
+    std::memcpy(&m_shadow[i * PAGE_SIZE], page.ptr, page.size);
+    m_shadow_hashes[i] = HashPage(page.ptr, page.size);
+  }
+}
+
+void DeltaSnapshotRing::RestoreNewest()
+{
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    const Page& page = m_pages[i];
+    if (HashPage(page.ptr, page.size) != m_shadow_hashes[i])
+      std::memcpy(page.ptr, &m_shadow[i * PAGE_SIZE], page.size);
+  }
+}
+
+void DeltaSnapshotRing::ApplyUndo(const Snapshot& snapshot)
+{
+  size_t offset = 0;
+  for (size_t j = 0; j < snapshot.undo_pages.size(); ++j)
+  {
+    const u32 i = snapshot.undo_pages[j];
+    const Page& page = m_pages[i];
+    const u8* const data = &snapshot.undo_data[offset];
+    std::memcpy(page.ptr, data, page.size);
+    std::memcpy(&m_shadow[i * PAGE_SIZE], data, page.size);
+    m_shadow_hashes[i] = snapshot.undo_hashes[j];
+    offset += page.size;
+  }
+}
+}  // namespace State
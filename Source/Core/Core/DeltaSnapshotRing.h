@@ -0,0 +1,86 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <span>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Core
+{
+class System;
+}
+
+namespace State
+{
+// A ring of in-memory savestates meant to be taken as often as every frame, e.g. for rollback or
+// rewind.
+//
+// The bulk memory regions (MEM1, MEM2, ARAM, ...) are not part of the serialized states. Instead a
+// copy of them as of the newest snapshot is kept along with a hash of every page, and each save
+// only hashes the regions and copies the pages that changed since. The previous contents of those
+// pages are attached to the previous snapshot, so loading an older one replays these changes
+// backwards. Loading a snapshot drops all snapshots newer than it.
+//
+// Write-protecting the regions to find dirty pages isn't an option, since the JIT's fastmem
+// accesses would trip over it, so all functions here have to be called from the CPU thread while it
+// is outside of emulated code.
+class DeltaSnapshotRing
+{
+public:
+  static constexpr size_t PAGE_SIZE = 0x1000;
+
+  explicit DeltaSnapshotRing(size_t capacity);
+
+  // Snapshot ids are chosen by the caller and must increase with every save.
+  void Save(Core::System& system, u64 id);
+  bool Load(Core::System& system, u64 id);
+  bool Contains(u64 id) const;
+  void Clear();
+
+  size_t GetSnapshotCount() const { return m_snapshots.size(); }
+  size_t GetLastDirtyPageCount() const { return m_last_dirty_page_count; }
+  // Bytes held by the snapshots and the copy of the bulk memory regions.
+  size_t GetMemoryUsage() const;
+
+private:
+  struct Page
+  {
+    u8* ptr;
+    u32 size;
+  };
+
+  struct Snapshot
+  {
+    u64 id = 0;
+    std::vector<u8> state;
+
+    // Pages that were modified on the way to the next snapshot, with their contents as of this one.
+    std::vector<u32> undo_pages;
+    std::vector<u64> undo_hashes;
+    std::vector<u8> undo_data;
+
+    void ClearUndo();
+  };
+
+  bool IsLayoutCurrent(const std::vector<std::span<u8>>& regions) const;
+  void ResetLayout(const std::vector<std::span<u8>>& regions);
+  void RestoreNewest();
+  void ApplyUndo(const Snapshot& snapshot);
+
+  const size_t m_capacity;
+
+  std::vector<std::span<u8>> m_regions;
+  std::vector<Page> m_pages;
+  // Copy of the bulk memory regions as of the newest snapshot, laid out page by page.
+  std::vector<u8> m_shadow;
+  std::vector<u64> m_shadow_hashes;
+
+  std::deque<Snapshot> m_snapshots;
+  size_t m_last_dirty_page_count = 0;
+};
+}  // namespace State
@@ -9,18 +9,34 @@
 #include <string>
 #include <vector>
 
+#include <zstd.h>
+
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
 constexpr u32 FILE_ID = 0x0d01f1f0;
-constexpr u32 VERSION_NUMBER = 5;
+constexpr u32 VERSION_NUMBER = 6;
 constexpr u32 MIN_LOADER_VERSION = 1;
 // This value is only used if the DFF file was created with overridden RAM sizes.
 // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
 constexpr u32 MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5;
+// Likewise, this is only used if the DFF file was saved with compressed frames.
+constexpr u32 MIN_LOADER_VERSION_FOR_COMPRESSED_FRAMES = 6;
+
+constexpr u8 FRAME_COMPRESSION_NONE = 0;
+constexpr u8 FRAME_COMPRESSION_ZSTD = 1;
+constexpr int FRAME_COMPRESSION_LEVEL = 3;
+// Far more than a frame of FIFO data and memory updates can take up, but it keeps a broken frame
+// list from making us allocate whatever it says.
+constexpr u32 MAX_UNCOMPRESSED_FRAME_SIZE = 1 << 30;
+
+// Frames are played back one after the other, so there's no point in keeping many of them around,
+// and the frames of big logs can be big.
+constexpr size_t FRAME_CACHE_SIZE = 2;
 
 #pragma pack(push, 1)
 
@@ -58,7 +74,15 @@ struct FileFrameInfo
   u32 fifoEnd;
   u64 memoryUpdatesOffset;
   u32 numMemoryUpdates;
-  u8 reserved[32];
+  // Added in version 6; these were uninitialized before that. A compressed frame is stored as one
+  // zstd frame of storedSize bytes at fifoDataOffset. Decompressed, it holds the FIFO data, the
+  // memory update list and the data of the memory updates, and memoryUpdatesOffset as well as the
+  // data offsets in the memory update list are relative to its start.
+  u8 compression;
+  u8 padding[3];
+  u32 storedSize;
+  u32 uncompressedSize;
+  u8 reserved[20];
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
@@ -101,7 +125,41 @@ bool FifoDataFile::GetIsWii() const
 
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  m_Frames.push_back(std::make_shared<const FifoFrameInfo>(frameInfo));
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  if (!m_file)
+    return m_Frames[frame];
+
+  std::lock_guard lk(m_frame_cache_mutex);
+
+  const auto it = std::find_if(m_frame_cache.begin(), m_frame_cache.end(),
+                               [frame](const auto& entry) { return entry.first == frame; });
+  if (it != m_frame_cache.end())
+  {
+    std::rotate(it, it + 1, m_frame_cache.end());
+    return m_frame_cache.back().second;
+  }
+
+  std::shared_ptr<const FifoFrameInfo> result = ReadFrame(frame);
+  if (!result)
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to read frame {} of the DFF file", frame);
+    m_file->ClearError();
+    return std::make_shared<const FifoFrameInfo>();
+  }
+
+  if (m_frame_cache.size() == FRAME_CACHE_SIZE)
+    m_frame_cache.erase(m_frame_cache.begin());
+  m_frame_cache.emplace_back(frame, result);
+  return result;
+}
+
+u32 FifoDataFile::GetFrameCount() const
+{
+  return static_cast<u32>(m_file ? m_frame_locations.size() : m_Frames.size());
 }
 
 bool FifoDataFile::Save(const std::string& filename)
@@ -110,12 +168,15 @@ bool FifoDataFile::Save(const std::string& filename)
   if (!file.Open(filename, "wb"))
     return false;
 
+  const u32 frame_count = GetFrameCount();
+  const bool compress_frames = Config::Get(Config::MAIN_FIFOPLAYER_COMPRESS_FRAMES);
+
   // Add space for header
   PadFile(sizeof(FileHeader), file);
 
   // Add space for frame list
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  PadFile(frame_count * sizeof(FileFrameInfo), file);
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
@@ -133,11 +194,14 @@ bool FifoDataFile::Save(const std::string& filename)
   file.WriteArray(m_TexMem);
 
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
+  // Maintain backwards compatability so long as the RAM sizes aren't overridden and the frames
+  // aren't compressed.
+  if (compress_frames)
+    header.min_loader_version = MIN_LOADER_VERSION_FOR_COMPRESSED_FRAMES;
+  else if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
     header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
   else
     header.min_loader_version = MIN_LOADER_VERSION;
@@ -158,7 +222,7 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = frame_count;
 
   header.flags = m_Flags;
 
@@ -170,26 +234,71 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, File::SeekOrigin::Begin);
   file.WriteBytes(&header, sizeof(FileHeader));
 
+  std::vector<u8> frame_data;
+  std::vector<u8> compressed_frame;
+
   // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
+  for (u32 i = 0; i < frame_count; ++i)
   {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
+    const std::shared_ptr<const FifoFrameInfo> frame = GetFrame(i);
+    const FifoFrameInfo& srcFrame = *frame;
 
-    // Write FIFO data
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
+    FileFrameInfo dstFrame{};
     dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
     dstFrame.fifoStart = srcFrame.fifoStart;
     dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
     dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
 
+    file.Seek(0, File::SeekOrigin::End);
+    const u64 dataOffset = file.Tell();
+    dstFrame.fifoDataOffset = dataOffset;
+
+    if (compress_frames)
+    {
+      frame_data.assign(srcFrame.fifoData.begin(), srcFrame.fifoData.end());
+      const u64 memoryUpdatesOffset = frame_data.size();
+      frame_data.resize(memoryUpdatesOffset +
+                        srcFrame.memoryUpdates.size() * sizeof(FileMemoryUpdate));
+
+      for (size_t j = 0; j < srcFrame.memoryUpdates.size(); ++j)
+      {
+        const MemoryUpdate& srcUpdate = srcFrame.memoryUpdates[j];
+
+        FileMemoryUpdate dstUpdate{};
+        dstUpdate.address = srcUpdate.address;
+        dstUpdate.dataOffset = frame_data.size();
+        dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+        dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+        dstUpdate.type = static_cast<u8>(srcUpdate.type);
+        std::memcpy(frame_data.data() + memoryUpdatesOffset + j * sizeof(FileMemoryUpdate),
+                    &dstUpdate, sizeof(FileMemoryUpdate));
+
+        frame_data.insert(frame_data.end(), srcUpdate.data.begin(), srcUpdate.data.end());
+      }
+
+      compressed_frame.resize(ZSTD_compressBound(frame_data.size()));
+      const size_t compressed_size =
+          ZSTD_compress(compressed_frame.data(), compressed_frame.size(), frame_data.data(),
+                        frame_data.size(), FRAME_COMPRESSION_LEVEL);
+
+      if (!ZSTD_isError(compressed_size) && compressed_size < frame_data.size())
+      {
+        file.WriteBytes(compressed_frame.data(), compressed_size);
+
+        dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
+        dstFrame.compression = FRAME_COMPRESSION_ZSTD;
+        dstFrame.storedSize = static_cast<u32>(compressed_size);
+        dstFrame.uncompressedSize = static_cast<u32>(frame_data.size());
+      }
+    }
+
+    // Frames that don't get smaller when compressed are stored like in older versions
+    if (dstFrame.compression == FRAME_COMPRESSION_NONE)
+    {
+      file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
+      dstFrame.memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+    }
+
     // Write frame info
     u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
     file.Seek(frameOffset, File::SeekOrigin::Begin);
@@ -316,33 +425,130 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
+  // Only read the frame list. The frames themselves are read when they're played or analyzed,
+  // so that big files open quickly and don't have to fit in memory.
+  const u64 file_size = file.GetSize();
+  if (header.frameListOffset > file_size ||
+      u64(header.frameCount) * sizeof(FileFrameInfo) > file_size - header.frameListOffset)
+  {
+    return panic_failed_to_read();
+  }
+
+  std::vector<FileFrameInfo> frame_list(header.frameCount);
+  file.Seek(header.frameListOffset, File::SeekOrigin::Begin);
+  if (!file.ReadArray(frame_list.data(), frame_list.size()))
+    return panic_failed_to_read();
+
+  dataFile->m_frame_locations.resize(header.frameCount);
   for (u32 i = 0; i < header.frameCount; ++i)
   {
-    u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
+    const FileFrameInfo& srcFrame = frame_list[i];
+
+    const bool compressed =
+        header.file_version >= 6 && srcFrame.compression != FRAME_COMPRESSION_NONE;
+    if (compressed && srcFrame.compression != FRAME_COMPRESSION_ZSTD)
+    {
+      CriticalAlertFmtT("Frame {0} of the DFF file uses an unknown compression method ({1}).", i,
+                        srcFrame.compression);
+      return nullptr;
+    }
+
+    const u64 storedSize = compressed ? srcFrame.storedSize : srcFrame.fifoDataSize;
+    if (srcFrame.fifoDataOffset > file_size || storedSize > file_size - srcFrame.fifoDataOffset)
       return panic_failed_to_read();
+    if (compressed && (srcFrame.uncompressedSize > MAX_UNCOMPRESSED_FRAME_SIZE ||
+                       srcFrame.fifoDataSize > srcFrame.uncompressedSize))
+    {
+      return panic_failed_to_read();
+    }
+
+    FrameLocation& location = dataFile->m_frame_locations[i];
+    location.fifoDataOffset = srcFrame.fifoDataOffset;
+    location.fifoDataSize = srcFrame.fifoDataSize;
+    location.fifoStart = srcFrame.fifoStart;
+    location.fifoEnd = srcFrame.fifoEnd;
+    location.memoryUpdatesOffset = srcFrame.memoryUpdatesOffset;
+    location.numMemoryUpdates = srcFrame.numMemoryUpdates;
+    location.compressed = compressed;
+    location.storedSize = compressed ? srcFrame.storedSize : 0;
+    location.uncompressedSize = compressed ? srcFrame.uncompressedSize : 0;
+  }
 
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
+  dataFile->m_file = std::make_unique<File::IOFile>(std::move(file));
+  dataFile->m_mapped_file.Open(filename);
+
+  return dataFile;
+}
 
-    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::ReadFrame(u32 frame) const
+{
+  const FrameLocation& location = m_frame_locations[frame];
 
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+  auto result = std::make_shared<FifoFrameInfo>();
+  result->fifoStart = location.fifoStart;
+  result->fifoEnd = location.fifoEnd;
 
-    if (!file.IsGood())
-      return panic_failed_to_read();
+  if (!location.compressed)
+  {
+    result->fifoData.resize(location.fifoDataSize);
+    if (!ReadFileData(location.fifoDataOffset, location.fifoDataSize, result->fifoData.data()))
+      return nullptr;
+
+    if (!ReadMemoryUpdates(location.memoryUpdatesOffset, location.numMemoryUpdates,
+                           result->memoryUpdates))
+    {
+      return nullptr;
+    }
+    return result;
+  }
 
-    dataFile->AddFrame(dstFrame);
+  // A mapped file can be decompressed from directly.
+  const u8* compressed = GetMappedData(location.fifoDataOffset, location.storedSize);
+  std::vector<u8> compressed_buffer;
+  if (!compressed)
+  {
+    compressed_buffer.resize(location.storedSize);
+    if (!ReadFileData(location.fifoDataOffset, location.storedSize, compressed_buffer.data()))
+      return nullptr;
+    compressed = compressed_buffer.data();
   }
 
-  return dataFile;
+  // The zstd frame header has the size too. Check that they agree before allocating the buffer.
+  if (ZSTD_getFrameContentSize(compressed, location.storedSize) != location.uncompressedSize)
+    return nullptr;
+
+  std::vector<u8> data(location.uncompressedSize);
+  const size_t size = ZSTD_decompress(data.data(), data.size(), compressed, location.storedSize);
+  if (ZSTD_isError(size) || size != data.size())
+    return nullptr;
+
+  if (location.fifoDataSize > size || location.memoryUpdatesOffset > size ||
+      u64(location.numMemoryUpdates) * sizeof(FileMemoryUpdate) >
+          size - location.memoryUpdatesOffset)
+  {
+    return nullptr;
+  }
+
+  result->fifoData.assign(data.begin(), data.begin() + location.fifoDataSize);
+
+  result->memoryUpdates.resize(location.numMemoryUpdates);
+  for (u32 i = 0; i < location.numMemoryUpdates; ++i)
+  {
+    FileMemoryUpdate srcUpdate;
+    std::memcpy(&srcUpdate, data.data() + location.memoryUpdatesOffset + i * sizeof(srcUpdate),
+                sizeof(srcUpdate));
+    if (srcUpdate.dataOffset > size || srcUpdate.dataSize > size - srcUpdate.dataOffset)
+      return nullptr;
+
+    MemoryUpdate& dstUpdate = result->memoryUpdates[i];
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.data.assign(data.begin() + srcUpdate.dataOffset,
+                          data.begin() + srcUpdate.dataOffset + srcUpdate.dataSize);
+    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+  }
+
+  return result;
 }
 
 void FifoDataFile::PadFile(size_t numBytes, File::IOFile& file)
@@ -380,7 +586,7 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
     u64 dataOffset = file.Tell();
     file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
 
-    FileMemoryUpdate dstUpdate;
+    FileMemoryUpdate dstUpdate{};
     dstUpdate.address = srcUpdate.address;
     dstUpdate.dataOffset = dataOffset;
     dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
@@ -395,17 +601,17 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
   return updateListOffset;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
+bool FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
+                                     std::vector<MemoryUpdate>& memUpdates) const
 {
   memUpdates.resize(numUpdates);
 
   for (u32 i = 0; i < numUpdates; ++i)
   {
     u64 updateOffset = fileOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
     FileMemoryUpdate srcUpdate;
-    file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate));
+    if (!ReadFileData(updateOffset, sizeof(FileMemoryUpdate), reinterpret_cast<u8*>(&srcUpdate)))
+      return false;
 
     MemoryUpdate& dstUpdate = memUpdates[i];
     dstUpdate.address = srcUpdate.address;
@@ -413,7 +619,38 @@ void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
     dstUpdate.data.resize(srcUpdate.dataSize);
     dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
 
-    file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
+    if (!ReadFileData(srcUpdate.dataOffset, srcUpdate.dataSize, dstUpdate.data.data()))
+      return false;
   }
+
+  return true;
+}
+
+const u8* FifoDataFile::GetMappedData(u64 offset, u64 size) const
+{
+  if (!m_mapped_file.IsOpen())
+    return nullptr;
+
+  // Load only checks the frame list, not the memory updates that frames point to.
+  const u64 file_size = m_mapped_file.GetSize();
+  if (offset > file_size || size > file_size - offset)
+    return nullptr;
+
+  return m_mapped_file.GetData() + offset;
+}
+
+bool FifoDataFile::ReadFileData(u64 offset, u64 size, u8* out) const
+{
+  if (m_mapped_file.IsOpen())
+  {
+    const u8* data = GetMappedData(offset, size);
+    if (!data)
+      return false;
+
+    std::copy_n(data, size, out);
+    return true;
+  }
+
+  m_file->Seek(offset, File::SeekOrigin::Begin);
+  return m_file->ReadBytes(out, size);
 }
@@ -5,10 +5,13 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace File
@@ -73,8 +76,10 @@ public:
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // The frames of a loaded file are read when they're needed, and only the last few of them are
+  // kept in memory. Can be called from multiple threads. If a frame can't be read, it's empty.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const;
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -91,8 +96,27 @@ private:
   bool GetFlag(u32 flag) const;
 
   u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  bool ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
+                         std::vector<MemoryUpdate>& memUpdates) const;
+
+  // Where a frame of a loaded file is stored
+  struct FrameLocation
+  {
+    u64 fifoDataOffset;
+    u32 fifoDataSize;
+    u32 fifoStart;
+    u32 fifoEnd;
+    u64 memoryUpdatesOffset;
+    u32 numMemoryUpdates;
+    bool compressed;
+    u32 storedSize;
+    u32 uncompressedSize;
+  };
+
+  std::shared_ptr<const FifoFrameInfo> ReadFrame(u32 frame) const;
+  // Returns nullptr if the file isn't mapped or the range is out of bounds
+  const u8* GetMappedData(u64 offset, u64 size) const;
+  bool ReadFileData(u64 offset, u64 size, u8* out) const;
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
@@ -105,5 +129,15 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  // Only used for files that weren't loaded, like recordings
+  std::vector<std::shared_ptr<const FifoFrameInfo>> m_Frames;
+
+  std::unique_ptr<File::IOFile> m_file;
+  // Frames are read from here if the file could be mapped, which saves a pair of system calls for
+  // every memory update. Otherwise they're read with m_file.
+  File::MappedFile m_mapped_file;
+  std::vector<FrameLocation> m_frame_locations;
+  mutable std::mutex m_frame_cache_mutex;
+  // The most recently used frame is at the back
+  mutable std::vector<std::pair<u32, std::shared_ptr<const FifoFrameInfo>>> m_frame_cache;
 };
@@ -35,12 +35,15 @@
 
 namespace
 {
+constexpr size_t ANALYZED_FRAME_CACHE_SIZE = 4;
+
 class FifoPlaybackAnalyzer : public OpcodeDecoder::Callback
 {
 public:
-  static void AnalyzeFrames(FifoDataFile* file, std::vector<AnalyzedFrameInfo>& frame_info);
+  explicit FifoPlaybackAnalyzer(const CPState& cpmem) : m_cpmem(cpmem) {}
 
-  explicit FifoPlaybackAnalyzer(const u32* cpmem) : m_cpmem(cpmem) {}
+  // Afterwards, m_cpmem is the state at the end of the frame
+  AnalyzedFrameInfo AnalyzeFrame(const FifoFrameInfo& frame);
 
   OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data)) {}
   OPCODE_CALLBACK(void OnCP(u8 command, u32 value)) { GetCPState().LoadCPReg(command, value); }
@@ -73,60 +76,53 @@ public:
   CPState m_cpmem;
 };
 
-void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
-                                         std::vector<AnalyzedFrameInfo>& frame_info)
+AnalyzedFrameInfo FifoPlaybackAnalyzer::AnalyzeFrame(const FifoFrameInfo& frame)
 {
-  FifoPlaybackAnalyzer analyzer(file->GetCPMem());
-  frame_info.clear();
-  frame_info.resize(file->GetFrameCount());
+  AnalyzedFrameInfo analyzed;
 
-  for (u32 frame_no = 0; frame_no < file->GetFrameCount(); frame_no++)
-  {
-    const FifoFrameInfo& frame = file->GetFrame(frame_no);
-    AnalyzedFrameInfo& analyzed = frame_info[frame_no];
+  u32 offset = 0;
 
-    u32 offset = 0;
+  u32 part_start = 0;
+  CPState cpmem;
 
-    u32 part_start = 0;
-    CPState cpmem;
+  while (offset < frame.fifoData.size())
+  {
+    const u32 cmd_size = OpcodeDecoder::RunCommand(&frame.fifoData[offset],
+                                                   u32(frame.fifoData.size()) - offset, *this);
 
-    while (offset < frame.fifoData.size())
+    if (m_start_of_primitives)
     {
-      const u32 cmd_size = OpcodeDecoder::RunCommand(&frame.fifoData[offset],
-                                                     u32(frame.fifoData.size()) - offset, analyzer);
-
-      if (analyzer.m_start_of_primitives)
-      {
-        // Start of primitive data for an object
-        analyzed.AddPart(FramePartType::Commands, part_start, offset, analyzer.m_cpmem);
-        part_start = offset;
-        // Copy cpmem now, because end_of_primitives isn't triggered until the first opcode after
-        // primitive data, and the first opcode might update cpmem
-        static_assert(std::is_trivially_copyable_v<CPState>);
-        std::memcpy(static_cast<void*>(&cpmem), static_cast<const void*>(&analyzer.m_cpmem),
-                    sizeof(CPState));
-      }
-      if (analyzer.m_end_of_primitives)
-      {
-        // End of primitive data for an object, and thus end of the object
-        analyzed.AddPart(FramePartType::PrimitiveData, part_start, offset, cpmem);
-        part_start = offset;
-      }
+      // Start of primitive data for an object
+      analyzed.AddPart(FramePartType::Commands, part_start, offset, m_cpmem);
+      part_start = offset;
+      // Copy cpmem now, because end_of_primitives isn't triggered until the first opcode after
+      // primitive data, and the first opcode might update cpmem
+      static_assert(std::is_trivially_copyable_v<CPState>);
+      std::memcpy(static_cast<void*>(&cpmem), static_cast<const void*>(&m_cpmem),
+                  sizeof(CPState));
+    }
+    if (m_end_of_primitives)
+    {
+      // End of primitive data for an object, and thus end of the object
+      analyzed.AddPart(FramePartType::PrimitiveData, part_start, offset, cpmem);
+      part_start = offset;
+    }
 
-      offset += cmd_size;
+    offset += cmd_size;
 
-      if (analyzer.m_efb_copy)
-      {
-        // We increase the offset beforehand, so that the trigger EFB copy command is included.
-        analyzed.AddPart(FramePartType::EFBCopy, part_start, offset, analyzer.m_cpmem);
-        part_start = offset;
-      }
+    if (m_efb_copy)
+    {
+      // We increase the offset beforehand, so that the trigger EFB copy command is included.
+      analyzed.AddPart(FramePartType::EFBCopy, part_start, offset, m_cpmem);
+      part_start = offset;
     }
-
-    // The frame should end with an EFB copy, so part_start should have been updated to the end.
-    ASSERT(part_start == frame.fifoData.size());
-    ASSERT(offset == frame.fifoData.size());
   }
+
+  // The frame should end with an EFB copy, so part_start should have been updated to the end.
+  ASSERT(part_start == frame.fifoData.size());
+  ASSERT(offset == frame.fifoData.size());
+
+  return analyzed;
 }
 
 void FifoPlaybackAnalyzer::OnBP(u8 command, u32 value)
@@ -187,14 +183,17 @@ bool FifoPlayer::Open(const std::string& filename)
 {
   Close();
 
-  m_File = FifoDataFile::Load(filename, false);
+  std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(filename, false);
 
-  if (m_File)
   {
-    FifoPlaybackAnalyzer::AnalyzeFrames(m_File.get(), m_FrameInfo);
+    std::lock_guard lk(m_analysis_mutex);
+    m_File = std::move(file);
+    if (m_File)
+      m_frame_start_cp_states.emplace_back(m_File->GetCPMem());
+  }
 
+  if (m_File)
     m_FrameRangeEnd = m_File->GetFrameCount() - 1;
-  }
 
   if (m_FileLoadedCb)
     m_FileLoadedCb();
@@ -204,7 +203,14 @@ bool FifoPlayer::Open(const std::string& filename)
 
 void FifoPlayer::Close()
 {
-  m_File.reset();
+  {
+    std::lock_guard lk(m_analysis_mutex);
+    m_frame_start_cp_states.clear();
+    m_frame_object_counts.clear();
+    m_analyzed_frame_cache.clear();
+    ++m_file_generation;
+    m_File.reset();
+  }
 
   m_FrameRangeStart = 0;
   m_FrameRangeEnd = 0;
@@ -297,7 +303,8 @@ CPU::State FifoPlayer::AdvanceFrame()
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  const std::shared_ptr<const FifoFrameInfo> frame = m_File->GetFrame(m_CurrentFrame);
+  WriteFrame(*frame, *GetAnalyzedFrameInfo(m_CurrentFrame));
 
   ++m_CurrentFrame;
   return CPU::State::Running;
@@ -338,31 +345,101 @@ bool FifoPlayer::IsRunningWithFakeVideoInterfaceUpdates() const
   return m_File->ShouldGenerateFakeVIUpdates();
 }
 
-u32 FifoPlayer::GetMaxObjectCount() const
+std::optional<u32> FifoPlayer::GetMaxObjectCount(const Common::Flag& cancel)
 {
-  u32 result = 0;
-  for (auto& frame : m_FrameInfo)
+  u32 generation;
   {
-    const u32 count = frame.part_type_counts[FramePartType::PrimitiveData];
-    if (count > result)
-      result = count;
+    std::lock_guard lk(m_analysis_mutex);
+    if (!m_File)
+      return std::nullopt;
+    generation = m_file_generation;
+  }
+
+  u32 max_count = 0;
+  for (u32 frame = 0;; ++frame)
+  {
+    // The lock is only held for one frame at a time, so that playback doesn't have to wait.
+    std::lock_guard lk(m_analysis_mutex);
+    if (cancel.IsSet() || m_file_generation != generation)
+      return std::nullopt;
+    if (frame >= m_File->GetFrameCount())
+      return max_count;
+
+    // Don't push the frames that are being played out of the cache.
+    if (frame >= m_frame_object_counts.size())
+      AnalyzeFrameUncached(frame);
+    max_count = std::max(max_count, m_frame_object_counts[frame]);
   }
-  return result;
 }
 
-u32 FifoPlayer::GetFrameObjectCount(u32 frame) const
+u32 FifoPlayer::GetFileGeneration()
 {
-  if (frame < m_FrameInfo.size())
+  std::lock_guard lk(m_analysis_mutex);
+  return m_file_generation;
+}
+
+u32 FifoPlayer::GetFrameObjectCount(u32 frame)
+{
+  if (!m_File || frame >= m_File->GetFrameCount())
+    return 0;
+
+  std::lock_guard lk(m_analysis_mutex);
+  if (frame >= m_frame_object_counts.size())
+    AnalyzeFrame(frame);
+
+  return m_frame_object_counts[frame];
+}
+
+u32 FifoPlayer::GetCurrentFrameObjectCount()
+{
+  return GetFrameObjectCount(m_CurrentFrame);
+}
+
+std::shared_ptr<const AnalyzedFrameInfo> FifoPlayer::GetAnalyzedFrameInfo(u32 frame)
+{
+  std::lock_guard lk(m_analysis_mutex);
+  return AnalyzeFrame(frame);
+}
+
+std::shared_ptr<const AnalyzedFrameInfo> FifoPlayer::AnalyzeFrame(u32 frame)
+{
+  const auto it =
+      std::find_if(m_analyzed_frame_cache.begin(), m_analyzed_frame_cache.end(),
+                   [frame](const auto& entry) { return entry.first == frame; });
+  if (it != m_analyzed_frame_cache.end())
   {
-    return m_FrameInfo[frame].part_type_counts[FramePartType::PrimitiveData];
+    std::rotate(it, it + 1, m_analyzed_frame_cache.end());
+    return m_analyzed_frame_cache.back().second;
   }
 
-  return 0;
+  std::shared_ptr<const AnalyzedFrameInfo> result = AnalyzeFrameUncached(frame);
+
+  if (m_analyzed_frame_cache.size() == ANALYZED_FRAME_CACHE_SIZE)
+    m_analyzed_frame_cache.erase(m_analyzed_frame_cache.begin());
+  m_analyzed_frame_cache.emplace_back(frame, result);
+  return result;
 }
 
-u32 FifoPlayer::GetCurrentFrameObjectCount() const
+std::shared_ptr<const AnalyzedFrameInfo> FifoPlayer::AnalyzeFrameUncached(u32 frame)
 {
-  return GetFrameObjectCount(m_CurrentFrame);
+  // A frame starts with the CP state that the frames before it left behind, so those have to be
+  // analyzed first if they haven't been yet
+  const u32 first_frame = std::min(frame, static_cast<u32>(m_frame_start_cp_states.size() - 1));
+
+  std::shared_ptr<const AnalyzedFrameInfo> result;
+  for (u32 i = first_frame; i <= frame; ++i)
+  {
+    FifoPlaybackAnalyzer analyzer(m_frame_start_cp_states[i]);
+    result = std::make_shared<const AnalyzedFrameInfo>(analyzer.AnalyzeFrame(*m_File->GetFrame(i)));
+
+    if (i + 1 == m_frame_start_cp_states.size())
+    {
+      m_frame_start_cp_states.push_back(analyzer.m_cpmem);
+      m_frame_object_counts.push_back(result->part_type_counts[FramePartType::PrimitiveData]);
+    }
+  }
+
+  return result;
 }
 
 void FifoPlayer::SetFrameRangeStart(u32 start)
@@ -482,8 +559,8 @@ void FifoPlayer::WriteAllMemoryUpdates()
 
   for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
   {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
-    for (auto& update : frame.memoryUpdates)
+    const std::shared_ptr<const FifoFrameInfo> frame = m_File->GetFrame(frameNum);
+    for (auto& update : frame->memoryUpdates)
     {
       WriteMemory(update);
     }
@@ -547,16 +624,16 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const std::shared_ptr<const FifoFrameInfo> frame = m_File->GetFrame(m_CurrentFrame);
 
   // Set fifo bounds
-  WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
-  WriteCP(CommandProcessor::FIFO_BASE_HI, frame.fifoStart >> 16);
-  WriteCP(CommandProcessor::FIFO_END_LO, frame.fifoEnd);
-  WriteCP(CommandProcessor::FIFO_END_HI, frame.fifoEnd >> 16);
+  WriteCP(CommandProcessor::FIFO_BASE_LO, frame->fifoStart);
+  WriteCP(CommandProcessor::FIFO_BASE_HI, frame->fifoStart >> 16);
+  WriteCP(CommandProcessor::FIFO_END_LO, frame->fifoEnd);
+  WriteCP(CommandProcessor::FIFO_END_HI, frame->fifoEnd >> 16);
 
   // Set watermarks, high at 75%, low at 0%
-  u32 hi_watermark = (frame.fifoEnd - frame.fifoStart) * 3 / 4;
+  u32 hi_watermark = (frame->fifoEnd - frame->fifoStart) * 3 / 4;
   WriteCP(CommandProcessor::FIFO_HI_WATERMARK_LO, hi_watermark);
   WriteCP(CommandProcessor::FIFO_HI_WATERMARK_HI, hi_watermark >> 16);
   WriteCP(CommandProcessor::FIFO_LO_WATERMARK_LO, 0);
@@ -565,19 +642,19 @@ void FifoPlayer::SetupFifo()
   // Set R/W pointers to fifo start
   WriteCP(CommandProcessor::FIFO_RW_DISTANCE_LO, 0);
   WriteCP(CommandProcessor::FIFO_RW_DISTANCE_HI, 0);
-  WriteCP(CommandProcessor::FIFO_WRITE_POINTER_LO, frame.fifoStart);
-  WriteCP(CommandProcessor::FIFO_WRITE_POINTER_HI, frame.fifoStart >> 16);
-  WriteCP(CommandProcessor::FIFO_READ_POINTER_LO, frame.fifoStart);
-  WriteCP(CommandProcessor::FIFO_READ_POINTER_HI, frame.fifoStart >> 16);
+  WriteCP(CommandProcessor::FIFO_WRITE_POINTER_LO, frame->fifoStart);
+  WriteCP(CommandProcessor::FIFO_WRITE_POINTER_HI, frame->fifoStart >> 16);
+  WriteCP(CommandProcessor::FIFO_READ_POINTER_LO, frame->fifoStart);
+  WriteCP(CommandProcessor::FIFO_READ_POINTER_HI, frame->fifoStart >> 16);
 
   // Set fifo bounds
-  WritePI(ProcessorInterface::PI_FIFO_BASE, frame.fifoStart);
-  WritePI(ProcessorInterface::PI_FIFO_END, frame.fifoEnd);
+  WritePI(ProcessorInterface::PI_FIFO_BASE, frame->fifoStart);
+  WritePI(ProcessorInterface::PI_FIFO_END, frame->fifoEnd);
 
   // Set write pointer
-  WritePI(ProcessorInterface::PI_FIFO_WPTR, frame.fifoStart);
+  WritePI(ProcessorInterface::PI_FIFO_WPTR, frame->fifoStart);
   FlushWGP();
-  WritePI(ProcessorInterface::PI_FIFO_WPTR, frame.fifoStart);
+  WritePI(ProcessorInterface::PI_FIFO_WPTR, frame->fifoStart);
 
   WriteCP(CommandProcessor::CTRL_REGISTER, 17);  // enable read & GP link
 }
@@ -5,12 +5,16 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/Config/Config.h"
+#include "Common/Flag.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "VideoCommon/CPMemory.h"
@@ -115,11 +119,18 @@ public:
   bool IsPlaying() const;
 
   FifoDataFile* GetFile() const { return m_File.get(); }
-  u32 GetMaxObjectCount() const;
-  u32 GetFrameObjectCount(u32 frame) const;
-  u32 GetCurrentFrameObjectCount() const;
+  // Frames are analyzed when they're first needed rather than when the file is opened. These can
+  // be called from multiple threads.
+  // GetMaxObjectCount analyzes every frame, which takes a while for big fifologs, so it shouldn't
+  // be called from the UI thread. It gives up if cancel is set or the file is closed meanwhile.
+  std::optional<u32> GetMaxObjectCount(const Common::Flag& cancel);
+  // Changes whenever the file is closed, so that results computed for an older file can be told
+  // apart.
+  u32 GetFileGeneration();
+  u32 GetFrameObjectCount(u32 frame);
+  u32 GetCurrentFrameObjectCount();
   u32 GetCurrentFrameNum() const { return m_CurrentFrame; }
-  const AnalyzedFrameInfo& GetAnalyzedFrameInfo(u32 frame) const { return m_FrameInfo[frame]; }
+  std::shared_ptr<const AnalyzedFrameInfo> GetAnalyzedFrameInfo(u32 frame);
   // Frame range
   u32 GetFrameRangeStart() const { return m_FrameRangeStart; }
   void SetFrameRangeStart(u32 start);
@@ -145,6 +156,10 @@ private:
 
   CPU::State AdvanceFrame();
 
+  // Must be called with m_analysis_mutex held
+  std::shared_ptr<const AnalyzedFrameInfo> AnalyzeFrame(u32 frame);
+  std::shared_ptr<const AnalyzedFrameInfo> AnalyzeFrameUncached(u32 frame);
+
   void WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo& info);
   void WriteFramePart(const FramePart& part, u32* next_mem_update, const FifoFrameInfo& frame);
 
@@ -204,5 +219,13 @@ private:
 
   std::unique_ptr<FifoDataFile> m_File;
 
-  std::vector<AnalyzedFrameInfo> m_FrameInfo;
+  std::mutex m_analysis_mutex;
+  // Analyzing a frame needs the CP state at its start, which is the state at the end of the frame
+  // before it, so the frames are analyzed in order once. Only this state and the object count of
+  // each frame are kept from that, along with the last few analyzed frames.
+  std::vector<CPState> m_frame_start_cp_states;
+  std::vector<u32> m_frame_object_counts;
+  std::vector<std::pair<u32, std::shared_ptr<const AnalyzedFrameInfo>>> m_analyzed_frame_cache;
+  // Changes whenever a file is closed, so that a long analysis can tell that it has to stop.
+  u32 m_file_generation = 0;
 };
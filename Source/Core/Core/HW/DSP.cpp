@@ -76,9 +76,9 @@ DSPManager::~DSPManager() = default;
 // time given to LLE DSP on every read of the high bits in a mailbox
 constexpr int DSP_MAIL_SLICE = 72;
 
-void DSPManager::DoState(PointerWrap& p)
+void DSPManager::DoState(PointerWrap& p, bool include_aram)
 {
-  if (!m_aram.wii_mode)
+  if (!m_aram.wii_mode && include_aram)
     p.DoArray(m_aram.ptr, m_aram.size);
   p.Do(m_dsp_control);
   p.Do(m_audio_dma);
@@ -603,4 +603,14 @@ u8* DSPManager::GetARAMPtr() const
   return m_aram.ptr;
 }
 
+u32 DSPManager::GetARAMSize() const
+{
+  return m_aram.size;
+}
+
+bool DSPManager::IsARAMWiiMode() const
+{
+  return m_aram.wii_mode;
+}
+
 }  // end of namespace DSP
@@ -86,7 +86,7 @@ public:
 
   DSPEmulator* GetDSPEmulator();
 
-  void DoState(PointerWrap& p);
+  void DoState(PointerWrap& p, bool include_aram = true);
 
   // TODO: Maybe rethink this? The timing is unpredictable.
   void GenerateDSPInterruptFromDSPEmu(DSPInterruptType type, int cycles_into_future = 0);
@@ -97,6 +97,9 @@ public:
 
   // Debugger Helper
   u8* GetARAMPtr() const;
+  u32 GetARAMSize() const;
+  // On the Wii, "ARAM" is MEM2 and belongs to the MemoryManager.
+  bool IsARAMWiiMode() const;
 
   void UpdateAudioDMA();
   void UpdateDSPSlice(int cycles);
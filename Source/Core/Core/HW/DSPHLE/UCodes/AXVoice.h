@@ -21,6 +21,7 @@
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceKernels.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
@@ -44,6 +45,9 @@ inline namespace AXWii
 {
 namespace
 {
+// The AX unit tests include this file too, without using everything in it, hence the
+// [[maybe_unused]]s.
+
 // Useful macro to convert xxx_hi + xxx_lo to xxx for 32 bits.
 #define HILO_TO_32(name) ((u32(name##_hi) << 16) | name##_lo)
 
@@ -100,7 +104,7 @@ bool HasLpf(u32 crc)
 }
 
 // Read a PB from MRAM/ARAM
-void ReadPB(Memory::MemoryManager& memory, u32 addr, PB_TYPE& pb, u32 crc)
+[[maybe_unused]] void ReadPB(Memory::MemoryManager& memory, u32 addr, PB_TYPE& pb, u32 crc)
 {
   if (HasLpf(crc))
   {
@@ -124,7 +128,7 @@ void ReadPB(Memory::MemoryManager& memory, u32 addr, PB_TYPE& pb, u32 crc)
 }
 
 // Write a PB back to MRAM/ARAM
-void WritePB(Memory::MemoryManager& memory, u32 addr, const PB_TYPE& pb, u32 crc)
+[[maybe_unused]] void WritePB(Memory::MemoryManager& memory, u32 addr, const PB_TYPE& pb, u32 crc)
 {
   if (HasLpf(crc))
   {
@@ -242,6 +246,7 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
                   u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
 {
   int read_samples_count = 0;
+  AXKernels::ResampleWindows windows;
 
   // If DSP DROM coefficients are available, support polyphase resampling.
   if (coeffs && srctype == SRCTYPE_POLYPHASE)
@@ -266,16 +271,16 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
       u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
       const s16* c = &coeffs[curr_pos_frac];
 
-      s64 t0 = temp[idx++ & 3];
-      s64 t1 = temp[idx++ & 3];
-      s64 t2 = temp[idx++ & 3];
-      s64 t3 = temp[idx++ & 3];
-
-      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
-
-      output[i] = MathUtil::SaturatingCast<s16>(samp);
+      // Only gather the inputs here, the filter is applied to all samples at once below.
+      for (u32 tap = 0; tap < 4; ++tap)
+      {
+        windows.taps[tap][i] = temp[idx++ & 3];
+        windows.coefs[tap][i] = c[tap];
+      }
     }
 
+    AXKernels::InterpolatePolyphase(output, windows, count);
+
     last_samples[3] = temp[--idx & 3];
     last_samples[2] = temp[--idx & 3];
     last_samples[1] = temp[--idx & 3];
@@ -307,30 +312,15 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
       }
 
       // Get our current fractional position, used to know how much of
-      // curr0 and how much of curr1 the output sample should be.
-      u16 curr_frac = curr_pos & 0xFFFF;
-      u16 inv_curr_frac = -curr_frac;
-
-      // Interpolate! If curr_frac is 0, we can simply take the last
-      // sample without any multiplying.
-      s16 sample;
-      if (curr_frac)
-      {
-        s32 s0 = temp[idx++ & 3];
-        s32 s1 = temp[idx++ & 3];
-
-        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
-        idx += 2;
-      }
-      else
-      {
-        sample = temp[idx++ & 3];
-        idx += 3;
-      }
-
-      output[i] = sample;
+      // curr0 and how much of curr1 the output sample should be. The
+      // interpolation itself is done for all samples at once below.
+      windows.frac[i] = curr_pos & 0xFFFF;
+      windows.taps[0][i] = temp[idx & 3];
+      windows.taps[1][i] = temp[(idx + 1) & 3];
     }
 
+    AXKernels::InterpolateLinear(output, windows, count);
+
     // Update the four last_samples values.
     last_samples[3] = temp[--idx & 3];
     last_samples[2] = temp[--idx & 3];
@@ -375,7 +365,6 @@ void GetInputSamples(HLEAccelerator* accelerator, PB_TYPE& pb, s16* samples, u16
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
 {
-  u16& volume = vd->volume;
   u16 volume_delta = vd->volume_delta;
 
   // If volume ramping is disabled, set volume_delta to 0. That way, the
@@ -384,18 +373,8 @@ void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bo
   if (!ramp)
     volume_delta = 0;
 
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
-
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
+  if (count != 0)
+    *dpop = AXKernels::MixAdd(out, input, count, &vd->volume, volume_delta);
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -409,8 +388,9 @@ s16 LowPassFilter(s16* samples, u32 count, s16 yn1, u16 a0, u16 b0)
 
 // Process 1ms of audio (for AX GC) or 3ms of audio (for AX Wii) from a PB and
 // mix it to the output buffers.
-void ProcessVoice(HLEAccelerator* accelerator, PB_TYPE& pb, const AXBuffers& buffers, u16 count,
-                  AXMixControl mctrl, const s16* coeffs)
+[[maybe_unused]] void ProcessVoice(HLEAccelerator* accelerator, PB_TYPE& pb,
+                                   const AXBuffers& buffers, u16 count, AXMixControl mctrl,
+                                   const s16* coeffs)
 {
   // If the voice is not running, nothing to do.
   if (pb.running != 1)
@@ -421,19 +401,15 @@ void ProcessVoice(HLEAccelerator* accelerator, PB_TYPE& pb, const AXBuffers& buf
   GetInputSamples(accelerator, pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
 #ifdef AX_GC
-    // signed on GameCube
-    const s32 volume = (s16)pb.vol_env.cur_volume;
+  // signed on GameCube
+  constexpr bool signed_volume = true;
 #else
-    // unsigned on Wii
-    const s32 volume = (u16)pb.vol_env.cur_volume;
+  // unsigned on Wii
+  constexpr bool signed_volume = false;
 #endif
-    const s32 sample = ((s32)samples[i] * volume) >> 15;
-    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  pb.vol_env.cur_volume = static_cast<s16>(AXKernels::ApplyVolumeEnvelope(
+      samples, count, pb.vol_env.cur_volume, pb.vol_env.cur_volume_delta, signed_volume));
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
@@ -0,0 +1,211 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXVoiceKernels.h"
+
+#include <algorithm>
+
+#include "Common/CPUDetect.h"
+#include "Common/Inline.h"
+#include "Common/MathUtil.h"
+
+#if defined(_M_X86_64)
+#define USE_SSE2
+#include <immintrin.h>
+#elif defined(_M_ARM_64)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
+namespace DSP::HLE::AXKernels
+{
+#ifdef USE_SSE2
+#include "Core/HW/DSPHLE/UCodes/AXVoiceKernelsImpl.h"
+#define USE_AVX2
+#include "Core/HW/DSPHLE/UCodes/AXVoiceKernelsImpl.h"
+
+// Every x64 CPU has SSE2, so only AVX2 needs to be checked for. This is checked at runtime even in
+// builds that require AVX2, so that the tests can run the SSE2 versions too.
+#define DISPATCH(function, ...)                                                                    \
+  (cpu_info.bAVX2 ? AXKernels_AVX2::function(__VA_ARGS__) : AXKernels_SSE2::function(__VA_ARGS__))
+#endif
+
+#ifdef USE_NEON
+namespace AXKernels_NEON
+{
+// Both the samples and the volumes fit in 16 bits, so the products fit in 32 bits.
+static int32x4_t ScaleSamples(int16x4_t samples, int32x4_t volumes)
+{
+  const int32x4_t scaled = vshrq_n_s32(vmulq_s32(vmovl_s16(samples), volumes), 15);
+  return vmaxq_s32(vminq_s32(scaled, vdupq_n_s32(32767)), vdupq_n_s32(-32767));
+}
+
+static int32x4_t RampVolumes(u16 volume, u16 volume_delta, bool signed_volume)
+{
+  const uint16x4_t steps = {0, 1, 2, 3};
+  const uint16x4_t volumes = vmla_u16(vdup_n_u16(volume), steps, vdup_n_u16(volume_delta));
+  if (signed_volume)
+    return vmovl_s16(vreinterpret_s16_u16(volumes));
+  return vreinterpretq_s32_u32(vmovl_u16(volumes));
+}
+
+static u32 ApplyVolumeEnvelope(s16* samples, u32 count, u16* volume, u16 volume_delta,
+                               bool signed_volume)
+{
+  const u32 vector_count = count - count % 4;
+  for (u32 i = 0; i < vector_count; i += 4)
+  {
+    const int32x4_t volumes = RampVolumes(*volume, volume_delta, signed_volume);
+    vst1_s16(samples + i, vmovn_s32(ScaleSamples(vld1_s16(samples + i), volumes)));
+    *volume = static_cast<u16>(*volume + 4 * volume_delta);
+  }
+  return vector_count;
+}
+
+static u32 MixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta)
+{
+  const u32 vector_count = count - count % 4;
+  for (u32 i = 0; i < vector_count; i += 4)
+  {
+    const int32x4_t volumes = RampVolumes(*volume, volume_delta, false);
+    const int32x4_t scaled = ScaleSamples(vld1_s16(input + i), volumes);
+    vst1q_s32(out + i, vaddq_s32(vld1q_s32(out + i), scaled));
+    *volume = static_cast<u16>(*volume + 4 * volume_delta);
+  }
+  return vector_count;
+}
+
+static u32 InterpolateLinear(s16* out, const ResampleWindows& windows, u32 count)
+{
+  const u32 vector_count = count - count % 4;
+  for (u32 i = 0; i < vector_count; i += 4)
+  {
+    const int16x4_t s0 = vld1_s16(windows.taps[0] + i);
+    const int16x4_t s1 = vld1_s16(windows.taps[1] + i);
+    const uint16x4_t frac = vld1_u16(windows.frac + i);
+    const uint16x4_t inv_frac = vsub_u16(vdup_n_u16(0), frac);
+
+    const int32x4_t sum =
+        vaddq_s32(vmulq_s32(vmovl_s16(s0), vreinterpretq_s32_u32(vmovl_u16(inv_frac))),
+                  vmulq_s32(vmovl_s16(s1), vreinterpretq_s32_u32(vmovl_u16(frac))));
+    const int16x4_t interpolated = vmovn_s32(vshrq_n_s32(sum, 16));
+
+    // A fractional position of 0 takes the oldest sample as it is
+    vst1_s16(out + i, vbsl_s16(vceq_u16(frac, vdup_n_u16(0)), s0, interpolated));
+  }
+  return vector_count;
+}
+
+static u32 InterpolatePolyphase(s16* out, const ResampleWindows& windows, u32 count)
+{
+  const u32 vector_count = count - count % 4;
+  for (u32 i = 0; i < vector_count; i += 4)
+  {
+    // See the x86 version for why the products are shifted separately
+    int32x4_t whole = vdupq_n_s32(0);
+    int32x4_t fraction = vdupq_n_s32(0);
+    for (u32 tap = 0; tap < 4; ++tap)
+    {
+      const int32x4_t p =
+          vmull_s16(vld1_s16(windows.taps[tap] + i), vld1_s16(windows.coefs[tap] + i));
+      whole = vaddq_s32(whole, vshrq_n_s32(p, 15));
+      fraction = vaddq_s32(fraction, vandq_s32(p, vdupq_n_s32(0x7FFF)));
+    }
+    vst1_s16(out + i, vqmovn_s32(vaddq_s32(whole, vshrq_n_s32(fraction, 15))));
+  }
+  return vector_count;
+}
+}  // namespace AXKernels_NEON
+
+#define DISPATCH(function, ...) AXKernels_NEON::function(__VA_ARGS__)
+#endif
+
+static s16 ScaleSample(s16 sample, s32 volume)
+{
+  return static_cast<s16>(std::clamp((s32(sample) * volume) >> 15, -32767, 32767));
+}
+
+u16 ApplyVolumeEnvelope(s16* samples, u32 count, u16 volume, u16 volume_delta,
+                        bool signed_volume)
+{
+  u32 i = 0;
+#if defined(USE_SSE2)
+  if (signed_volume)
+    i = DISPATCH(ApplyVolumeEnvelope<true>, samples, count, &volume, volume_delta);
+  else
+    i = DISPATCH(ApplyVolumeEnvelope<false>, samples, count, &volume, volume_delta);
+#elif defined(USE_NEON)
+  i = DISPATCH(ApplyVolumeEnvelope, samples, count, &volume, volume_delta, signed_volume);
+#endif
+
+  for (; i < count; ++i)
+  {
+    samples[i] = ScaleSample(samples[i], signed_volume ? static_cast<s16>(volume) : volume);
+    volume += volume_delta;
+  }
+  return volume;
+}
+
+s16 MixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta)
+{
+  if (count == 0)
+    return 0;
+
+  u32 i = 0;
+#ifdef DISPATCH
+  // Leave at least one sample for the scalar loop, which gives us the last sample
+  i = DISPATCH(MixAdd, out, input, count - 1, volume, volume_delta);
+#endif
+
+  s16 sample = 0;
+  for (; i < count; ++i)
+  {
+    sample = ScaleSample(input[i], *volume);
+    out[i] += sample;
+    *volume += volume_delta;
+  }
+  return sample;
+}
+
+void InterpolateLinear(s16* out, const ResampleWindows& windows, u32 count)
+{
+  u32 i = 0;
+#ifdef DISPATCH
+  i = DISPATCH(InterpolateLinear, out, windows, count);
+#endif
+
+  for (; i < count; ++i)
+  {
+    const u16 frac = windows.frac[i];
+    const u16 inv_frac = -frac;
+    if (frac)
+    {
+      const s32 s0 = windows.taps[0][i];
+      const s32 s1 = windows.taps[1][i];
+      out[i] = static_cast<s16>(((s0 * inv_frac) + (s1 * frac)) >> 16);
+    }
+    else
+    {
+      out[i] = windows.taps[0][i];
+    }
+  }
+}
+
+void InterpolatePolyphase(s16* out, const ResampleWindows& windows, u32 count)
+{
+  u32 i = 0;
+#ifdef DISPATCH
+  i = DISPATCH(InterpolatePolyphase, out, windows, count);
+#endif
+
+  for (; i < count; ++i)
+  {
+    s64 sample = 0;
+    for (u32 tap = 0; tap < 4; ++tap)
+      sample += s64(windows.taps[tap][i]) * windows.coefs[tap][i];
+    out[i] = MathUtil::SaturatingCast<s16>(sample >> 15);
+  }
+}
+
+#undef DISPATCH
+}  // namespace DSP::HLE::AXKernels
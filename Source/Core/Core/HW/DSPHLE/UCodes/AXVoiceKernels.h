@@ -0,0 +1,40 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Per-sample loops of the AX voice processing, shared by AX GC and AX Wii. These have vectorized
+// implementations for the host CPU, which produce exactly the same output as the scalar ones,
+// since the result of mixing must not depend on the host for netplay and movies.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace DSP::HLE::AXKernels
+{
+// The most samples that AX processes for a voice at once (3 ms for AX Wii)
+constexpr u32 MAX_SAMPLE_COUNT = 96;
+
+// The input samples that each output sample of a resampler is interpolated from, oldest first.
+// Filled in by the resampler, which has to fetch input samples one at a time.
+struct ResampleWindows
+{
+  s16 taps[4][MAX_SAMPLE_COUNT];
+  // Polyphase filter coefficients, one for each tap
+  s16 coefs[4][MAX_SAMPLE_COUNT];
+  // Fractional position between the two oldest taps, for linear interpolation
+  u16 frac[MAX_SAMPLE_COUNT];
+};
+
+// Scales samples by the voice's volume envelope, which changes by volume_delta after every sample.
+// The volume is signed on AX GC and unsigned on AX Wii. Returns the volume after the last sample.
+u16 ApplyVolumeEnvelope(s16* samples, u32 count, u16 volume, u16 volume_delta,
+                        bool signed_volume);
+
+// Adds samples scaled by a volume to an output buffer. The volume changes by volume_delta after
+// every sample and is updated to the volume after the last sample. Returns the last scaled
+// sample, which AX keeps for depopping, or 0 if count is 0.
+s16 MixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta);
+
+void InterpolateLinear(s16* out, const ResampleWindows& windows, u32 count);
+void InterpolatePolyphase(s16* out, const ResampleWindows& windows, u32 count);
+}  // namespace DSP::HLE::AXKernels
@@ -0,0 +1,190 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Included by AXVoiceKernels.cpp once for every x86 instruction set it has implementations for.
+// The SSE2 and AVX2 versions only differ in vector width, so they share this code.
+
+#if defined(USE_AVX2)
+#define VECTOR_NAMESPACE AXKernels_AVX2
+#define V(op) _mm256_##op
+#define VSUFFIX(op) _mm256_##op##_si256
+#define VLOAD(ptr) _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr))
+#define VSTORE(ptr, value) _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value)
+// Moves 64-bit elements 1 and 2 past each other, so that unpacking afterwards keeps the elements
+// in order despite working on each 128-bit half separately
+#define VINTERLEAVE_HALVES(value) _mm256_permute4x64_epi64(value, 0xD8)
+#elif defined(USE_SSE2)
+#define VECTOR_NAMESPACE AXKernels_SSE2
+#define V(op) _mm_##op
+#define VSUFFIX(op) _mm_##op##_si128
+#define VLOAD(ptr) _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr))
+#define VSTORE(ptr, value) _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), value)
+#define VINTERLEAVE_HALVES(value) (value)
+#else
+#error This file is meant to be used by AXVoiceKernels.cpp only!
+#endif
+
+#if defined(__GNUC__) && defined(USE_AVX2) && !defined(__AVX2__)
+#define ATTR_TARGET __attribute__((target("avx2")))
+#else
+#define ATTR_TARGET
+#endif
+
+namespace VECTOR_NAMESPACE
+{
+#if defined(USE_AVX2)
+using Vector = __m256i;
+#else
+using Vector = __m128i;
+#endif
+
+// Number of 16-bit elements in a vector
+constexpr u32 LANES = sizeof(Vector) / sizeof(s16);
+
+struct Products
+{
+  // Elements 0-3 and 4-7 of each 128-bit half
+  Vector low;
+  Vector high;
+};
+
+// Exact 32-bit products of signed 16-bit samples and signed or unsigned 16-bit factors.
+template <bool SignedFactors>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Products Multiply(Vector samples, Vector factors)
+{
+  const Vector low_bits = V(mullo_epi16)(samples, factors);
+  Vector high_bits = V(mulhi_epi16)(samples, factors);
+  if constexpr (!SignedFactors)
+  {
+    // mulhi_epi16 treats factors of 0x8000 and up as negative, which makes the product
+    // smaller by sample << 16
+    high_bits = V(add_epi16)(high_bits, VSUFFIX(and)(samples, V(srai_epi16)(factors, 15)));
+  }
+  return {V(unpacklo_epi16)(low_bits, high_bits), V(unpackhi_epi16)(low_bits, high_bits)};
+}
+
+// (sample * volume) >> 15, clamped to +/-32767
+template <bool SignedVolume>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector ScaleSamples(Vector samples, Vector volumes)
+{
+  const Products products = Multiply<SignedVolume>(samples, volumes);
+  const Vector packed = V(packs_epi32)(V(srai_epi32)(products.low, 15),
+                                       V(srai_epi32)(products.high, 15));
+  return V(max_epi16)(packed, V(set1_epi16)(-32767));
+}
+
+// The volume for each element of a vector, followed by the step to the next vector.
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector RampVolumes(u16 volume, u16 volume_delta,
+                                                           Vector* step)
+{
+  alignas(sizeof(Vector)) u16 volumes[LANES];
+  for (u32 i = 0; i < LANES; ++i)
+    volumes[i] = static_cast<u16>(volume + i * volume_delta);
+  *step = V(set1_epi16)(static_cast<s16>(LANES * volume_delta));
+  return VLOAD(volumes);
+}
+
+template <bool SignedVolume>
+ATTR_TARGET static u32 ApplyVolumeEnvelope(s16* samples, u32 count, u16* volume, u16 volume_delta)
+{
+  const u32 vector_count = count - count % LANES;
+  if (vector_count == 0)
+    return 0;
+
+  Vector step;
+  Vector volumes = RampVolumes(*volume, volume_delta, &step);
+  for (u32 i = 0; i < vector_count; i += LANES)
+  {
+    VSTORE(samples + i, ScaleSamples<SignedVolume>(VLOAD(samples + i), volumes));
+    volumes = V(add_epi16)(volumes, step);
+  }
+
+  *volume = static_cast<u16>(*volume + vector_count * volume_delta);
+  return vector_count;
+}
+
+ATTR_TARGET static u32 MixAdd(int* out, const s16* input, u32 count, u16* volume,
+                              u16 volume_delta)
+{
+  const u32 vector_count = count - count % LANES;
+  if (vector_count == 0)
+    return 0;
+
+  Vector step;
+  Vector volumes = RampVolumes(*volume, volume_delta, &step);
+  for (u32 i = 0; i < vector_count; i += LANES)
+  {
+    const Vector scaled = VINTERLEAVE_HALVES(ScaleSamples<false>(VLOAD(input + i), volumes));
+    // Sign extend to 32 bits
+    const Vector low = V(srai_epi32)(V(unpacklo_epi16)(scaled, scaled), 16);
+    const Vector high = V(srai_epi32)(V(unpackhi_epi16)(scaled, scaled), 16);
+    VSTORE(out + i, V(add_epi32)(VLOAD(out + i), low));
+    VSTORE(out + i + LANES / 2, V(add_epi32)(VLOAD(out + i + LANES / 2), high));
+    volumes = V(add_epi16)(volumes, step);
+  }
+
+  *volume = static_cast<u16>(*volume + vector_count * volume_delta);
+  return vector_count;
+}
+
+ATTR_TARGET static u32 InterpolateLinear(s16* out, const ResampleWindows& windows, u32 count)
+{
+  const u32 vector_count = count - count % LANES;
+  const Vector zero = VSUFFIX(setzero)();
+  for (u32 i = 0; i < vector_count; i += LANES)
+  {
+    const Vector s0 = VLOAD(windows.taps[0] + i);
+    const Vector s1 = VLOAD(windows.taps[1] + i);
+    const Vector frac = VLOAD(windows.frac + i);
+    const Vector inv_frac = V(sub_epi16)(zero, frac);
+
+    const Products p0 = Multiply<false>(s0, inv_frac);
+    const Products p1 = Multiply<false>(s1, frac);
+    const Vector interpolated =
+        V(packs_epi32)(V(srai_epi32)(V(add_epi32)(p0.low, p1.low), 16),
+                       V(srai_epi32)(V(add_epi32)(p0.high, p1.high), 16));
+
+    // A fractional position of 0 takes the oldest sample as it is
+    const Vector on_sample = V(cmpeq_epi16)(frac, zero);
+    VSTORE(out + i,
+           VSUFFIX(or)(VSUFFIX(and)(on_sample, s0), VSUFFIX(andnot)(on_sample, interpolated)));
+  }
+  return vector_count;
+}
+
+ATTR_TARGET static u32 InterpolatePolyphase(s16* out, const ResampleWindows& windows, u32 count)
+{
+  const u32 vector_count = count - count % LANES;
+  const Vector fraction_mask = V(set1_epi32)(0x7FFF);
+  for (u32 i = 0; i < vector_count; i += LANES)
+  {
+    // The sum of the four products can take up to 34 bits. Shifting each product before adding
+    // them up, and then adding the carry from the sum of their fractional parts, gives the same
+    // result as shifting the sum without needing 64-bit elements.
+    Products whole = {};
+    Products fraction = {};
+    for (u32 tap = 0; tap < 4; ++tap)
+    {
+      const Products p =
+          Multiply<true>(VLOAD(windows.taps[tap] + i), VLOAD(windows.coefs[tap] + i));
+      whole.low = V(add_epi32)(whole.low, V(srai_epi32)(p.low, 15));
+      whole.high = V(add_epi32)(whole.high, V(srai_epi32)(p.high, 15));
+      fraction.low = V(add_epi32)(fraction.low, VSUFFIX(and)(p.low, fraction_mask));
+      fraction.high = V(add_epi32)(fraction.high, VSUFFIX(and)(p.high, fraction_mask));
+    }
+
+    const Vector low = V(add_epi32)(whole.low, V(srai_epi32)(fraction.low, 15));
+    const Vector high = V(add_epi32)(whole.high, V(srai_epi32)(fraction.high, 15));
+    VSTORE(out + i, V(packs_epi32)(low, high));
+  }
+  return vector_count;
+}
+}  // namespace VECTOR_NAMESPACE
+
+#undef ATTR_TARGET
+#undef VINTERLEAVE_HALVES
+#undef VSTORE
+#undef VLOAD
+#undef VSUFFIX
+#undef V
+#undef VECTOR_NAMESPACE
@@ -0,0 +1,274 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/DVDPrefetcher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+#include "Common/Thread.h"
+
+#include "DiscIO/Blob.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeDisc.h"
+
+namespace DVD
+{
+// Two workers are enough to keep a compressed image ahead of the emulated drive, which only
+// transfers a few MiB per second.
+constexpr size_t WORKER_COUNT = 2;
+constexpr size_t MAX_BLOCKS = 48;
+
+// Sequential read-ahead distance in blocks. It starts small so that short reads of small files
+// don't cause much wasted work, and doubles while the sequence continues.
+constexpr u32 MIN_SEQUENTIAL_DEPTH = 2;
+constexpr u32 MAX_SEQUENTIAL_DEPTH = 16;
+constexpr u32 MAX_STRIDED_DEPTH = 4;
+
+std::unique_ptr<DVDPrefetcher> DVDPrefetcher::Create(const DiscIO::Volume& disc)
+{
+  std::vector<std::unique_ptr<DiscIO::Volume>> worker_discs;
+  for (size_t i = 0; i < WORKER_COUNT; i++)
+  {
+    std::unique_ptr<DiscIO::BlobReader> reader = disc.GetBlobReader().CopyReader();
+    if (!reader)
+      return nullptr;
+
+    std::unique_ptr<DiscIO::Volume> copy = DiscIO::CreateDisc(std::move(reader));
+    if (!copy)
+      return nullptr;
+
+    worker_discs.push_back(std::move(copy));
+  }
+
+  return std::unique_ptr<DVDPrefetcher>(new DVDPrefetcher(std::move(worker_discs)));
+}
+
+DVDPrefetcher::DVDPrefetcher(std::vector<std::unique_ptr<DiscIO::Volume>> worker_discs)
+    : m_worker_discs(std::move(worker_discs))
+{
+  for (const std::unique_ptr<DiscIO::Volume>& disc : m_worker_discs)
+    m_workers.emplace_back([this, &disc] { WorkerMain(*disc); });
+}
+
+DVDPrefetcher::~DVDPrefetcher()
+{
+  {
+    std::lock_guard lock(m_mutex);
+    m_exiting = true;
+  }
+  m_work_available.notify_all();
+
+  for (std::thread& worker : m_workers)
+    worker.join();
+}
+
+bool DVDPrefetcher::Read(const DiscIO::Volume& disc, u64 offset, u32 length, u8* buffer,
+                         const DiscIO::Partition& partition)
+{
+  // Queue the next blocks first, so that the workers can get started on them while we're busy.
+  LearnAccess(offset, length, partition);
+
+  const u64 end = offset + length;
+  bool success = true;
+
+  // Consecutive missed blocks are read from the disc with a single call.
+  u64 miss_start = end;
+  const auto read_misses = [&](u64 miss_end) {
+    if (miss_start == end)
+      return;
+    success &= disc.Read(miss_start, miss_end - miss_start, buffer + (miss_start - offset),
+                         partition);
+    miss_start = end;
+  };
+
+  for (u64 position = offset; position < end;)
+  {
+    const BlockKey key{partition.offset, position / BLOCK_SIZE};
+    const u64 block_end = std::min(end, (key.block + 1) * BLOCK_SIZE);
+
+    if (ReadFromBlock(key, position, block_end - position, buffer + (position - offset)))
+      read_misses(position);
+    else if (miss_start == end)
+      miss_start = position;
+
+    position = block_end;
+  }
+  read_misses(end);
+
+  return success;
+}
+
+DVDPrefetcher::Statistics DVDPrefetcher::GetStatistics() const
+{
+  std::lock_guard lock(m_mutex);
+  return m_statistics;
+}
+
+void DVDPrefetcher::WorkerMain(const DiscIO::Volume& disc)
+{
+  Common::SetCurrentThreadName("DVD prefetch thread");
+
+  std::unique_lock lock(m_mutex);
+  while (true)
+  {
+    m_work_available.wait(lock, [this] { return m_exiting || !m_queue.empty(); });
+    if (m_exiting)
+      return;
+
+    const BlockKey key = m_queue.front();
+    m_queue.pop_front();
+
+    // The DVD thread may have read the block by itself in the meantime.
+    const auto it = m_blocks.find(key);
+    if (it == m_blocks.end() || it->second.state != BlockState::Queued)
+      continue;
+
+    // Blocks that are loading are never erased, so the iterator stays valid while unlocked.
+    it->second.state = BlockState::Loading;
+    lock.unlock();
+
+    std::vector<u8> data(BLOCK_SIZE);
+    const DiscIO::Partition partition(key.partition);
+    const bool success = disc.Read(key.block * BLOCK_SIZE, BLOCK_SIZE, data.data(), partition);
+
+    lock.lock();
+    if (success)
+    {
+      it->second.state = BlockState::Ready;
+      it->second.data = std::move(data);
+      m_statistics.prefetched_blocks++;
+    }
+    else
+    {
+      // Usually the last block of the disc or partition, which the DVD thread reads by itself.
+      it->second.state = BlockState::Failed;
+    }
+    m_block_done.notify_all();
+  }
+}
+
+void DVDPrefetcher::LearnAccess(u64 offset, u32 length, const DiscIO::Partition& partition)
+{
+  const bool same_partition = partition.offset == m_last_partition;
+  const s64 delta = static_cast<s64>(offset - m_last_offset);
+
+  if (same_partition && offset == m_last_end)
+  {
+    m_depth = std::clamp(m_depth * 2, MIN_SEQUENTIAL_DEPTH, MAX_SEQUENTIAL_DEPTH);
+    QueueRange(offset + length, m_depth * BLOCK_SIZE, partition.offset);
+  }
+  else if (same_partition && m_stride != 0 && delta == m_stride)
+  {
+    m_depth = std::min(m_depth + 1, MAX_STRIDED_DEPTH);
+    for (u32 i = 1; i <= m_depth; i++)
+    {
+      const s64 next_offset = static_cast<s64>(offset) + m_stride * i;
+      if (next_offset < 0)
+        break;
+      QueueRange(static_cast<u64>(next_offset), length, partition.offset);
+    }
+  }
+  else
+  {
+    m_depth = 0;
+  }
+
+  m_stride = same_partition ? delta : 0;
+  m_last_partition = partition.offset;
+  m_last_offset = offset;
+  m_last_end = offset + length;
+}
+
+void DVDPrefetcher::QueueRange(u64 offset, u64 length, u64 partition)
+{
+  if (length == 0)
+    return;
+
+  {
+    std::lock_guard lock(m_mutex);
+    const u64 last_block = (offset + length - 1) / BLOCK_SIZE;
+    for (u64 block = offset / BLOCK_SIZE; block <= last_block; block++)
+    {
+      if (!QueueBlock({partition, block}))
+        break;
+    }
+  }
+  m_work_available.notify_all();
+}
+
+bool DVDPrefetcher::QueueBlock(const BlockKey& key)
+{
+  if (m_blocks.contains(key))
+    return true;
+
+  if (m_blocks.size() >= MAX_BLOCKS && !EvictBlock())
+    return false;
+
+  Block& block = m_blocks[key];
+  block.last_use = ++m_use_counter;
+  m_queue.push_back(key);
+  return true;
+}
+
+bool DVDPrefetcher::EvictBlock()
+{
+  // Blocks that have been read already go first, and prefetched blocks that are still waiting
+  // to be used go last. Within each group, the least recently used block goes first.
+  const auto priority = [](const Block& block) {
+    const bool waiting = block.state == BlockState::Ready && !block.used;
+    return std::make_tuple(waiting, block.last_use);
+  };
+
+  auto victim = m_blocks.end();
+  for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+  {
+    const BlockState state = it->second.state;
+    if (state != BlockState::Ready && state != BlockState::Failed)
+      continue;
+    if (victim == m_blocks.end() || priority(it->second) < priority(victim->second))
+      victim = it;
+  }
+
+  if (victim == m_blocks.end())
+    return false;
+
+  if (victim->second.state == BlockState::Ready && !victim->second.used)
+    m_statistics.unused_blocks++;
+  m_blocks.erase(victim);
+  return true;
+}
+
+bool DVDPrefetcher::ReadFromBlock(const BlockKey& key, u64 offset, u64 length, u8* buffer)
+{
+  std::unique_lock lock(m_mutex);
+
+  const auto it = m_blocks.find(key);
+  if (it == m_blocks.end())
+  {
+    m_statistics.misses++;
+    return false;
+  }
+
+  // A worker is already decoding the block, so waiting for it is cheaper than doing it again.
+  m_block_done.wait(lock, [&] { return it->second.state != BlockState::Loading; });
+
+  Block& block = it->second;
+  if (block.state != BlockState::Ready)
+  {
+    // If no worker has picked the block up yet, it's faster to read it right away than to wait
+    // for the blocks queued in front of it.
+    m_blocks.erase(it);
+    m_statistics.misses++;
+    return false;
+  }
+
+  std::memcpy(buffer, block.data.data() + (offset - key.block * BLOCK_SIZE), length);
+  block.used = true;
+  block.last_use = ++m_use_counter;
+  m_statistics.hits++;
+  return true;
+}
+}  // namespace DVD
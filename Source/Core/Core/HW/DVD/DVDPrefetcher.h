@@ -0,0 +1,115 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <compare>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+struct Partition;
+class Volume;
+}  // namespace DiscIO
+
+namespace DVD
+{
+// Reads disc data ahead of the emulated drive, so that decompressing a cold chunk of a compressed
+// disc image doesn't happen while the DVD thread is waiting for it.
+//
+// The access pattern is learned from the reads the DVD thread performs. Sequential and constant
+// stride accesses cause the following blocks to be read on a small pool of worker threads. Each
+// worker reads from its own copy of the disc, since BlobReaders aren't thread-safe.
+class DVDPrefetcher
+{
+public:
+  struct Statistics
+  {
+    // Counted in blocks of BLOCK_SIZE bytes that reads were split into.
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 prefetched_blocks = 0;
+    u64 unused_blocks = 0;
+  };
+
+  static constexpr u64 BLOCK_SIZE = 0x20000;
+
+  // Returns nullptr if the disc can't be copied for the worker threads.
+  static std::unique_ptr<DVDPrefetcher> Create(const DiscIO::Volume& disc);
+
+  ~DVDPrefetcher();
+
+  DVDPrefetcher(const DVDPrefetcher&) = delete;
+  DVDPrefetcher& operator=(const DVDPrefetcher&) = delete;
+
+  // Must only be called from the DVD thread. Data which hasn't been prefetched is read from disc.
+  bool Read(const DiscIO::Volume& disc, u64 offset, u32 length, u8* buffer,
+            const DiscIO::Partition& partition);
+
+  Statistics GetStatistics() const;
+
+private:
+  enum class BlockState
+  {
+    Queued,
+    Loading,
+    Ready,
+    Failed,
+  };
+
+  struct BlockKey
+  {
+    u64 partition;
+    u64 block;
+
+    auto operator<=>(const BlockKey&) const = default;
+  };
+
+  struct Block
+  {
+    BlockState state = BlockState::Queued;
+    bool used = false;
+    u64 last_use = 0;
+    std::vector<u8> data;
+  };
+
+  explicit DVDPrefetcher(std::vector<std::unique_ptr<DiscIO::Volume>> worker_discs);
+
+  void WorkerMain(const DiscIO::Volume& disc);
+
+  void LearnAccess(u64 offset, u32 length, const DiscIO::Partition& partition);
+  void QueueRange(u64 offset, u64 length, u64 partition);
+  bool QueueBlock(const BlockKey& key);
+  bool EvictBlock();
+
+  // Copies the part of the block which overlaps the read. Returns false on a miss.
+  bool ReadFromBlock(const BlockKey& key, u64 offset, u64 length, u8* buffer);
+
+  std::vector<std::unique_ptr<DiscIO::Volume>> m_worker_discs;
+  std::vector<std::thread> m_workers;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_block_done;
+  bool m_exiting = false;
+  std::deque<BlockKey> m_queue;
+  std::map<BlockKey, Block> m_blocks;
+  u64 m_use_counter = 0;
+  Statistics m_statistics;
+
+  // Only used by the DVD thread
+  u64 m_last_partition = 0;
+  u64 m_last_offset = 0;
+  u64 m_last_end = 0;
+  s64 m_stride = 0;
+  u32 m_depth = 0;
+};
+}  // namespace DVD
@@ -21,10 +21,12 @@
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/DVD/DVDInterface.h"
+#include "Core/HW/DVD/DVDPrefetcher.h"
 #include "Core/HW/DVD/FileMonitor.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
@@ -68,6 +70,7 @@ void DVDThread::StartDVDThread()
 void DVDThread::Stop()
 {
   StopDVDThread();
+  DestroyPrefetcher();
   m_disc.reset();
 }
 
@@ -131,7 +134,9 @@ void DVDThread::DoState(PointerWrap& p)
 void DVDThread::SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
+  DestroyPrefetcher();
   m_disc = std::move(disc);
+  CreatePrefetcher();
 }
 
 bool DVDThread::HasDisc() const
@@ -139,6 +144,44 @@ bool DVDThread::HasDisc() const
   return m_disc != nullptr;
 }
 
+void DVDThread::CreatePrefetcher()
+{
+  if (!m_disc || !Config::Get(Config::MAIN_DVD_READ_AHEAD))
+    return;
+
+  std::unique_ptr<DVDPrefetcher> prefetcher = DVDPrefetcher::Create(*m_disc);
+  if (!prefetcher)
+  {
+    WARN_LOG_FMT(DVDINTERFACE, "Disc read-ahead isn't supported for this disc");
+    return;
+  }
+
+  std::lock_guard lock(m_prefetcher_mutex);
+  m_prefetcher = std::move(prefetcher);
+}
+
+void DVDThread::DestroyPrefetcher()
+{
+  std::unique_ptr<DVDPrefetcher> prefetcher;
+  {
+    std::lock_guard lock(m_prefetcher_mutex);
+    prefetcher = std::move(m_prefetcher);
+  }
+  if (!prefetcher)
+    return;
+
+  const DVDPrefetcher::Statistics stats = prefetcher->GetStatistics();
+  INFO_LOG_FMT(DVDINTERFACE,
+               "Disc read-ahead: {} hits, {} misses, {} blocks prefetched, {} of them unused",
+               stats.hits, stats.misses, stats.prefetched_blocks, stats.unused_blocks);
+}
+
+DVDPrefetcher::Statistics DVDThread::GetPrefetchStatistics() const
+{
+  std::lock_guard lock(m_prefetcher_mutex);
+  return m_prefetcher ? m_prefetcher->GetStatistics() : DVDPrefetcher::Statistics{};
+}
+
 bool DVDThread::HasWiiHashes() const
 {
   // HasWiiHashes is thread-safe, so calling WaitUntilIdle isn't necessary.
@@ -345,7 +388,12 @@ void DVDThread::DVDThreadMain()
       m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
 
       std::vector<u8> buffer(request.length);
-      if (!m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+      const bool success =
+          m_prefetcher ? m_prefetcher->Read(*m_disc, request.dvd_offset, request.length,
+                                            buffer.data(), request.partition) :
+                         m_disc->Read(request.dvd_offset, request.length, buffer.data(),
+                                      request.partition);
+      if (!success)
         buffer.resize(0);
 
       request.realtime_done_us = Common::Timer::NowUs();
@@ -5,6 +5,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <utility>
@@ -16,6 +17,7 @@
 #include "Common/SPSCQueue.h"
 
 #include "Core/HW/DVD/DVDInterface.h"
+#include "Core/HW/DVD/DVDPrefetcher.h"
 #include "Core/HW/DVD/FileMonitor.h"
 
 #include "DiscIO/Volume.h"
@@ -67,6 +69,9 @@ public:
   void SetDisc(std::unique_ptr<DiscIO::Volume> disc);
   bool HasDisc() const;
 
+  // Returns empty statistics if read-ahead is disabled or there is no disc.
+  DVDPrefetcher::Statistics GetPrefetchStatistics() const;
+
   bool HasWiiHashes() const;
   DiscIO::Platform GetDiscType() const;
   u64 PartitionOffsetToRawOffset(u64 offset, const DiscIO::Partition& partition);
@@ -91,6 +96,9 @@ private:
   void StopDVDThread();
   void WaitUntilIdle();
 
+  void CreatePrefetcher();
+  void DestroyPrefetcher();
+
   void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                          const DiscIO::Partition& partition, DVD::ReplyType reply_type,
                          s64 ticks_until_completion);
@@ -140,6 +148,10 @@ private:
   std::map<u64, ReadResult> m_result_map;
 
   std::unique_ptr<DiscIO::Volume> m_disc;
+  // Only replaced while the DVD thread is idle. The mutex is for GetPrefetchStatistics, which may
+  // be called from any thread.
+  mutable std::mutex m_prefetcher_mutex;
+  std::unique_ptr<DVDPrefetcher> m_prefetcher;
 
   FileMonitor::FileLogger m_file_logger;
 
@@ -82,9 +82,9 @@ void Shutdown(Core::System& system)
   system.GetCoreTiming().Shutdown();
 }
 
-void DoState(Core::System& system, PointerWrap& p)
+void DoState(Core::System& system, PointerWrap& p, bool include_bulk_memory)
 {
-  system.GetMemory().DoState(p);
+  system.GetMemory().DoState(p, include_bulk_memory);
   p.DoMarker("Memory");
   system.GetMemoryInterface().DoState(p);
   p.DoMarker("MemoryInterface");
@@ -94,7 +94,7 @@ void DoState(Core::System& system, PointerWrap& p)
   p.DoMarker("SerialInterface");
   system.GetProcessorInterface().DoState(p);
   p.DoMarker("ProcessorInterface");
-  system.GetDSP().DoState(p);
+  system.GetDSP().DoState(p, include_bulk_memory);
   p.DoMarker("DSP");
   system.GetDVDInterface().DoState(p);
   p.DoMarker("DVDInterface");
@@ -117,4 +117,23 @@ void DoState(Core::System& system, PointerWrap& p)
 
   p.DoMarker("WIIHW");
 }
+
+std::vector<std::span<u8>> GetBulkMemoryRegions(Core::System& system)
+{
+  // This has to match what MemoryManager::DoState() and DSPManager::DoState() leave out.
+  auto& memory = system.GetMemory();
+  std::vector<std::span<u8>> regions;
+  regions.emplace_back(memory.GetRAM(), memory.GetRamSize());
+  regions.emplace_back(memory.GetL1Cache(), memory.GetL1CacheSize());
+  if (memory.GetFakeVMEM())
+    regions.emplace_back(memory.GetFakeVMEM(), memory.GetFakeVMemSize());
+  if (memory.GetEXRAM())
+    regions.emplace_back(memory.GetEXRAM(), memory.GetExRamSize());
+
+  auto& dsp = system.GetDSP();
+  if (!dsp.IsARAMWiiMode())
+    regions.emplace_back(dsp.GetARAMPtr(), dsp.GetARAMSize());
+
+  return regions;
+}
 }  // namespace HW
@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
 class PointerWrap;
 struct Sram;
 namespace Core
@@ -14,5 +19,11 @@ namespace HW
 {
 void Init(Core::System& system, const Sram* override_sram);
 void Shutdown(Core::System& system);
-void DoState(Core::System& system, PointerWrap& p);
+
+// If include_bulk_memory is false, the regions returned by GetBulkMemoryRegions() are left out of
+// the state. This is for callers that keep track of those separately, like DeltaSnapshotRing.
+void DoState(Core::System& system, PointerWrap& p, bool include_bulk_memory = true);
+
+// MEM1, MEM2, ARAM and the other large buffers that make up most of a savestate.
+std::vector<std::span<u8>> GetBulkMemoryRegions(Core::System& system);
 }  // namespace HW
@@ -96,7 +96,7 @@ public:
   void Shutdown();
   bool InitFastmemArena();
   void ShutdownFastmemArena();
-  void DoState(PointerWrap& p);
+  void DoState(PointerWrap& p, bool include_ram = true);
 
   void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
@@ -3,28 +3,51 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
 #include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
+#include <new>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
 
+#include "Common/Align.h"
+#include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
 
+static_assert(std::atomic<u32>::is_always_lock_free && std::atomic<u64>::is_always_lock_free,
+              "The shared memory is accessed from other processes");
+
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  const std::string socket_path = File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX);
+  if (!OpenSocket(socket_path))
     return;
+
+  m_binary = Config::Get(Config::MAIN_MEMORY_WATCHER_BINARY);
+  if (m_binary && !OpenSharedMemory(socket_path + ".shm"))
+    WARN_LOG_FMT(CORE, "MemoryWatcher: Failed to create shared memory, only using the socket");
+
   m_running = true;
 }
 
 MemoryWatcher::~MemoryWatcher()
 {
+  if (m_shared_memory)
+  {
+    munmap(m_shared_memory, m_shared_memory_size);
+    unlink(m_shared_memory_path.c_str());
+  }
+
   if (!m_running)
     return;
 
@@ -43,19 +66,36 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return !m_values.empty();
+  // The text protocol has always sent the changes sorted by line.
+  m_sorted_watches.resize(m_watches.size());
+  for (u32 i = 0; i < m_watches.size(); ++i)
+    m_sorted_watches[i] = i;
+  std::sort(m_sorted_watches.begin(), m_sorted_watches.end(),
+            [this](u32 a, u32 b) { return m_watches[a].line < m_watches[b].line; });
+
+  return !m_watches.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  if (std::any_of(m_watches.begin(), m_watches.end(),
+                  [&line](const Watch& watch) { return watch.line == line; }))
+  {
+    return;
+  }
+
+  Watch& watch = m_watches.emplace_back();
+  watch.line = line;
+  watch.first_offset = static_cast<u32>(m_offsets.size());
+  watch.value = 0;
 
   std::istringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    m_offsets.push_back(offset);
+
+  watch.offset_count = static_cast<u32>(m_offsets.size()) - watch.first_offset;
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,12 +107,49 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line)
+bool MemoryWatcher::OpenSharedMemory(const std::string& path)
+{
+  const u32 entry_count = static_cast<u32>(m_watches.size());
+  const u32 slot_size =
+      static_cast<u32>(Common::AlignUp(sizeof(SharedSlotHeader) + entry_count * sizeof(u32),
+                                       alignof(SharedSlotHeader)));
+  const size_t size = sizeof(SharedHeader) + size_t(SHARED_MEMORY_SLOT_COUNT) * slot_size;
+
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0)
+    return false;
+
+  void* mapping = MAP_FAILED;
+  if (ftruncate(fd, size) == 0)
+    mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    unlink(path.c_str());
+    return false;
+  }
+
+  m_shared_memory = static_cast<u8*>(mapping);
+  m_shared_memory_size = size;
+  m_shared_memory_path = path;
+
+  for (u32 i = 0; i < SHARED_MEMORY_SLOT_COUNT; ++i)
+    new (m_shared_memory + sizeof(SharedHeader) + i * slot_size) SharedSlotHeader{0, 0};
+
+  // Readers check the magic last, so only write it once everything else is in place.
+  auto* header = new (m_shared_memory) SharedHeader{
+      0, SHARED_MEMORY_VERSION, entry_count, SHARED_MEMORY_SLOT_COUNT, slot_size, 0, 0};
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = SHARED_MEMORY_MAGIC;
+  return true;
+}
+
+u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const Watch& watch) const
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 i = 0; i < watch.offset_count; ++i)
   {
-    value = PowerPC::MMU::HostRead_U32(guard, value + offset);
+    value = PowerPC::MMU::HostRead_U32(guard, value + m_offsets[watch.first_offset + i]);
     if (!PowerPC::MMU::HostIsRAMAddress(guard, value))
       break;
   }
@@ -84,29 +161,90 @@ std::string MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
   std::ostringstream message_stream;
   message_stream << std::hex;
 
-  for (auto& entry : m_values)
+  for (const u32 index : m_sorted_watches)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
-
-    u32 new_value = ChasePointer(guard, address);
-    if (new_value != current_value)
+    Watch& watch = m_watches[index];
+    const u32 new_value = ChasePointer(guard, watch);
+    if (new_value != watch.value)
     {
       // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      watch.value = new_value;
+      message_stream << watch.line << '\n' << new_value << '\n';
     }
   }
 
   return message_stream.str();
 }
 
+void MemoryWatcher::ComposeBinaryMessage(const Core::CPUThreadGuard& guard)
+{
+  m_binary_message.resize(sizeof(BinaryDeltaHeader));
+
+  u32 count = 0;
+  for (u32 i = 0; i < m_watches.size(); ++i)
+  {
+    Watch& watch = m_watches[i];
+    const u32 new_value = ChasePointer(guard, watch);
+    if (new_value == watch.value)
+      continue;
+
+    watch.value = new_value;
+    const BinaryDeltaEntry entry{i, new_value};
+    const size_t offset = m_binary_message.size();
+    m_binary_message.resize(offset + sizeof(entry));
+    std::memcpy(m_binary_message.data() + offset, &entry, sizeof(entry));
+    ++count;
+  }
+
+  const BinaryDeltaHeader header{BINARY_DELTA_MAGIC, m_frame, count};
+  std::memcpy(m_binary_message.data(), &header, sizeof(header));
+}
+
+void MemoryWatcher::PublishSharedMemory()
+{
+  auto* header = reinterpret_cast<SharedHeader*>(m_shared_memory);
+  const u64 published = header->published.load(std::memory_order_relaxed);
+  u8* slot = m_shared_memory + sizeof(SharedHeader) +
+             (published % SHARED_MEMORY_SLOT_COUNT) * header->slot_size;
+  auto* slot_header = reinterpret_cast<SharedSlotHeader*>(slot);
+
+  const u32 sequence = slot_header->sequence.load(std::memory_order_relaxed);
+  slot_header->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot_header->frame = m_frame;
+  u8* values = slot + sizeof(SharedSlotHeader);
+  for (const Watch& watch : m_watches)
+  {
+    std::memcpy(values, &watch.value, sizeof(u32));
+    values += sizeof(u32);
+  }
+
+  slot_header->sequence.store(sequence + 2, std::memory_order_release);
+  header->published.store(published + 1, std::memory_order_release);
+}
+
 void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
 {
   if (!m_running)
     return;
 
-  std::string message = ComposeMessages(guard);
-  sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
-         sizeof(m_addr));
+  ++m_frame;
+
+  if (!m_binary)
+  {
+    std::string message = ComposeMessages(guard);
+    sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
+           sizeof(m_addr));
+    return;
+  }
+
+  ComposeBinaryMessage(guard);
+  if (m_binary_message.size() == sizeof(BinaryDeltaHeader))
+    return;
+
+  if (m_shared_memory)
+    PublishSharedMemory();
+  sendto(m_fd, m_binary_message.data(), m_binary_message.size(), 0,
+         reinterpret_cast<sockaddr*>(&m_addr), sizeof(m_addr));
 }
@@ -5,7 +5,7 @@
 
 #include "Common/CommonTypes.h"
 
-#include <map>
+#include <atomic>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -24,28 +24,96 @@ class CPUThreadGuard;
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// With Core.MemoryWatcherBinary enabled, each datagram is instead a BinaryDeltaHeader followed by
+// a BinaryDeltaEntry for every value that changed, and nothing is sent for frames without changes.
+// Watches are identified by their index among the distinct lines of the input file. The current
+// values are additionally published to a shared memory file next to the socket (see SharedHeader),
+// which lets readers poll them without receiving every datagram.
 class MemoryWatcher final
 {
 public:
+  static constexpr u32 BINARY_DELTA_MAGIC = 0x3142574D;  // "MWB1"
+  static constexpr u32 SHARED_MEMORY_MAGIC = 0x3153574D;  // "MWS1"
+  static constexpr u32 SHARED_MEMORY_VERSION = 1;
+  static constexpr u32 SHARED_MEMORY_SLOT_COUNT = 8;
+
+  struct BinaryDeltaHeader
+  {
+    u32 magic;
+    u32 frame;
+    u32 count;
+  };
+
+  struct BinaryDeltaEntry
+  {
+    u32 index;
+    u32 value;
+  };
+
+  // The shared memory file starts with this header, followed by slot_count slots of slot_size
+  // bytes. Each slot is a SharedSlotHeader followed by entry_count u32 values, and the newest one
+  // is slot (published - 1) % slot_count.
+  struct SharedHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 slot_count;
+    u32 slot_size;
+    u32 reserved;
+    std::atomic<u64> published;
+  };
+
+  // The sequence is odd while the slot is being written. Readers have to copy the values and start
+  // over if the sequence was odd or changed in the meantime.
+  struct SharedSlotHeader
+  {
+    std::atomic<u32> sequence;
+    u32 frame;
+  };
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step(const Core::CPUThreadGuard& guard);
 
 private:
+  struct Watch
+  {
+    // Line as stored in the file
+    std::string line;
+    // Range of m_offsets to follow
+    u32 first_offset;
+    u32 offset_count;
+    u32 value;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenSharedMemory(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line);
+  u32 ChasePointer(const Core::CPUThreadGuard& guard, const Watch& watch) const;
   std::string ComposeMessages(const Core::CPUThreadGuard& guard);
+  void ComposeBinaryMessage(const Core::CPUThreadGuard& guard);
+  void PublishSharedMemory();
 
   bool m_running = false;
+  bool m_binary = false;
+  u32 m_frame = 0;
 
   int m_fd;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  // In the order of the input file
+  std::vector<Watch> m_watches;
+  std::vector<u32> m_offsets;
+  // Indices into m_watches, sorted by line
+  std::vector<u32> m_sorted_watches;
+
+  std::vector<u8> m_binary_message;
+
+  std::string m_shared_memory_path;
+  u8* m_shared_memory = nullptr;
+  size_t m_shared_memory_size = 0;
 };
@@ -83,9 +83,18 @@ namespace Movie
 using namespace WiimoteCommon;
 using namespace WiimoteEmu;
 
+// The last byte of the magic of chunked movies, instead of 0x1A
+constexpr u8 CHUNKED_MOVIE_MAGIC = 0x1B;
+
 static bool IsMovieHeader(const std::array<u8, 4>& magic)
 {
-  return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
+  return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' &&
+         (magic[3] == 0x1A || magic[3] == CHUNKED_MOVIE_MAGIC);
+}
+
+static bool IsChunkedMovie(const DTMHeader& header)
+{
+  return header.filetype[3] == CHUNKED_MOVIE_MAGIC;
 }
 
 static std::array<u8, 20> ConvertGitRevisionToBytes(const std::string& revision)
@@ -558,7 +567,7 @@ bool MovieManager::BeginRecordingInput(const ControllerTypeArray& controllers,
 
     m_play_mode = PlayMode::Recording;
     m_author = Config::Get(Config::MAIN_MOVIE_MOVIE_AUTHOR);
-    m_temp_input.clear();
+    m_input.Clear();
 
     m_current_byte = 0;
 
@@ -850,8 +859,9 @@ void MovieManager::RecordInput(const GCPadStatus* PadStatus, int controllerID)
 
   CheckPadStatus(PadStatus, controllerID);
 
-  m_temp_input.resize(m_current_byte + sizeof(ControllerState));
-  memcpy(&m_temp_input[m_current_byte], &m_pad_state, sizeof(ControllerState));
+  m_input.Truncate(m_current_byte);
+  m_input.Write(m_current_byte, reinterpret_cast<const u8*>(&m_pad_state),
+                sizeof(ControllerState), m_current_frame);
   m_current_byte += sizeof(ControllerState);
 }
 
@@ -876,9 +886,9 @@ void MovieManager::RecordWiimote(int wiimote, const u8* data, u8 size)
     return;
 
   InputUpdate();
-  m_temp_input.resize(m_current_byte + size + 1);
-  m_temp_input[m_current_byte++] = size;
-  memcpy(&m_temp_input[m_current_byte], data, size);
+  m_input.Truncate(m_current_byte);
+  m_input.Write(m_current_byte++, &size, 1, m_current_frame);
+  m_input.Write(m_current_byte, data, size, m_current_frame);
   m_current_byte += size;
 }
 
@@ -960,8 +970,13 @@ bool MovieManager::PlayInput(const std::string& movie_path,
 
   Core::UpdateWantDeterminism(m_system);
 
-  m_temp_input.resize(recording_file.GetSize() - 256);
-  recording_file.ReadBytes(m_temp_input.data(), m_temp_input.size());
+  InputLogFile input_file;
+  m_input.Clear();
+  if (!input_file.Open(&recording_file, IsChunkedMovie(m_temp_header)) ||
+      !m_input.CopyFrom(input_file, input_file.GetSize()))
+  {
+    PanicAlertFmtT("Failed to read the input of {0}. The movie will likely not sync!", movie_path);
+  }
   m_current_byte = 0;
   recording_file.Close();
 
@@ -1038,7 +1053,14 @@ void MovieManager::LoadInput(const std::string& movie_path)
   if (m_system.IsWii())
     ChangeWiiPads(true);
 
-  u64 totalSavedBytes = t_record.GetSize() - 256;
+  InputLogFile input_file;
+  if (!input_file.Open(&t_record, IsChunkedMovie(m_temp_header)))
+  {
+    PanicAlertFmtT("Savestate movie {0} is corrupted, movie recording stopping...", movie_path);
+    EndPlayInput(false);
+    return;
+  }
+  const u64 totalSavedBytes = input_file.GetSize();
 
   bool afterEnd = false;
   // This can only happen if the user manually deletes data from the dtm.
@@ -1051,42 +1073,41 @@ void MovieManager::LoadInput(const std::string& movie_path)
     afterEnd = true;
   }
 
-  if (!m_read_only || m_temp_input.empty())
+  if (!m_read_only || m_input.IsEmpty())
   {
     m_total_frames = m_temp_header.frameCount;
     m_total_lag_count = m_temp_header.lagCount;
     m_total_input_count = m_temp_header.inputCount;
     m_total_tick_count = m_tick_count_at_last_input = m_temp_header.tickCount;
 
-    m_temp_input.resize(static_cast<size_t>(totalSavedBytes));
-    t_record.ReadBytes(m_temp_input.data(), m_temp_input.size());
+    // Only the chunks that differ from the input we already have get read
+    m_input.Truncate(totalSavedBytes);
+    if (!m_input.CopyFrom(input_file, totalSavedBytes))
+      PanicAlertFmtT("Failed to read the input of {0}", movie_path);
   }
   else if (m_current_byte > 0)
   {
     if (m_current_byte > totalSavedBytes)
     {
     }
-    else if (m_current_byte > m_temp_input.size())
+    else if (m_current_byte > m_input.GetSize())
     {
       afterEnd = true;
       PanicAlertFmtT(
           "Warning: You loaded a save that's after the end of the current movie. (byte {0} "
           "> {1}) (input {2} > {3}). You should load another save before continuing, or load "
           "this state with read-only mode off.",
-          m_current_byte + 256, m_temp_input.size() + 256, m_current_input_count,
+          m_current_byte + 256, m_input.GetSize() + 256, m_current_input_count,
           m_total_input_count);
     }
-    else if (m_current_byte > 0 && !m_temp_input.empty())
+    else if (m_current_byte > 0 && !m_input.IsEmpty())
     {
       // verify identical from movie start to the save's current frame
-      std::vector<u8> movInput(m_current_byte);
-      t_record.ReadArray(movInput.data(), movInput.size());
-
-      const auto result = std::mismatch(movInput.begin(), movInput.end(), m_temp_input.begin());
+      const std::optional<u64> mismatch = m_input.FindMismatch(input_file, m_current_byte);
 
-      if (result.first != movInput.end())
+      if (mismatch)
       {
-        const ptrdiff_t mismatch_index = std::distance(movInput.begin(), result.first);
+        const u64 mismatch_index = *mismatch;
 
         // this is a "you did something wrong" alert for the user's benefit.
         // we'll try to say what's going on in excruciating detail, otherwise the user might not
@@ -1101,16 +1122,17 @@ void MovieManager::LoadInput(const std::string& movie_path)
                          "read-only mode off. Otherwise you'll probably get a desync.",
                          byte_offset, byte_offset);
 
-          std::copy(movInput.begin(), movInput.end(), m_temp_input.begin());
+          m_input.CopyFrom(input_file, m_current_byte);
         }
         else
         {
-          const ptrdiff_t frame = mismatch_index / sizeof(ControllerState);
-          ControllerState curPadState;
-          memcpy(&curPadState, &m_temp_input[frame * sizeof(ControllerState)],
-                 sizeof(ControllerState));
-          ControllerState movPadState;
-          memcpy(&movPadState, &movInput[frame * sizeof(ControllerState)], sizeof(ControllerState));
+          const u64 frame = mismatch_index / sizeof(ControllerState);
+          ControllerState curPadState{};
+          m_input.Read(frame * sizeof(ControllerState), reinterpret_cast<u8*>(&curPadState),
+                       sizeof(ControllerState));
+          ControllerState movPadState{};
+          input_file.Read(frame * sizeof(ControllerState), reinterpret_cast<u8*>(&movPadState),
+                          sizeof(ControllerState));
           PanicAlertFmtT(
               "Warning: You loaded a save whose movie mismatches on frame {0}. You should load "
               "another save before continuing, or load this state with read-only mode off. "
@@ -1175,7 +1197,7 @@ void MovieManager::LoadInput(const std::string& movie_path)
 // NOTE: CPU Thread
 void MovieManager::CheckInputEnd()
 {
-  if (m_current_byte >= m_temp_input.size() ||
+  if (m_current_byte >= m_input.GetSize() ||
       (m_system.GetCoreTiming().GetTicks() > m_total_tick_count &&
        !IsRecordingInputFromSaveState()))
   {
@@ -1188,18 +1210,17 @@ void MovieManager::PlayController(GCPadStatus* PadStatus, int controllerID)
 {
   // Correct playback is entirely dependent on the emulator polling the controllers
   // in the same order done during recording
-  if (!IsPlayingInput() || !IsUsingPad(controllerID) || m_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingPad(controllerID) || m_input.IsEmpty())
     return;
 
-  if (m_current_byte + sizeof(ControllerState) > m_temp_input.size())
+  if (!m_input.Read(m_current_byte, reinterpret_cast<u8*>(&m_pad_state), sizeof(ControllerState)))
   {
     PanicAlertFmtT("Premature movie end in PlayController. {0} + {1} > {2}", m_current_byte,
-                   sizeof(ControllerState), m_temp_input.size());
+                   sizeof(ControllerState), m_input.GetSize());
     EndPlayInput(!m_read_only);
     return;
   }
 
-  memcpy(&m_pad_state, &m_temp_input[m_current_byte], sizeof(ControllerState));
   m_current_byte += sizeof(ControllerState);
 
   PadStatus->isConnected = m_pad_state.is_connected;
@@ -1279,19 +1300,19 @@ void MovieManager::PlayController(GCPadStatus* PadStatus, int controllerID)
 bool MovieManager::PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt,
                                ExtensionNumber ext, const EncryptionKey& key)
 {
-  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || m_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || m_input.IsEmpty())
     return false;
 
-  if (m_current_byte > m_temp_input.size())
+  u8 sizeInMovie;
+  if (!m_input.Read(m_current_byte, &sizeInMovie, 1))
   {
     PanicAlertFmtT("Premature movie end in PlayWiimote. {0} > {1}", m_current_byte,
-                   m_temp_input.size());
+                   m_input.GetSize());
     EndPlayInput(!m_read_only);
     return false;
   }
 
   const u8 size = rpt.GetDataSize();
-  const u8 sizeInMovie = m_temp_input[m_current_byte];
 
   if (size != sizeInMovie)
   {
@@ -1308,15 +1329,14 @@ bool MovieManager::PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rp
 
   m_current_byte++;
 
-  if (m_current_byte + size > m_temp_input.size())
+  if (!m_input.Read(m_current_byte, rpt.GetDataPtr(), size))
   {
     PanicAlertFmtT("Premature movie end in PlayWiimote. {0} + {1} > {2}", m_current_byte, size,
-                   m_temp_input.size());
+                   m_input.GetSize());
     EndPlayInput(!m_read_only);
     return false;
   }
 
-  memcpy(rpt.GetDataPtr(), &m_temp_input[m_current_byte], size);
   m_current_byte += size;
 
   m_current_input_count++;
@@ -1360,7 +1380,7 @@ void MovieManager::EndPlayInput(bool cont)
 }
 
 // NOTE: Save State + Host Thread
-void MovieManager::SaveRecording(const std::string& filename)
+void MovieManager::SaveRecording(const std::string& filename, bool chunked)
 {
   File::IOFile save_record(filename, "wb");
   // Create the real header now and write it
@@ -1370,7 +1390,7 @@ void MovieManager::SaveRecording(const std::string& filename)
   header.filetype[0] = 'D';
   header.filetype[1] = 'T';
   header.filetype[2] = 'M';
-  header.filetype[3] = 0x1A;
+  header.filetype[3] = chunked ? CHUNKED_MOVIE_MAGIC : 0x1A;
   strncpy(header.gameID.data(), SConfig::GetInstance().GetGameID().c_str(), 6);
   header.bWii = m_system.IsWii();
   header.controllers = 0;
@@ -1412,7 +1432,7 @@ void MovieManager::SaveRecording(const std::string& filename)
 
   save_record.WriteArray(&header, 1);
 
-  bool success = save_record.WriteBytes(m_temp_input.data(), m_temp_input.size());
+  bool success = chunked ? m_input.WriteChunked(save_record) : m_input.WriteFlat(save_record);
 
   if (success && m_recording_from_save_state)
   {
@@ -1552,6 +1572,6 @@ void MovieManager::GetMD5()
 void MovieManager::Shutdown()
 {
   m_current_input_count = m_total_input_count = m_total_frames = m_tick_count_at_last_input = 0;
-  m_temp_input.clear();
+  m_input.Clear();
 }
 }  // namespace Movie
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Core/MovieInputLog.h"
 
 struct BootParameters;
 
@@ -75,6 +76,9 @@ static_assert(sizeof(ControllerState) == 8, "ControllerState should be 8 bytes")
 
 // When making changes to the DTM format, keep in mind that there are programs other
 // than Dolphin that parse DTM files. The format is expected to be relatively stable.
+// Chunked movies have their own magic, so that those programs reject them instead of reading
+// the chunks as input. Their header is the same, but the input is stored as described in
+// MovieInputLog.cpp.
 #pragma pack(push, 1)
 struct DTMHeader
 {
@@ -83,7 +87,7 @@ struct DTMHeader
     return {gameID.data(), strnlen(gameID.data(), gameID.size())};
   }
 
-  std::array<u8, 4> filetype;  // Unique Identifier (always "DTM"0x1A)
+  std::array<u8, 4> filetype;  // Unique Identifier ("DTM"0x1A, or "DTM"0x1B if chunked)
 
   std::array<char, 6> gameID;  // The Game ID
   bool bWii;                   // Wii game
@@ -214,7 +218,9 @@ public:
   bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt,
                    WiimoteEmu::ExtensionNumber ext, const WiimoteEmu::EncryptionKey& key);
   void EndPlayInput(bool cont);
-  void SaveRecording(const std::string& filename);
+  // Chunked movies can be verified and loaded without reading all of their input, but programs
+  // that only know the original DTM format can't read them.
+  void SaveRecording(const std::string& filename, bool chunked);
   void DoState(PointerWrap& p);
   void Shutdown();
   void CheckPadStatus(const GCPadStatus* PadStatus, int controllerID);
@@ -240,7 +246,7 @@ private:
   std::array<bool, 4> m_wiimotes{};
   ControllerState m_pad_state{};
   DTMHeader m_temp_header{};
-  std::vector<u8> m_temp_input;
+  InputLog m_input;
   u64 m_current_byte = 0;
   u64 m_current_frame = 0;
   u64 m_total_frames = 0;  // VI
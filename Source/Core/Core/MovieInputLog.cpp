@@ -0,0 +1,375 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieInputLog.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <lz4.h>
+#include <xxhash.h>
+
+#include "Common/Assert.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace Movie
+{
+namespace
+{
+#pragma pack(push, 1)
+// Follows the DTMHeader in chunked movies. The chunks come next, and then the index, which has
+// an entry for every chunk.
+struct ChunkedInputHeader
+{
+  u32 chunk_size;
+  u32 chunk_count;
+  u64 input_size;
+  // Relative to the start of the input, like all offsets in chunked movies
+  u64 index_offset;
+};
+static_assert(sizeof(ChunkedInputHeader) == 24);
+
+struct ChunkIndexEntry
+{
+  u64 offset;
+  // The frame that the first input in the chunk was recorded on
+  u64 first_frame;
+  // XXH3 of the uncompressed chunk
+  u64 hash;
+  u32 size;
+  // The same as size if the chunk is stored uncompressed, otherwise it's compressed with LZ4
+  u32 stored_size;
+};
+static_assert(sizeof(ChunkIndexEntry) == 32);
+#pragma pack(pop)
+
+u64 HashChunk(const std::vector<u8>& data)
+{
+  return XXH3_64bits(data.data(), data.size());
+}
+}  // namespace
+
+void InputLog::Clear()
+{
+  m_chunks.clear();
+  m_size = 0;
+}
+
+void InputLog::Truncate(u64 size)
+{
+  if (size >= m_size)
+    return;
+
+  const size_t chunk_count = static_cast<size_t>((size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+  m_chunks.resize(chunk_count);
+  if (chunk_count != 0)
+  {
+    Chunk& last_chunk = m_chunks.back();
+    last_chunk.data.resize(static_cast<size_t>(size - u64(chunk_count - 1) * CHUNK_SIZE));
+    last_chunk.hash.reset();
+  }
+  m_size = size;
+}
+
+void InputLog::Write(u64 offset, const u8* data, size_t size, u64 frame)
+{
+  ASSERT(offset <= m_size);
+
+  while (size != 0)
+  {
+    const size_t index = static_cast<size_t>(offset / CHUNK_SIZE);
+    const u32 chunk_offset = static_cast<u32>(offset % CHUNK_SIZE);
+    if (index == m_chunks.size())
+    {
+      Chunk& new_chunk = m_chunks.emplace_back();
+      new_chunk.data.reserve(CHUNK_SIZE);
+      new_chunk.first_frame = frame;
+    }
+
+    Chunk& chunk = m_chunks[index];
+    const u32 count = static_cast<u32>(std::min<size_t>(size, CHUNK_SIZE - chunk_offset));
+    if (chunk.data.size() < chunk_offset + count)
+      chunk.data.resize(chunk_offset + count);
+    std::memcpy(chunk.data.data() + chunk_offset, data, count);
+    chunk.hash.reset();
+
+    offset += count;
+    data += count;
+    size -= count;
+    m_size = std::max(m_size, offset);
+  }
+}
+
+bool InputLog::Read(u64 offset, u8* out, size_t size) const
+{
+  if (offset > m_size || size > m_size - offset)
+    return false;
+
+  while (size != 0)
+  {
+    const Chunk& chunk = m_chunks[static_cast<size_t>(offset / CHUNK_SIZE)];
+    const u32 chunk_offset = static_cast<u32>(offset % CHUNK_SIZE);
+    const u32 count = static_cast<u32>(std::min<size_t>(size, CHUNK_SIZE - chunk_offset));
+    std::memcpy(out, chunk.data.data() + chunk_offset, count);
+
+    offset += count;
+    out += count;
+    size -= count;
+  }
+  return true;
+}
+
+u64 InputLog::GetChunkHash(size_t index) const
+{
+  const Chunk& chunk = m_chunks[index];
+  if (!chunk.hash)
+    chunk.hash = HashChunk(chunk.data);
+  return *chunk.hash;
+}
+
+std::optional<u64> InputLog::FindMismatch(InputLogFile& file, u64 size) const
+{
+  ASSERT(size <= m_size && size <= file.GetSize());
+
+  for (u64 chunk_start = 0; chunk_start < size; chunk_start += CHUNK_SIZE)
+  {
+    const size_t index = static_cast<size_t>(chunk_start / CHUNK_SIZE);
+    const Chunk& chunk = m_chunks[index];
+
+    const std::optional<u64> file_hash = file.GetChunkHash(index);
+    if (file_hash && file.GetChunkSize(index) == chunk.data.size() &&
+        *file_hash == GetChunkHash(index))
+    {
+      continue;
+    }
+
+    // A chunk that can't be read can't be trusted to match either
+    const std::vector<u8>* file_chunk = file.ReadChunk(index);
+    if (!file_chunk)
+      return chunk_start;
+
+    const size_t count = static_cast<size_t>(std::min<u64>(size - chunk_start, CHUNK_SIZE));
+    const auto end = chunk.data.begin() + count;
+    const auto result = std::mismatch(chunk.data.begin(), end, file_chunk->begin());
+    if (result.first != end)
+      return chunk_start + std::distance(chunk.data.begin(), result.first);
+  }
+
+  return std::nullopt;
+}
+
+bool InputLog::CopyFrom(InputLogFile& file, u64 size)
+{
+  ASSERT(size <= file.GetSize());
+
+  for (u64 chunk_start = 0; chunk_start < size; chunk_start += CHUNK_SIZE)
+  {
+    const size_t index = static_cast<size_t>(chunk_start / CHUNK_SIZE);
+    const std::optional<u64> file_hash = file.GetChunkHash(index);
+    if (index < m_chunks.size() && file_hash &&
+        file.GetChunkSize(index) == m_chunks[index].data.size() &&
+        *file_hash == GetChunkHash(index))
+    {
+      continue;
+    }
+
+    const std::vector<u8>* file_chunk = file.ReadChunk(index);
+    if (!file_chunk)
+      return false;
+
+    const size_t count = static_cast<size_t>(std::min<u64>(size - chunk_start, CHUNK_SIZE));
+    Write(chunk_start, file_chunk->data(), count, file.GetChunkFirstFrame(index));
+    m_chunks[index].first_frame = file.GetChunkFirstFrame(index);
+  }
+
+  return true;
+}
+
+bool InputLog::WriteFlat(File::IOFile& file) const
+{
+  return std::all_of(m_chunks.begin(), m_chunks.end(), [&file](const Chunk& chunk) {
+    return file.WriteBytes(chunk.data.data(), chunk.data.size());
+  });
+}
+
+bool InputLog::WriteChunked(File::IOFile& file) const
+{
+  const u64 input_start = file.Tell();
+
+  ChunkedInputHeader header{};
+  header.chunk_size = CHUNK_SIZE;
+  header.chunk_count = static_cast<u32>(m_chunks.size());
+  header.input_size = m_size;
+  if (!file.WriteArray(&header, 1))
+    return false;
+
+  std::vector<ChunkIndexEntry> index;
+  index.reserve(m_chunks.size());
+  std::vector<char> compressed(LZ4_compressBound(CHUNK_SIZE));
+  u64 offset = sizeof(ChunkedInputHeader);
+  for (size_t i = 0; i < m_chunks.size(); ++i)
+  {
+    const Chunk& chunk = m_chunks[i];
+    const int size = static_cast<int>(chunk.data.size());
+    const int compressed_size =
+        LZ4_compress_default(reinterpret_cast<const char*>(chunk.data.data()), compressed.data(),
+                             size, static_cast<int>(compressed.size()));
+
+    // Input that doesn't compress is stored as it is
+    const bool is_compressed = compressed_size > 0 && compressed_size < size;
+    const void* stored_data = is_compressed ? static_cast<const void*>(compressed.data()) :
+                                              static_cast<const void*>(chunk.data.data());
+    const u32 stored_size = static_cast<u32>(is_compressed ? compressed_size : size);
+    if (!file.WriteBytes(stored_data, stored_size))
+      return false;
+
+    index.push_back({offset, chunk.first_frame, GetChunkHash(i), static_cast<u32>(size),
+                     stored_size});
+    offset += stored_size;
+  }
+
+  header.index_offset = offset;
+  if (!file.WriteArray(index.data(), index.size()))
+    return false;
+
+  const u64 end = file.Tell();
+  return file.Seek(input_start, File::SeekOrigin::Begin) && file.WriteArray(&header, 1) &&
+         file.Seek(end, File::SeekOrigin::Begin);
+}
+
+bool InputLogFile::Open(File::IOFile* file, bool chunked)
+{
+  m_file = file;
+  m_input_start = file->Tell();
+  m_chunks.clear();
+  m_buffered_chunk.reset();
+
+  const u64 file_size = file->GetSize();
+  if (file_size < m_input_start)
+    return false;
+
+  if (!chunked)
+  {
+    // The original format has no index, so the input is split into chunks as it's read
+    m_size = file_size - m_input_start;
+    for (u64 offset = 0; offset < m_size; offset += InputLog::CHUNK_SIZE)
+    {
+      const u32 size = static_cast<u32>(std::min<u64>(m_size - offset, InputLog::CHUNK_SIZE));
+      m_chunks.push_back({offset, 0, std::nullopt, size, size});
+    }
+    return true;
+  }
+
+  ChunkedInputHeader header;
+  if (!file->ReadArray(&header, 1) || header.chunk_size != InputLog::CHUNK_SIZE)
+    return false;
+
+  // The chunk count is only used to size the index once it's known to match the input size and
+  // the index is known to fit in the file.
+  const u64 chunk_count = header.input_size / InputLog::CHUNK_SIZE +
+                          (header.input_size % InputLog::CHUNK_SIZE != 0 ? 1 : 0);
+  if (header.chunk_count != chunk_count || header.index_offset > file_size - m_input_start ||
+      (file_size - m_input_start - header.index_offset) / sizeof(ChunkIndexEntry) < chunk_count)
+  {
+    return false;
+  }
+
+  std::vector<ChunkIndexEntry> index(header.chunk_count);
+  if (!file->Seek(m_input_start + header.index_offset, File::SeekOrigin::Begin) ||
+      !file->ReadArray(index.data(), index.size()))
+  {
+    return false;
+  }
+
+  // Every chunk except for the last one is full, which is what makes seeking a division
+  u64 size = 0;
+  for (size_t i = 0; i < index.size(); ++i)
+  {
+    const ChunkIndexEntry& entry = index[i];
+    const bool is_last = i == index.size() - 1;
+    if (entry.size == 0 || entry.size > InputLog::CHUNK_SIZE ||
+        (!is_last && entry.size != InputLog::CHUNK_SIZE) ||
+        entry.stored_size > static_cast<u32>(LZ4_compressBound(InputLog::CHUNK_SIZE)) ||
+        entry.offset > header.index_offset ||
+        header.index_offset - entry.offset < entry.stored_size)
+    {
+      return false;
+    }
+
+    m_chunks.push_back({entry.offset, entry.first_frame, entry.hash, entry.size,
+                        entry.stored_size});
+    size += entry.size;
+  }
+  if (size != header.input_size)
+    return false;
+
+  m_size = size;
+  return true;
+}
+
+const std::vector<u8>* InputLogFile::ReadChunk(size_t index)
+{
+  if (m_buffered_chunk == index)
+    return &m_buffer;
+  m_buffered_chunk.reset();
+
+  const Chunk& chunk = m_chunks[index];
+  if (!m_file->Seek(m_input_start + chunk.offset, File::SeekOrigin::Begin))
+    return nullptr;
+
+  m_buffer.resize(chunk.size);
+  if (chunk.stored_size == chunk.size)
+  {
+    if (!m_file->ReadBytes(m_buffer.data(), m_buffer.size()))
+      return nullptr;
+  }
+  else
+  {
+    m_compressed_buffer.resize(chunk.stored_size);
+    if (!m_file->ReadBytes(m_compressed_buffer.data(), m_compressed_buffer.size()))
+      return nullptr;
+
+    const int result =
+        LZ4_decompress_safe(reinterpret_cast<const char*>(m_compressed_buffer.data()),
+                            reinterpret_cast<char*>(m_buffer.data()),
+                            static_cast<int>(chunk.stored_size), static_cast<int>(chunk.size));
+    if (result != static_cast<int>(chunk.size))
+    {
+      ERROR_LOG_FMT(CORE, "Failed to decompress movie input chunk {}", index);
+      return nullptr;
+    }
+  }
+
+  if (chunk.hash && HashChunk(m_buffer) != *chunk.hash)
+  {
+    ERROR_LOG_FMT(CORE, "Movie input chunk {} is corrupted", index);
+    return nullptr;
+  }
+
+  m_buffered_chunk = index;
+  return &m_buffer;
+}
+
+bool InputLogFile::Read(u64 offset, u8* out, size_t size)
+{
+  if (offset > m_size || size > m_size - offset)
+    return false;
+
+  while (size != 0)
+  {
+    const std::vector<u8>* chunk = ReadChunk(static_cast<size_t>(offset / InputLog::CHUNK_SIZE));
+    if (!chunk)
+      return false;
+
+    const u32 chunk_offset = static_cast<u32>(offset % InputLog::CHUNK_SIZE);
+    const u32 count = static_cast<u32>(std::min<size_t>(size, chunk->size() - chunk_offset));
+    std::memcpy(out, chunk->data() + chunk_offset, count);
+
+    offset += count;
+    out += count;
+    size -= count;
+  }
+  return true;
+}
+}  // namespace Movie
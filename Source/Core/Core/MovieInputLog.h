@@ -0,0 +1,107 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+class IOFile;
+}
+
+namespace Movie
+{
+class InputLogFile;
+
+// The input of a movie, split into chunks of CHUNK_SIZE bytes. Recording never has to move the
+// input that came before it, and the chunk that holds any position is found with a division.
+// Every chunk is hashed, so a log can be compared against a file without reading the chunks
+// that they have in common.
+class InputLog
+{
+public:
+  static constexpr u32 CHUNK_SIZE = 0x10000;
+
+  u64 GetSize() const { return m_size; }
+  bool IsEmpty() const { return m_size == 0; }
+  void Clear();
+  void Truncate(u64 size);
+
+  // Writes data at offset, which must not be past the end of the log. frame is the frame that the
+  // data belongs to, which gets stored in the index of chunked movies for the chunks this starts.
+  void Write(u64 offset, const u8* data, size_t size, u64 frame);
+  // Returns false without reading anything if the log ends before offset + size
+  bool Read(u64 offset, u8* out, size_t size) const;
+
+  // Returns the offset of the first byte in [0, size) that differs from the file, or nullopt if
+  // they're identical. size must not be larger than the size of the log or the file.
+  std::optional<u64> FindMismatch(InputLogFile& file, u64 size) const;
+  // Makes the first size bytes the same as in the file, leaving the rest of the log as it is.
+  // Only the chunks that differ get read.
+  bool CopyFrom(InputLogFile& file, u64 size);
+
+  // Writes the input at the current position of the file, either as a single block like in the
+  // original DTM format or as (possibly compressed) chunks followed by an index
+  bool WriteFlat(File::IOFile& file) const;
+  bool WriteChunked(File::IOFile& file) const;
+
+private:
+  struct Chunk
+  {
+    std::vector<u8> data;
+    u64 first_frame = 0;
+    // Computed when needed, and reset whenever data changes
+    mutable std::optional<u64> hash;
+  };
+
+  u64 GetChunkHash(size_t index) const;
+
+  std::vector<Chunk> m_chunks;
+  u64 m_size = 0;
+};
+
+// The input stored in a movie file. Chunks are read on demand, so that comparing against or
+// copying from the file only reads the parts that are needed.
+class InputLogFile
+{
+public:
+  // The input has to start at the current position of the file, which must stay open while
+  // this is used
+  bool Open(File::IOFile* file, bool chunked);
+
+  u64 GetSize() const { return m_size; }
+  size_t GetChunkCount() const { return m_chunks.size(); }
+  u32 GetChunkSize(size_t index) const { return m_chunks[index].size; }
+  // Only chunked movies store hashes
+  std::optional<u64> GetChunkHash(size_t index) const { return m_chunks[index].hash; }
+  u64 GetChunkFirstFrame(size_t index) const { return m_chunks[index].first_frame; }
+
+  // Returns nullptr if the chunk can't be read. The data stays valid until another chunk is read.
+  const std::vector<u8>* ReadChunk(size_t index);
+  bool Read(u64 offset, u8* out, size_t size);
+
+private:
+  struct Chunk
+  {
+    u64 offset = 0;
+    u64 first_frame = 0;
+    std::optional<u64> hash;
+    u32 size = 0;
+    u32 stored_size = 0;
+  };
+
+  File::IOFile* m_file = nullptr;
+  u64 m_input_start = 0;
+  u64 m_size = 0;
+  std::vector<Chunk> m_chunks;
+
+  std::optional<size_t> m_buffered_chunk;
+  std::vector<u8> m_buffer;
+  std::vector<u8> m_compressed_buffer;
+};
+}  // namespace Movie
@@ -18,6 +18,8 @@
 
 #include <fmt/format.h>
 
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/SoundStream.h"
 #include "Common/Assert.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
@@ -40,6 +42,7 @@
 #include "Core/Config/SessionSettings.h"
 #include "Core/Config/WiimoteSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/CoreTiming.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
@@ -53,6 +56,7 @@
 #include "Core/HW/SI/SI_Device.h"
 #include "Core/HW/SI/SI_DeviceGCController.h"
 #include "Core/HW/Sram.h"
+#include "Core/HW/VideoInterface.h"
 #include "Core/HW/WiiSave.h"
 #include "Core/HW/WiiSaveStructs.h"
 #include "Core/HW/WiimoteEmu/DesiredWiimoteState.h"
@@ -64,7 +68,9 @@
 #include "Core/IOS/Uids.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayCommon.h"
+#include "Core/NetPlayRollback.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/State.h"
 #include "Core/SyncIdentifier.h"
 #include "Core/System.h"
 #include "DiscIO/Blob.h"
@@ -83,6 +89,17 @@ using namespace WiimoteCommon;
 static std::mutex crit_netplay_client;
 static NetPlayClient* netplay_client = nullptr;
 static bool s_si_poll_batching = false;
+// Set whenever OnSafePoint() has something to do, so that the CoreTiming slices in between don't
+// have to take crit_netplay_client.
+static Common::Flag s_safe_point_work_pending;
+
+// How long to wait before asking for missing pad input again, and how long the game waits for pad
+// input before it assumes that the batch it's waiting for was lost.
+constexpr std::chrono::milliseconds PAD_DATA_REQUEST_INTERVAL{100};
+
+// Spectators get their pad input in bursts. Once they run out, they wait for this many entries,
+// so that the game doesn't stutter on every burst.
+constexpr u32 SPECTATOR_REFILL_ENTRIES = 6;
 
 // called from ---GUI--- thread
 NetPlayClient::~NetPlayClient()
@@ -97,7 +114,10 @@ NetPlayClient::~NetPlayClient()
     m_dialog->AbortGameDigest();
     if (m_game_digest_thread.joinable())
       m_game_digest_thread.join();
+    if (m_spectator_snapshot_thread.joinable())
+      m_spectator_snapshot_thread.join();
     m_do_loop.Clear();
+    Common::ENet::WakeupThread(m_client);
     m_thread.join();
 
     m_chunked_data_receive_queue.clear();
@@ -127,8 +147,9 @@ NetPlayClient::~NetPlayClient()
 
 // called from ---GUI--- thread
 NetPlayClient::NetPlayClient(const std::string& address, const u16 port, NetPlayUI* dialog,
-                             const std::string& name, const NetTraversalConfig& traversal_config)
-    : m_dialog(dialog), m_player_name(name)
+                             const std::string& name, const NetTraversalConfig& traversal_config,
+                             const bool spectator)
+    : m_dialog(dialog), m_player_name(name), m_is_spectator(spectator)
 {
   ClearBuffers();
 
@@ -250,6 +271,7 @@ bool NetPlayClient::Connect()
   packet << Common::GetScmRevGitStr();
   packet << Common::GetNetplayDolphinVer();
   packet << m_player_name;
+  packet << m_is_spectator;
   Send(packet);
   enet_host_flush(m_client);
   sf::Packet rpac;
@@ -395,6 +417,30 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnPadHostData(packet);
     break;
 
+  case MessageID::PadDataBatch:
+    OnPadDataBatch(packet);
+    break;
+
+  case MessageID::PadDataRequest:
+    OnPadDataRequest(packet);
+    break;
+
+  case MessageID::SpectatorPadData:
+    OnSpectatorPadData(packet);
+    break;
+
+  case MessageID::SpectatorSnapshotRequest:
+    OnSpectatorSnapshotRequest();
+    break;
+
+  case MessageID::SpectatorSnapshot:
+    OnSpectatorSnapshot(packet);
+    break;
+
+  case MessageID::RollbackPadData:
+    OnRollbackPadData(packet);
+    break;
+
   case MessageID::WiimoteData:
     OnWiimoteData(packet);
     break;
@@ -448,6 +494,14 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnDesyncDetected(packet);
     break;
 
+  case MessageID::RAMHashBlocksRequest:
+    OnRAMHashBlocksRequest(packet);
+    break;
+
+  case MessageID::RAMDesyncDetected:
+    OnRAMDesyncDetected(packet);
+    break;
+
   case MessageID::SyncSaveData:
     OnSyncSaveData(packet);
     break;
@@ -518,6 +572,8 @@ void NetPlayClient::OnPlayerLeave(sf::Packet& packet)
     m_players.erase(m_players.find(pid));
   }
 
+  m_pad_buffer_controller.RemovePlayer(pid);
+
   m_dialog->Update();
 }
 
@@ -723,6 +779,197 @@ void NetPlayClient::OnPadHostData(sf::Packet& packet)
   }
 }
 
+void NetPlayClient::OnPadDataBatch(sf::Packet& packet)
+{
+  ReadPadDataBatch(packet);
+}
+
+// Returns false if the batch is malformed.
+bool NetPlayClient::ReadPadDataBatch(sf::Packet& packet)
+{
+  u8 pad_count;
+  packet >> pad_count;
+  std::vector<PadIndex> maps(pad_count);
+  for (PadIndex& map : maps)
+    packet >> map;
+
+  std::vector<GCPadStatus> new_entries;
+  for (const PadIndex map : maps)
+  {
+    // Trusting server for good map value (>=0 && <4)
+    PadStreamDecoder& decoder = m_pad_stream_decoders.at(map);
+    bool entries_missing = false;
+    new_entries.clear();
+    if (!decoder.Read(packet, &new_entries, &entries_missing))
+    {
+      ERROR_LOG_FMT(NETPLAY, "Received malformed pad data");
+      return false;
+    }
+
+    for (const GCPadStatus& pad : new_entries)
+      m_pad_buffer[map].Push(pad);
+
+    if (!new_entries.empty())
+      m_gc_pad_event.Set();
+
+    // More batches than the redundancy covers were lost. Ask the player for the missing entries,
+    // but give the answer some time to arrive before asking again.
+    const auto now = std::chrono::steady_clock::now();
+    if (entries_missing && now - m_pad_stream_request_time[map] > PAD_DATA_REQUEST_INTERVAL)
+    {
+      m_pad_stream_request_time[map] = now;
+
+      if (!decoder.CanCatchUp())
+      {
+        if (m_is_spectator)
+          m_spectator_resync_needed.Set();
+        else
+          ERROR_LOG_FMT(NETPLAY, "Pad {} input from entry {} is no longer available", map,
+                        decoder.GetNextEntry());
+        continue;
+      }
+
+      sf::Packet request;
+      request << MessageID::PadDataRequest;
+      request << map;
+      request << decoder.GetNextEntry();
+      SendAsync(std::move(request));
+    }
+  }
+
+  return true;
+}
+
+void NetPlayClient::OnPadDataRequest(sf::Packet& packet)
+{
+  PadIndex map;
+  u32 first_entry;
+  packet >> map >> first_entry;
+
+  sf::Packet response;
+  response << MessageID::PadDataBatch;
+  response << u8{1};
+  response << map;
+
+  {
+    std::lock_guard lk(m_pad_stream_lock);
+    if (!m_pad_stream_encoders.at(map).Write(response, first_entry))
+      ERROR_LOG_FMT(NETPLAY, "Pad {} input from entry {} is no longer available", map, first_entry);
+  }
+
+  Send(response);
+}
+
+void NetPlayClient::OnSpectatorPadData(sf::Packet& packet)
+{
+  {
+    // Until the host's savestate is loaded, it isn't known which entries the game will use first.
+    std::lock_guard lk(m_spectator_lock);
+    if (!m_spectator_synced.IsSet())
+    {
+      m_spectator_pending_pad_data.push_back(packet);
+      return;
+    }
+  }
+
+  ReadSpectatorPadData(packet);
+
+  if (m_spectator_resync_needed.TestAndClear())
+    ResyncSpectator();
+}
+
+void NetPlayClient::ReadSpectatorPadData(sf::Packet& packet)
+{
+  u8 batch_count;
+  packet >> batch_count;
+  for (u8 i = 0; i < batch_count; ++i)
+  {
+    if (!ReadPadDataBatch(packet))
+      return;
+  }
+}
+
+// The spectator fell so far behind that the input it needs is gone. Like when joining, the game
+// runs without input until a new savestate of the host arrives.
+void NetPlayClient::ResyncSpectator()
+{
+  INFO_LOG_FMT(NETPLAY, "Spectator fell behind, asking for a new savestate");
+
+  {
+    std::lock_guard lk(m_spectator_lock);
+    m_spectator_synced.Clear();
+    m_spectator_state.clear();
+    m_spectator_pending_pad_data.clear();
+  }
+
+  sf::Packet packet;
+  packet << MessageID::SpectatorSnapshotRequest;
+  Send(packet);
+}
+
+void NetPlayClient::OnSpectatorSnapshotRequest()
+{
+  // The server asks as soon as it has sent StartGame, which may be before the game is running
+  // here. GetNetPads() picks the request up once it is.
+  m_spectator_snapshot_requested.Set();
+  s_safe_point_work_pending.Set();
+}
+
+void NetPlayClient::OnSpectatorSnapshot(sf::Packet& packet)
+{
+  u32 game;
+  packet >> game;
+  if (!m_is_spectator || game != m_current_game)
+    return;
+
+  std::array<u32, 4> entries_used;
+  for (u32& entries : entries_used)
+    packet >> entries;
+
+  std::optional<std::vector<u8>> state = DecompressPacketIntoBuffer(packet);
+  if (!state)
+  {
+    m_dialog->AppendChat(Common::GetStringT("Failed to receive the host's savestate."));
+    return;
+  }
+
+  std::lock_guard lk(m_spectator_lock);
+  m_spectator_state = std::move(*state);
+  m_spectator_entries_used = entries_used;
+  s_safe_point_work_pending.Set();
+}
+
+void NetPlayClient::OnRollbackPadData(sf::Packet& packet)
+{
+  // Pad data from a game that wasn't started in rollback mode, or from the previous game
+  if (!m_rollback)
+    return;
+
+  FrameNum frame;
+  packet >> frame;
+
+  while (!packet.endOfPacket())
+  {
+    PadIndex map;
+    packet >> map;
+
+    GCPadStatus pad;
+    packet >> pad.button;
+    if (!m_gba_config.at(map).enabled)
+    {
+      packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
+          pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
+    }
+
+    // Trusting server for good map value (>=0 && <4)
+    m_rollback->AddInput(map, frame, pad);
+  }
+
+  // The input may not match what was predicted, which has to be handled at a safe point.
+  s_safe_point_work_pending.Set();
+  m_gc_pad_event.Set();
+}
+
 void NetPlayClient::OnWiimoteData(sf::Packet& packet)
 {
   while (!packet.endOfPacket())
@@ -918,6 +1165,8 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
       m_net_settings.savedata_write = false;
       m_net_settings.savedata_sync_all_wii = false;
     }
+    if (m_is_spectator)
+      m_net_settings.savedata_write = false;
     packet >> m_net_settings.strict_settings_sync;
 
     m_initial_rtc = Common::PacketReadU64(packet);
@@ -928,6 +1177,10 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.golf_mode;
     packet >> m_net_settings.use_fma;
     packet >> m_net_settings.hide_remote_gbas;
+    packet >> m_net_settings.rollback;
+    packet >> m_net_settings.rollback_max_frames;
+    packet >> m_net_settings.auto_pad_buffer;
+    packet >> m_net_settings.ram_hash_desync_detection;
 
     for (size_t i = 0; i < sizeof(m_net_settings.sram); ++i)
       packet >> m_net_settings.sram[i];
@@ -935,6 +1188,57 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     m_net_settings.is_hosting = m_local_player->IsHost();
   }
 
+  // Wii Remote state can't be predicted or rolled back, so such games keep using input delay.
+  const bool wiimotes_mapped =
+      std::any_of(m_wiimote_map.begin(), m_wiimote_map.end(), [](PlayerId pid) { return pid > 0; });
+  if (m_net_settings.rollback && wiimotes_mapped)
+  {
+    m_net_settings.rollback = false;
+    m_dialog->AppendChat(
+        Common::GetStringT("Rollback does not support Wii Remotes, falling back to input delay."));
+  }
+
+  if (m_net_settings.rollback)
+    m_rollback = std::make_unique<RollbackSession>(m_net_settings.rollback_max_frames);
+  else
+    m_rollback.reset();
+
+  // With rollback, a frame is first simulated with predicted inputs, so its memory may differ
+  // between players without anything being wrong.
+  if (m_net_settings.ram_hash_desync_detection && m_net_settings.rollback)
+  {
+    m_net_settings.ram_hash_desync_detection = false;
+    m_dialog->AppendChat(Common::GetStringT(
+        "RAM hash desync detection does not support rollback, only the timebase is checked."));
+  }
+
+  // In dual core, the GPU thread writes EFB and XFB copies to emulated memory at times that differ
+  // between players, so the memory could be hashed before a copy on one machine and after it on
+  // another.
+  if (m_net_settings.ram_hash_desync_detection && m_net_settings.cpu_thread &&
+      !m_net_settings.sync_gpu &&
+      (!m_net_settings.efb_to_texture_enable || !m_net_settings.xfb_to_texture_enable))
+  {
+    m_net_settings.ram_hash_desync_detection = false;
+    m_dialog->AppendChat(Common::GetStringT(
+        "RAM hash desync detection needs single core or Sync GPU while EFB or XFB copies are "
+        "stored in RAM, only the timebase is checked."));
+  }
+
+  // Spectators join late, so their frames don't line up with those of the players.
+  if (m_net_settings.ram_hash_desync_detection && !m_is_spectator)
+    m_ram_hash = std::make_unique<RAMHashTree>();
+  else
+    m_ram_hash.reset();
+
+  if (m_is_spectator)
+  {
+    std::lock_guard lk(m_spectator_lock);
+    m_spectator_state.clear();
+    m_spectator_pending_pad_data.clear();
+    m_spectator_synced.Clear();
+  }
+
   m_dialog->OnMsgStartGame();
 }
 
@@ -973,6 +1277,12 @@ void NetPlayClient::OnPlayerPingData(sf::Packet& packet)
     std::lock_guard lkp(m_crit.players);
     Player& player = m_players[pid];
     packet >> player.ping;
+
+    // Only players with controllers matter for how long input takes to arrive.
+    if (pid == m_pid || PlayerHasControllerMapped(pid))
+      m_pad_buffer_controller.AddPingSample(pid, pid == m_pid, player.ping);
+    else
+      m_pad_buffer_controller.RemovePlayer(pid);
   }
 
   DisplayPlayersPing();
@@ -999,6 +1309,61 @@ void NetPlayClient::OnDesyncDetected(sf::Packet& packet)
   m_dialog->OnDesync(frame, player);
 }
 
+void NetPlayClient::OnRAMHashBlocksRequest(sf::Packet& packet)
+{
+  u32 frame;
+  u8 region;
+  packet >> frame >> region;
+
+  std::vector<u64> block_hashes;
+  if (m_ram_hash)
+    block_hashes = m_ram_hash->GetBlockHashes(frame, region).value_or(std::vector<u64>{});
+
+  sf::Packet response;
+  response << MessageID::RAMHashBlocks;
+  response << frame;
+  response << region;
+  response << static_cast<u32>(block_hashes.size());
+  for (const u64 block_hash : block_hashes)
+    response << static_cast<sf::Uint64>(block_hash);
+
+  Send(response);
+}
+
+void NetPlayClient::OnRAMDesyncDetected(sf::Packet& packet)
+{
+  PlayerId pid_to_blame;
+  u32 frame;
+  u8 region;
+  bool has_block;
+  u32 block;
+  packet >> pid_to_blame >> frame >> region >> has_block >> block;
+
+  std::string player = "??";
+  {
+    std::lock_guard lkp(m_crit.players);
+    const auto it = m_players.find(pid_to_blame);
+    if (it != m_players.end())
+      player = it->second.name;
+  }
+
+  std::optional<u32> block_index;
+  if (has_block)
+    block_index = block;
+
+  const std::string location = m_ram_hash ? m_ram_hash->DescribeBlock(region, block_index) :
+                                            fmt::format("region {}", region);
+
+  // A block is only rehashed on one in HASH_SLICES frames, so the frame the digests first differ
+  // on can be up to HASH_SLICES - 1 frames after the one that actually changed the memory.
+  const u32 first_frame = frame - std::min(frame, RAMHashTree::HASH_SLICES - 1);
+
+  INFO_LOG_FMT(NETPLAY, "Player {} ({}) desynced between frames {} and {} in {}!", player,
+               pid_to_blame, first_frame, frame, location);
+
+  m_dialog->OnRAMDesync(first_frame, frame, player, location);
+}
+
 void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
 {
   SyncSaveDataID sub_id;
@@ -1522,7 +1887,7 @@ void NetPlayClient::OnGameDigestAbort()
 
 void NetPlayClient::Send(const sf::Packet& packet, const u8 channel_id)
 {
-  Common::ENet::SendPacket(m_server, packet, channel_id);
+  Common::ENet::SendPacket(m_server, packet, channel_id, channel_id != PAD_DATA_CHANNEL);
 }
 
 void NetPlayClient::DisplayPlayersPing()
@@ -1534,6 +1899,32 @@ void NetPlayClient::DisplayPlayersPing()
                        OSD::Duration::SHORT, OSD::Color::CYAN);
 }
 
+// called from ---CPU--- thread
+void NetPlayClient::UpdateAutoPadBuffer()
+{
+  const double refresh_rate =
+      Core::System::GetInstance().GetVideoInterface().GetTargetRefreshRate();
+  const double frame_time_ms = refresh_rate > 0 ? 1000.0 / refresh_rate : 0.0;
+
+  // Changes are picked up by PollLocalPad(). It pushes extra local input to grow the buffer, and
+  // the buffer shrinks by skipping pushes until the game has used up the input in it.
+  m_target_buffer_size =
+      m_pad_buffer_controller.Update(frame_time_ms, std::exchange(m_pad_buffer_stalled, false));
+
+  if (!g_ActiveConfig.bShowNetPlayPing || ++m_pad_buffer_stats_frames < 60)
+    return;
+
+  m_pad_buffer_stats_frames = 0;
+  const PadBufferController::Stats stats = m_pad_buffer_controller.GetStats();
+  OSD::AddTypedMessage(
+      OSD::MessageType::NetPlayBuffer,
+      fmt::format("Buffer: {} (auto, margin {}) | RTT: {} ms, jitter {} ms | "
+                  "Worst: {} ms, jitter {} ms",
+                  stats.buffer, stats.margin, stats.local_rtt, stats.local_jitter, stats.worst_rtt,
+                  stats.worst_jitter),
+      OSD::Duration::NORMAL, OSD::Color::CYAN);
+}
+
 u32 NetPlayClient::GetPlayersMaxPing() const
 {
   return std::max_element(
@@ -1577,7 +1968,7 @@ void NetPlayClient::SendAsync(sf::Packet&& packet, const u8 channel_id)
     std::lock_guard lkq(m_crit.async_queue_write);
     m_async_queue.Push(AsyncQueueEntry{std::move(packet), channel_id});
   }
-  Common::ENet::WakeupThread(m_client);
+  m_wakeup.Request(m_client);
 }
 
 // called from ---NETPLAY--- thread
@@ -1608,6 +1999,7 @@ void NetPlayClient::ThreadFunc()
     if (m_traversal_client)
       m_traversal_client->HandleResends();
     net = enet_host_service(m_client, &netEvent, 250);
+    m_wakeup.Reset();
     while (!m_async_queue.Empty())
     {
       INFO_LOG_FMT(NETPLAY, "Processing async queue event.");
@@ -1660,6 +2052,10 @@ void NetPlayClient::ThreadFunc()
     {
       ERROR_LOG_FMT(NETPLAY, "enet_host_service error: {}", net);
     }
+
+    // enet_host_service only sends when it has no received events left to return, so send what
+    // was queued above and by OnData right away instead.
+    enet_host_flush(m_client);
   }
 
   INFO_LOG_FMT(NETPLAY, "NetPlayClient shutting down.");
@@ -1754,6 +2150,18 @@ bool NetPlayClient::StartGame(const std::string& path)
   m_current_golfer = 1;
   m_wait_on_input = false;
 
+  m_safe_point_hooked = false;
+  m_rollback_frame = 0;
+  m_rollback_next_local_frame = 0;
+  m_rollback_next_snapshot_frame = 0;
+  m_rollback_resimulate_until.reset();
+
+  m_pad_buffer_controller.Reset(m_target_buffer_size);
+  m_pad_buffer_stalled = false;
+  m_pad_buffer_stats_frames = 0;
+
+  m_pad_entries_used.fill(0);
+
   m_is_running.Set();
   NetPlay_Enable(this);
 
@@ -1935,6 +2343,13 @@ void NetPlayClient::ClearBuffers()
     while (m_wiimote_buffer[i].Size())
       m_wiimote_buffer[i].Pop();
   }
+
+  std::lock_guard lk(m_pad_stream_lock);
+  for (PadStreamEncoder& encoder : m_pad_stream_encoders)
+    encoder.Reset();
+  for (PadStreamDecoder& decoder : m_pad_stream_decoders)
+    decoder.Reset();
+  m_pad_stream_request_time.fill({});
 }
 
 // called from ---NETPLAY--- thread
@@ -2040,8 +2455,25 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     m_wait_on_input_event.Wait();
   }
 
+  if (m_rollback)
+    return GetRollbackPads(pad_nb, batching, pad_status);
+
+  if (m_is_spectator && !m_spectator_synced.IsSet())
+  {
+    // Until the host's savestate is loaded at a safe point, the game just runs without input.
+    HookSafePoint();
+    *pad_status = GCPadStatus{};
+    return true;
+  }
+
+  if (m_spectator_snapshot_requested.IsSet())
+    HookSafePoint();
+
   if (IsFirstInGamePad(pad_nb) && batching)
   {
+    if (m_net_settings.auto_pad_buffer && !m_host_input_authority)
+      UpdateAutoPadBuffer();
+
     sf::Packet packet;
     packet << MessageID::PadData;
 
@@ -2052,8 +2484,10 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
       send_packet = PollLocalPad(local_pad, packet) || send_packet;
     }
 
-    if (send_packet)
+    if (send_packet && m_host_input_authority)
       SendAsync(std::move(packet));
+    else if (send_packet)
+      SendPadDataBatch();
 
     if (m_host_input_authority)
       SendPadHostPoll(-1);
@@ -2066,8 +2500,11 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     {
       sf::Packet packet;
       packet << MessageID::PadData;
-      if (PollLocalPad(local_pad, packet))
+      const bool send_packet = PollLocalPad(local_pad, packet);
+      if (send_packet && m_host_input_authority)
         SendAsync(std::move(packet));
+      else if (send_packet)
+        SendPadDataBatch();
     }
 
     if (m_host_input_authority)
@@ -2103,18 +2540,256 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
 
   // Now, we either use the data pushed earlier, or wait for the
   // other clients to send it to us
-  while (m_pad_buffer[pad_nb].Size() == 0)
+  const u32 wanted_entries =
+      m_is_spectator && m_pad_buffer[pad_nb].Size() == 0 ? SPECTATOR_REFILL_ENTRIES : 1;
+  while (m_pad_buffer[pad_nb].Size() < wanted_entries)
   {
     if (!m_is_running.IsSet())
     {
       return false;
     }
 
-    m_gc_pad_event.Wait();
+    if (m_is_spectator && !m_spectator_synced.IsSet())
+    {
+      HookSafePoint();
+      *pad_status = GCPadStatus{};
+      return true;
+    }
+
+    m_pad_buffer_stalled = true;
+    if (!m_gc_pad_event.WaitFor(PAD_DATA_REQUEST_INTERVAL) && !m_host_input_authority)
+      RecoverPadData(pad_nb);
   }
 
   m_pad_buffer[pad_nb].Pop(*pad_status);
+  ++m_pad_entries_used[pad_nb];
+
+  RecordPadToMovie(pad_nb, pad_status);
+
+  return true;
+}
+
+// called from ---CPU--- thread
+bool NetPlayClient::GetRollbackPads(const int pad_nb, const bool batching, GCPadStatus* pad_status)
+{
+  // In rollback mode every batched poll is a new input frame, while MMIO polls in between see the
+  // input of the current one again. Local pads are recorded (and sent) up to the configured delay
+  // ahead. Remote pads that haven't arrived yet are predicted; if a prediction turns out to be
+  // wrong, OnRollbackSafePoint() rewinds to the frame and replays it with the real input.
+  HookSafePoint();
+
+  if (IsFirstInGamePad(pad_nb) && batching)
+  {
+    ++m_rollback_frame;
+    // A snapshot of the new frame is due.
+    s_safe_point_work_pending.Set();
+  }
+
+  const FrameNum frame = m_rollback_frame == 0 ? 0 : m_rollback_frame - 1;
+  SendRollbackLocalPads(frame);
+
+  std::optional<GCPadStatus> status;
+  while (!(status = m_rollback->GetInput(pad_nb, frame)))
+  {
+    if (!m_is_running.IsSet())
+    {
+      return false;
+    }
+
+    m_gc_pad_event.Wait();
+  }
+
+  *pad_status = *status;
+
+  RecordPadToMovie(pad_nb, pad_status);
+
+  return true;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendRollbackLocalPads(const FrameNum frame)
+{
+  // The pad buffer size is the local input delay in rollback mode.
+  const FrameNum last_frame =
+      frame + std::min<FrameNum>(m_target_buffer_size, RollbackSession::MAX_INPUT_DELAY);
+  if (m_rollback_next_local_frame > last_frame)
+    return;
+
+  const int num_local_pads = NumLocalPads();
+  std::array<GCPadStatus, 4> local_status;
+  for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
+    local_status[local_pad] = GetLocalPadStatus(local_pad);
+
+  // Normally this sends a single frame. More are only needed when starting out or when the delay
+  // was raised, and those are filled with the current input.
+  for (; m_rollback_next_local_frame <= last_frame; ++m_rollback_next_local_frame)
+  {
+    sf::Packet packet;
+    packet << MessageID::RollbackPadData;
+    packet << m_rollback_next_local_frame;
+
+    for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
+    {
+      const int ingame_pad = LocalPadToInGamePad(local_pad);
+      m_rollback->AddInput(ingame_pad, m_rollback_next_local_frame, local_status[local_pad]);
+      AddPadStateToPacket(ingame_pad, local_status[local_pad], packet);
+    }
+
+    if (num_local_pads > 0)
+      SendAsync(std::move(packet));
+  }
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::HookSafePoint()
+{
+  if (m_safe_point_hooked)
+    return;
+
+  s_safe_point_work_pending.Set();
+  Core::System::GetInstance().GetCoreTiming().SetAdvanceCallback([] {
+    if (!s_safe_point_work_pending.TestAndClear())
+      return;
+
+    std::lock_guard lk(crit_netplay_client);
+    if (netplay_client)
+      netplay_client->OnSafePoint();
+  });
+  m_safe_point_hooked = true;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::OnSafePoint()
+{
+  OnSpectatorSafePoint();
+  OnRollbackSafePoint();
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::OnSpectatorSafePoint()
+{
+  auto& system = Core::System::GetInstance();
+
+  if (m_spectator_snapshot_requested.TestAndClear())
+  {
+    // Saving the state holds up the game for everyone for a moment. The server keeps this from
+    // happening more than every few seconds, however many spectators join.
+    std::vector<u8> state;
+    State::SaveToBufferImmediately(system, state);
+
+    sf::Packet packet;
+    packet << MessageID::SpectatorSnapshot;
+    packet << m_current_game;
+    for (const u32 entries : m_pad_entries_used)
+      packet << entries;
+
+    // Compressing the state takes a while, so don't hold up the game for it.
+    if (m_spectator_snapshot_thread.joinable())
+      m_spectator_snapshot_thread.join();
+    m_spectator_snapshot_thread =
+        std::thread([this, game = m_current_game, packet = std::move(packet),
+                     state = std::move(state)]() mutable {
+          if (!CompressBufferIntoPacket(state, packet))
+          {
+            ERROR_LOG_FMT(NETPLAY, "Failed to compress the savestate for spectators");
+
+            // Without a state the server asks again later.
+            packet.clear();
+            packet << MessageID::SpectatorSnapshot;
+            packet << game;
+          }
+          SendAsync(std::move(packet), CHUNKED_DATA_CHANNEL);
+        });
+  }
+
+  if (!m_is_spectator || m_spectator_synced.IsSet())
+    return;
+
+  std::lock_guard lk(m_spectator_lock);
+  if (m_spectator_state.empty())
+    return;
 
+  if (!State::LoadFromBufferImmediately(system, m_spectator_state))
+    ERROR_LOG_FMT(NETPLAY, "Failed to load the host's savestate");
+  m_spectator_state.clear();
+  m_spectator_state.shrink_to_fit();
+
+  // The game continues with the entries the host was about to use when it took the savestate.
+  // The NetPlay thread holds on to new input until m_spectator_synced is set, so the decoders and
+  // pad buffers are ours for now. The buffers still hold input from before, if the spectator is
+  // starting over after falling behind.
+  for (size_t i = 0; i < m_pad_stream_decoders.size(); ++i)
+  {
+    while (m_pad_buffer[i].Size())
+      m_pad_buffer[i].Pop();
+    m_pad_stream_decoders[i].Reset(m_spectator_entries_used[i]);
+    m_pad_entries_used[i] = m_spectator_entries_used[i];
+  }
+  for (sf::Packet& packet : m_spectator_pending_pad_data)
+    ReadSpectatorPadData(packet);
+  m_spectator_pending_pad_data.clear();
+
+  m_spectator_synced.Set();
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::OnRollbackSafePoint()
+{
+  if (!m_rollback)
+    return;
+
+  auto& system = Core::System::GetInstance();
+
+  if (const std::optional<FrameNum> rollback_frame = m_rollback->TakeRollbackFrame())
+  {
+    u32 timebase_frame = 0;
+    if (m_rollback->LoadSnapshot(system, *rollback_frame, &timebase_frame))
+    {
+      DEBUG_LOG_FMT(NETPLAY, "Rolling back from frame {} to frame {}", m_rollback_frame,
+                    *rollback_frame);
+
+      if (!m_rollback_resimulate_until)
+      {
+        m_rollback_resimulate_until = m_rollback_frame;
+        SetRollbackResimulating(true);
+      }
+
+      m_rollback_frame = *rollback_frame;
+      m_rollback_next_snapshot_frame = *rollback_frame + 1;
+      m_timebase_frame = timebase_frame;
+      return;
+    }
+  }
+
+  // Nothing is predicted before the first poll, so there's no need for a snapshot of frame 0. This
+  // also keeps us from saving a state while the emulated machine is still booting.
+  if (m_rollback_frame != 0 && m_rollback_frame >= m_rollback_next_snapshot_frame)
+  {
+    m_rollback->SaveSnapshot(system, m_rollback_frame, m_timebase_frame);
+    m_rollback_next_snapshot_frame = m_rollback_frame + 1;
+  }
+
+  if (m_rollback_resimulate_until && m_rollback_frame >= *m_rollback_resimulate_until)
+  {
+    m_rollback_resimulate_until.reset();
+    SetRollbackResimulating(false);
+  }
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SetRollbackResimulating(const bool resimulating)
+{
+  // Frames that are being re-simulated have already been shown and heard, and should run as fast
+  // as possible.
+  auto& system = Core::System::GetInstance();
+  system.GetVideoInterface().SetOutputSuppressed(resimulating);
+  system.GetCoreTiming().SetThrottleSuspended(resimulating);
+  if (SoundStream* sound_stream = system.GetSoundStream())
+    sound_stream->GetMixer()->SetInputSuppressed(resimulating);
+}
+
+void NetPlayClient::RecordPadToMovie(const int pad_nb, GCPadStatus* pad_status)
+{
   auto& movie = Core::System::GetInstance().GetMovie();
   if (movie.IsRecordingInput())
   {
@@ -2125,8 +2800,6 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
   {
     movie.CheckPadStatus(pad_status, pad_nb);
   }
-
-  return true;
 }
 
 u64 NetPlayClient::GetInitialRTCValue() const
@@ -2173,25 +2846,24 @@ bool NetPlayClient::WiimoteUpdate(const std::span<WiimoteDataBatchEntry>& entrie
   return true;
 }
 
-bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
+GCPadStatus NetPlayClient::GetLocalPadStatus(const int local_pad) const
 {
   const int ingame_pad = LocalPadToInGamePad(local_pad);
-  bool data_added = false;
-  GCPadStatus pad_status;
 
   if (m_gba_config[ingame_pad].enabled)
-  {
-    pad_status = Pad::GetGBAStatus(local_pad);
-  }
-  else if (Config::Get(Config::GetInfoForSIDevice(local_pad)) ==
-           SerialInterface::SIDEVICE_WIIU_ADAPTER)
-  {
-    pad_status = GCAdapter::Input(local_pad);
-  }
-  else
-  {
-    pad_status = Pad::GetStatus(local_pad);
-  }
+    return Pad::GetGBAStatus(local_pad);
+
+  if (Config::Get(Config::GetInfoForSIDevice(local_pad)) == SerialInterface::SIDEVICE_WIIU_ADAPTER)
+    return GCAdapter::Input(local_pad);
+
+  return Pad::GetStatus(local_pad);
+}
+
+bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
+{
+  const int ingame_pad = LocalPadToInGamePad(local_pad);
+  bool data_added = false;
+  const GCPadStatus pad_status = GetLocalPadStatus(local_pad);
 
   if (m_host_input_authority)
   {
@@ -2210,15 +2882,23 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
   }
   else
   {
+    // Only the buttons of GBAs are sent, like in the other modes.
+    GCPadStatus stream_status;
+    if (m_gba_config[ingame_pad].enabled)
+      stream_status.button = pad_status.button;
+    else
+      stream_status = pad_status;
+
     // adjust the buffer either up or down
     // inserting multiple padstates or dropping states
+    std::lock_guard lk(m_pad_stream_lock);
     while (m_pad_buffer[ingame_pad].Size() <= m_target_buffer_size)
     {
       // add to buffer
       m_pad_buffer[ingame_pad].Push(pad_status);
 
-      // add to packet
-      AddPadStateToPacket(ingame_pad, pad_status, packet);
+      // add to the stream, which SendPadDataBatch() sends
+      m_pad_stream_encoders[ingame_pad].Push(stream_status);
       data_added = true;
     }
   }
@@ -2226,6 +2906,42 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
   return data_added;
 }
 
+// called from ---CPU--- thread
+void NetPlayClient::RecoverPadData(const int pad_nb)
+{
+  // Batches are only sent when the game polls, and a receiver only notices a lost batch once the
+  // next one arrives. If the players wait on each other after losing each other's last batch,
+  // that never happens, so ask for the input we're waiting for and send ours again.
+  sf::Packet request;
+  request << MessageID::PadDataRequest;
+  request << static_cast<PadIndex>(pad_nb);
+  request << m_pad_entries_used[pad_nb] + m_pad_buffer[pad_nb].Size();
+  SendAsync(std::move(request));
+
+  SendPadDataBatch();
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendPadDataBatch()
+{
+  sf::Packet packet;
+  packet << MessageID::PadDataBatch;
+
+  const int num_local_pads = NumLocalPads();
+  packet << static_cast<u8>(num_local_pads);
+  for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
+    packet << static_cast<PadIndex>(LocalPadToInGamePad(local_pad));
+
+  {
+    std::lock_guard lk(m_pad_stream_lock);
+    for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
+      m_pad_stream_encoders[LocalPadToInGamePad(local_pad)].WriteRecent(packet);
+  }
+
+  if (num_local_pads > 0)
+    SendAsync(std::move(packet), PAD_DATA_CHANNEL);
+}
+
 bool NetPlayClient::AddLocalWiimoteToBuffer(const int local_wiimote,
                                             const WiimoteEmu::SerializedWiimoteState& state,
                                             sf::Packet& packet)
@@ -2522,7 +3238,12 @@ void NetPlayClient::SendTimeBase()
 {
   std::lock_guard lk(crit_netplay_client);
 
-  if (netplay_client->m_timebase_frame % 60 == 0)
+  // Spectators join late, so their frames don't line up with those of the players.
+  if (netplay_client->m_is_spectator)
+    return;
+
+  // Frames that are re-simulated after a rollback have already been reported.
+  if (netplay_client->m_timebase_frame % 60 == 0 && !netplay_client->m_rollback_resimulate_until)
   {
     const sf::Uint64 timebase = Core::System::GetInstance().GetSystemTimers().GetFakeTimeBase();
 
@@ -2534,6 +3255,23 @@ void NetPlayClient::SendTimeBase()
     netplay_client->SendAsync(std::move(packet));
   }
 
+  // The RAM hash, if enabled, is checked on every frame.
+  if (netplay_client->m_ram_hash)
+  {
+    const RAMHashDigest& digest = netplay_client->m_ram_hash->Update(
+        Core::System::GetInstance(), netplay_client->m_timebase_frame);
+
+    sf::Packet packet;
+    packet << MessageID::RAMHash;
+    packet << netplay_client->m_timebase_frame;
+    packet << static_cast<sf::Uint64>(digest.root);
+    packet << static_cast<u8>(digest.region_roots.size());
+    for (const u64 region_root : digest.region_roots)
+      packet << static_cast<sf::Uint64>(region_root);
+
+    netplay_client->SendAsync(std::move(packet));
+  }
+
   netplay_client->m_timebase_frame++;
 }
 
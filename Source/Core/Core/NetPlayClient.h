@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <thread>
@@ -17,10 +18,15 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/ENet.h"
 #include "Common/Event.h"
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayPadBufferController.h"
+#include "Core/NetPlayPadStream.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlayRAMHash.h"
+#include "Core/NetPlayRollback.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 
@@ -66,6 +72,8 @@ public:
   virtual void OnPadBufferChanged(u32 buffer) = 0;
   virtual void OnHostInputAuthorityChanged(bool enabled) = 0;
   virtual void OnDesync(u32 frame, const std::string& player) = 0;
+  virtual void OnRAMDesync(u32 first_frame, u32 last_frame, const std::string& player,
+                           const std::string& location) = 0;
   virtual void OnConnectionLost() = 0;
   virtual void OnConnectionError(const std::string& message) = 0;
   virtual void OnTraversalError(Common::TraversalClient::FailureReason error) = 0;
@@ -115,7 +123,8 @@ public:
   void SendAsync(sf::Packet&& packet, u8 channel_id = DEFAULT_CHANNEL);
 
   NetPlayClient(const std::string& address, const u16 port, NetPlayUI* dialog,
-                const std::string& name, const NetTraversalConfig& traversal_config);
+                const std::string& name, const NetTraversalConfig& traversal_config,
+                bool spectator = false);
   ~NetPlayClient();
 
   std::vector<const Player*> GetPlayers();
@@ -168,6 +177,10 @@ public:
   static void SendTimeBase();
   bool DoAllPlayersHaveGame();
 
+  // Called from the CPU thread at the end of a CoreTiming slice once HookSafePoint() has been
+  // called and there is work to do. Savestates can be saved and loaded there.
+  void OnSafePoint();
+
   const PadMappingArray& GetPadMapping() const;
   const GBAConfigArray& GetGBAConfig() const;
   const PadMappingArray& GetWiimoteMapping() const;
@@ -197,6 +210,7 @@ protected:
   } m_crit;
 
   Common::SPSCQueue<AsyncQueueEntry, false> m_async_queue;
+  Common::ENet::HostWakeup m_wakeup;
 
   std::array<Common::SPSCQueue<GCPadStatus>, 4> m_pad_buffer;
   std::array<Common::SPSCQueue<WiimoteEmu::SerializedWiimoteState>, 4> m_wiimote_buffer;
@@ -256,8 +270,20 @@ private:
   void SyncSaveDataResponse(bool success);
   void SyncCodeResponse(bool success);
 
+  GCPadStatus GetLocalPadStatus(int local_pad) const;
   bool PollLocalPad(int local_pad, sf::Packet& packet);
+  void SendPadDataBatch();
+  void RecoverPadData(int pad_nb);
   void SendPadHostPoll(PadIndex pad_num);
+  void RecordPadToMovie(int pad_nb, GCPadStatus* pad_status);
+
+  void HookSafePoint();
+  void OnRollbackSafePoint();
+  void OnSpectatorSafePoint();
+
+  bool GetRollbackPads(int pad_nb, bool batching, GCPadStatus* pad_status);
+  void SendRollbackLocalPads(FrameNum frame);
+  void SetRollbackResimulating(bool resimulating);
 
   bool AddLocalWiimoteToBuffer(int local_wiimote, const WiimoteEmu::SerializedWiimoteState& state,
                                sf::Packet& packet);
@@ -272,6 +298,7 @@ private:
   void SendGameStatus();
   void ComputeGameDigest(const SyncIdentifier& sync_identifier);
   void DisplayPlayersPing();
+  void UpdateAutoPadBuffer();
   u32 GetPlayersMaxPing() const;
 
   void OnData(sf::Packet& packet);
@@ -287,6 +314,15 @@ private:
   void OnGBAConfig(sf::Packet& packet);
   void OnPadData(sf::Packet& packet);
   void OnPadHostData(sf::Packet& packet);
+  void OnPadDataBatch(sf::Packet& packet);
+  bool ReadPadDataBatch(sf::Packet& packet);
+  void OnPadDataRequest(sf::Packet& packet);
+  void OnSpectatorPadData(sf::Packet& packet);
+  void ReadSpectatorPadData(sf::Packet& packet);
+  void ResyncSpectator();
+  void OnSpectatorSnapshotRequest();
+  void OnSpectatorSnapshot(sf::Packet& packet);
+  void OnRollbackPadData(sf::Packet& packet);
   void OnWiimoteData(sf::Packet& packet);
   void OnPadBuffer(sf::Packet& packet);
   void OnHostInputAuthority(sf::Packet& packet);
@@ -300,6 +336,8 @@ private:
   void OnPing(sf::Packet& packet);
   void OnPlayerPingData(sf::Packet& packet);
   void OnDesyncDetected(sf::Packet& packet);
+  void OnRAMHashBlocksRequest(sf::Packet& packet);
+  void OnRAMDesyncDetected(sf::Packet& packet);
   void OnSyncSaveData(sf::Packet& packet);
   void OnSyncSaveDataNotify(sf::Packet& packet);
   void OnSyncSaveDataRaw(sf::Packet& packet);
@@ -326,6 +364,7 @@ private:
   std::map<PlayerId, Player> m_players;
   std::string m_host_spec;
   std::string m_player_name;
+  bool m_is_spectator = false;
   bool m_connecting = false;
   Common::TraversalClient* m_traversal_client = nullptr;
   std::thread m_game_digest_thread;
@@ -344,9 +383,57 @@ private:
   bool m_sync_ar_codes_complete = false;
   std::unordered_map<u32, sf::Packet> m_chunked_data_receive_queue;
 
+  // Pad input in the fair input delay mode. The encoders are filled by the CPU thread and read by
+  // the NetPlay thread to answer requests for lost entries. The decoders are used by the NetPlay
+  // thread, except for spectators catching up with the game on the CPU thread.
+  std::mutex m_pad_stream_lock;
+  std::array<PadStreamEncoder, 4> m_pad_stream_encoders;
+  std::array<PadStreamDecoder, 4> m_pad_stream_decoders;
+  std::array<std::chrono::steady_clock::time_point, 4> m_pad_stream_request_time{};
+  // How many entries of every pad's stream the game has used. CPU thread only.
+  std::array<u32, 4> m_pad_entries_used{};
+
+  // Host side of spectators joining a running game: set by the NetPlay thread when the server asks
+  // for a savestate, which the CPU thread then takes at the next safe point.
+  Common::Flag m_spectator_snapshot_requested;
+  std::thread m_spectator_snapshot_thread;
+
+  // Spectator side: the NetPlay thread stores the host's savestate and holds on to the pad input
+  // until the CPU thread has loaded it at a safe point, which then sets m_spectator_synced.
+  std::mutex m_spectator_lock;
+  std::vector<u8> m_spectator_state;
+  std::array<u32, 4> m_spectator_entries_used{};
+  std::vector<sf::Packet> m_spectator_pending_pad_data;
+  Common::Flag m_spectator_synced;
+  // Set when the input a spectator needs is gone from the players' history, so it has to start
+  // over from a new savestate.
+  Common::Flag m_spectator_resync_needed;
+
+  // Automatic pad buffer size in the fair input delay mode. Pings are fed in by the NetPlay thread,
+  // the rest is only used by the CPU thread.
+  PadBufferController m_pad_buffer_controller;
+  bool m_pad_buffer_stalled = false;
+  u32 m_pad_buffer_stats_frames = 0;
+
   u64 m_initial_rtc = 0;
   u32 m_timebase_frame = 0;
 
+  // Only present while a game runs with RAM hash desync detection. Like m_rollback, it's created
+  // on the NetPlay thread and updated by the CPU thread.
+  std::unique_ptr<RAMHashTree> m_ram_hash;
+
+  // Only present while a game runs in the rollback network mode. Created and destroyed on the
+  // NetPlay thread, whose packets are the only other user of it.
+  std::unique_ptr<RollbackSession> m_rollback;
+  // All of the following are only used by the CPU thread.
+  bool m_safe_point_hooked = false;
+  // Number of batched polls so far, which is also the frame the next batched poll will be.
+  FrameNum m_rollback_frame = 0;
+  FrameNum m_rollback_next_local_frame = 0;
+  FrameNum m_rollback_next_snapshot_frame = 0;
+  // Set while re-simulating after a rollback, to the frame where we left off.
+  std::optional<FrameNum> m_rollback_resimulate_until;
+
   std::unique_ptr<IOS::HLE::FS::FileSystem> m_wii_sync_fs;
   std::vector<u64> m_wii_sync_titles;
   std::string m_wii_sync_redirect_folder;
@@ -0,0 +1,135 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayPadBufferController.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace NetPlay
+{
+void PadBufferController::RTTEstimate::AddSample(double sample)
+{
+  if (samples++ == 0)
+  {
+    rtt = sample;
+    deviation = 0;
+    return;
+  }
+
+  deviation = 0.75 * deviation + 0.25 * std::abs(rtt - sample);
+  rtt = 0.875 * rtt + 0.125 * sample;
+}
+
+void PadBufferController::Reset(u32 initial_buffer)
+{
+  std::lock_guard lk(m_lock);
+
+  // The RTT estimates are kept, since pings are measured outside of games too.
+  m_buffer = std::clamp(initial_buffer, MIN_BUFFER, MAX_BUFFER);
+  m_margin = 0;
+  m_frames_below = 0;
+  m_frames_since_stall = 0;
+}
+
+void PadBufferController::AddPingSample(PlayerId pid, bool is_local, u32 ping)
+{
+  std::lock_guard lk(m_lock);
+
+  if (is_local)
+    m_local.AddSample(ping);
+  else
+    m_remote[pid].AddSample(ping);
+}
+
+void PadBufferController::RemovePlayer(PlayerId pid)
+{
+  std::lock_guard lk(m_lock);
+
+  m_remote.erase(pid);
+}
+
+u32 PadBufferController::Update(double frame_time_ms, bool stalled)
+{
+  std::lock_guard lk(m_lock);
+
+  if (stalled)
+  {
+    m_margin = std::min(m_margin + 1, MAX_MARGIN);
+    m_frames_since_stall = 0;
+  }
+  else if (m_margin > 0 && ++m_frames_since_stall >= MARGIN_DECAY_FRAMES)
+  {
+    --m_margin;
+    m_frames_since_stall = 0;
+  }
+
+  // Keep the current size until there is something to go by.
+  if (!m_local.IsValid() || frame_time_ms <= 0)
+    return m_buffer;
+
+  bool any_remote = false;
+  double worst_latency = 0;
+  for (const auto& [pid, remote] : m_remote)
+  {
+    if (!remote.IsValid())
+      continue;
+
+    any_remote = true;
+    const double latency = (m_local.rtt + remote.rtt) / 2 +
+                           JITTER_FACTOR * (m_local.deviation + remote.deviation);
+    if (latency >= worst_latency)
+    {
+      worst_latency = latency;
+      m_worst_pid = pid;
+    }
+  }
+
+  if (!any_remote)
+    return m_buffer;
+
+  const u32 required =
+      std::clamp(static_cast<u32>(std::ceil(worst_latency / frame_time_ms)) + 1 + m_margin,
+                 MIN_BUFFER, MAX_BUFFER);
+
+  if (required > m_buffer)
+  {
+    m_buffer = required;
+    m_frames_below = 0;
+  }
+  else if (required < m_buffer)
+  {
+    if (++m_frames_below >= SHRINK_DELAY_FRAMES)
+    {
+      --m_buffer;
+      m_frames_below = 0;
+    }
+  }
+  else
+  {
+    m_frames_below = 0;
+  }
+
+  return m_buffer;
+}
+
+PadBufferController::Stats PadBufferController::GetStats() const
+{
+  std::lock_guard lk(m_lock);
+
+  Stats stats;
+  stats.buffer = m_buffer;
+  stats.margin = m_margin;
+  stats.local_rtt = static_cast<u32>(std::lround(m_local.rtt));
+  stats.local_jitter = static_cast<u32>(std::lround(m_local.deviation));
+
+  const auto worst = m_remote.find(m_worst_pid);
+  if (worst != m_remote.end())
+  {
+    stats.worst_rtt = static_cast<u32>(std::lround(worst->second.rtt));
+    stats.worst_jitter = static_cast<u32>(std::lround(worst->second.deviation));
+  }
+
+  return stats;
+}
+}  // namespace NetPlay
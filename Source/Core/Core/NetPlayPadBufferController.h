@@ -0,0 +1,85 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <mutex>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayProto.h"
+
+namespace NetPlay
+{
+// Picks the pad buffer size of the local player in the automatic buffer mode of fair input delay.
+//
+// The ping of every player to the server is smoothed like TCP smooths its RTT (RFC 6298): into a
+// moving average and a moving mean deviation, which stands in for the jitter. Unlike TCP, which
+// would rather wait too long than retransmit too early, the deviation starts at 0 instead of half
+// the first sample, since too much of it would be multiplied into a needlessly large buffer. An
+// estimate is only used after MIN_SAMPLES pings, once it has seen some jitter. Local input reaches
+// another player through the server, which takes about half of both of their RTTs. The buffer has
+// to cover that for the slowest other player, plus JITTER_FACTOR times their combined jitter, plus
+// a frame for polling.
+//
+// Running out of remote input in GetNetPads means input took longer than estimated. The way back
+// uses the same links, so each such stall also adds a frame of margin, which is taken away again
+// after MARGIN_DECAY_FRAMES frames without one.
+//
+// The buffer grows as soon as the estimate does, but only shrinks by one frame at a time once the
+// estimate has been lower for SHRINK_DELAY_FRAMES frames in a row.
+class PadBufferController
+{
+public:
+  static constexpr u32 MIN_BUFFER = 1;
+  static constexpr u32 MAX_BUFFER = 30;
+  static constexpr u32 MAX_MARGIN = 4;
+  static constexpr double JITTER_FACTOR = 4.0;
+  static constexpr u32 MIN_SAMPLES = 4;
+  static constexpr u32 SHRINK_DELAY_FRAMES = 180;
+  static constexpr u32 MARGIN_DECAY_FRAMES = 600;
+
+  struct Stats
+  {
+    u32 buffer = 0;
+    u32 margin = 0;
+    u32 local_rtt = 0;
+    u32 local_jitter = 0;
+    u32 worst_rtt = 0;
+    u32 worst_jitter = 0;
+  };
+
+  // Called when a game starts.
+  void Reset(u32 initial_buffer);
+
+  // Called from the NetPlay thread.
+  void AddPingSample(PlayerId pid, bool is_local, u32 ping);
+  void RemovePlayer(PlayerId pid);
+
+  // Called from the CPU thread once per frame. Returns the new buffer size.
+  u32 Update(double frame_time_ms, bool stalled);
+  Stats GetStats() const;
+
+private:
+  struct RTTEstimate
+  {
+    double rtt = 0;
+    double deviation = 0;
+    u32 samples = 0;
+
+    void AddSample(double sample);
+    bool IsValid() const { return samples >= MIN_SAMPLES; }
+  };
+
+  mutable std::mutex m_lock;
+
+  RTTEstimate m_local;
+  std::map<PlayerId, RTTEstimate> m_remote;
+  PlayerId m_worst_pid = 0;
+
+  u32 m_buffer = MIN_BUFFER;
+  u32 m_margin = 0;
+  u32 m_frames_below = 0;
+  u32 m_frames_since_stall = 0;
+};
+}  // namespace NetPlay
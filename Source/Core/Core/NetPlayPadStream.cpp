@@ -0,0 +1,145 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayPadStream.h"
+
+#include <algorithm>
+
+namespace NetPlay
+{
+namespace
+{
+enum FieldGroup : u8
+{
+  BUTTON = 1 << 0,
+  ANALOG = 1 << 1,
+  STICK = 1 << 2,
+  SUBSTICK = 1 << 3,
+  TRIGGERS = 1 << 4,
+  CONNECTED = 1 << 5,
+};
+}  // namespace
+
+static void WriteEntry(sf::Packet& packet, const GCPadStatus& previous, const GCPadStatus& status)
+{
+  u8 mask = 0;
+  if (status.button != previous.button)
+    mask |= BUTTON;
+  if (status.analogA != previous.analogA || status.analogB != previous.analogB)
+    mask |= ANALOG;
+  if (status.stickX != previous.stickX || status.stickY != previous.stickY)
+    mask |= STICK;
+  if (status.substickX != previous.substickX || status.substickY != previous.substickY)
+    mask |= SUBSTICK;
+  if (status.triggerLeft != previous.triggerLeft || status.triggerRight != previous.triggerRight)
+    mask |= TRIGGERS;
+  if (status.isConnected != previous.isConnected)
+    mask |= CONNECTED;
+
+  packet << mask;
+  if (mask & BUTTON)
+    packet << status.button;
+  if (mask & ANALOG)
+    packet << status.analogA << status.analogB;
+  if (mask & STICK)
+    packet << status.stickX << status.stickY;
+  if (mask & SUBSTICK)
+    packet << status.substickX << status.substickY;
+  if (mask & TRIGGERS)
+    packet << status.triggerLeft << status.triggerRight;
+  if (mask & CONNECTED)
+    packet << status.isConnected;
+}
+
+// Updates status, which holds the previous entry, to the next one.
+static void ReadEntry(sf::Packet& packet, GCPadStatus* status)
+{
+  u8 mask = 0;
+  packet >> mask;
+  if (mask & BUTTON)
+    packet >> status->button;
+  if (mask & ANALOG)
+    packet >> status->analogA >> status->analogB;
+  if (mask & STICK)
+    packet >> status->stickX >> status->stickY;
+  if (mask & SUBSTICK)
+    packet >> status->substickX >> status->substickY;
+  if (mask & TRIGGERS)
+    packet >> status->triggerLeft >> status->triggerRight;
+  if (mask & CONNECTED)
+    packet >> status->isConnected;
+}
+
+void PadStreamEncoder::Reset()
+{
+  m_next_entry = 0;
+}
+
+void PadStreamEncoder::Push(const GCPadStatus& status)
+{
+  m_history[m_next_entry % HISTORY_SIZE] = status;
+  ++m_next_entry;
+}
+
+bool PadStreamEncoder::Write(sf::Packet& packet, u32 first_entry) const
+{
+  const u32 oldest_entry = m_next_entry - std::min(m_next_entry, HISTORY_SIZE);
+  const bool complete = first_entry >= oldest_entry;
+  first_entry = std::clamp(first_entry, oldest_entry, m_next_entry);
+
+  packet << first_entry;
+  packet << static_cast<u8>(m_next_entry - first_entry);
+
+  GCPadStatus previous;
+  for (u32 entry = first_entry; entry < m_next_entry; ++entry)
+  {
+    const GCPadStatus& status = m_history[entry % HISTORY_SIZE];
+    WriteEntry(packet, previous, status);
+    previous = status;
+  }
+
+  return complete;
+}
+
+void PadStreamEncoder::WriteRecent(sf::Packet& packet) const
+{
+  Write(packet, m_next_entry - std::min(m_next_entry, REDUNDANT_ENTRIES));
+}
+
+void PadStreamDecoder::Reset(u32 next_entry)
+{
+  m_next_entry = next_entry;
+  m_end_entry = next_entry;
+}
+
+bool PadStreamDecoder::Read(sf::Packet& packet, std::vector<GCPadStatus>* new_entries,
+                            bool* entries_missing)
+{
+  u32 first_entry = 0;
+  u8 count = 0;
+  packet >> first_entry >> count;
+  *entries_missing = first_entry > m_next_entry;
+  m_end_entry = std::max(m_end_entry, first_entry + count);
+
+  GCPadStatus status;
+  for (u32 entry = first_entry; entry < first_entry + count; ++entry)
+  {
+    ReadEntry(packet, &status);
+    if (!packet)
+      return false;
+
+    if (entry == m_next_entry)
+    {
+      new_entries->push_back(status);
+      ++m_next_entry;
+    }
+  }
+
+  return static_cast<bool>(packet);
+}
+
+bool PadStreamDecoder::CanCatchUp() const
+{
+  return m_end_entry - m_next_entry <= PadStreamEncoder::HISTORY_SIZE;
+}
+}  // namespace NetPlay
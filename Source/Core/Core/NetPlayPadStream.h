@@ -0,0 +1,73 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+
+#include "Common/CommonTypes.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// Wire format of GC pad input in the fair input delay mode.
+//
+// The input of every pad is a stream of entries, one for every state pushed to its pad buffer,
+// numbered from 0 at the start of the game. A PadDataBatch message holds the newest entries of all
+// of a player's pads:
+//
+//   u8 pad count, PadIndex for every pad, then for every pad:
+//   u32 number of the first entry, u8 entry count, entries
+//
+// Every entry is a u8 mask of the field groups that changed since the previous entry of the
+// message, followed by those fields. The first entry is compared against a default GCPadStatus.
+// The pad indices come first so that the server can check them and relay the message as is.
+//
+// Batches are sent unreliably and repeat the last REDUNDANT_ENTRIES entries, so one that gets lost
+// is made up for by the next. A receiver that still misses entries asks for them again.
+class PadStreamEncoder
+{
+public:
+  static constexpr u32 HISTORY_SIZE = 128;
+  static constexpr u32 REDUNDANT_ENTRIES = 8;
+
+  void Reset();
+  void Push(const GCPadStatus& status);
+  u32 GetNextEntry() const { return m_next_entry; }
+
+  // Writes the entries from the given one up to the newest. Entries that are no longer in the
+  // history are skipped; returns false in that case.
+  bool Write(sf::Packet& packet, u32 first_entry) const;
+  // Writes the last REDUNDANT_ENTRIES entries.
+  void WriteRecent(sf::Packet& packet) const;
+
+private:
+  std::array<GCPadStatus, HISTORY_SIZE> m_history{};
+  u32 m_next_entry = 0;
+};
+
+class PadStreamDecoder
+{
+public:
+  // Starts at the given entry, for spectators that join from a savestate.
+  void Reset(u32 next_entry = 0);
+  u32 GetNextEntry() const { return m_next_entry; }
+
+  // Reads the entries of one pad and appends those that weren't read before to new_entries.
+  // entries_missing is set if there is a gap before the entries in the packet, which then can't be
+  // used. Returns false if the packet is malformed.
+  bool Read(sf::Packet& packet, std::vector<GCPadStatus>* new_entries, bool* entries_missing);
+
+  // Whether the sender still has the entries that are missing. It only keeps the last
+  // PadStreamEncoder::HISTORY_SIZE entries of its stream.
+  bool CanCatchUp() const;
+
+private:
+  u32 m_next_entry = 0;
+  // One past the newest entry seen in a packet.
+  u32 m_end_entry = 0;
+};
+}  // namespace NetPlay
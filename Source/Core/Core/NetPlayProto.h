@@ -105,6 +105,10 @@ struct NetSettings
   bool golf_mode = false;
   bool use_fma = false;
   bool hide_remote_gbas = false;
+  bool rollback = false;
+  u32 rollback_max_frames = 0;
+  bool auto_pad_buffer = false;
+  bool ram_hash_desync_detection = false;
 
   Sram sram;
 
@@ -150,6 +154,10 @@ enum class MessageID : u8
   PadBuffer = 0x62,
   PadHostData = 0x63,
   GBAConfig = 0x64,
+  RollbackPadData = 0x65,
+  PadDataBatch = 0x66,
+  PadDataRequest = 0x67,
+  SpectatorPadData = 0x68,
 
   WiimoteData = 0x70,
   WiimoteMapping = 0x71,
@@ -168,9 +176,15 @@ enum class MessageID : u8
   ClientCapabilities = 0xA5,
   HostInputAuthority = 0xA6,
   PowerButton = 0xA7,
+  SpectatorSnapshotRequest = 0xA8,
+  SpectatorSnapshot = 0xA9,
 
   TimeBase = 0xB0,
   DesyncDetected = 0xB1,
+  RAMHash = 0xB2,
+  RAMHashBlocksRequest = 0xB3,
+  RAMHashBlocks = 0xB4,
+  RAMDesyncDetected = 0xB5,
 
   ComputeGameDigest = 0xC0,
   GameDigestProgress = 0xC1,
@@ -228,6 +242,8 @@ enum : u8
 {
   DEFAULT_CHANNEL,
   CHUNKED_DATA_CHANNEL,
+  // Unreliable. Only used for PadDataBatch, which carries enough redundancy to cope with loss.
+  PAD_DATA_CHANNEL,
   CHANNEL_COUNT
 };
 
@@ -0,0 +1,231 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRAMHash.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <xxhash.h>
+
+#include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
+#include "Core/System.h"
+
+namespace NetPlay
+{
+static u64 HashHashes(const u64* hashes, size_t count)
+{
+  return XXH3_64bits(hashes, count * sizeof(u64));
+}
+
+const RAMHashDigest& RAMHashTree::Update(Core::System& system, u32 frame)
+{
+  const std::vector<std::span<u8>> regions = HW::GetBulkMemoryRegions(system);
+  if (!IsLayoutCurrent(regions))
+  {
+    ResetLayout(regions);
+    NameRegions(system);
+  }
+
+  return Update(regions, frame);
+}
+
+const RAMHashDigest& RAMHashTree::Update(const std::vector<std::span<u8>>& regions, u32 frame)
+{
+  if (!IsLayoutCurrent(regions))
+    ResetLayout(regions);
+
+  const u32 slice = frame % HASH_SLICES;
+  bool any_region_dirty = m_all_dirty;
+  for (size_t r = 0; r < m_regions.size(); ++r)
+  {
+    const Region& region = m_regions[r];
+    bool region_dirty = m_all_dirty;
+    for (size_t b = 0; b < region.block_count; ++b)
+    {
+      if (!m_all_dirty && (region.first_block + b) % HASH_SLICES != slice)
+        continue;
+
+      const size_t block_offset = b * BLOCK_SIZE;
+      const size_t block_end = std::min(block_offset + BLOCK_SIZE, region.memory.size());
+      const size_t first_page = region.first_page + b * PAGES_PER_BLOCK;
+
+      bool block_dirty = m_all_dirty;
+      size_t page = first_page;
+      for (size_t offset = block_offset; offset < block_end; offset += PAGE_SIZE, ++page)
+      {
+        const size_t size = std::min(PAGE_SIZE, block_end - offset);
+        const u64 hash = XXH3_64bits(region.memory.data() + offset, size);
+        if (hash != m_page_hashes[page])
+        {
+          m_page_hashes[page] = hash;
+          block_dirty = true;
+        }
+      }
+
+      if (block_dirty)
+      {
+        m_block_hashes[region.first_block + b] =
+            HashHashes(&m_page_hashes[first_page], page - first_page);
+        region_dirty = true;
+      }
+    }
+
+    if (region_dirty)
+    {
+      m_digest.region_roots[r] =
+          HashHashes(m_block_hashes.data() + region.first_block, region.block_count);
+      any_region_dirty = true;
+    }
+  }
+
+  if (any_region_dirty)
+    m_digest.root = HashHashes(m_digest.region_roots.data(), m_digest.region_roots.size());
+  m_all_dirty = false;
+
+  std::lock_guard lk(m_lock);
+  HistoryEntry& entry = m_history[frame % HISTORY_SIZE];
+  entry.frame = frame;
+  entry.block_hashes = m_block_hashes;
+
+  return m_digest;
+}
+
+std::optional<std::vector<u64>> RAMHashTree::GetBlockHashes(u32 frame, u8 region) const
+{
+  std::lock_guard lk(m_lock);
+
+  const HistoryEntry& entry = m_history[frame % HISTORY_SIZE];
+  if (entry.frame != frame || region >= m_regions.size())
+    return std::nullopt;
+
+  const Region& r = m_regions[region];
+  const auto begin = entry.block_hashes.begin() + r.first_block;
+  return std::vector<u64>(begin, begin + r.block_count);
+}
+
+std::string RAMHashTree::DescribeBlock(u8 region, std::optional<u32> block) const
+{
+  std::lock_guard lk(m_lock);
+
+  if (region >= m_regions.size())
+    return fmt::format("region {}", region);
+
+  const Region& r = m_regions[region];
+  if (!block || *block >= r.block_count)
+    return r.name;
+
+  const size_t offset = *block * BLOCK_SIZE;
+  const size_t size = std::min(BLOCK_SIZE, r.memory.size() - offset);
+  return fmt::format("{} {:#010x}-{:#010x}", r.name, r.address + offset,
+                     r.address + offset + size - 1);
+}
+
+bool RAMHashTree::IsLayoutCurrent(const std::vector<std::span<u8>>& regions) const
+{
+  return std::equal(regions.begin(), regions.end(), m_regions.begin(), m_regions.end(),
+                    [](std::span<u8> a, const Region& b) {
+                      return a.data() == b.memory.data() && a.size() == b.memory.size();
+                    });
+}
+
+void RAMHashTree::ResetLayout(const std::vector<std::span<u8>>& regions)
+{
+  std::lock_guard lk(m_lock);
+
+  m_regions.clear();
+  size_t page_count = 0;
+  size_t block_count = 0;
+  for (const std::span<u8> memory_region : regions)
+  {
+    Region& region = m_regions.emplace_back();
+    region.memory = memory_region;
+    region.name = fmt::format("region {}", m_regions.size() - 1);
+    region.address = 0;
+    region.first_page = page_count;
+    region.first_block = block_count;
+    region.block_count = (memory_region.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    page_count += (memory_region.size() + PAGE_SIZE - 1) / PAGE_SIZE;
+    block_count += region.block_count;
+  }
+
+  m_page_hashes.assign(page_count, 0);
+  m_block_hashes.assign(block_count, 0);
+  m_digest.region_roots.assign(m_regions.size(), 0);
+  m_all_dirty = true;
+
+  // Block indices of older frames don't match anymore.
+  for (HistoryEntry& entry : m_history)
+    entry.frame = INVALID_FRAME;
+}
+
+void RAMHashTree::NameRegions(Core::System& system)
+{
+  std::lock_guard lk(m_lock);
+
+  auto& memory = system.GetMemory();
+  for (Region& region : m_regions)
+  {
+    if (region.memory.data() == memory.GetRAM())
+    {
+      region.name = "MEM1";
+      region.address = 0x80000000;
+    }
+    else if (region.memory.data() == memory.GetEXRAM())
+    {
+      region.name = "MEM2";
+      region.address = 0x90000000;
+    }
+    else if (region.memory.data() == memory.GetL1Cache())
+    {
+      region.name = "L1 cache";
+      region.address = 0xE0000000;
+    }
+    else if (region.memory.data() == memory.GetFakeVMEM())
+    {
+      region.name = "fake VMEM";
+      region.address = 0x7E000000;
+    }
+    else
+    {
+      region.name = "ARAM";
+      region.address = 0;
+    }
+  }
+}
+
+std::optional<RAMHashMismatch> CompareRAMHashDigests(std::span<const RAMHashDigest> digests)
+{
+  if (std::all_of(digests.begin(), digests.end(),
+                  [&](const RAMHashDigest& digest) { return digest.root == digests[0].root; }))
+  {
+    return std::nullopt;
+  }
+
+  // Blame the player whose memory differs from everyone else's, if there is one.
+  size_t blamed = 0;
+  for (size_t i = 0; i < digests.size(); ++i)
+  {
+    if (std::count_if(digests.begin(), digests.end(), [&](const RAMHashDigest& other) {
+          return other.root == digests[i].root;
+        }) == 1)
+    {
+      blamed = i;
+      break;
+    }
+  }
+
+  // The first region that differs from another player's memory is the one to narrow down.
+  const auto other = std::find_if(digests.begin(), digests.end(), [&](const RAMHashDigest& digest) {
+    return digest.root != digests[blamed].root;
+  });
+  const std::vector<u64>& lhs = digests[blamed].region_roots;
+  const std::vector<u64>& rhs = other->region_roots;
+  const auto region =
+      std::mismatch(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()).first - lhs.begin();
+
+  return RAMHashMismatch{blamed, static_cast<u8>(region)};
+}
+}  // namespace NetPlay
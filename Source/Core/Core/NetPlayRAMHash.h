@@ -0,0 +1,109 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Core
+{
+class System;
+}
+
+namespace NetPlay
+{
+struct RAMHashDigest
+{
+  u64 root = 0;
+  // One hash per bulk memory region, in the order of HW::GetBulkMemoryRegions().
+  std::vector<u64> region_roots;
+};
+
+// Hashes the bulk memory regions of the emulated machine (MEM1, MEM2, ARAM, ...) once per frame
+// for the RAM hash desync detection.
+//
+// The page hashes are the leaves of a small tree per region: every block hash covers
+// PAGES_PER_BLOCK page hashes, and the region root covers the block hashes of the region. Players
+// exchange the digest every frame, and the block hashes of the last HISTORY_SIZE frames are kept so
+// that a mismatch can be narrowed down to a block afterwards.
+//
+// As for DeltaSnapshotRing, dirty pages are found by hashing rather than by write-protecting the
+// memory, since that would get in the way of fastmem. Hashing all of MEM1, MEM2 and ARAM takes a
+// few milliseconds, which is too much to do every frame, so an update only rehashes the pages of
+// one in HASH_SLICES blocks. Which ones is decided by the frame number, so every player hashes the
+// same blocks on the same frame, and a change shows up in the digest within HASH_SLICES frames.
+class RAMHashTree
+{
+public:
+  static constexpr size_t PAGE_SIZE = 0x1000;
+  static constexpr size_t PAGES_PER_BLOCK = 64;
+  static constexpr size_t BLOCK_SIZE = PAGE_SIZE * PAGES_PER_BLOCK;
+  static constexpr u32 HASH_SLICES = 8;
+  static constexpr u32 HISTORY_SIZE = 120;
+
+  // Called from the CPU thread once per frame.
+  const RAMHashDigest& Update(Core::System& system, u32 frame);
+  // Same as above, for memory regions that aren't the ones of the emulated machine.
+  const RAMHashDigest& Update(const std::vector<std::span<u8>>& regions, u32 frame);
+
+  // Called from the NetPlay thread. Returns nothing if the frame is no longer in the history.
+  std::optional<std::vector<u64>> GetBlockHashes(u32 frame, u8 region) const;
+
+  // Called from the NetPlay thread. Describes a region, or a block of it, for the user.
+  std::string DescribeBlock(u8 region, std::optional<u32> block) const;
+
+private:
+  static constexpr u32 INVALID_FRAME = std::numeric_limits<u32>::max();
+
+  struct Region
+  {
+    std::span<u8> memory;
+    std::string name;
+    u32 address;
+    size_t first_page;
+    size_t first_block;
+    size_t block_count;
+  };
+
+  struct HistoryEntry
+  {
+    u32 frame = INVALID_FRAME;
+    std::vector<u64> block_hashes;
+  };
+
+  bool IsLayoutCurrent(const std::vector<std::span<u8>>& regions) const;
+  void ResetLayout(const std::vector<std::span<u8>>& regions);
+  void NameRegions(Core::System& system);
+
+  // Guards the layout and the history, which are read from the NetPlay thread.
+  mutable std::mutex m_lock;
+
+  std::vector<Region> m_regions;
+  std::vector<u64> m_page_hashes;
+  std::vector<u64> m_block_hashes;
+  bool m_all_dirty = true;
+  RAMHashDigest m_digest;
+
+  std::array<HistoryEntry, HISTORY_SIZE> m_history;
+};
+
+struct RAMHashMismatch
+{
+  // The digest that differs from all the others, or the first one if none of them stands out.
+  size_t blamed;
+  // The first region in which the blamed digest differs from another one.
+  u8 region;
+};
+
+// Compares the digests of every player for a frame. Returns nothing if they all match.
+std::optional<RAMHashMismatch> CompareRAMHashDigests(std::span<const RAMHashDigest> digests);
+}  // namespace NetPlay
@@ -0,0 +1,121 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRollback.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Common/Logging/Log.h"
+
+namespace NetPlay
+{
+RollbackSession::RollbackSession(u32 max_rollback_frames)
+    : m_max_rollback_frames(std::min(max_rollback_frames, MAX_ROLLBACK_FRAMES))
+{
+  for (PadHistory& history : m_pads)
+    history.used_frame.fill(INVALID_FRAME);
+}
+
+void RollbackSession::AddInput(PadIndex pad, FrameNum frame, const GCPadStatus& status)
+{
+  std::lock_guard lk(m_input_lock);
+
+  PadHistory& history = m_pads.at(pad);
+  if (frame != history.confirmed_count)
+  {
+    WARN_LOG_FMT(NETPLAY, "Rollback: dropping input for pad {} frame {}, expected frame {}", pad,
+                 frame, history.confirmed_count);
+    return;
+  }
+
+  const size_t index = frame % INPUT_HISTORY_SIZE;
+  history.confirmed[index] = status;
+  history.confirmed_count = frame + 1;
+
+  if (history.used_frame[index] == frame && !SamePadStatus(history.used[index], status))
+  {
+    DEBUG_LOG_FMT(NETPLAY, "Rollback: misprediction for pad {} on frame {}", pad, frame);
+    m_rollback_frame = m_rollback_frame ? std::min(*m_rollback_frame, frame) : frame;
+  }
+}
+
+std::optional<GCPadStatus> RollbackSession::GetInput(PadIndex pad, FrameNum frame)
+{
+  std::lock_guard lk(m_input_lock);
+
+  PadHistory& history = m_pads.at(pad);
+  GCPadStatus status;
+  if (frame < history.confirmed_count)
+  {
+    status = history.confirmed[frame % INPUT_HISTORY_SIZE];
+  }
+  else
+  {
+    // The earliest frame we could have to roll back to is the first unconfirmed one.
+    const FrameNum first_unconfirmed = history.confirmed_count;
+    if (frame - first_unconfirmed >= m_max_rollback_frames || !HasSnapshot(first_unconfirmed) ||
+        !HasSnapshot(frame))
+    {
+      return std::nullopt;
+    }
+
+    status = first_unconfirmed == 0 ?
+                 NeutralPadStatus() :
+                 history.confirmed[(first_unconfirmed - 1) % INPUT_HISTORY_SIZE];
+  }
+
+  const size_t index = frame % INPUT_HISTORY_SIZE;
+  history.used_frame[index] = frame;
+  history.used[index] = status;
+  return status;
+}
+
+std::optional<FrameNum> RollbackSession::TakeRollbackFrame()
+{
+  std::lock_guard lk(m_input_lock);
+  return std::exchange(m_rollback_frame, std::nullopt);
+}
+
+void RollbackSession::SaveSnapshot(Core::System& system, FrameNum frame, u32 timebase_frame)
+{
+  m_snapshot_timebase_frames[frame % m_snapshot_timebase_frames.size()] = timebase_frame;
+  m_snapshots.Save(system, frame);
+}
+
+bool RollbackSession::LoadSnapshot(Core::System& system, FrameNum frame, u32* timebase_frame)
+{
+  if (!m_snapshots.Load(system, frame))
+  {
+    ERROR_LOG_FMT(NETPLAY, "Rollback: failed to load snapshot for frame {}", frame);
+    return false;
+  }
+
+  *timebase_frame = m_snapshot_timebase_frames[frame % m_snapshot_timebase_frames.size()];
+  return true;
+}
+
+bool RollbackSession::HasSnapshot(FrameNum frame) const
+{
+  return m_snapshots.Contains(frame);
+}
+
+bool RollbackSession::SamePadStatus(const GCPadStatus& lhs, const GCPadStatus& rhs)
+{
+  return lhs.button == rhs.button && lhs.stickX == rhs.stickX && lhs.stickY == rhs.stickY &&
+         lhs.substickX == rhs.substickX && lhs.substickY == rhs.substickY &&
+         lhs.triggerLeft == rhs.triggerLeft && lhs.triggerRight == rhs.triggerRight &&
+         lhs.analogA == rhs.analogA && lhs.analogB == rhs.analogB &&
+         lhs.isConnected == rhs.isConnected;
+}
+
+GCPadStatus RollbackSession::NeutralPadStatus()
+{
+  GCPadStatus status;
+  status.stickX = GCPadStatus::MAIN_STICK_CENTER_X;
+  status.stickY = GCPadStatus::MAIN_STICK_CENTER_Y;
+  status.substickX = GCPadStatus::C_STICK_CENTER_X;
+  status.substickY = GCPadStatus::C_STICK_CENTER_Y;
+  return status;
+}
+}  // namespace NetPlay
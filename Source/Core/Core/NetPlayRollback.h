@@ -0,0 +1,91 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/DeltaSnapshotRing.h"
+#include "Core/NetPlayProto.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace Core
+{
+class System;
+}
+
+namespace NetPlay
+{
+// Input history and savestate ring for the rollback network mode.
+//
+// Every batched SI poll is one input frame. Remote pads that haven't arrived for the polled frame
+// yet are predicted by repeating their last known input, and the inputs handed to the game are
+// remembered. When the real input for an already simulated frame arrives and differs from what was
+// used, that frame is marked for rollback: the CPU thread then loads the snapshot taken just
+// before the frame was polled and re-simulates up to where it was.
+class RollbackSession
+{
+public:
+  // Inputs are kept for this many frames. It only has to cover the rollback window plus the input
+  // delay of every player, which are both capped far below this.
+  static constexpr u32 INPUT_HISTORY_SIZE = 128;
+  static constexpr u32 MAX_ROLLBACK_FRAMES = 30;
+  static constexpr u32 MAX_INPUT_DELAY = 16;
+
+  explicit RollbackSession(u32 max_rollback_frames);
+
+  u32 GetMaxRollbackFrames() const { return m_max_rollback_frames; }
+
+  // Called from the CPU thread for local pads and the NetPlay thread for remote ones.
+  // Inputs of a pad must be added in frame order without gaps.
+  void AddInput(PadIndex pad, FrameNum frame, const GCPadStatus& status);
+
+  // Called from the CPU thread. Returns the confirmed input of the pad for the given frame, or a
+  // prediction if it hasn't arrived yet. Returns nothing if the frame may not be predicted, either
+  // because it's too far ahead of the last confirmed input or because there is no snapshot to roll
+  // back to, in which case the caller has to wait for more input.
+  std::optional<GCPadStatus> GetInput(PadIndex pad, FrameNum frame);
+
+  // Returns the earliest frame that was simulated with a wrong prediction and clears it.
+  std::optional<FrameNum> TakeRollbackFrame();
+
+  // The snapshot ring is only touched by the CPU thread.
+  // The snapshot for a frame holds the emulated machine right before that frame is polled.
+  void SaveSnapshot(Core::System& system, FrameNum frame, u32 timebase_frame);
+  bool LoadSnapshot(Core::System& system, FrameNum frame, u32* timebase_frame);
+  bool HasSnapshot(FrameNum frame) const;
+
+private:
+  static constexpr FrameNum INVALID_FRAME = std::numeric_limits<FrameNum>::max();
+
+  struct PadHistory
+  {
+    // Frames [0, confirmed_count) have been confirmed.
+    FrameNum confirmed_count = 0;
+    std::array<GCPadStatus, INPUT_HISTORY_SIZE> confirmed{};
+
+    std::array<FrameNum, INPUT_HISTORY_SIZE> used_frame{};
+    std::array<GCPadStatus, INPUT_HISTORY_SIZE> used{};
+  };
+
+  static bool SamePadStatus(const GCPadStatus& lhs, const GCPadStatus& rhs);
+  static GCPadStatus NeutralPadStatus();
+
+  const u32 m_max_rollback_frames;
+
+  std::mutex m_input_lock;
+  std::array<PadHistory, 4> m_pads;
+  std::optional<FrameNum> m_rollback_frame;
+
+  // The newest snapshot is the one the current frame started from, and a rollback can reach back
+  // to the oldest frame that is still allowed to be unconfirmed.
+  State::DeltaSnapshotRing m_snapshots{m_max_rollback_frames + 2};
+  // Timebase frame of every snapshot, indexed by its frame modulo the size.
+  std::vector<u32> m_snapshot_timebase_frames = std::vector<u32>(m_max_rollback_frames + 2);
+};
+}  // namespace NetPlay
@@ -86,11 +86,19 @@
 
 namespace NetPlay
 {
+// Taking a savestate for spectators holds up the host's game for a moment, so spectators joining
+// around the same time share one, and the host is asked at most this often.
+constexpr std::chrono::seconds SPECTATOR_SNAPSHOT_INTERVAL{5};
+// The host sends the savestate over the chunked data channel before it's relayed, which can take
+// a while for large states on slow connections. It's asked again if nothing arrives in time.
+constexpr std::chrono::seconds SPECTATOR_SNAPSHOT_TIMEOUT{60};
+
 NetPlayServer::~NetPlayServer()
 {
   if (is_connected)
   {
     m_do_loop = false;
+    Common::ENet::WakeupThread(m_server);
     m_chunked_data_event.Set();
     m_chunked_data_complete_event.Set();
     if (m_chunked_data_thread.joinable())
@@ -273,7 +281,16 @@ void NetPlayServer::ThreadFunc()
     int net;
     if (m_traversal_client)
       m_traversal_client->HandleResends();
-    net = enet_host_service(m_server, &netEvent, 1000);
+    // Don't sleep past the next ping, or past when pad data is due to go out to spectators.
+    const u64 ping_elapsed = m_ping_timer.ElapsedMs();
+    u32 timeout = ping_elapsed > 1000 ? 0 : static_cast<u32>(1001 - ping_elapsed);
+    if (!m_spectators.empty())
+    {
+      const auto spectator_wait = m_spectator_relay.GetTimeUntilNextMessage();
+      timeout = static_cast<u32>(std::min<s64>(timeout, spectator_wait.count()));
+    }
+    net = enet_host_service(m_server, &netEvent, timeout);
+    m_wakeup.Reset();
     while (!m_async_queue.Empty())
     {
       INFO_LOG_FMT(NETPLAY, "Processing async queue event.");
@@ -285,10 +302,14 @@ void NetPlayServer::ThreadFunc()
         {
           if (m_players.find(e.target_pid) != m_players.end())
             Send(m_players.at(e.target_pid).socket, e.packet, e.channel_id);
+          else if (m_spectators.find(e.target_pid) != m_spectators.end())
+            Send(m_spectators.at(e.target_pid).socket, e.packet, e.channel_id);
         }
         else
         {
           SendToClients(e.packet, e.target_pid, e.channel_id);
+          if (e.include_spectators)
+            SendToSpectators(e.packet);
         }
       }
       INFO_LOG_FMT(NETPLAY, "Processing async queue event done.");
@@ -338,6 +359,21 @@ void NetPlayServer::ThreadFunc()
             enet_peer_disconnect_later(netEvent.peer, 0);
           }
         }
+        else if (const auto spectator_it = m_spectators.find(*PeerPlayerId(netEvent.peer));
+                 spectator_it != m_spectators.end())
+        {
+          Client& spectator = spectator_it->second;
+          if (OnSpectatorData(rpac, spectator) != 0)
+          {
+            INFO_LOG_FMT(NETPLAY, "Invalid packet from spectator {}, disconnecting.",
+                         spectator.pid);
+
+            std::lock_guard lkg(m_crit.game);
+            OnSpectatorDisconnect(spectator);
+
+            ClearPeerPlayerId(netEvent.peer);
+          }
+        }
         else
         {
           auto it = m_players.find(*PeerPlayerId(netEvent.peer));
@@ -380,6 +416,14 @@ void NetPlayServer::ThreadFunc()
 
           ClearPeerPlayerId(netEvent.peer);
         }
+        else if (const auto spectator_it = m_spectators.find(player_id);
+                 spectator_it != m_spectators.end())
+        {
+          INFO_LOG_FMT(NETPLAY, "Disconnecting spectator {}.", player_id);
+          OnSpectatorDisconnect(spectator_it->second);
+
+          ClearPeerPlayerId(netEvent.peer);
+        }
         else
         {
           ERROR_LOG_FMT(NETPLAY, "Invalid player {} to disconnect.", player_id);
@@ -403,6 +447,12 @@ void NetPlayServer::ThreadFunc()
     {
       ERROR_LOG_FMT(NETPLAY, "enet_host_service error: {}", net);
     }
+
+    UpdateSpectators();
+
+    // enet_host_service only sends when it has no received events left to return, so relay what
+    // was queued above and by OnData right away instead.
+    enet_host_flush(m_server);
   }
 
   INFO_LOG_FMT(NETPLAY, "NetPlayServer shutting down.");
@@ -414,6 +464,12 @@ void NetPlayServer::ThreadFunc()
     enet_peer_disconnect(player_entry.second.socket, 0);
   }
   m_players.clear();
+  for (auto& spectator_entry : m_spectators)
+  {
+    ClearPeerPlayerId(spectator_entry.second.socket);
+    enet_peer_disconnect(spectator_entry.second.socket, 0);
+  }
+  m_spectators.clear();
 }
 
 static void SendSyncIdentifier(sf::Packet& spac, const SyncIdentifier& sync_identifier)
@@ -438,19 +494,22 @@ ConnectionError NetPlayServer::OnConnect(ENetPeer* incoming_connection, sf::Pack
   if (netplay_version != Common::GetScmRevGitStr())
     return ConnectionError::VersionMismatch;
 
-  if (m_is_running || m_start_pending)
+  Client new_player{};
+  bool spectator = false;
+  received_packet >> new_player.revision;
+  received_packet >> new_player.name;
+  received_packet >> spectator;
+
+  // Spectators can join a running game, see UpdateSpectators().
+  if (!spectator && (m_is_running || m_start_pending))
     return ConnectionError::GameRunning;
 
-  if (m_players.size() >= 255)
+  if (m_players.size() + m_spectators.size() >= 255)
     return ConnectionError::ServerFull;
 
-  Client new_player{};
   new_player.pid = GiveFirstAvailableIDTo(incoming_connection);
   new_player.socket = incoming_connection;
 
-  received_packet >> new_player.revision;
-  received_packet >> new_player.name;
-
   if (StringUTF8CodePointCount(new_player.name) > MAX_NAME_LENGTH)
     return ConnectionError::NameTooLong;
 
@@ -458,27 +517,25 @@ ConnectionError NetPlayServer::OnConnect(ENetPeer* incoming_connection, sf::Pack
   // sent packets before a connection is deemed disconnected
   enet_peer_timeout(incoming_connection, 0, PEER_TIMEOUT.count(), PEER_TIMEOUT.count());
 
+  if (spectator)
+    return AddSpectator(std::move(new_player));
+
   // force a ping on first netplay loop
   m_update_pings = true;
 
   AssignNewUserAPad(new_player);
 
-  // tell other players a new player joined
-  SendResponseToAllPlayers(MessageID::PlayerJoin, new_player.pid, new_player.name,
-                           new_player.revision);
+  // tell other players and the spectators a new player joined
+  sf::Packet join_packet;
+  join_packet << MessageID::PlayerJoin << new_player.pid << new_player.name << new_player.revision;
+  SendToClients(join_packet);
+  SendToSpectators(join_packet);
 
   // tell new client they connected and their ID
   SendResponseToPlayer(new_player, MessageID::ConnectionSuccessful, new_player.pid);
 
   // tell new client the selected game
-  if (!m_selected_game_name.empty())
-  {
-    sf::Packet send_packet;
-    send_packet << MessageID::ChangeGame;
-    SendSyncIdentifier(send_packet, m_selected_game_identifier);
-    send_packet << m_selected_game_name;
-    Send(new_player.socket, send_packet);
-  }
+  SendSelectedGame(new_player);
 
   if (!m_host_input_authority)
     SendResponseToPlayer(new_player, MessageID::PadBuffer, m_target_buffer_size);
@@ -510,6 +567,19 @@ ConnectionError NetPlayServer::OnConnect(ENetPeer* incoming_connection, sf::Pack
   return ConnectionError::NoError;
 }
 
+// called from ---NETPLAY--- thread
+void NetPlayServer::SendSelectedGame(const Client& player)
+{
+  if (m_selected_game_name.empty())
+    return;
+
+  sf::Packet send_packet;
+  send_packet << MessageID::ChangeGame;
+  SendSyncIdentifier(send_packet, m_selected_game_identifier);
+  send_packet << m_selected_game_name;
+  Send(player.socket, send_packet);
+}
+
 // called from ---NETPLAY--- thread
 unsigned int NetPlayServer::OnDisconnect(const Client& player)
 {
@@ -528,6 +598,7 @@ unsigned int NetPlayServer::OnDisconnect(const Client& player)
         spac << MessageID::DisableGame;
         // this thread doesn't need players lock
         SendToClients(spac);
+        SendToSpectators(spac);
         break;
       }
     }
@@ -551,8 +622,13 @@ unsigned int NetPlayServer::OnDisconnect(const Client& player)
   if (it != m_players.end())
     m_players.erase(it);
 
-  // alert other players of disconnect
+  // The RAM hashes that are still being collected are either waiting for this player or include
+  // theirs, so none of them can be compared anymore.
+  m_ram_hash_by_frame.clear();
+
+  // alert other players and the spectators of disconnect
   SendToClients(spac);
+  SendToSpectators(spac);
 
   for (size_t i = 0; i < m_pad_map.size(); ++i)
   {
@@ -577,6 +653,223 @@ unsigned int NetPlayServer::OnDisconnect(const Client& player)
   return 0;
 }
 
+// called from ---NETPLAY--- thread
+ConnectionError NetPlayServer::AddSpectator(Client&& spectator)
+{
+  SendResponseToPlayer(spectator, MessageID::ConnectionSuccessful, spectator.pid);
+
+  SendSelectedGame(spectator);
+
+  // Spectators see the players, but the players don't see them.
+  for (const auto& existing_player : m_players)
+  {
+    SendResponseToPlayer(spectator, MessageID::PlayerJoin, existing_player.second.pid,
+                         existing_player.second.name, existing_player.second.revision);
+  }
+
+  m_dialog->AppendChat(Common::FmtFormatT("{0} is now spectating.", spectator.name));
+
+  {
+    std::lock_guard lkp(m_crit.players);
+    m_spectators.emplace(spectator.pid, std::move(spectator));
+    UpdatePadMapping();
+  }
+
+  return ConnectionError::NoError;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::OnSpectatorDisconnect(const Client& spectator)
+{
+  const PlayerId pid = spectator.pid;
+
+  m_dialog->AppendChat(Common::FmtFormatT("{0} stopped spectating.", spectator.name));
+
+  enet_peer_disconnect(spectator.socket, 0);
+
+  std::lock_guard lkp(m_crit.players);
+  m_spectators.erase(pid);
+
+  // The chunked data thread may be waiting for the spectator to receive a savestate.
+  m_chunked_data_complete_event.Set();
+}
+
+// called from ---NETPLAY--- thread
+unsigned int NetPlayServer::OnSpectatorData(sf::Packet& packet, Client& spectator)
+{
+  MessageID mid;
+  packet >> mid;
+
+  INFO_LOG_FMT(NETPLAY, "Got spectator message: {:x} from spectator {}", static_cast<u8>(mid),
+               spectator.pid);
+
+  // Spectators also act like clients, but what they send about the game is of no use.
+  switch (mid)
+  {
+  case MessageID::ChunkedDataComplete:
+  {
+    u32 cid;
+    packet >> cid;
+
+    if (m_chunked_data_complete_count.find(cid) != m_chunked_data_complete_count.end())
+    {
+      m_chunked_data_complete_count[cid]++;
+      m_chunked_data_complete_event.Set();
+    }
+  }
+  break;
+
+  case MessageID::PadDataRequest:
+  {
+    PadIndex map;
+    packet >> map;
+    if (!packet || map < 0 || map >= static_cast<PadIndex>(m_pad_map.size()))
+      return 1;
+
+    // The answer is relayed to the players too, who just skip the entries they already have.
+    const auto it = m_players.find(m_pad_map[map]);
+    if (it != m_players.end())
+      Send(it->second.socket, packet);
+  }
+  break;
+
+  case MessageID::SpectatorSnapshotRequest:
+  {
+    // The spectator fell too far behind to get the input it needs, and starts over from a new
+    // savestate like when it joined. UpdateSpectators() asks the host for one.
+    std::lock_guard lkg(m_crit.game);
+    if (spectator.spectator_state != SpectatorState::Live ||
+        spectator.current_game != m_current_game)
+    {
+      break;
+    }
+
+    for (const sf::Packet& message : m_spectator_relay.GetLogMessages())
+      Send(spectator.socket, message);
+    spectator.spectator_state = SpectatorState::WaitingForSnapshot;
+  }
+  break;
+
+  default:
+    break;
+  }
+
+  return 0;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::OnSpectatorSnapshot(sf::Packet& packet)
+{
+  u32 game;
+  packet >> game;
+  if (game != m_current_game)
+    return;
+
+  m_spectator_snapshot_game = 0;
+
+  // The host failed to make a savestate. UpdateSpectators() asks again.
+  if (packet.endOfPacket())
+  {
+    ERROR_LOG_FMT(NETPLAY, "The host failed to send a savestate for spectators");
+    return;
+  }
+
+  for (auto& [pid, spectator] : m_spectators)
+  {
+    if (spectator.spectator_state != SpectatorState::WaitingForSnapshot ||
+        spectator.current_game != m_current_game)
+    {
+      continue;
+    }
+
+    SendChunked(sf::Packet(packet), pid, "Spectator Synchronization");
+    spectator.spectator_state = SpectatorState::Live;
+  }
+}
+
+bool NetPlayServer::CanSpectate() const
+{
+  // Spectators join from a savestate of the host and the pad input relayed since, which is only
+  // kept for GC controllers in the fair input delay mode. The savestate has neither the memory
+  // card contents nor the Wii NAND, and spectators don't get the save data the players were sent,
+  // so only GC games that started without save data can be watched. Spectators don't take part in
+  // desync detection either, so anything else would diverge unnoticed.
+  const auto is_mapped = [](PlayerId pid) { return pid > 0; };
+  const auto is_enabled = [](const GBAConfig& config) { return config.enabled; };
+  return m_is_gamecube_game && !m_settings.savedata_load && !m_host_input_authority &&
+         !m_settings.rollback &&
+         std::none_of(m_wiimote_map.begin(), m_wiimote_map.end(), is_mapped) &&
+         std::none_of(m_gba_config.begin(), m_gba_config.end(), is_enabled);
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::UpdateSpectators()
+{
+  std::lock_guard lkg(m_crit.game);
+
+  const std::vector<sf::Packet> pad_data = m_spectator_relay.TakeMessages();
+  if (m_spectators.empty())
+    return;
+
+  const bool can_join = m_is_running && CanSpectate();
+  for (auto& [pid, spectator] : m_spectators)
+  {
+    // Spectators of a game that's over wait for the next one.
+    if (!m_is_running || spectator.current_game != m_current_game)
+      spectator.spectator_state = SpectatorState::WaitingForGame;
+
+    if (spectator.spectator_state != SpectatorState::WaitingForGame)
+    {
+      for (const sf::Packet& message : pad_data)
+        Send(spectator.socket, message);
+      continue;
+    }
+
+    if (!can_join)
+      continue;
+
+    // Start the game like the players did. The spectator then runs it until the host's savestate
+    // arrives, holding on to the pad input meanwhile. The log reaches back further than the input
+    // the host has yet to use when it takes the savestate, and the rest follows as it's relayed.
+    SendSelectedGame(spectator);
+    for (const sf::Packet& code_packet : m_spectator_code_packets)
+      Send(spectator.socket, code_packet);
+    Send(spectator.socket, m_start_game_packet);
+    for (const sf::Packet& message : m_spectator_relay.GetLogMessages())
+      Send(spectator.socket, message);
+
+    spectator.current_game = m_current_game;
+    spectator.spectator_state = SpectatorState::WaitingForSnapshot;
+  }
+
+  const auto is_waiting = [this](const auto& entry) {
+    return entry.second.spectator_state == SpectatorState::WaitingForSnapshot &&
+           entry.second.current_game == m_current_game;
+  };
+  const auto host = m_players.find(1);
+  if (!can_join || host == m_players.end() ||
+      std::none_of(m_spectators.begin(), m_spectators.end(), is_waiting))
+  {
+    return;
+  }
+
+  // Ask the host for a savestate, unless it's still working on one or was asked very recently.
+  // The request also has to be repeated if the host fails to make one, or if it never arrives.
+  const auto now = std::chrono::steady_clock::now();
+  const auto since_request = now - m_spectator_snapshot_request_time;
+  if (m_spectator_snapshot_game == m_current_game ? since_request < SPECTATOR_SNAPSHOT_TIMEOUT :
+                                                    since_request < SPECTATOR_SNAPSHOT_INTERVAL)
+  {
+    return;
+  }
+
+  sf::Packet spac;
+  spac << MessageID::SpectatorSnapshotRequest;
+  Send(host->second.socket, spac);
+  m_spectator_snapshot_game = m_current_game;
+  m_spectator_snapshot_request_time = now;
+}
+
 // called from ---GUI--- thread
 PadMappingArray NetPlayServer::GetPadMapping() const
 {
@@ -637,6 +930,7 @@ void NetPlayServer::UpdatePadMapping()
     spac << mapping;
   }
   SendToClients(spac);
+  SendToSpectators(spac);
 }
 
 // called from ---GUI--- thread and ---NETPLAY--- thread
@@ -708,7 +1002,7 @@ void NetPlayServer::SendAsync(sf::Packet&& packet, const PlayerId pid, const u8
     std::lock_guard lkq(m_crit.async_queue_write);
     m_async_queue.Push(AsyncQueueEntry{std::move(packet), pid, TargetMode::Only, channel_id});
   }
-  Common::ENet::WakeupThread(m_server);
+  m_wakeup.Request(m_server);
 }
 
 void NetPlayServer::SendAsyncToClients(sf::Packet&& packet, const PlayerId skip_pid,
@@ -719,7 +1013,17 @@ void NetPlayServer::SendAsyncToClients(sf::Packet&& packet, const PlayerId skip_
     m_async_queue.Push(
         AsyncQueueEntry{std::move(packet), skip_pid, TargetMode::AllExcept, channel_id});
   }
-  Common::ENet::WakeupThread(m_server);
+  m_wakeup.Request(m_server);
+}
+
+void NetPlayServer::SendAsyncToClientsAndSpectators(sf::Packet&& packet)
+{
+  {
+    std::lock_guard lkq(m_crit.async_queue_write);
+    m_async_queue.Push(
+        AsyncQueueEntry{std::move(packet), 0, TargetMode::AllExcept, DEFAULT_CHANNEL, true});
+  }
+  m_wakeup.Request(m_server);
 }
 
 void NetPlayServer::SendChunked(sf::Packet&& packet, const PlayerId pid, const std::string& title)
@@ -842,6 +1146,92 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
+  case MessageID::PadDataBatch:
+  {
+    // if this is pad data from the last game still being received, ignore it
+    if (player.current_game != m_current_game)
+      break;
+
+    // The pads of a batch are listed up front, so it can be relayed without decoding the input.
+    u8 pad_count;
+    packet >> pad_count;
+    for (u8 i = 0; i < pad_count; ++i)
+    {
+      PadIndex map;
+      packet >> map;
+
+      // If the data is not from the correct player,
+      // then disconnect them.
+      if (!packet || map < 0 || map >= static_cast<PadIndex>(m_pad_map.size()) ||
+          m_pad_map[map] != player.pid)
+      {
+        return 1;
+      }
+    }
+
+    SendToClients(packet, player.pid, PAD_DATA_CHANNEL);
+
+    std::lock_guard lkg(m_crit.game);
+    m_spectator_relay.Add(packet);
+  }
+  break;
+
+  case MessageID::PadDataRequest:
+  {
+    PadIndex map;
+    packet >> map;
+    if (!packet || map < 0 || map >= static_cast<PadIndex>(m_pad_map.size()))
+      return 1;
+
+    // Forward the request to the player the pad belongs to, whose answer is relayed to everyone.
+    const auto it = m_players.find(m_pad_map[map]);
+    if (it != m_players.end() && it->first != player.pid)
+      Send(it->second.socket, packet);
+  }
+  break;
+
+  case MessageID::RollbackPadData:
+  {
+    // if this is pad data from the last game still being received, ignore it
+    if (player.current_game != m_current_game)
+      break;
+
+    FrameNum frame;
+    packet >> frame;
+
+    sf::Packet spac;
+    spac << MessageID::RollbackPadData;
+    spac << frame;
+
+    while (!packet.endOfPacket())
+    {
+      PadIndex map;
+      packet >> map;
+
+      // If the data is not from the correct player,
+      // then disconnect them.
+      if (m_pad_map.at(map) != player.pid)
+      {
+        return 1;
+      }
+
+      GCPadStatus pad;
+      packet >> pad.button;
+      spac << map << pad.button;
+      if (!m_gba_config.at(map).enabled)
+      {
+        packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
+            pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
+
+        spac << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
+             << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
+      }
+    }
+
+    SendToClients(spac, player.pid);
+  }
+  break;
+
   case MessageID::PadHostData:
   {
     // Kick player if they're not the golfer.
@@ -1008,6 +1398,16 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 
     std::lock_guard lkp(m_crit.players);
     SendToClients(spac);
+    SendToSpectators(spac);
+  }
+  break;
+
+  case MessageID::SpectatorSnapshot:
+  {
+    if (!player.IsHost())
+      return 1;
+
+    OnSpectatorSnapshot(packet);
   }
   break;
 
@@ -1088,6 +1488,98 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
+  case MessageID::RAMHash:
+  {
+    u32 frame;
+    packet >> frame;
+    RAMHashDigest digest;
+    digest.root = Common::PacketReadU64(packet);
+    u8 region_count;
+    packet >> region_count;
+    digest.region_roots.resize(region_count);
+    for (u64& region_root : digest.region_roots)
+      region_root = Common::PacketReadU64(packet);
+
+    if (m_ram_desync)
+      break;
+
+    RAMHashes& hashes = m_ram_hash_by_frame[frame];
+    hashes.pids.push_back(player.pid);
+    hashes.digests.push_back(std::move(digest));
+    if (hashes.digests.size() < m_players.size())
+      break;
+
+    const std::optional<RAMHashMismatch> mismatch = CompareRAMHashDigests(hashes.digests);
+    if (!mismatch)
+    {
+      m_ram_hash_by_frame.erase(frame);
+      break;
+    }
+
+    m_ram_desync = RAMDesync{};
+    m_ram_desync->frame = frame;
+    m_ram_desync->pid_to_blame = hashes.pids[mismatch->blamed];
+    m_ram_desync->region = mismatch->region;
+    m_ram_hash_by_frame.clear();
+
+    sf::Packet spac;
+    spac << MessageID::RAMHashBlocksRequest;
+    spac << m_ram_desync->frame;
+    spac << m_ram_desync->region;
+    SendToClients(spac);
+  }
+  break;
+
+  case MessageID::RAMHashBlocks:
+  {
+    u32 frame;
+    u8 region;
+    u32 block_count;
+    packet >> frame >> region >> block_count;
+    std::vector<u64> block_hashes(block_count);
+    for (u64& block_hash : block_hashes)
+      block_hash = Common::PacketReadU64(packet);
+
+    if (!m_ram_desync || m_ram_desync->reported || m_ram_desync->frame != frame ||
+        m_ram_desync->region != region)
+    {
+      break;
+    }
+
+    m_ram_desync->block_hashes[player.pid] = std::move(block_hashes);
+    if (m_ram_desync->block_hashes.size() < m_players.size())
+      break;
+
+    // Players that don't have the frame anymore send no hashes, in which case only the region
+    // can be reported.
+    std::optional<u32> block;
+    const std::vector<u64>& blamed = m_ram_desync->block_hashes[m_ram_desync->pid_to_blame];
+    for (const auto& [pid, hashes] : m_ram_desync->block_hashes)
+    {
+      if (pid == m_ram_desync->pid_to_blame || hashes.empty() || hashes.size() != blamed.size())
+        continue;
+
+      const auto mismatch = std::mismatch(blamed.begin(), blamed.end(), hashes.begin()).first;
+      if (mismatch != blamed.end())
+      {
+        block = static_cast<u32>(mismatch - blamed.begin());
+        break;
+      }
+    }
+
+    sf::Packet spac;
+    spac << MessageID::RAMDesyncDetected;
+    spac << m_ram_desync->pid_to_blame;
+    spac << m_ram_desync->frame;
+    spac << m_ram_desync->region;
+    spac << block.has_value();
+    spac << block.value_or(0);
+    SendToClients(spac);
+
+    m_ram_desync->reported = true;
+  }
+  break;
+
   case MessageID::GameDigestProgress:
   {
     int progress;
@@ -1303,7 +1795,7 @@ bool NetPlayServer::ChangeGame(const SyncIdentifier& sync_identifier,
   SendSyncIdentifier(spac, m_selected_game_identifier);
   spac << m_selected_game_name;
 
-  SendAsyncToClients(std::move(spac));
+  SendAsyncToClientsAndSpectators(std::move(spac));
 
   return true;
 }
@@ -1452,6 +1944,10 @@ bool NetPlayServer::SetupNetSettings()
   settings.golf_mode = Config::Get(Config::NETPLAY_NETWORK_MODE) == "golf";
   settings.use_fma = DoAllPlayersHaveHardwareFMA();
   settings.hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
+  settings.rollback = Config::Get(Config::NETPLAY_NETWORK_MODE) == "rollback";
+  settings.rollback_max_frames = Config::Get(Config::NETPLAY_ROLLBACK_MAX_FRAMES);
+  settings.auto_pad_buffer = Config::Get(Config::NETPLAY_AUTO_PAD_BUFFER);
+  settings.ram_hash_desync_detection = Config::Get(Config::NETPLAY_RAM_HASH_DESYNC_DETECTION);
 
   // Unload GameINI to restore things to normal
   Config::RemoveLayer(Config::LayerType::GlobalGame);
@@ -1493,6 +1989,11 @@ bool NetPlayServer::RequestStartGame()
   if (!SetupNetSettings())
     return false;
 
+  {
+    std::lock_guard lkg(m_crit.game);
+    m_spectator_code_packets.clear();
+  }
+
   bool start_now = true;
 
   if (m_settings.savedata_load)
@@ -1558,6 +2059,8 @@ bool NetPlayServer::StartGame()
 
   m_timebase_by_frame.clear();
   m_desync_detected = false;
+  m_ram_hash_by_frame.clear();
+  m_ram_desync.reset();
   std::lock_guard lkg(m_crit.game);
   // only used as an identifier, not time value, so truncation is fine
   m_current_game = static_cast<u32>(Common::Timer::NowMs());
@@ -1571,8 +2074,10 @@ bool NetPlayServer::StartGame()
 
   const sf::Uint64 initial_rtc = GetInitialNetPlayRTC();
 
-  const std::string region = Config::GetDirectoryForRegion(
-      Config::ToGameCubeRegion(m_dialog->FindGameFile(m_selected_game_identifier)->GetRegion()));
+  const auto game = m_dialog->FindGameFile(m_selected_game_identifier);
+  const std::string region =
+      Config::GetDirectoryForRegion(Config::ToGameCubeRegion(game->GetRegion()));
+  m_is_gamecube_game = game->GetPlatform() == DiscIO::Platform::GameCubeDisc;
 
   // load host's GC SRAM
   SConfig::GetInstance().m_strSRAM = File::GetUserPath(F_GCSRAM_IDX);
@@ -1659,10 +2164,16 @@ bool NetPlayServer::StartGame()
   spac << m_settings.golf_mode;
   spac << m_settings.use_fma;
   spac << m_settings.hide_remote_gbas;
+  spac << m_settings.rollback;
+  spac << m_settings.rollback_max_frames;
+  spac << m_settings.auto_pad_buffer;
+  spac << m_settings.ram_hash_desync_detection;
 
   for (size_t i = 0; i < sizeof(m_settings.sram); ++i)
     spac << m_settings.sram[i];
 
+  m_start_game_packet = spac;
+  m_spectator_relay.SetGame(m_current_game);
   SendAsyncToClients(std::move(spac));
 
   m_start_pending = false;
@@ -2057,12 +2568,21 @@ bool NetPlayServer::SyncCodes()
   // Initialize Number of Synced Players
   m_codes_synced_players = 0;
 
+  // Spectators that join once the game runs get the same codes.
+  const auto send_to_clients = [this](sf::Packet&& pac) {
+    {
+      std::lock_guard lkg(m_crit.game);
+      m_spectator_code_packets.push_back(pac);
+    }
+    SendAsyncToClients(std::move(pac));
+  };
+
   // Notify Clients of Incoming Code Sync
   {
     sf::Packet pac;
     pac << MessageID::SyncCodes;
     pac << SyncCodeID::Notify;
-    SendAsyncToClients(std::move(pac));
+    send_to_clients(std::move(pac));
   }
   // Sync Gecko Codes
   {
@@ -2091,7 +2611,7 @@ bool NetPlayServer::SyncCodes()
       pac << MessageID::SyncCodes;
       pac << SyncCodeID::NotifyGecko;
       pac << codelines;
-      SendAsyncToClients(std::move(pac));
+      send_to_clients(std::move(pac));
     }
 
     // Send entire codeset in the second packet
@@ -2110,7 +2630,7 @@ bool NetPlayServer::SyncCodes()
           pac << code.data;
         }
       }
-      SendAsyncToClients(std::move(pac));
+      send_to_clients(std::move(pac));
     }
   }
 
@@ -2141,7 +2661,7 @@ bool NetPlayServer::SyncCodes()
       pac << MessageID::SyncCodes;
       pac << SyncCodeID::NotifyAR;
       pac << codelines;
-      SendAsyncToClients(std::move(pac));
+      send_to_clients(std::move(pac));
     }
 
     // Send entire codeset in the second packet
@@ -2160,7 +2680,7 @@ bool NetPlayServer::SyncCodes()
           pac << op.value;
         }
       }
-      SendAsyncToClients(std::move(pac));
+      send_to_clients(std::move(pac));
     }
   }
 
@@ -2201,9 +2721,20 @@ void NetPlayServer::SendToClients(const sf::Packet& packet, const PlayerId skip_
   }
 }
 
+void NetPlayServer::SendToSpectators(const sf::Packet& packet)
+{
+  for (auto& p : m_spectators)
+    Send(p.second.socket, packet);
+}
+
+bool NetPlayServer::IsClientConnected(const PlayerId pid) const
+{
+  return m_players.contains(pid) || m_spectators.contains(pid);
+}
+
 void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet, const u8 channel_id)
 {
-  Common::ENet::SendPacket(socket, packet, channel_id);
+  Common::ENet::SendPacket(socket, packet, channel_id, channel_id != PAD_DATA_CHANNEL);
 }
 
 void NetPlayServer::KickPlayer(PlayerId player)
@@ -2242,14 +2773,8 @@ void NetPlayServer::AssignNewUserAPad(const Client& player)
 PlayerId NetPlayServer::GiveFirstAvailableIDTo(ENetPeer* player)
 {
   PlayerId pid = 1;
-  for (auto i = m_players.begin(); i != m_players.end(); ++i)
-  {
-    if (i->second.pid == pid)
-    {
-      pid++;
-      i = m_players.begin();
-    }
-  }
+  while (m_players.contains(pid) || m_spectators.contains(pid))
+    pid++;
   player->data = new PlayerId(pid);
   return pid;
 }
@@ -2266,17 +2791,6 @@ void NetPlayServer::SendResponseToPlayer(const Client& player, const MessageID m
   Send(player.socket, response);
 }
 
-template <typename... Data>
-void NetPlayServer::SendResponseToAllPlayers(const MessageID message_id, Data&&... data_to_send)
-{
-  sf::Packet response;
-  response << message_id;
-  // this is a C++17 fold expression used to call the << operator for all of the data
-  (response << ... << std::forward<Data>(data_to_send));
-
-  SendToClients(response);
-}
-
 u16 NetPlayServer::GetPort() const
 {
   return m_server->address.port;
@@ -2426,7 +2940,7 @@ void NetPlayServer::ChunkedDataThreadFunc()
         }
         if (e.target_mode == TargetMode::Only)
         {
-          if (m_players.find(e.target_pid) == m_players.end())
+          if (!IsClientConnected(e.target_pid))
           {
             skip_wait = true;
             break;
@@ -2465,8 +2979,11 @@ void NetPlayServer::ChunkedDataThreadFunc()
       }
 
       while (m_chunked_data_complete_count[id] < player_count && m_do_loop &&
-             !m_abort_chunked_data && !skip_wait)
+             !m_abort_chunked_data && !skip_wait &&
+             (e.target_mode != TargetMode::Only || IsClientConnected(e.target_pid)))
+      {
         m_chunked_data_complete_event.Wait();
+      }
       m_chunked_data_complete_count.erase(id);
       m_dialog->HideChunkedProgressDialog();
 
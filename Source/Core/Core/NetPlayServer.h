@@ -5,6 +5,7 @@
 
 #include <SFML/Network/Packet.hpp>
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -15,13 +16,17 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include "Common/ENet.h"
 #include "Common/Event.h"
 #include "Common/QoSSession.h"
 #include "Common/SPSCQueue.h"
 #include "Common/Timer.h"
 #include "Common/TraversalClient.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlayRAMHash.h"
+#include "Core/NetPlaySpectatorRelay.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 #include "UICommon/NetPlayIndex.h"
@@ -79,6 +84,13 @@ public:
   bool is_connected = false;
 
 private:
+  enum class SpectatorState
+  {
+    WaitingForGame,
+    WaitingForSnapshot,
+    Live
+  };
+
   class Client
   {
   public:
@@ -95,6 +107,9 @@ private:
 
     Common::QoSSession qos_session;
 
+    // Spectators only. current_game is then the game they were sent.
+    SpectatorState spectator_state = SpectatorState::WaitingForGame;
+
     bool operator==(const Client& other) const { return this == &other; }
     bool IsHost() const { return pid == 1; }
   };
@@ -111,6 +126,7 @@ private:
     PlayerId target_pid{};
     TargetMode target_mode{};
     u8 channel_id = 0;
+    bool include_spectators = false;
   };
 
   struct ChunkedDataQueueEntry
@@ -132,14 +148,23 @@ private:
   template <typename... Data>
   void SendResponseToPlayer(const Client& player, const MessageID message_id,
                             Data&&... data_to_send);
-  template <typename... Data>
-  void SendResponseToAllPlayers(const MessageID message_id, Data&&... data_to_send);
   void SendToClients(const sf::Packet& packet, PlayerId skip_pid = 0,
                      u8 channel_id = DEFAULT_CHANNEL);
   void Send(ENetPeer* socket, const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
   ConnectionError OnConnect(ENetPeer* socket, sf::Packet& received_packet);
   unsigned int OnDisconnect(const Client& player);
   unsigned int OnData(sf::Packet& packet, Client& player);
+  void SendSelectedGame(const Client& player);
+
+  ConnectionError AddSpectator(Client&& spectator);
+  void OnSpectatorDisconnect(const Client& spectator);
+  unsigned int OnSpectatorData(sf::Packet& packet, Client& spectator);
+  void OnSpectatorSnapshot(sf::Packet& packet);
+  bool CanSpectate() const;
+  void UpdateSpectators();
+  void SendToSpectators(const sf::Packet& packet);
+  void SendAsyncToClientsAndSpectators(sf::Packet&& packet);
+  bool IsClientConnected(PlayerId pid) const;
 
   void OnTraversalStateChanged() override;
   void OnConnectReady(ENetAddress) override {}
@@ -185,9 +210,42 @@ private:
 
   std::map<PlayerId, Client> m_players;
 
+  // Spectators are kept apart from the players, so that everything sent to or expected from all
+  // players leaves them out. They only get what UpdateSpectators() sends them.
+  std::map<PlayerId, Client> m_spectators;
+  // Protected by m_crit.game, since StartGame() starts it over from the GUI thread.
+  SpectatorRelay m_spectator_relay;
+  // What a spectator has to be sent to start the running game, besides the host's savestate.
+  std::vector<sf::Packet> m_spectator_code_packets;
+  sf::Packet m_start_game_packet;
+  bool m_is_gamecube_game = false;
+  // The game a savestate has been asked of the host for, if any, and when it was last asked.
+  u32 m_spectator_snapshot_game = 0;
+  std::chrono::steady_clock::time_point m_spectator_snapshot_request_time;
+
   std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
   bool m_desync_detected = false;
 
+  // A RAM hash mismatch that is being narrowed down to a block.
+  struct RAMDesync
+  {
+    u32 frame = 0;
+    PlayerId pid_to_blame = 0;
+    u8 region = 0;
+    std::map<PlayerId, std::vector<u64>> block_hashes;
+    bool reported = false;
+  };
+
+  // The RAM hash digests of a frame, as they come in.
+  struct RAMHashes
+  {
+    std::vector<PlayerId> pids;
+    std::vector<RAMHashDigest> digests;
+  };
+
+  std::unordered_map<u32, RAMHashes> m_ram_hash_by_frame;
+  std::optional<RAMDesync> m_ram_desync;
+
   struct
   {
     std::recursive_mutex game;
@@ -198,6 +256,7 @@ private:
   } m_crit;
 
   Common::SPSCQueue<AsyncQueueEntry, false> m_async_queue;
+  Common::ENet::HostWakeup m_wakeup;
   Common::SPSCQueue<ChunkedDataQueueEntry, false> m_chunked_data_queue;
 
   SyncIdentifier m_selected_game_identifier;
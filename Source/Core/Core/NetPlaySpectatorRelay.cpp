@@ -0,0 +1,86 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlaySpectatorRelay.h"
+
+#include <algorithm>
+
+#include "Common/SFMLHelper.h"
+#include "Core/NetPlayProto.h"
+
+namespace NetPlay
+{
+void SpectatorRelay::SetGame(u32 game)
+{
+  if (game == m_game)
+    return;
+
+  m_game = game;
+  m_log.clear();
+  m_pending = 0;
+}
+
+void SpectatorRelay::Add(const sf::Packet& pad_data_batch)
+{
+  // Leave out the MessageID.
+  const u8* data = static_cast<const u8*>(pad_data_batch.getData());
+  const size_t size = pad_data_batch.getDataSize();
+  if (size <= sizeof(MessageID))
+    return;
+
+  m_log.emplace_back(data + sizeof(MessageID), data + size);
+  if (m_log.size() > LOG_SIZE)
+    m_log.pop_front();
+
+  if (m_pending == 0)
+    m_first_pending_time = std::chrono::steady_clock::now();
+  m_pending = std::min(m_pending + 1, m_log.size());
+}
+
+std::vector<sf::Packet> SpectatorRelay::TakeMessages()
+{
+  if (m_pending == 0)
+    return {};
+
+  if (m_pending < MAX_BATCHES_PER_MESSAGE &&
+      std::chrono::steady_clock::now() - m_first_pending_time < BATCH_INTERVAL)
+  {
+    return {};
+  }
+
+  std::vector<sf::Packet> messages = MakeMessages(m_log.size() - m_pending);
+  m_pending = 0;
+  return messages;
+}
+
+std::vector<sf::Packet> SpectatorRelay::GetLogMessages() const
+{
+  return MakeMessages(0);
+}
+
+std::chrono::milliseconds SpectatorRelay::GetTimeUntilNextMessage() const
+{
+  if (m_pending == 0)
+    return std::chrono::milliseconds::max();
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - m_first_pending_time);
+  return std::max(BATCH_INTERVAL - elapsed, std::chrono::milliseconds::zero());
+}
+
+std::vector<sf::Packet> SpectatorRelay::MakeMessages(size_t first_batch) const
+{
+  std::vector<sf::Packet> messages;
+  for (size_t batch = first_batch; batch < m_log.size(); batch += MAX_BATCHES_PER_MESSAGE)
+  {
+    const size_t count = std::min(MAX_BATCHES_PER_MESSAGE, m_log.size() - batch);
+
+    sf::Packet& message = messages.emplace_back();
+    message << MessageID::SpectatorPadData;
+    message << static_cast<u8>(count);
+    for (size_t i = batch; i < batch + count; ++i)
+      message.append(m_log[i].data(), m_log[i].size());
+  }
+  return messages;
+}
+}  // namespace NetPlay
@@ -0,0 +1,60 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+
+#include "Common/CommonTypes.h"
+
+namespace NetPlay
+{
+// Server side of the pad data sent to spectators of a game in the fair input delay mode.
+//
+// Spectators don't get the PadDataBatch messages of the players as they are relayed, but
+// SpectatorPadData messages holding all of those relayed in the last BATCH_INTERVAL:
+//
+//   u8 batch count, then every PadDataBatch without its MessageID
+//
+// This saves both bandwidth and the server's time, as there is one message per spectator every
+// BATCH_INTERVAL instead of one for every player's every frame.
+//
+// The last LOG_SIZE batches of the game are kept as well. A spectator that joins late starts from a
+// savestate of the host along with how many entries of every pad's input stream the host had used.
+// It gets the log as soon as the savestate is asked for, and new batches from then on, which covers
+// every entry the host hadn't used yet as long as the log reaches back further than its pad buffer.
+class SpectatorRelay
+{
+public:
+  static constexpr size_t LOG_SIZE = 1024;
+  static constexpr size_t MAX_BATCHES_PER_MESSAGE = 32;
+  static constexpr std::chrono::milliseconds BATCH_INTERVAL{50};
+
+  // Starts over when the game changes.
+  void SetGame(u32 game);
+
+  // Adds a PadDataBatch message that was relayed to the players.
+  void Add(const sf::Packet& pad_data_batch);
+
+  // Returns the messages for the batches added since the last call, or nothing if it's too early.
+  std::vector<sf::Packet> TakeMessages();
+  // Returns the messages for the whole log.
+  std::vector<sf::Packet> GetLogMessages() const;
+
+  // How long the server may sleep before TakeMessages() has something to send.
+  std::chrono::milliseconds GetTimeUntilNextMessage() const;
+
+private:
+  std::vector<sf::Packet> MakeMessages(size_t first_batch) const;
+
+  u32 m_game = 0;
+  std::deque<std::vector<u8>> m_log;
+  // The newest m_pending batches of the log haven't been sent yet.
+  size_t m_pending = 0;
+  std::chrono::steady_clock::time_point m_first_pending_time;
+};
+}  // namespace NetPlay
@@ -17,6 +17,7 @@
 // ----------
 #pragma once
 
+#include <map>
 #include <optional>
 
 #include <rangeset/rangesizeset.h>
@@ -89,6 +89,7 @@ const u8* JitBase::Dispatch(JitBase& jit)
 
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
+  jit.GetBlockCache()->PrecompileProfiledBlocks();
   jit.Jit(em_address);
 }
 
@@ -7,7 +7,6 @@
 #include <array>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <set>
 #include <utility>
 
@@ -15,10 +14,14 @@
 #include "Common/JitRegister.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
+#include "Core/Movie.h"
+#include "Core/NetPlayProto.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitProfile.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -28,8 +31,163 @@ using namespace Gen;
 
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
-  return physical_addresses.lower_bound(address) !=
-         physical_addresses.lower_bound(address + length);
+  return std::lower_bound(physical_addresses.begin(), physical_addresses.end(), address) !=
+         std::lower_bound(physical_addresses.begin(), physical_addresses.end(), address + length);
+}
+
+JitBlockPhysicalIndex::JitBlockPhysicalIndex() = default;
+
+JitBlockPhysicalIndex::~JitBlockPhysicalIndex() = default;
+
+void JitBlockPhysicalIndex::Clear()
+{
+  for (auto& directory : m_directories)
+    directory.reset();
+}
+
+JitBlockPhysicalIndex::Page* JitBlockPhysicalIndex::GetPage(u32 address) const
+{
+  const auto& directory = m_directories[address >> DIRECTORY_SHIFT];
+  if (!directory)
+    return nullptr;
+  return (*directory)[(address >> PAGE_SHIFT) & (directory->size() - 1)].get();
+}
+
+JitBlockPhysicalIndex::Page& JitBlockPhysicalIndex::GetOrCreatePage(u32 address)
+{
+  auto& directory = m_directories[address >> DIRECTORY_SHIFT];
+  if (!directory)
+    directory = std::make_unique<Directory>();
+  auto& page = (*directory)[(address >> PAGE_SHIFT) & (directory->size() - 1)];
+  if (!page)
+    page = std::make_unique<Page>();
+  return *page;
+}
+
+void JitBlockPhysicalIndex::AddEntry(JitBlock& block)
+{
+  Page& page = GetOrCreatePage(block.physicalAddress);
+  JitBlock*& head = page.entries[(block.physicalAddress >> LINE_SHIFT) & (page.entries.size() - 1)];
+  block.next_in_line = head;
+  head = &block;
+}
+
+void JitBlockPhysicalIndex::RemoveEntry(JitBlock& block)
+{
+  Page* page = GetPage(block.physicalAddress);
+  if (!page)
+    return;
+
+  JitBlock** link =
+      &page->entries[(block.physicalAddress >> LINE_SHIFT) & (page->entries.size() - 1)];
+  while (*link && *link != &block)
+    link = &(*link)->next_in_line;
+  if (*link)
+    *link = block.next_in_line;
+  block.next_in_line = nullptr;
+}
+
+JitBlock* JitBlockPhysicalIndex::FindEntry(u32 physical_address, u32 effective_address,
+                                           CPUEmuFeatureFlags feature_flags) const
+{
+  const Page* page = GetPage(physical_address);
+  if (!page)
+    return nullptr;
+
+  JitBlock* block = page->entries[(physical_address >> LINE_SHIFT) & (page->entries.size() - 1)];
+  for (; block; block = block->next_in_line)
+  {
+    if (block->physicalAddress == physical_address &&
+        block->effectiveAddress == effective_address && block->feature_flags == feature_flags)
+    {
+      return block;
+    }
+  }
+  return nullptr;
+}
+
+void JitBlockPhysicalIndex::AddRange(JitBlock& block)
+{
+  // The addresses are sorted, so each range only has to be checked against the previous one.
+  u32 previous_range = 0;
+  bool first = true;
+  for (u32 address : block.physical_addresses)
+  {
+    const u32 range = address >> RANGE_SHIFT;
+    if (!first && range == previous_range)
+      continue;
+
+    Page& page = GetOrCreatePage(address);
+    page.ranges[range & (page.ranges.size() - 1)].push_back(&block);
+    previous_range = range;
+    first = false;
+  }
+}
+
+void JitBlockPhysicalIndex::RemoveRange(JitBlock& block)
+{
+  u32 previous_range = 0;
+  bool first = true;
+  for (u32 address : block.physical_addresses)
+  {
+    const u32 range = address >> RANGE_SHIFT;
+    if (!first && range == previous_range)
+      continue;
+
+    Page* page = GetPage(address);
+    if (page)
+    {
+      std::vector<JitBlock*>& blocks = page->ranges[range & (page->ranges.size() - 1)];
+      const auto it = std::find(blocks.begin(), blocks.end(), &block);
+      if (it != blocks.end())
+      {
+        *it = blocks.back();
+        blocks.pop_back();
+      }
+    }
+    previous_range = range;
+    first = false;
+  }
+}
+
+void JitBlockPhysicalIndex::FindOverlapping(u32 address, u32 length,
+                                            std::vector<JitBlock*>& blocks) const
+{
+  constexpr u64 range_size = u64(1) << RANGE_SHIFT;
+  // A range that goes past the end of the address space stops there instead of wrapping around.
+  const u64 end = std::min(u64(address) + length, u64(1) << 32);
+  u64 range_start = address & ~(range_size - 1);
+  while (range_start < end)
+  {
+    if (!m_directories[range_start >> DIRECTORY_SHIFT])
+    {
+      range_start = ((range_start >> DIRECTORY_SHIFT) + 1) << DIRECTORY_SHIFT;
+      continue;
+    }
+
+    const Page* page = GetPage(static_cast<u32>(range_start));
+    if (!page)
+    {
+      range_start = ((range_start >> PAGE_SHIFT) + 1) << PAGE_SHIFT;
+      continue;
+    }
+
+    const u64 range_index = (range_start >> RANGE_SHIFT) & (page->ranges.size() - 1);
+    for (JitBlock* block : page->ranges[range_index])
+    {
+      // A block can occupy several of the ranges, so only report it for the first one of them
+      // that has an instruction of it in [address, end).
+      const auto it = std::lower_bound(block->physical_addresses.begin(),
+                                       block->physical_addresses.end(), address);
+      if (it != block->physical_addresses.end() && *it < end &&
+          (*it & ~(range_size - 1)) == range_start)
+      {
+        blocks.push_back(block);
+      }
+    }
+
+    range_start += range_size;
+  }
 }
 
 JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
@@ -48,6 +206,9 @@ void JitBaseBlockCache::Init()
     m_entry_points_ptr = reinterpret_cast<u8**>(m_entry_points_arena.Create(FAST_BLOCK_MAP_SIZE));
 #endif
 
+  if (Config::Get(Config::MAIN_JIT_BLOCK_PROFILE))
+    m_profile = std::make_unique<JitProfile>(m_jit.m_system.GetMemory());
+
   Clear();
 }
 
@@ -55,6 +216,12 @@ void JitBaseBlockCache::Shutdown()
 {
   Common::JitRegister::Shutdown();
 
+  if (m_profile)
+  {
+    m_profile->Save();
+    m_profile.reset();
+  }
+
   m_entry_points_arena.Release();
 }
 
@@ -68,13 +235,15 @@ void JitBaseBlockCache::Clear()
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
   m_jit.js.noSpeculativeConstantsAddresses.clear();
-  for (auto& e : block_map)
+  for (JitBlock& block : m_blocks)
   {
-    DestroyBlock(e.second);
+    if (block.in_use)
+      DestroyBlock(block);
   }
-  block_map.clear();
+  m_blocks.clear();
+  m_free_blocks.clear();
   links_to.clear();
-  block_range_map.clear();
+  m_physical_index.Clear();
 
   valid_block.ClearAll();
 
@@ -100,22 +269,49 @@ JitBlock** JitBaseBlockCache::GetFastBlockMapFallback()
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
 {
-  for (const auto& e : block_map)
-    f(e.second);
+  for (const JitBlock& block : m_blocks)
+  {
+    if (block.in_use)
+      f(block);
+  }
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   const u32 physical_address = m_jit.m_mmu.JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physical_address, JitBlock())->second;
+
+  JitBlock* block;
+  if (!m_free_blocks.empty())
+  {
+    block = m_free_blocks.back();
+    m_free_blocks.pop_back();
+  }
+  else
+  {
+    block = &m_blocks.emplace_back();
+  }
+
+  JitBlock& b = *block;
+  static_cast<JitBlockData&>(b) = {};
   b.effectiveAddress = em_address;
   b.physicalAddress = physical_address;
   b.feature_flags = m_jit.m_ppc_state.feature_flags;
   b.linkData.clear();
+  b.physical_addresses.clear();
+  b.profile_data = {};
   b.fast_block_map_index = 0;
+  b.in_use = true;
+
+  m_physical_index.AddEntry(b);
   return &b;
 }
 
+void JitBaseBlockCache::FreeBlock(JitBlock& block)
+{
+  block.in_use = false;
+  m_free_blocks.push_back(&block);
+}
+
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
                                       const std::set<u32>& physical_addresses)
 {
@@ -131,20 +327,25 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   }
   block.fast_block_map_index = index;
 
-  block.physical_addresses = physical_addresses;
-
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  for (u32 addr : physical_addresses)
-  {
+  block.physical_addresses.assign(physical_addresses.begin(), physical_addresses.end());
+  for (u32 addr : block.physical_addresses)
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
-  }
+  m_physical_index.AddRange(block);
+
+  if (m_profile)
+    m_profile->RecordBlock(block);
 
   if (block_link)
   {
-    for (const auto& e : block.linkData)
+    for (auto& e : block.linkData)
     {
-      links_to[e.exitAddress].insert(&block);
+      JitBlock::LinkData*& head = links_to[e.exitAddress];
+      e.source = &block;
+      e.prev_to_same_address = nullptr;
+      e.next_to_same_address = head;
+      if (head)
+        head->prev_to_same_address = &e;
+      head = &e;
     }
 
     LinkBlock(block);
@@ -177,15 +378,46 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, CPUEmuFeatureFla
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  return m_physical_index.FindEntry(translated_addr, addr, feature_flags);
+}
+
+void JitBaseBlockCache::PrecompileProfiledBlocks()
+{
+  // Translating addresses in MMU mode can change the emulated TLB, and compiling reads
+  // instructions through the emulated icache. Both are part of the emulated state, which must not
+  // depend on a local profile when it has to match other players or a recording.
+  if (!m_profile || m_jit.IsDebuggingEnabled() || m_jit.m_system.IsMMUMode() ||
+      NetPlay::IsNetPlayRunning() || m_jit.m_system.GetMovie().IsMovieActive())
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.feature_flags == feature_flags)
-      return &b;
+    return;
   }
 
-  return nullptr;
+  m_profile->Update();
+
+  // Compiling a whole profile in one go would just move the stutter somewhere else.
+  const CPUEmuFeatureFlags feature_flags = m_jit.m_ppc_state.feature_flags;
+  JitProfile::Entry entry;
+  for (u32 i = 0; i < MAX_PRECOMPILED_BLOCKS_PER_CALL &&
+                  m_profile->GetNextEntryToCompile(feature_flags, &entry);
+       ++i)
+  {
+    u32 physical_address = entry.effective_address;
+    if (feature_flags & FEATURE_FLAG_MSR_IR)
+    {
+      const auto translated = m_jit.m_mmu.JitCache_TranslateAddress(entry.effective_address);
+      if (!translated.valid || !translated.from_bat)
+        continue;
+      physical_address = translated.address;
+    }
+
+    if (physical_address != entry.physical_address ||
+        m_physical_index.FindEntry(physical_address, entry.effective_address, feature_flags))
+    {
+      continue;
+    }
+
+    m_jit.Jit(entry.effective_address);
+  }
 }
 
 const u8* JitBaseBlockCache::Dispatch()
@@ -310,51 +542,15 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
 
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  m_physical_index.FindOverlapping(address, length, m_blocks_to_erase);
+  for (JitBlock* block : m_blocks_to_erase)
   {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
-    {
-      JitBlock* block = *iter;
-      if (block->OverlapsPhysicalRange(address, length))
-      {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
-      }
-      else
-      {
-        iter++;
-      }
-    }
-
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+    m_physical_index.RemoveRange(*block);
+    m_physical_index.RemoveEntry(*block);
+    DestroyBlock(*block);
+    FreeBlock(*block);
   }
+  m_blocks_to_erase.clear();
 }
 
 u32* JitBaseBlockCache::GetBlockBitSet() const
@@ -395,10 +591,10 @@ void JitBaseBlockCache::LinkBlock(JitBlock& block)
   if (it == links_to.end())
     return;
 
-  for (JitBlock* b2 : it->second)
+  for (JitBlock::LinkData* e = it->second; e; e = e->next_to_same_address)
   {
-    if (block.feature_flags == b2->feature_flags)
-      LinkBlockExits(*b2);
+    if (block.feature_flags == e->source->feature_flags)
+      LinkBlockExits(*e->source);
   }
 }
 
@@ -414,19 +610,13 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
   const auto it = links_to.find(block.effectiveAddress);
   if (it == links_to.end())
     return;
-  for (JitBlock* sourceBlock : it->second)
+  for (JitBlock::LinkData* e = it->second; e; e = e->next_to_same_address)
   {
-    if (sourceBlock->feature_flags != block.feature_flags)
+    if (e->source->feature_flags != block.feature_flags)
       continue;
 
-    for (auto& e : sourceBlock->linkData)
-    {
-      if (e.exitAddress == block.effectiveAddress)
-      {
-        WriteLinkBlock(e, nullptr);
-        e.linkStatus = false;
-      }
-    }
+    WriteLinkBlock(*e, nullptr);
+    e->linkStatus = false;
   }
 }
 
@@ -450,14 +640,23 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
   UnlinkBlock(block);
 
   // Delete linking addresses
-  for (const auto& e : block.linkData)
+  for (auto& e : block.linkData)
   {
-    auto it = links_to.find(e.exitAddress);
-    if (it == links_to.end())
+    if (!e.source)
       continue;
-    it->second.erase(&block);
-    if (it->second.empty())
-      links_to.erase(it);
+
+    if (e.prev_to_same_address)
+      e.prev_to_same_address->next_to_same_address = e.next_to_same_address;
+    else if (e.next_to_same_address)
+      links_to[e.exitAddress] = e.next_to_same_address;
+    else
+      links_to.erase(e.exitAddress);
+    if (e.next_to_same_address)
+      e.next_to_same_address->prev_to_same_address = e.prev_to_same_address;
+
+    e.source = nullptr;
+    e.prev_to_same_address = nullptr;
+    e.next_to_same_address = nullptr;
   }
 
   // Raise an signal if we are going to call this block again
@@ -6,13 +6,12 @@
 #include <array>
 #include <bitset>
 #include <cstring>
+#include <deque>
 #include <functional>
-#include <map>
 #include <memory>
 #include <set>
 #include <type_traits>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -20,6 +19,7 @@
 #include "Core/PowerPC/Gekko.h"
 
 class JitBase;
+class JitProfile;
 
 // offsetof is only conditionally supported for non-standard layout types,
 // so this struct needs to have a standard layout.
@@ -39,7 +39,7 @@ struct JitBlockData
   // The effective address (PC) for the beginning of the block.
   u32 effectiveAddress;
   // The physical address of the code represented by this block.
-  // Various maps in the cache are indexed by this (block_map
+  // Various maps in the cache are indexed by this (m_physical_index
   // and valid_block in particular). This is useful because of
   // of the way the instruction cache works on PowerPC.
   u32 physicalAddress;
@@ -77,11 +77,17 @@ struct JitBlock : public JitBlockData
     u32 exitAddress;
     bool linkStatus;  // is it already linked?
     bool call;
+
+    // All exits of valid blocks to the same exitAddress form a list, which is used to query all
+    // blocks which link to an address.
+    JitBlock* source = nullptr;
+    LinkData* prev_to_same_address = nullptr;
+    LinkData* next_to_same_address = nullptr;
   };
   std::vector<LinkData> linkData;
 
-  // This set stores all physical addresses of all occupied instructions.
-  std::set<u32> physical_addresses;
+  // The sorted physical addresses of all occupied instructions.
+  std::vector<u32> physical_addresses;
 
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
@@ -92,6 +98,11 @@ struct JitBlock : public JitBlockData
     u64 ticStart;
     u64 ticStop;
   } profile_data = {};
+
+  // Next block with an entry point in the same cache line, see JitBlockPhysicalIndex.
+  JitBlock* next_in_line = nullptr;
+  // Whether the block is in use or waiting in JitBaseBlockCache to be reused.
+  bool in_use = false;
 };
 
 typedef void (*CompiledCode)();
@@ -126,6 +137,50 @@ public:
   bool Test(u32 bit) const { return (m_valid_block[bit / 32] & (1u << (bit % 32))) != 0; }
 };
 
+// Looks up blocks by the physical address of their entry point or of any of their instructions.
+//
+// Physical pages get allocated on demand in a two-level table. Each page keeps a list of the blocks
+// whose entry point lies in each of its cache lines, and an array of the blocks with instructions
+// in each 0x100 byte range of it, so that invalidating a range only has to look at the blocks
+// which are actually close to it.
+class JitBlockPhysicalIndex
+{
+public:
+  JitBlockPhysicalIndex();
+  ~JitBlockPhysicalIndex();
+
+  void Clear();
+
+  void AddEntry(JitBlock& block);
+  void RemoveEntry(JitBlock& block);
+  JitBlock* FindEntry(u32 physical_address, u32 effective_address,
+                      CPUEmuFeatureFlags feature_flags) const;
+
+  // Uses block.physical_addresses, which must not change until the range is removed again.
+  void AddRange(JitBlock& block);
+  void RemoveRange(JitBlock& block);
+  // Appends every block with an instruction in [address, address + length) to blocks, once.
+  void FindOverlapping(u32 address, u32 length, std::vector<JitBlock*>& blocks) const;
+
+private:
+  static constexpr u32 PAGE_SHIFT = 12;
+  static constexpr u32 LINE_SHIFT = 5;
+  static constexpr u32 RANGE_SHIFT = 8;
+  static constexpr u32 DIRECTORY_SHIFT = 22;
+
+  struct Page
+  {
+    std::array<JitBlock*, 1 << (PAGE_SHIFT - LINE_SHIFT)> entries{};
+    std::array<std::vector<JitBlock*>, 1 << (PAGE_SHIFT - RANGE_SHIFT)> ranges;
+  };
+  using Directory = std::array<std::unique_ptr<Page>, 1 << (DIRECTORY_SHIFT - PAGE_SHIFT)>;
+
+  Page* GetPage(u32 address) const;
+  Page& GetOrCreatePage(u32 address);
+
+  std::array<std::unique_ptr<Directory>, 1 << (32 - DIRECTORY_SHIFT)> m_directories;
+};
+
 class JitBaseBlockCache
 {
 public:
@@ -156,6 +211,10 @@ public:
   // This might return nullptr if there is no such block.
   JitBlock* GetBlockFromStartAddress(u32 em_address, CPUEmuFeatureFlags feature_flags);
 
+  // Compiles some of the blocks from the JIT block profile whose code has been loaded by now.
+  // Only called before compiling a block, where JitBase::Jit can safely be called.
+  void PrecompileProfiledBlocks();
+
   // Get the normal entry for the block associated with the current program
   // counter. This will JIT code if necessary. (This is the reference
   // implementation; high-performance JITs will want to use a custom
@@ -183,23 +242,27 @@ private:
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, CPUEmuFeatureFlags feature_flags);
+  void FreeBlock(JitBlock& block);
+
+  static constexpr u32 MAX_PRECOMPILED_BLOCKS_PER_CALL = 8;
 
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address, u32 msr);
 
-  // links_to hold all exit points of all valid blocks in a reverse way.
-  // It is used to query all blocks which links to an address.
-  std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
+  // links_to hold the first of the exits of all valid blocks to an address, see LinkData.
+  std::unordered_map<u32, JitBlock::LinkData*> links_to;  // destination_PC -> exit
+
+  // All blocks. Their addresses have to stay the same, and destroyed ones get reused.
+  std::deque<JitBlock> m_blocks;
+  std::vector<JitBlock*> m_free_blocks;
 
-  // Map indexed by the physical address of the entry point.
-  // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  // This is used to query the block based on the current PC in a slow way,
+  // and for invalidation of memory regions.
+  JitBlockPhysicalIndex m_physical_index;
+  std::vector<JitBlock*> m_blocks_to_erase;
 
-  // Range of overlapping code indexed by a masked physical address.
-  // This is used for invalidation of memory regions. The range is grouped
-  // in macro blocks of each 0x100 bytes.
-  static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  // Only exists with Core.JITBlockProfile enabled.
+  std::unique_ptr<JitProfile> m_profile;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
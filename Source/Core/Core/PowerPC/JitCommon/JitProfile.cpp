@@ -0,0 +1,186 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitProfile.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <xxhash.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+
+JitProfile::JitProfile(Memory::MemoryManager& memory) : m_memory(memory)
+{
+}
+
+JitProfile::~JitProfile()
+{
+  if (m_load_thread.joinable())
+    m_load_thread.join();
+}
+
+std::string JitProfile::GetPath(const std::string& game_id)
+{
+  return File::GetUserPath(D_CACHE_IDX) + "JitProfiles" DIR_SEP + game_id + ".jitprofile";
+}
+
+void JitProfile::Update()
+{
+  if (!m_load_started)
+  {
+    const std::string& game_id = SConfig::GetInstance().GetGameID();
+    if (game_id.empty() || game_id == "00000000")
+      return;
+
+    m_game_id = game_id;
+    m_load_started = true;
+    m_load_thread = std::thread(&JitProfile::LoadThread, this, GetPath(game_id));
+    return;
+  }
+
+  if (m_load_finished || !m_load_done.load(std::memory_order_acquire))
+    return;
+
+  m_load_thread.join();
+  m_load_finished = true;
+  m_pending_entries = std::move(m_loaded_entries);
+  m_loaded_entries.clear();
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} entries from the JIT block profile of {}",
+               m_pending_entries.size(), m_game_id);
+}
+
+void JitProfile::LoadThread(std::string path)
+{
+  Common::SetCurrentThreadName("JIT Profile Loader");
+
+  File::IOFile file(path, "rb");
+  FileHeader header;
+  if (file && file.ReadArray(&header, 1) && header.magic == FILE_MAGIC &&
+      header.version == FILE_VERSION && header.entry_count <= MAX_ENTRIES)
+  {
+    std::vector<Entry> entries(header.entry_count);
+    if (file.ReadArray(entries.data(), entries.size()))
+    {
+      // Going through the entries in address order touches RAM more linearly when they get
+      // checked, and entry points of the same function end up next to each other.
+      std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+        return lhs.physical_address < rhs.physical_address;
+      });
+      m_loaded_entries = std::move(entries);
+    }
+  }
+
+  m_load_done.store(true, std::memory_order_release);
+}
+
+bool JitProfile::GetNextEntryToCompile(CPUEmuFeatureFlags feature_flags, Entry* entry)
+{
+  // Entries whose code isn't loaded yet stay around, since the game may load it later on.
+  const size_t checks = std::min(MAX_CHECKS_PER_CALL, m_pending_entries.size());
+  for (size_t i = 0; i < checks; ++i)
+  {
+    if (m_pending_cursor >= m_pending_entries.size())
+      m_pending_cursor = 0;
+
+    const Entry& candidate = m_pending_entries[m_pending_cursor];
+    if (candidate.feature_flags != feature_flags || !IsCodeInRAM(candidate))
+    {
+      ++m_pending_cursor;
+      continue;
+    }
+
+    *entry = candidate;
+    m_pending_entries[m_pending_cursor] = m_pending_entries.back();
+    m_pending_entries.pop_back();
+    return true;
+  }
+  return false;
+}
+
+const u8* JitProfile::GetCode(u32 physical_address, u32 size) const
+{
+  const u32 address = physical_address & 0x3FFFFFFF;
+  const bool in_mem1 = address < m_memory.GetRamSizeReal() &&
+                       size <= m_memory.GetRamSizeReal() - address;
+  const bool in_mem2 = m_memory.GetEXRAM() && (address >> 28) == 0x1 &&
+                       (address & 0x0FFFFFFF) < m_memory.GetExRamSizeReal() &&
+                       size <= m_memory.GetExRamSizeReal() - (address & 0x0FFFFFFF);
+  if (!in_mem1 && !in_mem2)
+    return nullptr;
+  return m_memory.GetPointerForRange(address, size);
+}
+
+bool JitProfile::IsCodeInRAM(const Entry& entry) const
+{
+  const u8* code = GetCode(entry.physical_address, entry.code_size);
+  return code && XXH3_64bits(code, entry.code_size) == entry.code_hash;
+}
+
+void JitProfile::RecordBlock(const JitBlock& block)
+{
+  if (block.physical_addresses.empty() || m_recorded_entries.size() >= MAX_ENTRIES)
+    return;
+
+  // Blocks which follow branches far away are rare, and not worth hashing everything in between.
+  const u32 code_size = block.physical_addresses.back() - block.physicalAddress + 4;
+  if (block.physical_addresses.front() != block.physicalAddress || code_size > MAX_CODE_SIZE)
+    return;
+
+  const u8* code = GetCode(block.physicalAddress, code_size);
+  if (!code)
+    return;
+
+  m_recorded_entries.insert_or_assign(
+      GetKey(block.effectiveAddress, block.feature_flags),
+      Entry{block.effectiveAddress, block.physicalAddress, block.feature_flags, code_size,
+            XXH3_64bits(code, code_size)});
+}
+
+void JitProfile::Save()
+{
+  if (m_game_id.empty() || m_recorded_entries.empty())
+    return;
+
+  if (m_load_thread.joinable())
+    m_load_thread.join();
+  if (m_load_started && !m_load_finished)
+  {
+    m_load_finished = true;
+    m_pending_entries = std::move(m_loaded_entries);
+  }
+
+  // Keep what this session didn't get to, like code of modes that weren't played this time.
+  std::vector<Entry> entries;
+  entries.reserve(m_recorded_entries.size() + m_pending_entries.size());
+  for (const auto& [key, entry] : m_recorded_entries)
+    entries.push_back(entry);
+  for (const Entry& entry : m_pending_entries)
+  {
+    if (entries.size() < MAX_ENTRIES &&
+        !m_recorded_entries.contains(GetKey(entry.effective_address, entry.feature_flags)))
+    {
+      entries.push_back(entry);
+    }
+  }
+
+  const std::string path = GetPath(m_game_id);
+  File::CreateFullPath(path);
+  File::IOFile file(path, "wb");
+  const FileHeader header{FILE_MAGIC, FILE_VERSION, static_cast<u32>(entries.size()), 0};
+  if (!file || !file.WriteArray(&header, 1) || !file.WriteArray(entries.data(), entries.size()))
+  {
+    WARN_LOG_FMT(DYNA_REC, "Failed to write the JIT block profile to {}", path);
+    return;
+  }
+
+  INFO_LOG_FMT(DYNA_REC, "Saved {} entries to the JIT block profile of {}", entries.size(),
+               m_game_id);
+}
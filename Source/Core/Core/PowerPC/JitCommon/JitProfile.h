@@ -0,0 +1,98 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/Gekko.h"
+
+namespace Memory
+{
+class MemoryManager;
+}
+
+struct JitBlock;
+
+// Remembers which blocks a game compiled, so that the next time it is booted they can be compiled
+// as soon as their code is in RAM instead of when they first get executed.
+//
+// The profile is stored per game ID in the cache directory. Every entry carries a hash of the
+// guest code it was compiled from, and entries are only handed out while RAM still contains
+// exactly that code. Reading and sorting the file happens on a separate thread; everything else
+// has to be called on the CPU thread.
+class JitProfile
+{
+public:
+  static constexpr u32 FILE_MAGIC = 0x5054494A;  // "JITP"
+  static constexpr u32 FILE_VERSION = 1;
+
+  struct FileHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 reserved;
+  };
+
+  struct Entry
+  {
+    u32 effective_address;
+    u32 physical_address;
+    CPUEmuFeatureFlags feature_flags;
+    // Size of the hashed code, starting at physical_address
+    u32 code_size;
+    u64 code_hash;
+  };
+  static_assert(sizeof(Entry) == 24);
+
+  explicit JitProfile(Memory::MemoryManager& memory);
+  ~JitProfile();
+
+  JitProfile(const JitProfile&) = delete;
+  JitProfile& operator=(const JitProfile&) = delete;
+
+  // Starts loading the profile once the game ID is known and picks up the loaded entries.
+  void Update();
+  // Looks at a limited number of the loaded entries and returns one whose code is in RAM.
+  bool GetNextEntryToCompile(CPUEmuFeatureFlags feature_flags, Entry* entry);
+
+  void RecordBlock(const JitBlock& block);
+  void Save();
+
+private:
+  static constexpr size_t MAX_ENTRIES = 0x10000;
+  static constexpr u32 MAX_CODE_SIZE = 0x10000;
+  static constexpr size_t MAX_CHECKS_PER_CALL = 64;
+
+  static u64 GetKey(u32 effective_address, CPUEmuFeatureFlags feature_flags)
+  {
+    return (u64(effective_address) << 32) | feature_flags;
+  }
+
+  static std::string GetPath(const std::string& game_id);
+  void LoadThread(std::string path);
+
+  const u8* GetCode(u32 physical_address, u32 size) const;
+  bool IsCodeInRAM(const Entry& entry) const;
+
+  Memory::MemoryManager& m_memory;
+
+  std::string m_game_id;
+  std::thread m_load_thread;
+  std::atomic<bool> m_load_done = false;
+  // Written by the load thread before m_load_done is set
+  std::vector<Entry> m_loaded_entries;
+
+  bool m_load_started = false;
+  bool m_load_finished = false;
+  std::vector<Entry> m_pending_entries;
+  size_t m_pending_cursor = 0;
+
+  std::unordered_map<u64, Entry> m_recorded_entries;
+};
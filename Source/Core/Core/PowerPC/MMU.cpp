@@ -918,6 +918,81 @@ std::optional<ReadResult<std::string>> MMU::HostTryReadString(const Core::CPUThr
   return ReadResult<std::string>(c->translated, std::move(s));
 }
 
+bool MMU::HostTryReadBlock(const Core::CPUThreadGuard& guard, u32 address, u8* out, u32 size,
+                           RequestedAddressSpace space)
+{
+  DEBUG_ASSERT(size != 0 && (address & ~HW_PAGE_MASK) == ((address + size - 1) & ~HW_PAGE_MASK));
+
+  auto& mmu = guard.GetSystem().GetMMU();
+  switch (space)
+  {
+  case RequestedAddressSpace::Effective:
+    return mmu.ReadBlockFromHardware(address, out, size, mmu.m_ppc_state.msr.DR);
+  case RequestedAddressSpace::Physical:
+    return mmu.ReadBlockFromHardware(address, out, size, false);
+  case RequestedAddressSpace::Virtual:
+    if (!mmu.m_ppc_state.msr.DR)
+      return false;
+    return mmu.ReadBlockFromHardware(address, out, size, true);
+  }
+
+  ASSERT(false);
+  return false;
+}
+
+// The same as ReadFromHardware<XCheckTLBFlag::NoException> for a whole block, minus the byteswap
+bool MMU::ReadBlockFromHardware(u32 em_address, u8* out, u32 size, bool translate)
+{
+  bool wi = false;
+  if (translate)
+  {
+    const auto translated_addr = TranslateAddress<XCheckTLBFlag::NoException>(em_address);
+    if (!translated_addr.Success())
+      return false;
+    em_address = translated_addr.address;
+    wi = translated_addr.wi;
+  }
+
+  const u32 segment = em_address >> 28;
+  const u32 offset = em_address & 0x0FFFFFFF;
+  if (m_memory.GetL1Cache() && segment == 0xE && offset + size <= m_memory.GetL1CacheSize())
+  {
+    std::memcpy(out, &m_memory.GetL1Cache()[offset], size);
+    return true;
+  }
+
+  if (m_memory.GetRAM() && (em_address & 0xF8000000) == 0x00000000)
+  {
+    // Mirrors of RAM are masked the same way as in ReadFromHardware.
+    const u32 ram_offset = em_address & m_memory.GetRamMask();
+    if (ram_offset + size > m_memory.GetRamSizeReal())
+      return false;
+
+    if (!m_ppc_state.m_enable_dcache || wi)
+      std::memcpy(out, &m_memory.GetRAM()[ram_offset], size);
+    else
+      m_ppc_state.dCache.Read(ram_offset, out, size, true);
+    return true;
+  }
+
+  if (m_memory.GetEXRAM() && segment == 0x1 && offset + size <= m_memory.GetExRamSizeReal())
+  {
+    if (!m_ppc_state.m_enable_dcache || wi)
+      std::memcpy(out, &m_memory.GetEXRAM()[offset], size);
+    else
+      m_ppc_state.dCache.Read(em_address, out, size, true);
+    return true;
+  }
+
+  if (m_memory.GetFakeVMEM() && ((em_address & 0xFE000000) == 0x7E000000))
+  {
+    std::memcpy(out, &m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask()], size);
+    return true;
+  }
+
+  return false;
+}
+
 bool MMU::IsOptimizableRAMAddress(const u32 address, const u32 access_size) const
 {
   if (m_power_pc.GetMemChecks().HasAny())
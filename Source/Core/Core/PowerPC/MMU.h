@@ -164,6 +164,13 @@ public:
   HostTryReadString(const Core::CPUThreadGuard& guard, u32 address, size_t size = 0,
                     RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+  // Copies size bytes of emulated memory to out as they are stored, without byteswapping. This is
+  // for reading large blocks, like HostTryReadU8 in a loop but without translating every byte.
+  // The bytes must not cross a page boundary. Returns false without copying anything if they
+  // aren't all RAM.
+  static bool HostTryReadBlock(const Core::CPUThreadGuard& guard, u32 address, u8* out, u32 size,
+                               RequestedAddressSpace space = RequestedAddressSpace::Effective);
+
   // Writes a value to emulated memory using the currently active MMU settings.
   // If the write fails (eg. address does not correspond to a mapped address in the current address
   // space), a PanicAlert will be shown to the user.
@@ -307,6 +314,7 @@ private:
 
   template <XCheckTLBFlag flag, typename T, bool never_translate = false>
   T ReadFromHardware(u32 em_address);
+  bool ReadBlockFromHardware(u32 em_address, u8* out, u32 size, bool translate);
   template <XCheckTLBFlag flag, bool never_translate = false>
   void WriteToHardware(u32 em_address, const u32 data, const u32 size);
   template <XCheckTLBFlag flag>
@@ -7,6 +7,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <filesystem>
+#include <limits>
 #include <locale>
 #include <map>
 #include <memory>
@@ -21,9 +22,12 @@
 
 #include <lz4.h>
 #include <lzo/lzo1x.h>
+#include <zstd.h>
 
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
@@ -36,6 +40,7 @@
 
 #include "Core/AchievementManager.h"
 #include "Core/Config/AchievementSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -49,6 +54,8 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
+#include "DiscIO/MultithreadedCompressor.h"
+
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -80,6 +87,7 @@ struct CompressAndDumpState_args
   std::vector<u8> buffer_vector;
   std::string filename;
   std::shared_ptr<Common::Event> state_write_done_event;
+  int zstd_level = 0;
 };
 
 // Protects against simultaneous reads and writes to the final savestate location from multiple
@@ -108,6 +116,10 @@ constexpr u32 COMPRESSED_DATA_OFFSET = 0;
 
 constexpr u32 COOKIE_BASE = 0xBAADBABE;
 
+// Uncompressed size of the blocks of LZ4Blocks and ZstdBlocks states. Small enough that even GC
+// states are split into enough blocks to keep every core busy.
+constexpr u32 COMPRESSION_BLOCK_SIZE = 1024 * 1024;
+
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
 // because they save the exact Dolphin version to savestates.
@@ -138,7 +150,7 @@ void EnableCompression(bool compression)
   s_use_compression = compression;
 }
 
-static void DoState(Core::System& system, PointerWrap& p)
+static void DoState(Core::System& system, PointerWrap& p, bool include_bulk_memory = true)
 {
   bool is_wii = system.IsWii() || system.IsMIOS();
   const bool is_wii_currently = is_wii;
@@ -187,7 +199,7 @@ static void DoState(Core::System& system, PointerWrap& p)
   p.DoMarker("CoreTiming");
 
   // HW needs to be restored before PowerPC because the data cache might need to be flushed.
-  HW::DoState(system, p);
+  HW::DoState(system, p, include_bulk_memory);
   p.DoMarker("HW");
 
   system.GetPowerPC().DoState(p);
@@ -245,6 +257,69 @@ void SaveToBuffer(Core::System& system, std::vector<u8>& buffer)
       true);
 }
 
+void SaveToBufferWithoutBulkMemory(Core::System& system, std::vector<u8>& buffer)
+{
+  // Snapshots are taken as often as every frame and their size barely changes, so write straight
+  // into the previous allocation. If the state has outgrown it, PointerWrap switches to measure
+  // mode and keeps counting, which gives us the size to retry with.
+  if (!buffer.empty())
+  {
+    buffer.resize(buffer.capacity());
+
+    u8* ptr = buffer.data();
+    PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+    DoState(system, p, false);
+
+    const size_t buffer_size = static_cast<size_t>(ptr - buffer.data());
+    if (p.IsWriteMode())
+    {
+      buffer.resize(buffer_size);
+      return;
+    }
+
+    buffer.resize(buffer_size);
+  }
+  else
+  {
+    u8* ptr = nullptr;
+    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+    DoState(system, p_measure, false);
+    buffer.resize(reinterpret_cast<size_t>(ptr));
+  }
+
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  DoState(system, p, false);
+}
+
+bool LoadFromBufferWithoutBulkMemory(Core::System& system, std::vector<u8>& buffer)
+{
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  DoState(system, p, false);
+  return p.IsReadMode();
+}
+
+void SaveToBufferImmediately(Core::System& system, std::vector<u8>& buffer)
+{
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  DoState(system, p_measure);
+  buffer.resize(reinterpret_cast<size_t>(ptr));
+
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  DoState(system, p);
+}
+
+bool LoadFromBufferImmediately(Core::System& system, std::vector<u8>& buffer)
+{
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  DoState(system, p);
+  return p.IsReadMode();
+}
+
 namespace
 {
 struct SlotWithTimestamp
@@ -316,51 +391,125 @@ static bool CompareTimestamp(const SlotWithTimestamp& lhs, const SlotWithTimesta
   return lhs.timestamp < rhs.timestamp;
 }
 
-static void CompressBufferToFile(const u8* raw_buffer, u64 size, File::IOFile& f)
+struct CompressThreadState
 {
-  u64 total_bytes_compressed = 0;
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> zstd_context{nullptr, ZSTD_freeCCtx};
+};
 
-  while (true)
-  {
-    u64 bytes_left_to_compress = size - total_bytes_compressed;
+struct CompressBlockParameters
+{
+  u32 index;
+  const u8* data;
+  u32 size;
+};
 
-    int bytes_to_compress =
-        static_cast<int>(std::min(static_cast<u64>(LZ4_MAX_INPUT_SIZE), bytes_left_to_compress));
-    int compressed_buffer_size = LZ4_compressBound(bytes_to_compress);
-    auto compressed_buffer = std::make_unique<char[]>(compressed_buffer_size);
-    s32 compressed_len =
-        LZ4_compress_default(reinterpret_cast<const char*>(raw_buffer) + total_bytes_compressed,
-                             compressed_buffer.get(), bytes_to_compress, compressed_buffer_size);
+struct CompressedBlock
+{
+  u32 index;
+  std::vector<u8> data;
+};
 
-    if (compressed_len == 0)
-    {
-      PanicAlertFmtT("Internal LZ4 Error - compression failed");
-      break;
-    }
+static bool CompressBufferToFile(const u8* raw_buffer, u64 size, int zstd_level, File::IOFile& f)
+{
+  const u64 block_count = Common::AlignUp(size, COMPRESSION_BLOCK_SIZE) / COMPRESSION_BLOCK_SIZE;
+  if (block_count > std::numeric_limits<u32>::max())
+  {
+    PanicAlertFmtT("Internal Error - state too large to compress");
+    return false;
+  }
 
-    // The size of the data to write is 'compressed_len'
-    f.WriteArray(&compressed_len, 1);
-    f.WriteBytes(compressed_buffer.get(), compressed_len);
+  // The index is written again with the actual sizes once all blocks have been compressed.
+  const StateBlockIndexHeader index_header{COMPRESSION_BLOCK_SIZE, static_cast<u32>(block_count)};
+  std::vector<u32> compressed_sizes(block_count);
+  f.WriteArray(&index_header, 1);
+  const u64 compressed_sizes_offset = f.Tell();
+  f.WriteArray(compressed_sizes.data(), compressed_sizes.size());
+
+  const int clamped_zstd_level = std::min(zstd_level, ZSTD_maxCLevel());
+
+  DiscIO::MultithreadedCompressor<CompressThreadState, CompressBlockParameters, CompressedBlock>
+      compressor(
+          [clamped_zstd_level](CompressThreadState* state) {
+            if (clamped_zstd_level <= 0)
+              return DiscIO::ConversionResultCode::Success;
+
+            state->zstd_context.reset(ZSTD_createCCtx());
+            if (!state->zstd_context)
+              return DiscIO::ConversionResultCode::InternalError;
+            return DiscIO::ConversionResultCode::Success;
+          },
+          [clamped_zstd_level](CompressThreadState* state, CompressBlockParameters parameters)
+              -> DiscIO::ConversionResult<CompressedBlock> {
+            CompressedBlock block{parameters.index, {}};
+            if (state->zstd_context)
+            {
+              block.data.resize(ZSTD_compressBound(parameters.size));
+              const size_t result =
+                  ZSTD_compressCCtx(state->zstd_context.get(), block.data.data(),
+                                    block.data.size(), parameters.data, parameters.size,
+                                    clamped_zstd_level);
+              if (ZSTD_isError(result))
+                return DiscIO::ConversionResultCode::InternalError;
+              block.data.resize(result);
+            }
+            else
+            {
+              const int bytes_to_compress = static_cast<int>(parameters.size);
+              block.data.resize(LZ4_compressBound(bytes_to_compress));
+              const int result = LZ4_compress_default(
+                  reinterpret_cast<const char*>(parameters.data),
+                  reinterpret_cast<char*>(block.data.data()), bytes_to_compress,
+                  static_cast<int>(block.data.size()));
+              if (result <= 0)
+                return DiscIO::ConversionResultCode::InternalError;
+              block.data.resize(result);
+            }
+            return block;
+          },
+          [&compressed_sizes, &f](CompressedBlock block) {
+            compressed_sizes[block.index] = static_cast<u32>(block.data.size());
+            if (!f.WriteBytes(block.data.data(), block.data.size()))
+              return DiscIO::ConversionResultCode::WriteFailed;
+            return DiscIO::ConversionResultCode::Success;
+          });
+
+  for (u32 i = 0; i < block_count; ++i)
+  {
+    const u64 offset = static_cast<u64>(i) * COMPRESSION_BLOCK_SIZE;
+    const u32 bytes_to_compress =
+        static_cast<u32>(std::min<u64>(COMPRESSION_BLOCK_SIZE, size - offset));
+    compressor.CompressAndWrite({i, raw_buffer + offset, bytes_to_compress});
+  }
 
-    total_bytes_compressed += bytes_to_compress;
-    if (total_bytes_compressed == size)
-      break;
+  compressor.Shutdown();
+
+  if (compressor.GetStatus() != DiscIO::ConversionResultCode::Success)
+  {
+    PanicAlertFmtT("Internal Error - state compression failed");
+    return false;
   }
+
+  const u64 end_offset = f.Tell();
+  f.Seek(compressed_sizes_offset, File::SeekOrigin::Begin);
+  f.WriteArray(compressed_sizes.data(), compressed_sizes.size());
+  f.Seek(end_offset, File::SeekOrigin::Begin);
+  return f.IsGood();
 }
 
-static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size)
+static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size,
+                                 CompressionType compression_type)
 {
   StateExtendedBaseHeader& base_header = extended_header.base_header;
   base_header.header_version = EXTENDED_HEADER_VERSION;
-  base_header.compression_type =
-      s_use_compression ? CompressionType::LZ4 : CompressionType::Uncompressed;
+  base_header.compression_type = compression_type;
   base_header.payload_offset = COMPRESSED_DATA_OFFSET;
   base_header.uncompressed_size = uncompressed_size;
 
   // If more fields are added to StateExtendedHeader, set them here.
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+static void WriteHeadersToFile(size_t uncompressed_size, CompressionType compression_type,
+                               File::IOFile& f)
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
@@ -372,7 +521,7 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   header.version_header.version_string_length = static_cast<u32>(header.version_string.length());
 
   StateExtendedHeader extended_header{};
-  CreateExtendedHeader(extended_header, uncompressed_size);
+  CreateExtendedHeader(extended_header, uncompressed_size, compression_type);
 
   f.WriteArray(&header.legacy_header, 1);
   f.WriteArray(&header.version_header, 1);
@@ -406,12 +555,30 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
     return;
   }
 
-  WriteHeadersToFile(buffer_size, f);
-
+  CompressionType compression_type = CompressionType::Uncompressed;
   if (s_use_compression)
-    CompressBufferToFile(buffer_data, buffer_size, f);
+  {
+    compression_type =
+        save_args.zstd_level > 0 ? CompressionType::ZstdBlocks : CompressionType::LZ4Blocks;
+  }
+
+  WriteHeadersToFile(buffer_size, compression_type, f);
+
+  if (compression_type != CompressionType::Uncompressed)
+  {
+    if (!CompressBufferToFile(buffer_data, buffer_size, save_args.zstd_level, f))
+    {
+      // Don't replace the existing state with a broken one.
+      f.Close();
+      File::Delete(temp_filename);
+      Core::DisplayMessage("Failed to compress state file", 2000);
+      return;
+    }
+  }
   else
+  {
     f.WriteBytes(buffer_data, buffer_size);
+  }
 
   if (!f.IsGood())
     Core::DisplayMessage("Failed to write state file", 2000);
@@ -444,7 +611,7 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
 
     auto& movie = system.GetMovie();
     if ((movie.IsMovieActive()) && !movie.IsJustStartingRecordingInputFromSaveState())
-      movie.SaveRecording(dtmname);
+      movie.SaveRecording(dtmname, true);
     else if (!movie.IsMovieActive())
       File::Delete(dtmname);
 
@@ -504,6 +671,7 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
           CompressAndDumpState_args save_args;
           save_args.buffer_vector = std::move(current_buffer);
           save_args.filename = filename;
+          save_args.zstd_level = Config::Get(Config::MAIN_SAVESTATE_ZSTD_LEVEL);
           if (wait)
           {
             sync_event = std::make_shared<Common::Event>();
@@ -721,6 +889,123 @@ static bool DecompressLZ4(std::vector<u8>& raw_buffer, u64 size, File::IOFile& f
   }
 }
 
+struct DecompressThreadState
+{
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> zstd_context{nullptr, ZSTD_freeDCtx};
+};
+
+struct DecompressBlockParameters
+{
+  std::vector<u8> compressed_data;
+  u8* out;
+  u32 size;
+};
+
+static bool DecompressBlocks(std::vector<u8>& raw_buffer, u64 size,
+                             CompressionType compression_type, File::IOFile& f)
+{
+  StateBlockIndexHeader index_header;
+  if (!f.ReadArray(&index_header, 1))
+  {
+    PanicAlertFmt("Could not read state block index");
+    return false;
+  }
+
+  const u64 block_size = index_header.block_size;
+  if (block_size == 0 || index_header.block_count != Common::AlignUp(size, block_size) / block_size)
+  {
+    PanicAlertFmt("State block index corrupted");
+    return false;
+  }
+
+  std::vector<u32> compressed_sizes(index_header.block_count);
+  if (!f.ReadArray(compressed_sizes.data(), compressed_sizes.size()))
+  {
+    PanicAlertFmt("Could not read state block index");
+    return false;
+  }
+
+  raw_buffer.resize(size);
+
+  // Blocks are decompressed straight into place, so there is nothing left to do in the output step.
+  const bool use_zstd = compression_type == CompressionType::ZstdBlocks;
+  DiscIO::MultithreadedCompressor<DecompressThreadState, DecompressBlockParameters, u32>
+      decompressor(
+          [use_zstd](DecompressThreadState* state) {
+            if (!use_zstd)
+              return DiscIO::ConversionResultCode::Success;
+
+            state->zstd_context.reset(ZSTD_createDCtx());
+            if (!state->zstd_context)
+              return DiscIO::ConversionResultCode::InternalError;
+            return DiscIO::ConversionResultCode::Success;
+          },
+          [](DecompressThreadState* state, DecompressBlockParameters parameters)
+              -> DiscIO::ConversionResult<u32> {
+            size_t bytes_read;
+            if (state->zstd_context)
+            {
+              bytes_read = ZSTD_decompressDCtx(state->zstd_context.get(), parameters.out,
+                                               parameters.size, parameters.compressed_data.data(),
+                                               parameters.compressed_data.size());
+              if (ZSTD_isError(bytes_read))
+                return DiscIO::ConversionResultCode::InternalError;
+            }
+            else
+            {
+              const int result = LZ4_decompress_safe(
+                  reinterpret_cast<const char*>(parameters.compressed_data.data()),
+                  reinterpret_cast<char*>(parameters.out),
+                  static_cast<int>(parameters.compressed_data.size()),
+                  static_cast<int>(parameters.size));
+              if (result < 0)
+                return DiscIO::ConversionResultCode::InternalError;
+              bytes_read = static_cast<size_t>(result);
+            }
+
+            if (bytes_read != parameters.size)
+              return DiscIO::ConversionResultCode::InternalError;
+            return parameters.size;
+          },
+          [](u32) { return DiscIO::ConversionResultCode::Success; });
+
+  bool read_failed = false;
+  for (u32 i = 0; i < index_header.block_count; ++i)
+  {
+    if (decompressor.GetStatus() != DiscIO::ConversionResultCode::Success)
+      break;
+
+    const u64 offset = i * block_size;
+    DecompressBlockParameters parameters;
+    parameters.compressed_data.resize(compressed_sizes[i]);
+    parameters.out = raw_buffer.data() + offset;
+    parameters.size = static_cast<u32>(std::min(block_size, size - offset));
+    if (!f.ReadBytes(parameters.compressed_data.data(), parameters.compressed_data.size()))
+    {
+      read_failed = true;
+      break;
+    }
+
+    decompressor.CompressAndWrite(std::move(parameters));
+  }
+
+  decompressor.Shutdown();
+
+  if (read_failed)
+  {
+    PanicAlertFmt("Could not read state data");
+    return false;
+  }
+
+  if (decompressor.GetStatus() != DiscIO::ConversionResultCode::Success)
+  {
+    PanicAlertFmtT("Internal Error - state decompression failed");
+    return false;
+  }
+
+  return true;
+}
+
 static bool ValidateHeaders(const StateHeader& header)
 {
   bool success = true;
@@ -818,6 +1103,20 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     break;
   }
+  case CompressionType::LZ4Blocks:
+  case CompressionType::ZstdBlocks:
+  {
+    Core::DisplayMessage("Decompressing State...", 500);
+    const auto compression_type =
+        static_cast<CompressionType>(extended_header.base_header.compression_type);
+    if (!DecompressBlocks(buffer, extended_header.base_header.uncompressed_size, compression_type,
+                          f))
+    {
+      return;
+    }
+
+    break;
+  }
   case CompressionType::Uncompressed:
   {
     u64 header_len = sizeof(StateHeaderLegacy) + sizeof(StateHeaderVersion) +
@@ -884,7 +1183,7 @@ void LoadAs(Core::System& system, const std::string& filename)
           SaveToBuffer(system, s_undo_load_buffer);
           const std::string dtmpath = File::GetUserPath(D_STATESAVES_IDX) + "undo.dtm";
           if (movie.IsMovieActive())
-            movie.SaveRecording(dtmpath);
+            movie.SaveRecording(dtmpath, true);
           else if (File::Exists(dtmpath))
             File::Delete(dtmpath);
         }
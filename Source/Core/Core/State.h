@@ -55,6 +55,11 @@ enum CompressionType : u16
 {
   Uncompressed = 0,
   LZ4 = 1,
+  // The payload of these starts with a StateBlockIndexHeader, followed by the compressed size of
+  // every block as a u32 and then the blocks themselves. Each block holds block_size bytes of the
+  // uncompressed state (except for the last one) and is compressed independently of the others.
+  LZ4Blocks = 2,
+  ZstdBlocks = 3,
   // Add new compression types after this, as the compression type
   // is numerically stored in the state file.
 };
@@ -80,6 +85,14 @@ struct StateExtendedHeader
   // and WriteHeadersToFile()
 };
 
+struct StateBlockIndexHeader
+{
+  u32 block_size;
+  u32 block_count;
+};
+static_assert(sizeof(StateBlockIndexHeader) == 8);
+static_assert(std::is_trivially_copyable_v<StateBlockIndexHeader>);
+
 void Init(Core::System& system);
 
 void Shutdown();
@@ -109,6 +122,18 @@ void LoadAs(Core::System& system, const std::string& filename);
 void SaveToBuffer(Core::System& system, std::vector<u8>& buffer);
 void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer);
 
+// Variants of the above for DeltaSnapshotRing. These must be called from the CPU thread while it is
+// outside of emulated code, run immediately, and skip the NetPlay restriction on loading.
+// The regions from HW::GetBulkMemoryRegions() are left out and have to be handled by the caller.
+// The buffer's existing allocation is reused when the state still fits into it.
+void SaveToBufferWithoutBulkMemory(Core::System& system, std::vector<u8>& buffer);
+bool LoadFromBufferWithoutBulkMemory(Core::System& system, std::vector<u8>& buffer);
+
+// Variants of SaveToBuffer and LoadFromBuffer for NetPlay spectators joining a running game, with
+// the same requirements as the ones above. The whole state is included.
+void SaveToBufferImmediately(Core::System& system, std::vector<u8>& buffer);
+bool LoadFromBufferImmediately(Core::System& system, std::vector<u8>& buffer);
+
 void LoadLastSaved(Core::System& system, int i = 1);
 void SaveFirstSaved(Core::System& system);
 void UndoSaveState(Core::System& system);
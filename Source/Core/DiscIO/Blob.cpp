@@ -64,71 +64,112 @@ std::string GetName(BlobType blob_type, bool translate)
 void SectorReader::SetSectorSize(int blocksize)
 {
   m_block_size = std::max(blocksize, 0);
-  for (auto& cache_entry : m_cache)
-  {
-    cache_entry.Reset();
-    cache_entry.data.resize(m_chunk_blocks * m_block_size);
-  }
+  ResetCache();
 }
 
 void SectorReader::SetChunkSize(int block_cnt)
 {
   m_chunk_blocks = std::max(block_cnt, 1);
-  // Clear cache and resize the data arrays
-  SetSectorSize(m_block_size);
+  ResetCache();
+}
+
+void SectorReader::SetCacheCapacity(u64 bytes)
+{
+  m_cache_capacity = bytes;
+  ResetCache();
 }
 
 SectorReader::~SectorReader()
 {
 }
 
-const SectorReader::Cache* SectorReader::FindCacheLine(u64 block_num)
+void SectorReader::ResetCache()
 {
-  auto itr = std::find_if(m_cache.begin(), m_cache.end(),
-                          [&](const Cache& entry) { return entry.Contains(block_num); });
-  if (itr == m_cache.end())
-    return nullptr;
+  const u64 chunk_bytes = GetChunkBytes();
+  const u64 lines =
+      chunk_bytes ? std::max<u64>(MIN_CACHE_LINES, m_cache_capacity / chunk_bytes) : 0;
+
+  m_cache_lines.assign(lines, CacheLine{});
+  m_cache_data.resize(lines * chunk_bytes);
+  m_cache_data.shrink_to_fit();
+  m_cache_index.clear();
+  m_clock_hand = 0;
+}
 
-  itr->MarkUsed();
-  return &*itr;
+std::optional<u32> SectorReader::FindCacheLine(u64 chunk_idx) const
+{
+  const auto it = m_cache_index.find(chunk_idx);
+  if (it == m_cache_index.end())
+    return std::nullopt;
+  return it->second;
 }
 
-SectorReader::Cache* SectorReader::GetEmptyCacheLine()
+u32 SectorReader::GetEmptyCacheLine()
 {
-  Cache* oldest = &m_cache[0];
-  // Find the Least Recently Used cache line to replace.
-  std::for_each(m_cache.begin() + 1, m_cache.end(), [&](Cache& line) {
-    if (line.IsLessRecentlyUsedThan(*oldest))
+  while (true)
+  {
+    const u32 index = m_clock_hand;
+    CacheLine& line = m_cache_lines[index];
+    m_clock_hand = (m_clock_hand + 1) % m_cache_lines.size();
+
+    if (line.referenced)
     {
-      oldest->ShiftLRU();
-      oldest = &line;
-      return;
+      line.referenced = false;
+      continue;
     }
-    line.ShiftLRU();
-  });
-  oldest->Reset();
-  return oldest;
+
+    if (line.num_blocks != 0)
+    {
+      m_cache_index.erase(line.chunk_idx);
+      line.num_blocks = 0;
+    }
+    return index;
+  }
 }
 
-const SectorReader::Cache* SectorReader::GetCacheLine(u64 block_num)
+u64 SectorReader::LoadChunks(u64 first_chunk, u64 count)
 {
-  if (auto entry = FindCacheLine(block_num))
-    return entry;
-
-  // Cache miss. Fault in the missing entry.
-  Cache* cache = GetEmptyCacheLine();
-  // We only read aligned chunks, this avoids duplicate overlapping entries.
-  u64 chunk_idx = block_num / m_chunk_blocks;
-  u32 blocks_read = ReadChunk(cache->data.data(), chunk_idx);
-  if (!blocks_read)
-    return nullptr;
-  cache->Fill(chunk_idx * m_chunk_blocks, blocks_read);
+  m_cache_statistics.misses += count;
+
+  const u64 chunk_bytes = GetChunkBytes();
+  m_batch_buffer.resize(count * chunk_bytes);
+
+  const u64 first_block = first_chunk * m_chunk_blocks;
+  const u64 end_block = (GetDataSize() + m_block_size - 1) / m_block_size;
+  u64 num_blocks = 0;
+  if (count > 1 && end_block > first_block)
+  {
+    num_blocks = std::min(count * m_chunk_blocks, end_block - first_block);
+    if (!ReadMultipleAlignedBlocks(first_block, num_blocks, m_batch_buffer.data()))
+      num_blocks = 0;
+  }
 
-  // Secondary check for out-of-bounds read.
-  // If we got less than m_chunk_blocks, we may still have missed.
-  // We do this after the cache fill since the cache line itself is
-  // fine, the problem is being asked to read past the end of the disk.
-  return cache->Contains(block_num) ? cache : nullptr;
+  if (num_blocks == 0)
+  {
+    // Let ReadChunk deal with reading past the end of the disc
+    for (u64 i = 0; i < count; ++i)
+    {
+      const u32 blocks_read = ReadChunk(m_batch_buffer.data() + i * chunk_bytes, first_chunk + i);
+      num_blocks += blocks_read;
+      if (blocks_read < m_chunk_blocks)
+        break;
+    }
+  }
+
+  for (u64 i = 0; i * m_chunk_blocks < num_blocks; ++i)
+  {
+    const u32 blocks =
+        static_cast<u32>(std::min<u64>(m_chunk_blocks, num_blocks - i * m_chunk_blocks));
+    const u32 index = GetEmptyCacheLine();
+    u8* data = GetLineData(index);
+    const u8* source = m_batch_buffer.data() + i * chunk_bytes;
+    std::copy(source, source + blocks * m_block_size, data);
+    std::fill(data + blocks * m_block_size, data + chunk_bytes, 0u);
+
+    m_cache_lines[index] = {first_chunk + i, blocks, false};
+    m_cache_index.emplace(first_chunk + i, index);
+  }
+  return num_blocks;
 }
 
 bool SectorReader::Read(u64 offset, u64 size, u8* out_ptr)
@@ -136,30 +177,53 @@ bool SectorReader::Read(u64 offset, u64 size, u8* out_ptr)
   if (offset + size > GetDataSize())
     return false;
 
+  const u64 chunk_bytes = GetChunkBytes();
   u64 remain = size;
-  u64 block = 0;
-  u32 position_in_block = static_cast<u32>(offset % m_block_size);
 
   while (remain > 0)
   {
-    block = offset / m_block_size;
-
-    const Cache* cache = GetCacheLine(block);
-    if (!cache)
-      return false;
+    const u64 chunk = offset / chunk_bytes;
 
     // Cache entries are aligned chunks, we may not want to read from the start
-    u32 read_offset = static_cast<u32>(block - cache->block_idx) * m_block_size + position_in_block;
-    u32 can_read = m_block_size * cache->num_blocks - read_offset;
-    u32 was_read = static_cast<u32>(std::min<u64>(can_read, remain));
+    const u64 read_offset = offset - chunk * chunk_bytes;
+    const u8* data;
+    u64 can_read;
+
+    if (const std::optional<u32> index = FindCacheLine(chunk))
+    {
+      CacheLine& line = m_cache_lines[*index];
+      line.referenced = true;
+      m_cache_statistics.hits++;
+      data = GetLineData(*index);
+      can_read = u64(m_block_size) * line.num_blocks;
+    }
+    else
+    {
+      // Fault in the missing chunk together with the missing chunks directly after it that this
+      // read also needs, so that they can be decoded in one go. The data is copied out of the
+      // batch buffer, since small caches may not be able to hold the whole batch.
+      const u64 last_chunk = (offset + remain - 1) / chunk_bytes;
+      u64 count = 1;
+      while (count < MAX_BATCH_CHUNKS && chunk + count <= last_chunk &&
+             !m_cache_index.contains(chunk + count))
+      {
+        ++count;
+      }
+
+      can_read = u64(m_block_size) * LoadChunks(chunk, count);
+      data = m_batch_buffer.data();
+    }
+
+    // If we got less than m_chunk_blocks, we may be past the end of the disc
+    if (read_offset >= can_read)
+      return false;
 
-    std::copy(cache->data.begin() + read_offset, cache->data.begin() + read_offset + was_read,
-              out_ptr);
+    const u64 was_read = std::min(can_read - read_offset, remain);
+    std::copy(data + read_offset, data + read_offset + was_read, out_ptr);
 
     offset += was_read;
     out_ptr += was_read;
     remain -= was_read;
-    position_in_block = 0;
   }
   return true;
 }
@@ -18,6 +18,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -107,10 +108,23 @@ protected:
 class SectorReader : public BlobReader
 {
 public:
+  struct CacheStatistics
+  {
+    // Counted in chunks
+    u64 hits = 0;
+    u64 misses = 0;
+  };
+
+  static constexpr u64 DEFAULT_CACHE_CAPACITY = 4 * 1024 * 1024;
+
   virtual ~SectorReader() = 0;
 
   bool Read(u64 offset, u64 size, u8* out_ptr) override;
 
+  // Sets how many bytes of decoded chunks to keep in memory. This clears the cache.
+  void SetCacheCapacity(u64 bytes);
+  const CacheStatistics& GetCacheStatistics() const { return m_cache_statistics; }
+
 protected:
   void SetSectorSize(int blocksize);
   int GetSectorSize() const { return m_block_size; }
@@ -130,52 +144,31 @@ protected:
   virtual bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr);
 
 private:
-  struct Cache
+  // The cache uses the CLOCK replacement policy. Lines are marked as referenced when they're hit,
+  // and the clock hand clears the mark when it passes them while looking for a line to replace.
+  // Newly loaded lines start out unreferenced, so chunks that are only read once, like during
+  // a long sequential read, are replaced before chunks that keep getting read.
+  struct CacheLine
   {
-    std::vector<u8> data;
-    u64 block_idx = 0;
-    u32 num_blocks = 0;
-
-    // [Pseudo-] Least Recently Used Shift Register
-    // When an empty cache line is needed, the line with the lowest value
-    // is taken and reset; the LRU register is then shifted down 1 place
-    // on all lines (low bit discarded). When a line is used, the high bit
-    // is set marking it as most recently used.
-    u32 lru_sreg = 0;
-
-    void Reset()
-    {
-      block_idx = 0;
-      num_blocks = 0;
-      lru_sreg = 0;
-    }
-    void Fill(u64 block, u32 count)
-    {
-      block_idx = block;
-      num_blocks = count;
-      // NOTE: Setting only the high bit means the newest line will
-      //   be selected for eviction if every line in the cache was
-      //   touched. This gives MRU behavior which is probably
-      //   desirable in that case.
-      MarkUsed();
-    }
-    bool Contains(u64 block) const { return block >= block_idx && block - block_idx < num_blocks; }
-    void MarkUsed() { lru_sreg |= 0x80000000; }
-    void ShiftLRU() { lru_sreg >>= 1; }
-    bool IsLessRecentlyUsedThan(const Cache& other) const { return lru_sreg < other.lru_sreg; }
+    u64 chunk_idx = 0;
+    u32 num_blocks = 0;  // Zero if the line is empty
+    bool referenced = false;
   };
 
-  // Gets the cache line that contains the given block, or nullptr.
-  // NOTE: The cache record only lasts until it expires (next GetEmptyCacheLine)
-  const Cache* FindCacheLine(u64 block_num);
+  void ResetCache();
+  u64 GetChunkBytes() const { return u64(m_block_size) * m_chunk_blocks; }
+  u8* GetLineData(u32 line) { return m_cache_data.data() + line * GetChunkBytes(); }
+
+  // Returns the index of the line which holds the chunk, or nullopt.
+  std::optional<u32> FindCacheLine(u64 chunk_idx) const;
 
-  // Finds the least recently used cache line, resets and returns it.
-  Cache* GetEmptyCacheLine();
+  // Empties the line under the clock hand that isn't referenced and returns its index.
+  u32 GetEmptyCacheLine();
 
-  // Combines FindCacheLine with GetEmptyCacheLine and ReadChunk.
-  // Always returns a valid cache line (loading the data if needed).
-  // May return nullptr only if the cache missed and the read failed.
-  const Cache* GetCacheLine(u64 block_num);
+  // Reads count chunks, which must not be in the cache, into m_batch_buffer with a single call
+  // to ReadMultipleAlignedBlocks where possible, and adds them to the cache. Returns the number
+  // of blocks read, which is less than requested at the end of the disc or on errors.
+  u64 LoadChunks(u64 first_chunk, u64 count);
 
   // Read all bytes from a chunk of blocks into a buffer.
   // Returns the number of blocks read (may be less than m_chunk_blocks
@@ -183,10 +176,19 @@ private:
   // evenly divisible into chunks). Returns zero if it fails.
   u32 ReadChunk(u8* buffer, u64 chunk_num);
 
-  static constexpr int CACHE_LINES = 32;
+  static constexpr u32 MIN_CACHE_LINES = 2;
+  static constexpr u64 MAX_BATCH_CHUNKS = 64;
+
   u32 m_block_size = 0;    // Bytes in a sector/block
   u32 m_chunk_blocks = 1;  // Number of sectors/blocks in a chunk
-  std::array<Cache, CACHE_LINES> m_cache;
+
+  u64 m_cache_capacity = DEFAULT_CACHE_CAPACITY;
+  std::vector<CacheLine> m_cache_lines;
+  std::vector<u8> m_cache_data;
+  std::unordered_map<u64, u32> m_cache_index;
+  u32 m_clock_hand = 0;
+  std::vector<u8> m_batch_buffer;
+  CacheStatistics m_cache_statistics;
 };
 
 // Factory function - examines the path to choose the right type of BlobReader, and returns one.
@@ -94,17 +94,8 @@ u64 CompressedBlobReader::GetBlockCompressedSize(u64 block_num) const
 
 bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 {
-  bool uncompressed = false;
-  u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
-  u64 offset = m_block_pointers[block_num] + m_data_offset;
-
-  if (offset & (1ULL << 63))
-  {
-    if (comp_block_size != m_header.block_size)
-      ERROR_LOG_FMT(DISCIO, "Uncompressed block with wrong size");
-    uncompressed = true;
-    offset &= ~(1ULL << 63);
-  }
+  const u32 comp_block_size = static_cast<u32>(GetBlockCompressedSize(block_num));
+  const u64 offset = (m_block_pointers[block_num] & ~(1ULL << 63)) + m_data_offset;
 
   // clear unused part of zlib buffer. maybe this can be deleted when it works fully.
   memset(&m_zlib_buffer[comp_block_size], 0, m_zlib_buffer.size() - comp_block_size);
@@ -118,8 +109,61 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
     return false;
   }
 
+  z_stream z = {};
+  inflateInit(&z);
+  const bool success = DecodeBlock(block_num, m_zlib_buffer.data(), comp_block_size, out_ptr, &z);
+  inflateEnd(&z);
+  return success;
+}
+
+bool CompressedBlobReader::ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  // Blocks are stored back to back, so the compressed data of all of them can be read at once,
+  // and then be inflated using the same z_stream.
+  const u64 first_offset = m_block_pointers[block_num] & ~(1ULL << 63);
+  u64 total_size = 0;
+  for (u64 i = 0; i < num_blocks; ++i)
+  {
+    if ((m_block_pointers[block_num + i] & ~(1ULL << 63)) != first_offset + total_size)
+      return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+    total_size += static_cast<u32>(GetBlockCompressedSize(block_num + i));
+  }
+
+  m_batch_buffer.resize(total_size);
+  m_file.Seek(first_offset + m_data_offset, File::SeekOrigin::Begin);
+  if (!m_file.ReadBytes(m_batch_buffer.data(), total_size))
+  {
+    ERROR_LOG_FMT(DISCIO, "The disc image \"{}\" is truncated, some of the data is missing.",
+                  m_file_name);
+    m_file.ClearError();
+    return false;
+  }
+
+  z_stream z = {};
+  inflateInit(&z);
+  bool success = true;
+  const u8* data = m_batch_buffer.data();
+  for (u64 i = 0; i < num_blocks && success; ++i)
+  {
+    const u32 size = static_cast<u32>(GetBlockCompressedSize(block_num + i));
+    inflateReset(&z);
+    success = DecodeBlock(block_num + i, data, size, out_ptr, &z);
+    data += size;
+    out_ptr += m_header.block_size;
+  }
+  inflateEnd(&z);
+  return success;
+}
+
+bool CompressedBlobReader::DecodeBlock(u64 block_num, const u8* data, u32 size, u8* out_ptr,
+                                       z_stream* z) const
+{
+  const bool uncompressed = (m_block_pointers[block_num] & (1ULL << 63)) != 0;
+  if (uncompressed && size != m_header.block_size)
+    ERROR_LOG_FMT(DISCIO, "Uncompressed block with wrong size");
+
   // First, check hash.
-  const u32 block_hash = Common::HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  const u32 block_hash = Common::HashAdler32(data, size);
   if (block_hash != m_hashes[block_num])
   {
     ERROR_LOG_FMT(DISCIO,
@@ -130,34 +174,31 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 
   if (uncompressed)
   {
-    std::copy(m_zlib_buffer.begin(), m_zlib_buffer.begin() + comp_block_size, out_ptr);
+    std::copy(data, data + size, out_ptr);
+    return true;
   }
-  else
+
+  // zlib doesn't modify the input, it just isn't declared as const
+  z->next_in = const_cast<u8*>(data);
+  z->avail_in = size;
+  if (z->avail_in > m_header.block_size)
   {
-    z_stream z = {};
-    z.next_in = m_zlib_buffer.data();
-    z.avail_in = comp_block_size;
-    if (z.avail_in > m_header.block_size)
-    {
-      ERROR_LOG_FMT(DISCIO, "Compressed block size is larger than uncompressed block size");
-    }
-    z.next_out = out_ptr;
-    z.avail_out = m_header.block_size;
-    inflateInit(&z);
-    int status = inflate(&z, Z_FULL_FLUSH);
-    u32 uncomp_size = m_header.block_size - z.avail_out;
-    if (status != Z_STREAM_END)
-    {
-      // this seem to fire wrongly from time to time
-      // to be sure, don't use compressed isos :P
-      ERROR_LOG_FMT(DISCIO, "Failure reading block {} - out of data and not at end.", block_num);
-    }
-    inflateEnd(&z);
-    if (uncomp_size != m_header.block_size)
-    {
-      ERROR_LOG_FMT(DISCIO, "Wrong block size");
-      return false;
-    }
+    ERROR_LOG_FMT(DISCIO, "Compressed block size is larger than uncompressed block size");
+  }
+  z->next_out = out_ptr;
+  z->avail_out = m_header.block_size;
+  int status = inflate(z, Z_FULL_FLUSH);
+  u32 uncomp_size = m_header.block_size - z->avail_out;
+  if (status != Z_STREAM_END)
+  {
+    // this seem to fire wrongly from time to time
+    // to be sure, don't use compressed isos :P
+    ERROR_LOG_FMT(DISCIO, "Failure reading block {} - out of data and not at end.", block_num);
+  }
+  if (uncomp_size != m_header.block_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "Wrong block size");
+    return false;
   }
   return true;
 }
@@ -20,6 +20,8 @@
 #include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
 
+struct z_stream_s;
+
 namespace DiscIO
 {
 static constexpr u32 GCZ_MAGIC = 0xB10BC001;
@@ -64,9 +66,15 @@ public:
   u64 GetBlockCompressedSize(u64 block_num) const;
   bool GetBlock(u64 block_num, u8* out_ptr) override;
 
+protected:
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override;
+
 private:
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  // Checks the hash of a block and decompresses it using an initialized z_stream.
+  bool DecodeBlock(u64 block_num, const u8* data, u32 size, u8* out_ptr, z_stream_s* z) const;
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -74,6 +82,7 @@ private:
   File::IOFile m_file;
   u64 m_file_size;
   std::vector<u8> m_zlib_buffer;
+  std::vector<u8> m_batch_buffer;
   std::string m_file_name;
 };
 
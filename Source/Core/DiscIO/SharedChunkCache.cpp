@@ -0,0 +1,93 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/SharedChunkCache.h"
+
+namespace DiscIO
+{
+// Enough for a few seconds of streaming from a disc using the largest chunk size that Dolphin
+// creates, or for a loading screen's worth of chunks using the default chunk size.
+constexpr size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+static u64 Mix(u64 value)
+{
+  value ^= value >> 33;
+  value *= 0xFF51AFD7ED558CCDULL;
+  value ^= value >> 33;
+  return value;
+}
+
+size_t SharedChunkCache::KeyHash::operator()(const SharedChunkKey& key) const
+{
+  u64 hash = Mix(key.file_id ^ key.offset_in_file);
+  hash = Mix(hash ^ key.data_offset);
+  hash = Mix(hash ^ key.decompressed_size ^ (static_cast<u64>(key.exception_lists) << 32));
+  return static_cast<size_t>(hash);
+}
+
+SharedChunkCache::SharedChunkCache(size_t capacity_in_bytes)
+    : m_shard_capacity(capacity_in_bytes / SHARD_COUNT)
+{
+}
+
+SharedChunkCache& SharedChunkCache::GetInstance()
+{
+  static SharedChunkCache instance(DEFAULT_CAPACITY);
+  return instance;
+}
+
+size_t SharedChunkCache::GetSize(const DecodedChunk& chunk)
+{
+  return chunk.data.size() + chunk.exception_lists.size();
+}
+
+SharedChunkCache::Shard& SharedChunkCache::GetShard(const SharedChunkKey& key)
+{
+  // Consecutive chunks of a file go to different shards, so that threads decoding neighboring
+  // chunks in parallel don't contend on the same lock.
+  return m_shards[Mix(key.file_id ^ key.offset_in_file) % SHARD_COUNT];
+}
+
+std::shared_ptr<const DecodedChunk> SharedChunkCache::Get(const SharedChunkKey& key)
+{
+  Shard& shard = GetShard(key);
+  std::lock_guard lock(shard.mutex);
+
+  const auto it = shard.entries.find(key);
+  if (it == shard.entries.end())
+    return nullptr;
+
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+  return it->second->second;
+}
+
+void SharedChunkCache::Insert(const SharedChunkKey& key, std::shared_ptr<const DecodedChunk> chunk)
+{
+  const size_t size = GetSize(*chunk);
+  if (size > m_shard_capacity)
+    return;
+
+  Shard& shard = GetShard(key);
+  std::lock_guard lock(shard.mutex);
+
+  const auto it = shard.entries.find(key);
+  if (it != shard.entries.end())
+  {
+    shard.size_in_bytes -= GetSize(*it->second->second);
+    shard.lru.erase(it->second);
+    shard.entries.erase(it);
+  }
+
+  while (shard.size_in_bytes + size > m_shard_capacity)
+  {
+    const Entry& victim = shard.lru.back();
+    shard.size_in_bytes -= GetSize(*victim.second);
+    shard.entries.erase(victim.first);
+    shard.lru.pop_back();
+  }
+
+  shard.lru.emplace_front(key, std::move(chunk));
+  shard.entries.emplace(key, shard.lru.begin());
+  shard.size_in_bytes += size;
+}
+}  // namespace DiscIO
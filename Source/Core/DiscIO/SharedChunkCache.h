@@ -0,0 +1,84 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+// A fully decompressed chunk of a WIA or RVZ file. It isn't modified after being cached,
+// so any number of readers on any thread can use it at the same time.
+struct DecodedChunk
+{
+  std::vector<u8> data;
+  // Hash exception lists in the format they're stored in, or empty if the chunk has none
+  std::vector<u8> exception_lists;
+};
+
+struct SharedChunkKey
+{
+  // Identifies the contents of the file rather than its path, so copies of a reader and
+  // readers that opened the file through different paths all share entries
+  u64 file_id = 0;
+  u64 offset_in_file = 0;
+  // These affect how the chunk is decoded, so they're part of the key in case two groups
+  // share the same data in the file
+  u64 data_offset = 0;
+  u64 decompressed_size = 0;
+  u32 exception_lists = 0;
+
+  bool operator==(const SharedChunkKey&) const = default;
+};
+
+// Process-wide, size-bounded LRU cache of decompressed chunks. It's split into shards by chunk
+// so that readers on different threads rarely wait for each other.
+class SharedChunkCache
+{
+public:
+  explicit SharedChunkCache(size_t capacity_in_bytes);
+
+  SharedChunkCache(const SharedChunkCache&) = delete;
+  SharedChunkCache& operator=(const SharedChunkCache&) = delete;
+
+  static SharedChunkCache& GetInstance();
+
+  std::shared_ptr<const DecodedChunk> Get(const SharedChunkKey& key);
+  // Replaces any existing entry with the same key. Chunks larger than a shard are not cached.
+  void Insert(const SharedChunkKey& key, std::shared_ptr<const DecodedChunk> chunk);
+
+private:
+  static constexpr size_t SHARD_COUNT = 16;
+
+  struct KeyHash
+  {
+    size_t operator()(const SharedChunkKey& key) const;
+  };
+
+  using Entry = std::pair<SharedChunkKey, std::shared_ptr<const DecodedChunk>>;
+
+  struct Shard
+  {
+    std::mutex mutex;
+    // Most recently used entries first
+    std::list<Entry> lru;
+    std::unordered_map<SharedChunkKey, std::list<Entry>::iterator, KeyHash> entries;
+    size_t size_in_bytes = 0;
+  };
+
+  static size_t GetSize(const DecodedChunk& chunk);
+  Shard& GetShard(const SharedChunkKey& key);
+
+  std::array<Shard, SHARD_COUNT> m_shards;
+  size_t m_shard_capacity;
+};
+}  // namespace DiscIO
@@ -7,10 +7,13 @@
 #include <future>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
+#include <utility>
 
 #include <mbedtls/md5.h>
 #include <mz_compat.h>
@@ -359,6 +362,12 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
 
 constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
 
+// Lets reading run ahead of the hash lanes and integrity checks by a few reads, so that neither
+// has to wait for the other as long as they're about equally fast. Wii reads are a whole group,
+// so this means up to 16 MiB of buffers.
+constexpr size_t READ_BUFFER_COUNT = 8;
+constexpr unsigned int MAX_CHECK_WORKERS = 4;
+
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
     : m_volume(volume), m_redump_verification(redump_verification),
@@ -1078,45 +1087,154 @@ void VolumeVerifier::SetUpHashing()
   {
     m_sha1_context = Common::SHA1::CreateContext();
   }
+
+  m_buffers = std::vector<ReadBuffer>(READ_BUFFER_COUNT);
+
+  // Each hash gets a thread of its own, which consumes the buffers in order
+  if (m_hashes_to_calculate.crc32)
+  {
+    m_crc32_lane.Reset("VolumeVerifier CRC32", [this](ChunkToHash chunk) {
+      const u8* data = m_buffers[chunk.buffer_index].data.data();
+      m_crc32_context =
+          Common::UpdateCRC32(m_crc32_context, data, static_cast<size_t>(chunk.size));
+      ReleaseBuffer(chunk.buffer_index);
+    });
+  }
+
+  if (m_hashes_to_calculate.md5)
+  {
+    m_md5_lane.Reset("VolumeVerifier MD5", [this](ChunkToHash chunk) {
+      mbedtls_md5_update_ret(&m_md5_context, m_buffers[chunk.buffer_index].data.data(),
+                             chunk.size);
+      ReleaseBuffer(chunk.buffer_index);
+    });
+  }
+
+  if (m_hashes_to_calculate.sha1)
+  {
+    m_sha1_lane.Reset("VolumeVerifier SHA1", [this](ChunkToHash chunk) {
+      m_sha1_context->Update(m_buffers[chunk.buffer_index].data.data(), chunk.size);
+      ReleaseBuffer(chunk.buffer_index);
+    });
+  }
+
+  // Checking the integrity of a group means decrypting it and hashing every block, which is more
+  // work than any single hash lane does, so groups are checked on several threads.
+  if (!m_groups.empty() || !m_content_offsets.empty())
+  {
+    const unsigned int worker_count =
+        std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_CHECK_WORKERS);
+    for (unsigned int i = 0; i < worker_count; ++i)
+    {
+      m_check_workers.push_back(std::make_unique<Common::WorkQueueThread<std::function<void()>>>(
+          "VolumeVerifier check", [](std::function<void()> check) { check(); }));
+    }
+  }
 }
 
-void VolumeVerifier::WaitForAsyncOperations() const
+void VolumeVerifier::WaitForAsyncOperations()
 {
-  if (m_crc32_future.valid())
-    m_crc32_future.wait();
-  if (m_md5_future.valid())
-    m_md5_future.wait();
-  if (m_sha1_future.valid())
-    m_sha1_future.wait();
-  if (m_content_future.valid())
-    m_content_future.wait();
-  if (m_group_future.valid())
-    m_group_future.wait();
+  m_crc32_lane.WaitForCompletion();
+  m_md5_lane.WaitForCompletion();
+  m_sha1_lane.WaitForCompletion();
+  for (auto& worker : m_check_workers)
+    worker->WaitForCompletion();
 }
 
-bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
+bool VolumeVerifier::ReadChunk(u64 bytes_to_read)
 {
-  std::vector<u8> data(bytes_to_read);
+  const size_t previous_buffer = m_current_buffer;
+  m_current_buffer = (m_current_buffer + 1) % m_buffers.size();
+
+  ReadBuffer& buffer = m_buffers[m_current_buffer];
+  {
+    std::unique_lock lock(m_buffer_mutex);
+    m_buffer_released.wait(lock, [&buffer] { return buffer.users == 0; });
+  }
+  buffer.data.resize(bytes_to_read);
 
+  // The previous buffer may still be in use, but only for reading
+  const std::vector<u8>& previous_data = m_buffers[previous_buffer].data;
   const u64 bytes_to_copy = std::min(m_excess_bytes, bytes_to_read);
   if (bytes_to_copy > 0)
-    std::memcpy(data.data(), m_data.data() + m_data.size() - m_excess_bytes, bytes_to_copy);
+  {
+    std::memcpy(buffer.data.data(), previous_data.data() + previous_data.size() - m_excess_bytes,
+                bytes_to_copy);
+  }
   bytes_to_read -= bytes_to_copy;
 
   if (bytes_to_read > 0)
   {
-    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read, data.data() + bytes_to_copy,
-                       PARTITION_NONE))
+    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read,
+                       buffer.data.data() + bytes_to_copy, PARTITION_NONE))
     {
       return false;
     }
   }
 
-  WaitForAsyncOperations();
-  m_data = std::move(data);
   return true;
 }
 
+void VolumeVerifier::ReleaseBuffer(size_t buffer_index)
+{
+  {
+    std::lock_guard lock(m_buffer_mutex);
+    m_buffers[buffer_index].users--;
+  }
+  m_buffer_released.notify_one();
+}
+
+void VolumeVerifier::QueueCheck(std::function<void()> check)
+{
+  m_check_workers[m_next_check_worker]->Push(std::move(check));
+  m_next_check_worker = (m_next_check_worker + 1) % m_check_workers.size();
+}
+
+void VolumeVerifier::VerifyGroup(size_t group_index, size_t buffer_index, bool read_failed)
+{
+  // The partition keys and H3 tables that CheckBlockIntegrity uses were already loaded by
+  // CheckPartition, so several groups can be checked at the same time.
+  const GroupToVerify& group = m_groups[group_index];
+  const u8* data = m_buffers[buffer_index].data.data();
+
+  u64 biggest_verified_offset = 0;
+  size_t block_errors = 0;
+  size_t unused_block_errors = 0;
+
+  u64 offset_in_group = 0;
+  for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
+       ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
+  {
+    const u64 block_offset = group.offset + offset_in_group;
+
+    if (!read_failed &&
+        m_volume.CheckBlockIntegrity(block_index, data + offset_in_group, group.partition))
+    {
+      biggest_verified_offset = block_offset + VolumeWii::BLOCK_TOTAL_SIZE;
+    }
+    else
+    {
+      if (m_scrubber.CanBlockBeScrubbed(block_offset))
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
+        unused_block_errors++;
+      }
+      else
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+        block_errors++;
+      }
+    }
+  }
+
+  std::lock_guard lock(m_result_mutex);
+  m_biggest_verified_offset = std::max(m_biggest_verified_offset, biggest_verified_offset);
+  if (block_errors != 0)
+    m_block_errors[group.partition] += block_errors;
+  if (unused_block_errors != 0)
+    m_unused_block_errors[group.partition] += unused_block_errors;
+}
+
 void VolumeVerifier::Process()
 {
   ASSERT(m_started);
@@ -1188,7 +1306,7 @@ void VolumeVerifier::Process()
   }
 
   const bool is_data_needed = m_calculating_any_hash || content_read || group_read;
-  const bool read_failed = is_data_needed && !ReadChunkAndWaitForAsyncOperations(bytes_to_read);
+  const bool read_failed = is_data_needed && !ReadChunk(bytes_to_read);
 
   if (read_failed)
   {
@@ -1200,39 +1318,42 @@ void VolumeVerifier::Process()
 
   m_excess_bytes = excess_bytes;
   const u64 byte_increment = bytes_to_read - excess_bytes;
+  const size_t buffer_index = m_current_buffer;
 
-  if (m_calculating_any_hash)
+  if (is_data_needed)
   {
-    if (m_hashes_to_calculate.crc32)
+    // Count all users up front, so that the buffer can't be released before everyone has it
+    std::lock_guard lock(m_buffer_mutex);
+    ReadBuffer& buffer = m_buffers[buffer_index];
+    if (m_calculating_any_hash)
     {
-      m_crc32_future = std::async(std::launch::async, [this, byte_increment] {
-        m_crc32_context = Common::UpdateCRC32(m_crc32_context, m_data.data(),
-                                              static_cast<size_t>(byte_increment));
-      });
+      buffer.users += m_hashes_to_calculate.crc32 + m_hashes_to_calculate.md5 +
+                      m_hashes_to_calculate.sha1;
     }
+    buffer.users += content_read + group_read;
+  }
 
+  if (m_calculating_any_hash)
+  {
+    const ChunkToHash chunk{buffer_index, byte_increment};
+    if (m_hashes_to_calculate.crc32)
+      m_crc32_lane.Push(chunk);
     if (m_hashes_to_calculate.md5)
-    {
-      m_md5_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_md5_update_ret(&m_md5_context, m_data.data(), byte_increment);
-      });
-    }
-
+      m_md5_lane.Push(chunk);
     if (m_hashes_to_calculate.sha1)
-    {
-      m_sha1_future = std::async(std::launch::async, [this, byte_increment] {
-        m_sha1_context->Update(m_data.data(), byte_increment);
-      });
-    }
+      m_sha1_lane.Push(chunk);
   }
 
   if (content_read)
   {
-    m_content_future = std::async(std::launch::async, [this, read_failed, content] {
-      if (read_failed || !m_volume.CheckContentIntegrity(content, m_data, m_ticket))
+    QueueCheck([this, read_failed, content, buffer_index] {
+      if (read_failed ||
+          !m_volume.CheckContentIntegrity(content, m_buffers[buffer_index].data, m_ticket))
       {
+        std::lock_guard lock(m_result_mutex);
         AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content.id));
       }
+      ReleaseBuffer(buffer_index);
     });
 
     m_content_index++;
@@ -1240,35 +1361,9 @@ void VolumeVerifier::Process()
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
-
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
-        {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
-        }
-      }
+    QueueCheck([this, read_failed, group_index = m_group_index, buffer_index] {
+      VerifyGroup(group_index, buffer_index, read_failed);
+      ReleaseBuffer(buffer_index);
     });
 
     m_group_index++;
@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <functional>
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -14,6 +17,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/Volume.h"
@@ -144,6 +148,20 @@ private:
     size_t block_index_end;
   };
 
+  // Process() reads into a ring of these buffers, and the hash lanes and integrity checks use
+  // the data in place. A buffer is only reused once everything that uses it is done with it.
+  struct ReadBuffer
+  {
+    std::vector<u8> data;
+    u32 users = 0;  // Guarded by m_buffer_mutex
+  };
+
+  struct ChunkToHash
+  {
+    size_t buffer_index;
+    u64 size;
+  };
+
   std::vector<Partition> CheckPartitions();
   bool CheckPartition(const Partition& partition);  // Returns false if partition should be ignored
   std::string GetPartitionName(std::optional<u32> type) const;
@@ -156,8 +174,11 @@ private:
   void CheckMisc();
   void CheckSuperPaperMario();
   void SetUpHashing();
-  void WaitForAsyncOperations() const;
-  bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  void WaitForAsyncOperations();
+  bool ReadChunk(u64 bytes_to_read);
+  void ReleaseBuffer(size_t buffer_index);
+  void VerifyGroup(size_t group_index, size_t buffer_index, bool read_failed);
+  void QueueCheck(std::function<void()> check);
 
   void AddProblem(Severity severity, std::string text);
 
@@ -179,12 +200,13 @@ private:
   std::unique_ptr<Common::SHA1::Context> m_sha1_context;
 
   u64 m_excess_bytes = 0;
-  std::vector<u8> m_data;
-  std::future<void> m_crc32_future;
-  std::future<void> m_md5_future;
-  std::future<void> m_sha1_future;
-  std::future<void> m_content_future;
-  std::future<void> m_group_future;
+  std::vector<ReadBuffer> m_buffers;
+  size_t m_current_buffer = 0;
+  std::mutex m_buffer_mutex;
+  std::condition_variable m_buffer_released;
+
+  // Guards the results of the integrity checks, which run on several threads at once
+  std::mutex m_result_mutex;
 
   DiscScrubber m_scrubber;
   IOS::ES::TicketReader m_ticket;
@@ -203,6 +225,13 @@ private:
   u64 m_progress = 0;
   u64 m_max_progress = 0;
   DataSizeType m_data_size_type;
+
+  // Declared last so that the threads are stopped before anything they use is destroyed
+  Common::WorkQueueThread<ChunkToHash> m_crc32_lane;
+  Common::WorkQueueThread<ChunkToHash> m_md5_lane;
+  Common::WorkQueueThread<ChunkToHash> m_sha1_lane;
+  std::vector<std::unique_ptr<Common::WorkQueueThread<std::function<void()>>>> m_check_workers;
+  size_t m_next_check_worker = 0;
 };
 
 }  // namespace DiscIO
@@ -6,13 +6,17 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <future>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
+#include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <zstd.h>
@@ -33,6 +37,7 @@
 #include "DiscIO/Filesystem.h"
 #include "DiscIO/LaggedFibonacciGenerator.h"
 #include "DiscIO/MultithreadedCompressor.h"
+#include "DiscIO/SharedChunkCache.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/VolumeWii.h"
 #include "DiscIO/WIACompression.h"
@@ -233,6 +238,14 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
   if (HasDataOverlap())
     return false;
 
+  // Header 1 covers everything in header 2 except the group entries
+  const auto context = Common::SHA1::CreateContext();
+  context->Update(m_header_1.header_1_hash.data(), m_header_1.header_1_hash.size());
+  context->Update(reinterpret_cast<const u8*>(m_group_entries.data()),
+                  m_group_entries.size() * sizeof(GroupEntry));
+  const Common::SHA1::Digest file_digest = context->Finish();
+  std::memcpy(&m_file_id, file_digest.data(), sizeof(m_file_id));
+
   return true;
 }
 
@@ -501,7 +514,12 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   data_size += skipped_data;
 
   const u64 start_group_index = (*offset - data_offset) / chunk_size;
-  for (u64 i = start_group_index; i < number_of_groups && (*size) > 0; ++i)
+
+  // Find all the groups first, so that the chunks which need decoding can be decoded in parallel
+  std::vector<GroupRead> reads;
+  u64 read_offset = *offset;
+  u64 read_size = *size;
+  for (u64 i = start_group_index; i < number_of_groups && read_size > 0; ++i)
   {
     const u64 total_group_index = group_index + i;
     if (total_group_index >= m_group_entries.size())
@@ -509,11 +527,11 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
 
     const GroupEntry group = m_group_entries[total_group_index];
     const u64 group_offset_in_data = i * chunk_size;
-    const u64 offset_in_group = *offset - group_offset_in_data - data_offset;
+    const u64 offset_in_group = read_offset - group_offset_in_data - data_offset;
 
     chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
 
-    const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
+    const u64 bytes_to_read = std::min(chunk_size - offset_in_group, read_size);
     u32 group_data_size = Common::swap32(group.data_size);
 
     WIARVZCompressionType compression_type = m_compression_type;
@@ -528,43 +546,182 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
       rvz_packed_size = Common::swap32(group.rvz_packed_size);
     }
 
-    if (group_data_size == 0)
-    {
-      std::memset(*out_ptr, 0, bytes_to_read);
-    }
-    else
+    GroupRead& read = reads.emplace_back();
+    read.total_group_index = total_group_index;
+    read.group_offset_in_data = group_offset_in_data;
+    read.offset_in_group = offset_in_group;
+    read.bytes_to_read = bytes_to_read;
+    read.has_data = group_data_size != 0;
+    if (read.has_data)
     {
       const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+      read.location.key = {m_file_id, group_offset_in_file, group_offset_in_data, chunk_size,
+                           exception_lists};
+      read.location.compressed_size = group_data_size;
+      read.location.compression_type = compression_type;
+      read.location.rvz_packed_size = rvz_packed_size;
+    }
 
-      Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
+    read_offset += bytes_to_read;
+    read_size -= bytes_to_read;
+  }
 
-      if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
+  if (!LoadChunks(&reads))
+    return false;
+
+  for (const GroupRead& read : reads)
+  {
+    if (!read.has_data)
+    {
+      std::memset(*out_ptr, 0, read.bytes_to_read);
+    }
+    else
+    {
+      std::span<const u8> exception_lists;
+      if (read.chunk)
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
-        return false;
+        std::memcpy(*out_ptr, read.chunk->data.data() + read.offset_in_group, read.bytes_to_read);
+        exception_lists = read.chunk->exception_lists;
+      }
+      else
+      {
+        // The chunk isn't cached, and only part of it is needed, so it's only decompressed as far
+        // as this read goes. Subsequent reads continue from where this one stopped.
+        const ChunkLocation& location = read.location;
+        Chunk& chunk = ReadCompressedData(
+            location.key.offset_in_file, location.compressed_size, location.key.decompressed_size,
+            location.compression_type, location.key.exception_lists, location.rvz_packed_size,
+            location.key.data_offset);
+
+        const bool was_decoded = chunk.IsDecoded();
+        if (!chunk.Read(read.offset_in_group, read.bytes_to_read, *out_ptr))
+        {
+          m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+          return false;
+        }
+        exception_lists = chunk.GetExceptionLists();
+
+        if (!was_decoded && chunk.IsDecoded())
+        {
+          auto decoded = std::make_shared<DecodedChunk>();
+          if (chunk.Decode(decoded.get()))
+            SharedChunkCache::GetInstance().Insert(location.key, std::move(decoded));
+        }
       }
 
-      if (m_write_to_exception_list && m_exception_list_last_group_index != total_group_index)
+      if (m_write_to_exception_list && m_exception_list_last_group_index != read.total_group_index)
       {
-        const u64 exception_list_index = offset_in_group / VolumeWii::GROUP_DATA_SIZE;
+        const u64 exception_list_index = read.offset_in_group / VolumeWii::GROUP_DATA_SIZE;
         const u16 additional_offset =
-            static_cast<u16>(group_offset_in_data % VolumeWii::GROUP_DATA_SIZE /
+            static_cast<u16>(read.group_offset_in_data % VolumeWii::GROUP_DATA_SIZE /
                              VolumeWii::BLOCK_DATA_SIZE * VolumeWii::BLOCK_HEADER_SIZE);
-        chunk.GetHashExceptions(&m_exception_list, exception_list_index, additional_offset);
-        m_exception_list_last_group_index = total_group_index;
+        GetHashExceptions(exception_lists, &m_exception_list, exception_list_index,
+                          additional_offset);
+        m_exception_list_last_group_index = read.total_group_index;
       }
     }
 
-    *offset += bytes_to_read;
-    *size -= bytes_to_read;
-    *out_ptr += bytes_to_read;
+    *offset += read.bytes_to_read;
+    *size -= read.bytes_to_read;
+    *out_ptr += read.bytes_to_read;
+  }
+
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::LoadChunks(std::vector<GroupRead>* reads)
+{
+  SharedChunkCache& cache = SharedChunkCache::GetInstance();
+
+  // Chunks that aren't cached are only decoded here if the read needs them up to their end,
+  // since decompression has to go through everything in front of the data anyway. The rest are
+  // left for ReadFromGroups to decompress only as far as needed, using m_cached_chunk.
+  std::vector<GroupRead*> missing;
+  for (GroupRead& read : *reads)
+  {
+    if (!read.has_data)
+      continue;
+
+    if (m_last_chunk && m_last_chunk_key == read.location.key)
+      read.chunk = m_last_chunk;
+    else
+      read.chunk = cache.Get(read.location.key);
+
+    const SharedChunkKey& key = read.location.key;
+    if (!read.chunk && m_cached_chunk_offset != key.offset_in_file &&
+        read.offset_in_group + read.bytes_to_read == key.decompressed_size)
+    {
+      missing.push_back(&read);
+    }
+  }
+
+  // Each additional thread needs a file of its own. Duplicate gives them independent file
+  // positions. A single chunk is decoded on this thread, without starting any other.
+  std::vector<File::IOFile> files;
+  if (missing.size() > 1)
+  {
+    const size_t thread_count =
+        std::min<size_t>(missing.size(), std::max(1u, std::thread::hardware_concurrency()));
+    for (size_t i = 1; i < thread_count; ++i)
+    {
+      File::IOFile file = m_file.Duplicate("rb");
+      if (!file.IsOpen())
+        break;
+      files.push_back(std::move(file));
+    }
+  }
+
+  const size_t stride = files.size() + 1;
+  const auto decode = [this, &missing, stride](File::IOFile* file, size_t first) {
+    for (size_t i = first; i < missing.size(); i += stride)
+      missing[i]->chunk = DecodeChunk(file, missing[i]->location);
+  };
+
+  std::vector<std::future<void>> futures;
+  for (size_t i = 0; i < files.size(); ++i)
+    futures.push_back(std::async(std::launch::async, decode, &files[i], i + 1));
+  decode(&m_file, 0);
+  for (std::future<void>& future : futures)
+    future.wait();
+
+  for (const GroupRead* read : missing)
+  {
+    if (!read->chunk)
+      return false;
+    cache.Insert(read->location.key, read->chunk);
+  }
+
+  for (const GroupRead& read : *reads)
+  {
+    if (read.chunk && read.offset_in_group + read.bytes_to_read > read.chunk->data.size())
+      return false;
+  }
+
+  if (!reads->empty() && reads->back().chunk)
+  {
+    m_last_chunk = reads->back().chunk;
+    m_last_chunk_key = reads->back().location.key;
   }
 
   return true;
 }
 
+template <bool RVZ>
+std::shared_ptr<const DecodedChunk>
+WIARVZFileReader<RVZ>::DecodeChunk(File::IOFile* file, const ChunkLocation& location) const
+{
+  const SharedChunkKey& key = location.key;
+  Chunk chunk = CreateChunk(file, key.offset_in_file, location.compressed_size,
+                            key.decompressed_size, location.compression_type, key.exception_lists,
+                            location.rvz_packed_size, key.data_offset);
+
+  auto decoded = std::make_shared<DecodedChunk>();
+  if (!chunk.Decode(decoded.get()))
+    return nullptr;
+  return decoded;
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -575,6 +732,19 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
   if (offset_in_file == m_cached_chunk_offset)
     return m_cached_chunk;
 
+  m_cached_chunk = CreateChunk(&m_file, offset_in_file, compressed_size, decompressed_size,
+                               compression_type, exception_lists, rvz_packed_size, data_offset);
+  m_cached_chunk_offset = offset_in_file;
+  return m_cached_chunk;
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                                   u64 decompressed_size, WIARVZCompressionType compression_type,
+                                   u32 exception_lists, u32 rvz_packed_size,
+                                   u64 data_offset) const
+{
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
   {
@@ -603,11 +773,8 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
 
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return Chunk(file, offset_in_file, compressed_size, decompressed_size, exception_lists,
+               compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
 }
 
 template <bool RVZ>
@@ -815,14 +982,48 @@ bool WIARVZFileReader<RVZ>::Chunk::HandleExceptions(const u8* data, size_t bytes
 }
 
 template <bool RVZ>
-void WIARVZFileReader<RVZ>::Chunk::GetHashExceptions(
-    std::vector<HashExceptionEntry>* exception_list, u64 exception_list_index,
-    u16 additional_offset) const
+bool WIARVZFileReader<RVZ>::Chunk::Decode(DecodedChunk* out)
+{
+  out->data.resize(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+  if (!Read(0, out->data.size(), out->data.data()))
+    return false;
+
+  const std::span<const u8> exception_lists = GetExceptionLists();
+  out->exception_lists.assign(exception_lists.begin(), exception_lists.end());
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::IsDecoded() const
+{
+  return m_decompressor &&
+         GetOutBytesWrittenExcludingExceptions() ==
+             m_out.data.size() - m_out_bytes_allocated_for_exceptions;
+}
+
+template <bool RVZ>
+std::span<const u8> WIARVZFileReader<RVZ>::Chunk::GetExceptionLists() const
 {
   ASSERT(m_exception_lists == 0);
 
-  const u8* data_start = m_compressed_exception_lists ? m_out.data.data() : m_in.data.data();
-  const u8* data = data_start;
+  if (m_compressed_exception_lists)
+    return std::span(m_out.data).first(m_out_bytes_used_for_exceptions);
+  else
+    return std::span(m_in.data).first(m_in_bytes_used_for_exceptions);
+}
+
+template <bool RVZ>
+size_t WIARVZFileReader<RVZ>::Chunk::GetOutBytesWrittenExcludingExceptions() const
+{
+  return m_exception_lists == 0 ? m_out.bytes_written - m_out_bytes_used_for_exceptions : 0;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::GetHashExceptions(std::span<const u8> exception_lists,
+                                              std::vector<HashExceptionEntry>* exception_list,
+                                              u64 exception_list_index, u16 additional_offset)
+{
+  const u8* data = exception_lists.data();
 
   for (u64 i = exception_list_index; i > 0; --i)
     data += Common::swap16(data) * sizeof(HashExceptionEntry) + sizeof(u16);
@@ -839,14 +1040,7 @@ void WIARVZFileReader<RVZ>::Chunk::GetHashExceptions(
     offset = Common::swap16(Common::swap16(offset) + additional_offset);
   }
 
-  ASSERT(data <= data_start + (m_compressed_exception_lists ? m_out_bytes_used_for_exceptions :
-                                                              m_in_bytes_used_for_exceptions));
-}
-
-template <bool RVZ>
-size_t WIARVZFileReader<RVZ>::Chunk::GetOutBytesWrittenExcludingExceptions() const
-{
-  return m_exception_lists == 0 ? m_out.bytes_written - m_out_bytes_used_for_exceptions : 0;
+  ASSERT(data <= exception_lists.data() + exception_lists.size());
 }
 
 template <bool RVZ>
@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -17,6 +18,7 @@
 #include "Common/Swap.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/MultithreadedCompressor.h"
+#include "DiscIO/SharedChunkCache.h"
 #include "DiscIO/WIACompression.h"
 #include "DiscIO/WiiEncryptionCache.h"
 
@@ -194,9 +196,13 @@ private:
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
 
+    // Decompresses all of the data, for sharing it through SharedChunkCache
+    bool Decode(DecodedChunk* out);
+    // Whether all of the data has been decompressed by calls to Read
+    bool IsDecoded() const;
+
     // This can only be called once at least one byte of data has been read
-    void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
-                           u64 exception_list_index, u16 additional_offset) const;
+    std::span<const u8> GetExceptionLists() const;
 
     template <typename T>
     bool ReadAll(std::vector<T>* vector)
@@ -234,12 +240,45 @@ private:
 
   const PartitionEntry* GetPartition(u64 partition_data_offset, u32* partition_first_sector) const;
 
+  // Everything needed for decoding the data of one group
+  struct ChunkLocation
+  {
+    SharedChunkKey key;
+    u64 compressed_size;
+    WIARVZCompressionType compression_type;
+    u32 rvz_packed_size;
+  };
+
+  // The part of one group that a call to ReadFromGroups reads
+  struct GroupRead
+  {
+    u64 total_group_index;
+    u64 group_offset_in_data;
+    u64 offset_in_group;
+    u64 bytes_to_read;
+    bool has_data;
+    ChunkLocation location;
+    // Null if the data is to be read through m_cached_chunk instead
+    std::shared_ptr<const DecodedChunk> chunk;
+  };
+
   bool ReadFromGroups(u64* offset, u64* size, u8** out_ptr, u64 chunk_size, u32 sector_size,
                       u64 data_offset, u64 data_size, u32 group_index, u32 number_of_groups,
                       u32 exception_lists);
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk CreateChunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                    u64 decompressed_size, WIARVZCompressionType compression_type,
+                    u32 exception_lists, u32 rvz_packed_size, u64 data_offset) const;
+
+  bool LoadChunks(std::vector<GroupRead>* reads);
+  std::shared_ptr<const DecodedChunk> DecodeChunk(File::IOFile* file,
+                                                  const ChunkLocation& location) const;
+
+  static void GetHashExceptions(std::span<const u8> exception_lists,
+                                std::vector<HashExceptionEntry>* exception_list,
+                                u64 exception_list_index, u16 additional_offset);
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -371,6 +410,12 @@ private:
   u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
   WiiEncryptionCache m_encryption_cache;
 
+  // Identifies the contents of the file for SharedChunkCache
+  u64 m_file_id = 0;
+  // The chunk used most recently, which small sequential reads keep hitting
+  std::shared_ptr<const DecodedChunk> m_last_chunk;
+  SharedChunkKey m_last_chunk_key;
+
   std::vector<HashExceptionEntry> m_exception_list;
   bool m_write_to_exception_list = false;
   u64 m_exception_list_last_group_index;
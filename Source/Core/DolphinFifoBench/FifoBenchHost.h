@@ -0,0 +1,11 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+namespace FifoBench
+{
+// Set when emulation stops, or the core asks the host to stop it
+void RequestStop();
+bool IsStopRequested();
+}  // namespace FifoBench
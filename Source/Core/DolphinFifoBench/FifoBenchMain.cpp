@@ -0,0 +1,189 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <picojson.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#include "Common/FileUtil.h"
+#include "Common/ScopeGuard.h"
+#include "Common/StringUtil.h"
+#include "Common/WindowSystemInfo.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/System.h"
+#include "DolphinFifoBench/FifoBenchHost.h"
+#include "DolphinFifoBench/FifoBenchmark.h"
+#include "UICommon/UICommon.h"
+#include "VideoBackends/Null/VideoBackend.h"
+#include "VideoBackends/Software/VideoBackend.h"
+
+#ifdef _WIN32
+#define main app_main
+#endif
+
+int main(int argc, char* argv[])
+{
+  Core::DeclareAsHostThread();
+
+  optparse::OptionParser parser;
+
+  parser.usage("usage: dolphin-fifo-bench [options]... FILE");
+  parser.description("Plays a fifolog without a window and reports how long each frame took, "
+                     "in total and in some stages of the video pipeline.");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path. Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-v", "--video-backend")
+      .type("string")
+      .action("store")
+      .help("Video backend to play the fifolog with [%choices]")
+      .choices({"null", "software"})
+      .set_default("null");
+
+  parser.add_option("-w", "--warmup")
+      .type("int")
+      .action("store")
+      .help("Number of times to play the fifolog before measuring [default: %default]")
+      .set_default(1);
+
+  parser.add_option("-l", "--loops")
+      .type("int")
+      .action("store")
+      .help("Number of times to play the fifolog while measuring [default: %default]")
+      .set_default(1);
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Write the results as JSON to FILE instead of standard output.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(argc, argv);
+  const std::vector<std::string> args = parser.args();
+  if (args.size() != 1)
+  {
+    parser.print_help();
+    return EXIT_FAILURE;
+  }
+  const std::string& fifolog_path = args.front();
+
+  const int warmup_loops = static_cast<int>(options.get("warmup"));
+  const int loops = static_cast<int>(options.get("loops"));
+  if (warmup_loops < 0 || loops < 1)
+  {
+    fmt::print(std::cerr, "Error: At least one loop has to be measured\n");
+    return EXIT_FAILURE;
+  }
+
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+  Common::ScopeGuard ui_common_guard([] { UICommon::Shutdown(); });
+
+  const std::string video_backend = options["video_backend"] == "software" ?
+                                        SW::VideoSoftware::NAME :
+                                        Null::VideoBackend::NAME;
+
+  // Keep the results comparable between runs and machines: no speed limit, no audio, and the GPU
+  // on the CPU thread, so that the stages of a frame are measured while the frame is played.
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, video_backend);
+  Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, BACKEND_NULLSOUND);
+  Config::SetCurrent(Config::MAIN_CPU_THREAD, false);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES, false);
+
+  std::unique_ptr<BootParameters> boot =
+      BootParameters::GenerateFromFile(fifolog_path, BootSessionData());
+  if (!boot || !std::holds_alternative<BootParameters::DFF>(boot->parameters))
+  {
+    fmt::print(std::cerr, "Error: {} is not a fifolog\n", fifolog_path);
+    return EXIT_FAILURE;
+  }
+
+  Core::System& system = Core::System::GetInstance();
+  FifoBench::FifoBenchmark benchmark(system.GetFifoPlayer(),
+                                     {static_cast<u32>(warmup_loops), static_cast<u32>(loops)});
+
+  Core::AddOnStateChangedCallback([](Core::State state) {
+    if (state == Core::State::Uninitialized)
+      FifoBench::RequestStop();
+  });
+
+  WindowSystemInfo wsi;
+  wsi.type = WindowSystemType::Headless;
+  if (!BootManager::BootCore(system, std::move(boot), wsi))
+  {
+    fmt::print(std::cerr, "Error: Could not play {}\n", fifolog_path);
+    return EXIT_FAILURE;
+  }
+
+  while (!benchmark.IsDone() && !FifoBench::IsStopRequested())
+  {
+    Core::HostDispatchJobs(system);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  Core::Stop(system);
+  Core::Shutdown(system);
+
+  if (!benchmark.IsDone())
+  {
+    fmt::print(std::cerr, "Error: Playback stopped before all loops were measured\n");
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cerr, "{}", benchmark.GetSummary());
+
+  const std::string json = benchmark.ToJson(fifolog_path, video_backend).serialize(true);
+  if (options.is_set("output"))
+  {
+    if (!File::WriteStringToFile(options["output"], json))
+    {
+      fmt::print(std::cerr, "Error: Could not write {}\n", options["output"]);
+      return EXIT_FAILURE;
+    }
+  }
+  else
+  {
+    fmt::print(std::cout, "{}", json);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+#ifdef _WIN32
+int wmain(int, wchar_t*[], wchar_t*[])
+{
+  std::vector<std::string> args = Common::CommandLineToUtf8Argv(GetCommandLineW());
+  const int argc = static_cast<int>(args.size());
+  std::vector<char*> argv(args.size());
+  for (size_t i = 0; i < args.size(); ++i)
+    argv[i] = args[i].data();
+
+  return main(argc, argv.data());
+}
+
+#undef main
+#endif
@@ -0,0 +1,224 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinFifoBench/FifoBenchmark.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+
+namespace FifoBench
+{
+namespace
+{
+struct Statistics
+{
+  double total = 0;
+  double mean = 0;
+  double median = 0;
+  double p95 = 0;
+  double min = 0;
+  double max = 0;
+};
+
+Statistics GetStatistics(std::vector<double> values)
+{
+  Statistics result;
+  if (values.empty())
+    return result;
+
+  std::sort(values.begin(), values.end());
+  const auto percentile = [&values](double p) {
+    const size_t index = static_cast<size_t>(std::ceil(p * values.size())) - 1;
+    return values[std::clamp<size_t>(index, 0, values.size() - 1)];
+  };
+
+  result.total = std::accumulate(values.begin(), values.end(), 0.0);
+  result.mean = result.total / values.size();
+  result.median = percentile(0.5);
+  result.p95 = percentile(0.95);
+  result.min = values.front();
+  result.max = values.back();
+  return result;
+}
+
+picojson::object StatisticsToJson(const Statistics& statistics)
+{
+  picojson::object result;
+  result.emplace("total_us", statistics.total);
+  result.emplace("mean_us", statistics.mean);
+  result.emplace("median_us", statistics.median);
+  result.emplace("p95_us", statistics.p95);
+  result.emplace("min_us", statistics.min);
+  result.emplace("max_us", statistics.max);
+  return result;
+}
+
+double ToMicroseconds(u64 nanoseconds)
+{
+  return nanoseconds / 1000.0;
+}
+
+constexpr std::array<StageTimers::Stage, StageTimers::NUM_STAGES> STAGES = {
+    StageTimers::Stage::OpcodeDecoder,
+    StageTimers::Stage::RunVertices,
+    StageTimers::Stage::TextureCache,
+    StageTimers::Stage::Flush,
+};
+}  // namespace
+
+FifoBenchmark::FifoBenchmark(FifoPlayer& player, const Options& options)
+    : m_player(player), m_options(options)
+{
+  // Unlike in the FIFO player window, every object is drawn
+  m_player.SetObjectRangeEnd(std::numeric_limits<u32>::max());
+  m_player.SetFrameWrittenCallback([this] { OnFrameWritten(); });
+  StageTimers::SetEnabled(true);
+}
+
+FifoBenchmark::~FifoBenchmark()
+{
+  StageTimers::SetEnabled(false);
+  m_player.SetFrameWrittenCallback(nullptr);
+}
+
+void FifoBenchmark::OnFrameWritten()
+{
+  // Called on the CPU thread right before a frame is written, which is when the previous one ends
+  const auto now = std::chrono::steady_clock::now();
+  const StageTimers::Totals totals = StageTimers::TakeTotals();
+
+  std::lock_guard lk(m_mutex);
+  if (m_done.IsSet())
+    return;
+
+  if (!m_frame_start)
+    m_frame_count = m_player.GetFile()->GetFrameCount();
+
+  if (m_frame_start)
+  {
+    const u64 wall_nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - *m_frame_start).count();
+    m_samples.push_back({m_current_loop, m_current_frame, wall_nanoseconds, totals});
+
+    if (m_current_frame + 1 == m_frame_count)
+    {
+      ++m_current_loop;
+      if (m_current_loop == m_options.warmup_loops + m_options.loops)
+      {
+        m_done.Set();
+        return;
+      }
+    }
+  }
+
+  m_frame_start = now;
+  m_current_frame = m_player.GetCurrentFrameNum();
+}
+
+std::vector<FifoBenchmark::FrameSample> FifoBenchmark::GetSamples() const
+{
+  std::lock_guard lk(m_mutex);
+
+  std::vector<FrameSample> result;
+  std::copy_if(m_samples.begin(), m_samples.end(), std::back_inserter(result),
+               [this](const FrameSample& sample) { return sample.loop >= m_options.warmup_loops; });
+  return result;
+}
+
+picojson::value FifoBenchmark::ToJson(const std::string& fifolog_path,
+                                      const std::string& video_backend) const
+{
+  const std::vector<FrameSample> samples = GetSamples();
+  u32 frame_count;
+  {
+    std::lock_guard lk(m_mutex);
+    frame_count = m_frame_count;
+  }
+
+  picojson::array frames;
+  std::vector<double> wall_times;
+  std::array<std::vector<double>, StageTimers::NUM_STAGES> stage_times;
+  for (const FrameSample& sample : samples)
+  {
+    picojson::object frame;
+    frame.emplace("loop", static_cast<double>(sample.loop - m_options.warmup_loops));
+    frame.emplace("frame", static_cast<double>(sample.frame));
+    frame.emplace("wall_us", ToMicroseconds(sample.wall_nanoseconds));
+    wall_times.push_back(ToMicroseconds(sample.wall_nanoseconds));
+
+    picojson::object stages;
+    for (const StageTimers::Stage stage : STAGES)
+    {
+      const StageTimers::StageTotal& total = sample.stages[static_cast<size_t>(stage)];
+      picojson::object stage_json;
+      stage_json.emplace("us", ToMicroseconds(total.nanoseconds));
+      stage_json.emplace("calls", static_cast<double>(total.calls));
+      stages.emplace(StageTimers::GetStageName(stage), std::move(stage_json));
+      stage_times[static_cast<size_t>(stage)].push_back(ToMicroseconds(total.nanoseconds));
+    }
+    frame.emplace("stages", std::move(stages));
+
+    frames.emplace_back(std::move(frame));
+  }
+
+  picojson::object summary;
+  summary.emplace("wall", StatisticsToJson(GetStatistics(std::move(wall_times))));
+  for (const StageTimers::Stage stage : STAGES)
+  {
+    std::vector<double>& times = stage_times[static_cast<size_t>(stage)];
+    summary.emplace(StageTimers::GetStageName(stage),
+                    StatisticsToJson(GetStatistics(std::move(times))));
+  }
+
+  picojson::object result;
+  result.emplace("fifolog", fifolog_path);
+  result.emplace("video_backend", video_backend);
+  result.emplace("frame_count", static_cast<double>(frame_count));
+  result.emplace("warmup_loops", static_cast<double>(m_options.warmup_loops));
+  result.emplace("loops", static_cast<double>(m_options.loops));
+  result.emplace("summary", std::move(summary));
+  result.emplace("frames", std::move(frames));
+  return picojson::value(std::move(result));
+}
+
+std::string FifoBenchmark::GetSummary() const
+{
+  const std::vector<FrameSample> samples = GetSamples();
+
+  std::string result = fmt::format("{} frames measured\n", samples.size());
+  result += fmt::format("{:<16}{:>12}{:>12}{:>12}{:>12}\n", "", "mean (ms)", "median (ms)",
+                        "p95 (ms)", "max (ms)");
+
+  const auto add_line = [&result](std::string_view name, std::vector<double> values) {
+    const Statistics statistics = GetStatistics(std::move(values));
+    result += fmt::format("{:<16}{:>12.3f}{:>12.3f}{:>12.3f}{:>12.3f}\n", name,
+                          statistics.mean / 1000, statistics.median / 1000,
+                          statistics.p95 / 1000, statistics.max / 1000);
+  };
+
+  std::vector<double> wall_times;
+  for (const FrameSample& sample : samples)
+    wall_times.push_back(ToMicroseconds(sample.wall_nanoseconds));
+  add_line("wall", std::move(wall_times));
+
+  for (const StageTimers::Stage stage : STAGES)
+  {
+    std::vector<double> times;
+    for (const FrameSample& sample : samples)
+      times.push_back(ToMicroseconds(sample.stages[static_cast<size_t>(stage)].nanoseconds));
+    add_line(StageTimers::GetStageName(stage), std::move(times));
+  }
+
+  return result;
+}
+}  // namespace FifoBench
@@ -0,0 +1,72 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <picojson.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+#include "VideoCommon/StageTimers.h"
+
+class FifoPlayer;
+
+namespace FifoBench
+{
+struct Options
+{
+  // Loops that are played before the measured ones, to fill caches and compile shaders
+  u32 warmup_loops = 1;
+  u32 loops = 1;
+};
+
+// Measures every frame of a fifolog as FifoPlayer plays it. A frame is measured from the moment
+// FifoPlayer starts writing it until it starts writing the next one, so it also includes the time
+// the GPU thread needs to catch up in single core mode.
+class FifoBenchmark
+{
+public:
+  struct FrameSample
+  {
+    u32 loop;
+    u32 frame;
+    u64 wall_nanoseconds;
+    StageTimers::Totals stages;
+  };
+
+  FifoBenchmark(FifoPlayer& player, const Options& options);
+  FifoBenchmark(const FifoBenchmark&) = delete;
+  FifoBenchmark& operator=(const FifoBenchmark&) = delete;
+  ~FifoBenchmark();
+
+  // Set when all loops have been measured
+  bool IsDone() const { return m_done.IsSet(); }
+
+  // Returns the samples of the measured loops, leaving out the warmup loops
+  std::vector<FrameSample> GetSamples() const;
+
+  picojson::value ToJson(const std::string& fifolog_path, const std::string& video_backend) const;
+  std::string GetSummary() const;
+
+private:
+  void OnFrameWritten();
+
+  FifoPlayer& m_player;
+  Options m_options;
+
+  mutable std::mutex m_mutex;
+  // Only known once the file has been loaded, and the player closes it when emulation stops
+  u32 m_frame_count = 0;
+  std::vector<FrameSample> m_samples;
+  std::optional<std::chrono::steady_clock::time_point> m_frame_start;
+  u32 m_current_loop = 0;
+  u32 m_current_frame = 0;
+  Common::Flag m_done;
+};
+}  // namespace FifoBench
@@ -154,7 +154,8 @@ void FIFOAnalyzer::UpdateTree()
 
     recording_item->addChild(frame_item);
 
-    const AnalyzedFrameInfo& frame_info = m_fifo_player.GetAnalyzedFrameInfo(frame);
+    const auto analyzed_frame = m_fifo_player.GetAnalyzedFrameInfo(frame);
+    const AnalyzedFrameInfo& frame_info = *analyzed_frame;
     ASSERT(frame_info.parts.size() != 0);
 
     Common::EnumMap<u32, FramePartType::EFBCopy> part_counts;
@@ -347,8 +348,10 @@ void FIFOAnalyzer::UpdateDetails()
   const u32 start_part_nr = items[0]->data(0, PART_START_ROLE).toUInt();
   const u32 end_part_nr = items[0]->data(0, PART_END_ROLE).toUInt();
 
-  const AnalyzedFrameInfo& frame_info = m_fifo_player.GetAnalyzedFrameInfo(frame_nr);
-  const auto& fifo_frame = m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const auto analyzed_frame = m_fifo_player.GetAnalyzedFrameInfo(frame_nr);
+  const AnalyzedFrameInfo& frame_info = *analyzed_frame;
+  const auto fifo_frame_ptr = m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const FifoFrameInfo& fifo_frame = *fifo_frame_ptr;
 
   const u32 object_start = frame_info.parts[start_part_nr].m_start;
   const u32 object_end = frame_info.parts[end_part_nr].m_end;
@@ -430,8 +433,10 @@ void FIFOAnalyzer::BeginSearch()
   const u32 start_part_nr = items[0]->data(0, PART_START_ROLE).toUInt();
   const u32 end_part_nr = items[0]->data(0, PART_END_ROLE).toUInt();
 
-  const AnalyzedFrameInfo& frame_info = m_fifo_player.GetAnalyzedFrameInfo(frame_nr);
-  const FifoFrameInfo& fifo_frame = m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const auto analyzed_frame = m_fifo_player.GetAnalyzedFrameInfo(frame_nr);
+  const AnalyzedFrameInfo& frame_info = *analyzed_frame;
+  const auto fifo_frame_ptr = m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const FifoFrameInfo& fifo_frame = *fifo_frame_ptr;
 
   const u32 object_start = frame_info.parts[start_part_nr].m_start;
   const u32 object_end = frame_info.parts[end_part_nr].m_end;
@@ -762,8 +767,10 @@ void FIFOAnalyzer::UpdateDescription()
   const u32 end_part_nr = items[0]->data(0, PART_END_ROLE).toUInt();
   const u32 entry_nr = m_detail_list->currentRow();
 
-  const AnalyzedFrameInfo& frame_info = m_fifo_player.GetAnalyzedFrameInfo(frame_nr);
-  const FifoFrameInfo& fifo_frame = m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const auto analyzed_frame = m_fifo_player.GetAnalyzedFrameInfo(frame_nr);
+  const AnalyzedFrameInfo& frame_info = *analyzed_frame;
+  const auto fifo_frame_ptr = m_fifo_player.GetFile()->GetFrame(frame_nr);
+  const FifoFrameInfo& fifo_frame = *fifo_frame_ptr;
 
   const u32 object_start = frame_info.parts[start_part_nr].m_start;
   const u32 object_end = frame_info.parts[end_part_nr].m_end;
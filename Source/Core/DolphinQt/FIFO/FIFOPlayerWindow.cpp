@@ -18,6 +18,8 @@
 #include <QVBoxLayout>
 
 #include <algorithm>
+#include <limits>
+#include <optional>
 
 #include "Core/Core.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
@@ -72,6 +74,7 @@ FIFOPlayerWindow::~FIFOPlayerWindow()
 {
   m_fifo_player.SetFileLoadedCallback({});
   m_fifo_player.SetFrameWrittenCallback({});
+  StopObjectCountThread();
 }
 
 void FIFOPlayerWindow::CreateWidgets()
@@ -139,9 +142,11 @@ void FIFOPlayerWindow::CreateWidgets()
   m_frame_record_count->setMinimum(1);
   m_frame_record_count->setMaximum(3600);
   m_frame_record_count->setValue(3);
+  m_compress_frames = new ToolTipCheckBox(tr("Compress Frames"));
 
   recording_layout->addWidget(m_frame_record_count_label);
   recording_layout->addWidget(m_frame_record_count);
+  recording_layout->addWidget(m_compress_frames);
   recording_group->setLayout(recording_layout);
 
   m_button_box = new QDialogButtonBox(QDialogButtonBox::Close);
@@ -177,6 +182,7 @@ void FIFOPlayerWindow::LoadSettings()
 {
   m_early_memory_updates->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES));
   m_loop->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_LOOP_REPLAY));
+  m_compress_frames->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_COMPRESS_FRAMES));
 }
 
 void FIFOPlayerWindow::ConnectWidgets()
@@ -188,6 +194,7 @@ void FIFOPlayerWindow::ConnectWidgets()
   connect(m_button_box, &QDialogButtonBox::rejected, this, &FIFOPlayerWindow::hide);
   connect(m_early_memory_updates, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
   connect(m_loop, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
+  connect(m_compress_frames, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
 
   connect(m_frame_range_from, &QSpinBox::valueChanged, this, &FIFOPlayerWindow::OnLimitsChanged);
   connect(m_frame_range_to, &QSpinBox::valueChanged, this, &FIFOPlayerWindow::OnLimitsChanged);
@@ -206,9 +213,15 @@ void FIFOPlayerWindow::AddDescriptions()
       QT_TR_NOOP("If unchecked, then playback of the fifolog stops after the final frame.<br><br>"
                  "This is generally only useful when a frame-dumping option is enabled.<br><br>"
                  "<dolphin_emphasis>If unsure, leave this checked.</dolphin_emphasis>");
+  static const char TR_COMPRESS_FRAMES_DESCRIPTION[] = QT_TR_NOOP(
+      "If enabled, then each frame of saved fifologs is compressed, which makes big fifologs "
+      "much smaller. Fifologs with compressed frames can't be played by older versions of "
+      "Dolphin.<br><br>"
+      "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
 
   m_early_memory_updates->SetDescription(tr(TR_MEMORY_UPDATES_DESCRIPTION));
   m_loop->SetDescription(tr(TR_LOOP_DESCRIPTION));
+  m_compress_frames->SetDescription(tr(TR_COMPRESS_FRAMES_DESCRIPTION));
 }
 
 void FIFOPlayerWindow::LoadRecording()
@@ -305,8 +318,9 @@ void FIFOPlayerWindow::UpdateInfo()
 
     for (u32 i = 0; i < file->GetFrameCount(); ++i)
     {
-      fifo_bytes += file->GetFrame(i).fifoData.size();
-      for (const auto& mem_update : file->GetFrame(i).memoryUpdates)
+      const auto frame = file->GetFrame(i);
+      fifo_bytes += frame->fifoData.size();
+      for (const auto& mem_update : frame->memoryUpdates)
         mem_bytes += mem_update.data.size();
     }
 
@@ -329,16 +343,29 @@ void FIFOPlayerWindow::OnFIFOLoaded()
 {
   FifoDataFile* file = m_fifo_player.GetFile();
 
-  auto object_count = m_fifo_player.GetMaxObjectCount();
   auto frame_count = file->GetFrameCount();
 
+  // Finding the most objects in a frame means analyzing every frame, which takes a while for big
+  // fifologs. Until that's done, the object range isn't limited.
   m_frame_range_to->setMaximum(frame_count - 1);
-  m_object_range_to->setMaximum(object_count - 1);
+  m_object_range_to->setMaximum(std::numeric_limits<int>::max());
 
   m_frame_range_from->setValue(0);
   m_object_range_from->setValue(0);
   m_frame_range_to->setValue(frame_count - 1);
-  m_object_range_to->setValue(object_count - 1);
+  m_object_range_to->setValue(m_object_range_to->maximum());
+
+  StopObjectCountThread();
+  const u32 generation = m_fifo_player.GetFileGeneration();
+  m_object_count_thread = std::thread([this, generation] {
+    const std::optional<u32> object_count = m_fifo_player.GetMaxObjectCount(m_object_count_cancel);
+    if (object_count)
+    {
+      QueueOnObject(this, [this, generation, count = *object_count] {
+        OnMaxObjectCountFound(generation, count);
+      });
+    }
+  });
 
   UpdateInfo();
   UpdateLimits();
@@ -347,11 +374,35 @@ void FIFOPlayerWindow::OnFIFOLoaded()
   m_analyzer->Update();
 }
 
+void FIFOPlayerWindow::OnMaxObjectCountFound(u32 generation, u32 object_count)
+{
+  // The file may have been closed or replaced while the result was queued.
+  if (generation != m_fifo_player.GetFileGeneration())
+    return;
+
+  // Keep a range the user has picked meanwhile, unless it's out of bounds now.
+  const bool whole_range = m_object_range_to->value() == m_object_range_to->maximum();
+  m_object_range_to->setMaximum(static_cast<int>(object_count) - 1);
+  if (whole_range)
+    m_object_range_to->setValue(m_object_range_to->maximum());
+}
+
+void FIFOPlayerWindow::StopObjectCountThread()
+{
+  if (!m_object_count_thread.joinable())
+    return;
+
+  m_object_count_cancel.Set();
+  m_object_count_thread.join();
+  m_object_count_cancel.Clear();
+}
+
 void FIFOPlayerWindow::OnConfigChanged()
 {
   Config::SetBase(Config::MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES,
                   m_early_memory_updates->isChecked());
   Config::SetBase(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, m_loop->isChecked());
+  Config::SetBase(Config::MAIN_FIFOPLAYER_COMPRESS_FRAMES, m_compress_frames->isChecked());
 }
 
 void FIFOPlayerWindow::OnLimitsChanged()
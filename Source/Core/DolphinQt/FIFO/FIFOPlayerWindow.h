@@ -5,6 +5,10 @@
 
 #include <QWidget>
 
+#include <thread>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
 #include "Core/Core.h"
 
 class QDialogButtonBox;
@@ -44,8 +48,11 @@ private:
   void OnLimitsChanged();
   void OnRecordingDone();
   void OnFIFOLoaded();
+  void OnMaxObjectCountFound(u32 generation, u32 object_count);
   void OnConfigChanged();
 
+  void StopObjectCountThread();
+
   void UpdateControls();
   void UpdateInfo();
   void UpdateLimits();
@@ -72,6 +79,7 @@ private:
   QLabel* m_object_range_to_label;
   ToolTipCheckBox* m_early_memory_updates;
   ToolTipCheckBox* m_loop;
+  ToolTipCheckBox* m_compress_frames;
   QDialogButtonBox* m_button_box;
 
   QWidget* m_main_widget;
@@ -79,4 +87,7 @@ private:
 
   FIFOAnalyzer* m_analyzer;
   Core::State m_emu_state = Core::State::Uninitialized;
+
+  std::thread m_object_count_thread;
+  Common::Flag m_object_count_cancel;
 };
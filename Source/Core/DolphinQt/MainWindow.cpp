@@ -2214,6 +2214,7 @@ bool MainWindow::NetPlayJoin()
   const std::string traversal_host = Config::Get(Config::NETPLAY_TRAVERSAL_SERVER);
   const u16 traversal_port = Config::Get(Config::NETPLAY_TRAVERSAL_PORT);
   const std::string nickname = Config::Get(Config::NETPLAY_NICKNAME);
+  const bool spectator = !server && Config::Get(Config::NETPLAY_JOIN_AS_SPECTATOR);
   const std::string network_mode = Config::Get(Config::NETPLAY_NETWORK_MODE);
   const bool host_input_authority = network_mode == "hostinputauthority" || network_mode == "golf";
 
@@ -2228,7 +2229,8 @@ bool MainWindow::NetPlayJoin()
   Settings::Instance().ResetNetPlayClient(new NetPlay::NetPlayClient(
       host_ip, host_port, m_netplay_dialog, nickname,
       NetPlay::NetTraversalConfig{is_hosting_netplay ? false : is_traversal, traversal_host,
-                                  traversal_port}));
+                                  traversal_port},
+      spectator));
 
   if (!Settings::Instance().GetNetPlayClient()->IsConnected())
   {
@@ -2577,7 +2579,10 @@ void MainWindow::OnExportRecording()
   QString dtm_file = DolphinFileDialog::getSaveFileName(
       this, tr("Save Recording File As"), QString(), tr("Dolphin TAS Movies (*.dtm)"));
   if (!dtm_file.isEmpty())
-    system.GetMovie().SaveRecording(dtm_file.toStdString());
+  {
+    system.GetMovie().SaveRecording(dtm_file.toStdString(),
+                                    Config::Get(Config::MAIN_MOVIE_CHUNKED_FORMAT));
+  }
 }
 
 void MainWindow::OnActivateChat()
@@ -199,12 +199,28 @@ void NetPlayDialog::CreateMainLayout()
          "switched at any time.\nSuitable for turn-based games with timing-sensitive controls, "
          "such as golf."));
   m_golf_mode_action->setCheckable(true);
+  m_rollback_action = m_network_menu->addAction(tr("Rollback"));
+  m_rollback_action->setToolTip(
+      tr("Each player sends their own inputs to the game with a small input delay, configured by "
+         "the host. Inputs of other players that haven't arrived yet are predicted, and the game "
+         "is rewound and replayed when a prediction was wrong.\nSuitable for competitive games on "
+         "high latency connections. Not available for games using Wii Remotes."));
+  m_rollback_action->setCheckable(true);
 
   m_network_mode_group = new QActionGroup(this);
   m_network_mode_group->setExclusive(true);
   m_network_mode_group->addAction(m_fixed_delay_action);
   m_network_mode_group->addAction(m_host_input_authority_action);
   m_network_mode_group->addAction(m_golf_mode_action);
+  m_network_mode_group->addAction(m_rollback_action);
+
+  m_network_menu->addSeparator();
+  m_auto_buffer_action = m_network_menu->addAction(tr("Automatic Buffer Size"));
+  m_auto_buffer_action->setToolTip(
+      tr("In Fair Input Delay, each player's buffer is adjusted during the game to the measured "
+         "latency and jitter of their connection to the other players. The buffer size set by "
+         "the host is used as the starting point."));
+  m_auto_buffer_action->setCheckable(true);
   m_fixed_delay_action->setChecked(true);
 
   m_game_digest_menu = m_menu_bar->addMenu(tr("Checksum"));
@@ -232,6 +248,14 @@ void NetPlayDialog::CreateMainLayout()
   m_golf_mode_overlay_action->setCheckable(true);
   m_hide_remote_gbas_action = m_other_menu->addAction(tr("Hide Remote GBAs"));
   m_hide_remote_gbas_action->setCheckable(true);
+  m_ram_hash_action = m_other_menu->addAction(tr("Check Emulated Memory Every Frame"));
+  m_ram_hash_action->setToolTip(
+      tr("Compares a hash of the emulated memory of all players on every frame, so that desyncs "
+         "are reported within a few frames of when they happen, along with the memory region "
+         "where they happen.\nHashing costs about a millisecond of CPU time per frame. Not "
+         "available in rollback mode, or in dual core mode without Sync GPU unless EFB and XFB "
+         "copies are stored to texture only."));
+  m_ram_hash_action->setCheckable(true);
 
   m_game_button->setDefault(false);
   m_game_button->setAutoDefault(false);
@@ -376,6 +400,7 @@ void NetPlayDialog::ConnectWidgets()
           [hia_function] { hia_function(true); });
   connect(m_golf_mode_action, &QAction::toggled, this, [hia_function] { hia_function(true); });
   connect(m_fixed_delay_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
+  connect(m_rollback_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
 
   connect(m_start_button, &QPushButton::clicked, this, &NetPlayDialog::OnStart);
   connect(m_quit_button, &QPushButton::clicked, this, &NetPlayDialog::reject);
@@ -424,7 +449,10 @@ void NetPlayDialog::ConnectWidgets()
   connect(m_golf_mode_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_golf_mode_overlay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_fixed_delay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_rollback_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_hide_remote_gbas_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_ram_hash_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_auto_buffer_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
 }
 
 void NetPlayDialog::SendMessage(const std::string& msg)
@@ -536,6 +564,7 @@ void NetPlayDialog::show(std::string nickname, bool use_traversal)
 #else
   m_hide_remote_gbas_action->setVisible(false);
 #endif
+  m_ram_hash_action->setVisible(is_hosting);
   m_start_button->setHidden(!is_hosting);
   m_kick_button->setHidden(!is_hosting);
   m_assign_ports_button->setHidden(!is_hosting);
@@ -862,6 +891,16 @@ void NetPlayDialog::SetOptionsEnabled(bool enabled)
     m_host_input_authority_action->setEnabled(enabled);
     m_golf_mode_action->setEnabled(enabled);
     m_fixed_delay_action->setEnabled(enabled);
+    m_rollback_action->setEnabled(enabled);
+    m_ram_hash_action->setEnabled(enabled);
+    m_auto_buffer_action->setEnabled(enabled);
+
+    // During a game in the automatic buffer mode, every client picks its own buffer size.
+    if (m_auto_buffer_action->isChecked() && !m_host_input_authority)
+    {
+      m_buffer_size_box->setEnabled(enabled);
+      m_buffer_label->setEnabled(enabled);
+    }
   }
 
   m_record_input_action->setEnabled(enabled);
@@ -971,6 +1010,17 @@ void NetPlayDialog::OnDesync(u32 frame, const std::string& player)
                  "red", OSD::Duration::VERY_LONG);
 }
 
+void NetPlayDialog::OnRAMDesync(u32 first_frame, u32 last_frame, const std::string& player,
+                                const std::string& location)
+{
+  DisplayMessage(
+      tr("Desync detected: the emulated memory of %1 started to differ between frames %2 and %3 "
+         "in %4")
+          .arg(QString::fromStdString(player), QString::number(first_frame),
+               QString::number(last_frame), QString::fromStdString(location)),
+      "red", OSD::Duration::VERY_LONG);
+}
+
 void NetPlayDialog::OnConnectionLost()
 {
   DisplayMessage(tr("Lost connection to NetPlay server..."), "red");
@@ -1134,6 +1184,8 @@ void NetPlayDialog::LoadSettings()
   const bool strict_settings_sync = Config::Get(Config::NETPLAY_STRICT_SETTINGS_SYNC);
   const bool golf_mode_overlay = Config::Get(Config::NETPLAY_GOLF_MODE_OVERLAY);
   const bool hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
+  const bool ram_hash = Config::Get(Config::NETPLAY_RAM_HASH_DESYNC_DETECTION);
+  const bool auto_buffer = Config::Get(Config::NETPLAY_AUTO_PAD_BUFFER);
 
   m_buffer_size_box->setValue(buffer_size);
 
@@ -1150,6 +1202,8 @@ void NetPlayDialog::LoadSettings()
   m_strict_settings_sync_action->setChecked(strict_settings_sync);
   m_golf_mode_overlay_action->setChecked(golf_mode_overlay);
   m_hide_remote_gbas_action->setChecked(hide_remote_gbas);
+  m_ram_hash_action->setChecked(ram_hash);
+  m_auto_buffer_action->setChecked(auto_buffer);
 
   const std::string network_mode = Config::Get(Config::NETPLAY_NETWORK_MODE);
 
@@ -1165,6 +1219,10 @@ void NetPlayDialog::LoadSettings()
   {
     m_golf_mode_action->setChecked(true);
   }
+  else if (network_mode == "rollback")
+  {
+    m_rollback_action->setChecked(true);
+  }
   else
   {
     WARN_LOG_FMT(NETPLAY, "Unknown network mode '{}', using 'fixeddelay'", network_mode);
@@ -1193,6 +1251,8 @@ void NetPlayDialog::SaveSettings()
   Config::SetBase(Config::NETPLAY_STRICT_SETTINGS_SYNC, m_strict_settings_sync_action->isChecked());
   Config::SetBase(Config::NETPLAY_GOLF_MODE_OVERLAY, m_golf_mode_overlay_action->isChecked());
   Config::SetBase(Config::NETPLAY_HIDE_REMOTE_GBAS, m_hide_remote_gbas_action->isChecked());
+  Config::SetBase(Config::NETPLAY_RAM_HASH_DESYNC_DETECTION, m_ram_hash_action->isChecked());
+  Config::SetBase(Config::NETPLAY_AUTO_PAD_BUFFER, m_auto_buffer_action->isChecked());
 
   std::string network_mode;
   if (m_fixed_delay_action->isChecked())
@@ -1207,6 +1267,10 @@ void NetPlayDialog::SaveSettings()
   {
     network_mode = "golf";
   }
+  else if (m_rollback_action->isChecked())
+  {
+    network_mode = "rollback";
+  }
 
   Config::SetBase(Config::NETPLAY_NETWORK_MODE, network_mode);
 }
@@ -65,6 +65,8 @@ public:
   void OnPadBufferChanged(u32 buffer) override;
   void OnHostInputAuthorityChanged(bool enabled) override;
   void OnDesync(u32 frame, const std::string& player) override;
+  void OnRAMDesync(u32 first_frame, u32 last_frame, const std::string& player,
+                   const std::string& location) override;
   void OnConnectionLost() override;
   void OnConnectionError(const std::string& message) override;
   void OnTraversalError(Common::TraversalClient::FailureReason error) override;
@@ -157,7 +159,10 @@ private:
   QAction* m_golf_mode_action;
   QAction* m_golf_mode_overlay_action;
   QAction* m_fixed_delay_action;
+  QAction* m_rollback_action;
   QAction* m_hide_remote_gbas_action;
+  QAction* m_ram_hash_action;
+  QAction* m_auto_buffer_action;
   QPushButton* m_quit_button;
   QSplitter* m_splitter;
   QActionGroup* m_network_mode_group;
@@ -43,6 +43,7 @@ NetPlaySetupDialog::NetPlaySetupDialog(const GameListModel& game_list_model, QWi
   std::string nickname = Config::Get(Config::NETPLAY_NICKNAME);
   std::string traversal_choice = Config::Get(Config::NETPLAY_TRAVERSAL_CHOICE);
   int connect_port = Config::Get(Config::NETPLAY_CONNECT_PORT);
+  bool join_as_spectator = Config::Get(Config::NETPLAY_JOIN_AS_SPECTATOR);
   int host_port = Config::Get(Config::NETPLAY_HOST_PORT);
   int host_listen_port = Config::Get(Config::NETPLAY_LISTEN_PORT);
   bool enable_chunked_upload_limit = Config::Get(Config::NETPLAY_ENABLE_CHUNKED_UPLOAD_LIMIT);
@@ -56,6 +57,7 @@ NetPlaySetupDialog::NetPlaySetupDialog(const GameListModel& game_list_model, QWi
   m_nickname_edit->setText(QString::fromStdString(nickname));
   m_connection_type->setCurrentIndex(traversal_choice == "direct" ? 0 : 1);
   m_connect_port_box->setValue(connect_port);
+  m_connect_spectator_check->setChecked(join_as_spectator);
   m_host_port_box->setValue(host_port);
 
   m_host_force_port_box->setValue(host_listen_port);
@@ -102,9 +104,14 @@ void NetPlaySetupDialog::CreateMainLayout()
   m_ip_edit = new QLineEdit;
   m_connect_port_label = new QLabel(tr("Port:"));
   m_connect_port_box = new QSpinBox;
+  m_connect_spectator_check = new QCheckBox(tr("Join as Spectator"));
   m_connect_button = new NonDefaultQPushButton(tr("Connect"));
 
   m_connect_port_box->setMaximum(65535);
+  m_connect_spectator_check->setToolTip(
+      tr("Watch the game without playing. Spectators can join a game that is already running if "
+         "it is a GameCube game using Fair Input Delay, without GBAs or loaded save data. The "
+         "host's game then pauses briefly to send you a savestate."));
 
   connection_layout->addWidget(m_ip_label, 0, 0);
   connection_layout->addWidget(m_ip_edit, 0, 1);
@@ -127,6 +134,7 @@ void NetPlaySetupDialog::CreateMainLayout()
 
   connection_layout->addWidget(alert_label, 1, 0, 1, -1);
   connection_layout->addItem(new QSpacerItem(1, 1), 2, 0, -1, -1);
+  connection_layout->addWidget(m_connect_spectator_check, 3, 0, 1, 2);
   connection_layout->addWidget(m_connect_button, 3, 3, Qt::AlignRight);
 
   connection_widget->setLayout(connection_layout);
@@ -217,6 +225,7 @@ void NetPlaySetupDialog::ConnectWidgets()
   // Connect widget
   connect(m_ip_edit, &QLineEdit::textChanged, this, &NetPlaySetupDialog::SaveSettings);
   connect(m_connect_port_box, &QSpinBox::valueChanged, this, &NetPlaySetupDialog::SaveSettings);
+  connect(m_connect_spectator_check, &QCheckBox::toggled, this, &NetPlaySetupDialog::SaveSettings);
   // Host widget
   connect(m_host_port_box, &QSpinBox::valueChanged, this, &NetPlaySetupDialog::SaveSettings);
   connect(m_host_games, &QListWidget::currentRowChanged, [this](int index) {
@@ -268,6 +277,8 @@ void NetPlaySetupDialog::SaveSettings()
                            m_ip_edit->text().toStdString());
   Config::SetBaseOrCurrent(Config::NETPLAY_CONNECT_PORT,
                            static_cast<u16>(m_connect_port_box->value()));
+  Config::SetBaseOrCurrent(Config::NETPLAY_JOIN_AS_SPECTATOR,
+                           m_connect_spectator_check->isChecked());
   Config::SetBaseOrCurrent(Config::NETPLAY_HOST_PORT, static_cast<u16>(m_host_port_box->value()));
 #ifdef USE_UPNP
   Config::SetBaseOrCurrent(Config::NETPLAY_USE_UPNP, m_host_upnp->isChecked());
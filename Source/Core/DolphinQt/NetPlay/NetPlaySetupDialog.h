@@ -59,6 +59,7 @@ private:
   QLineEdit* m_ip_edit;
   QLabel* m_connect_port_label;
   QSpinBox* m_connect_port_box;
+  QCheckBox* m_connect_spectator_check;
   QPushButton* m_connect_button;
 
   // Host Widget
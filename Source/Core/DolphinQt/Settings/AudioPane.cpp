@@ -93,6 +93,19 @@ void AudioPane::CreateWidgets()
            "crackling. Certain backends only."));
   }
 
+  m_low_latency = new QCheckBox(tr("Low Latency Mode"));
+  m_low_latency->setToolTip(
+      tr("Has the backend request new samples in smaller batches, which reduces latency at the "
+         "cost of more CPU usage and a higher risk of crackling. Certain backends only."));
+  m_low_latency_period_label = new QLabel(tr("Period:"));
+  m_low_latency_period_spin = new QSpinBox();
+  m_low_latency_period_spin->setMinimum(32);
+  m_low_latency_period_spin->setMaximum(512);
+  m_low_latency_period_spin->setSuffix(tr(" samples"));
+  m_low_latency_period_spin->setToolTip(
+      tr("The number of samples requested at a time in low latency mode. The backend may use a "
+         "higher value if the audio device doesn't support it."));
+
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
 
@@ -124,6 +137,8 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_backend_label, m_backend_combo);
   if (m_latency_control_supported)
     backend_layout->addRow(m_latency_label, m_latency_spin);
+  backend_layout->addRow(m_low_latency);
+  backend_layout->addRow(m_low_latency_period_label, m_low_latency_period_spin);
 
 #ifdef _WIN32
   m_wasapi_device_label = new QLabel(tr("Device:"));
@@ -180,6 +195,8 @@ void AudioPane::ConnectWidgets()
   {
     connect(m_latency_spin, &QSpinBox::valueChanged, this, &AudioPane::SaveSettings);
   }
+  connect(m_low_latency, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
+  connect(m_low_latency_period_spin, &QSpinBox::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
@@ -241,6 +258,9 @@ void AudioPane::LoadSettings()
   // Latency
   if (m_latency_control_supported)
     m_latency_spin->setValue(Config::Get(Config::MAIN_AUDIO_LATENCY));
+  m_low_latency->setChecked(Config::Get(Config::MAIN_AUDIO_LOW_LATENCY));
+  m_low_latency_period_spin->setValue(Config::Get(Config::MAIN_AUDIO_LOW_LATENCY_PERIOD));
+  UpdateLowLatencyWidgets();
 
   // Stretch
   m_stretching_enable->setChecked(Config::Get(Config::MAIN_AUDIO_STRETCH));
@@ -309,6 +329,10 @@ void AudioPane::SaveSettings()
   // Latency
   if (m_latency_control_supported)
     Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LATENCY, m_latency_spin->value());
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LOW_LATENCY, m_low_latency->isChecked());
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LOW_LATENCY_PERIOD,
+                           m_low_latency_period_spin->value());
+  UpdateLowLatencyWidgets();
 
   // Stretch
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH, m_stretching_enable->isChecked());
@@ -354,6 +378,7 @@ void AudioPane::OnBackendChanged()
     m_latency_label->setEnabled(AudioCommon::SupportsLatencyControl(backend));
     m_latency_spin->setEnabled(AudioCommon::SupportsLatencyControl(backend));
   }
+  UpdateLowLatencyWidgets();
 
 #ifdef _WIN32
   bool is_wasapi = backend == BACKEND_WASAPI;
@@ -393,6 +418,7 @@ void AudioPane::OnEmulationStateChanged(bool running)
     m_latency_label->setEnabled(!running);
     m_latency_spin->setEnabled(!running);
   }
+  UpdateLowLatencyWidgets();
 
 #ifdef _WIN32
   m_wasapi_device_combo->setEnabled(!running);
@@ -450,3 +476,14 @@ void AudioPane::EnableDolbyQualityWidgets(bool enabled) const
   m_dolby_quality_highest_label->setEnabled(enabled);
   m_dolby_quality_latency_label->setEnabled(enabled);
 }
+
+void AudioPane::UpdateLowLatencyWidgets() const
+{
+  // The period is picked when the backend starts, so it can't be changed while running
+  const bool enabled =
+      AudioCommon::SupportsLowLatencyMode(Config::Get(Config::MAIN_AUDIO_BACKEND)) &&
+      Core::GetState() == Core::State::Uninitialized;
+  m_low_latency->setEnabled(enabled);
+  m_low_latency_period_label->setEnabled(enabled && m_low_latency->isChecked());
+  m_low_latency_period_spin->setEnabled(enabled && m_low_latency->isChecked());
+}
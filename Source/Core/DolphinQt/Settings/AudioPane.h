@@ -43,6 +43,7 @@ private:
   QString GetDPL2QualityLabel(AudioCommon::DPL2Quality value) const;
   QString GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality value) const;
   void EnableDolbyQualityWidgets(bool enabled) const;
+  void UpdateLowLatencyWidgets() const;
 
   QHBoxLayout* m_main_layout;
 
@@ -66,6 +67,9 @@ private:
   QLabel* m_dolby_quality_latency_label;
   QLabel* m_latency_label;
   QSpinBox* m_latency_spin;
+  QCheckBox* m_low_latency;
+  QLabel* m_low_latency_period_label;
+  QSpinBox* m_low_latency_period_spin;
 #ifdef _WIN32
   QLabel* m_wasapi_device_label;
   QComboBox* m_wasapi_device_combo;
@@ -19,6 +19,7 @@ class VideoSoftware : public VideoBackendBase
 
   void InitBackendInfo(const WindowSystemInfo& wsi) override;
 
+public:
   static constexpr const char* NAME = "Software Renderer";
 };
 }  // namespace SW
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/AsyncShaderCompiler.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "Common/Assert.h"
@@ -22,6 +23,10 @@ AsyncShaderCompiler::~AsyncShaderCompiler()
   // Pending work can be left at shutdown.
   // The work item classes are expected to clean up after themselves.
   ASSERT(!HasWorkerThreads());
+
+  CompletedItem* completed = m_completed_work.exchange(nullptr);
+  while (completed)
+    delete std::exchange(completed, completed->next);
 }
 
 void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
@@ -30,41 +35,137 @@ void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
   if (!HasWorkerThreads())
   {
     item->Compile();
-    m_completed_work.push_back(std::move(item));
+    PushCompletedItem(std::move(item));
+    return;
   }
-  else
+
+  const size_t bucket = std::min<size_t>(priority / PRIORITY_BUCKET_SIZE, NUM_PRIORITY_BUCKETS - 1);
+  m_queued_total.fetch_add(1, std::memory_order_relaxed);
+  PushQueuedItem(QueuedItem{std::move(item), Clock::now()}, bucket);
+}
+
+void AsyncShaderCompiler::PushQueuedItem(QueuedItem queued_item, size_t bucket)
+{
+  WorkerQueue& queue = *m_worker_queues[m_next_worker_queue];
+  m_next_worker_queue = (m_next_worker_queue + 1) % m_worker_queues.size();
+
+  // Count the item before a worker can take it, so that the count never drops below zero.
+  m_pending_count.fetch_add(1);
+  {
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.buckets[bucket].push_back(std::move(queued_item));
+  }
+
+  // Taking the lock makes sure a worker which just found nothing to do is either still awake or
+  // already waiting, so the notification can't get lost.
+  std::lock_guard<std::mutex> guard(m_wake_lock);
+  m_worker_thread_wake.notify_one();
+}
+
+bool AsyncShaderCompiler::TakeWorkItem(size_t index, QueuedItem* queued_item)
+{
+  const size_t num_queues = m_worker_queues.size();
+  for (size_t bucket = 0; bucket < NUM_PRIORITY_BUCKETS; bucket++)
+  {
+    // Start with the worker's own queue, then steal from the others.
+    for (size_t i = 0; i < num_queues; i++)
+    {
+      WorkerQueue& queue = *m_worker_queues[(index + i) % num_queues];
+      std::lock_guard<std::mutex> guard(queue.lock);
+      std::deque<QueuedItem>& items = queue.buckets[bucket];
+      if (items.empty())
+        continue;
+
+      // The owner takes the oldest item, thieves the newest one, so that they rarely collide on
+      // the same end of a long queue.
+      if (i == 0)
+      {
+        *queued_item = std::move(items.front());
+        items.pop_front();
+      }
+      else
+      {
+        *queued_item = std::move(items.back());
+        items.pop_back();
+      }
+
+      // Count the worker as busy first, so that HasPendingWork() never sees neither.
+      m_busy_workers.fetch_add(1);
+      m_pending_count.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void AsyncShaderCompiler::PushCompletedItem(WorkItemPtr item)
+{
+  auto* completed = new CompletedItem{std::move(item), m_completed_work.load()};
+  while (!m_completed_work.compare_exchange_weak(completed->next, completed,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed))
+  {
+  }
+}
+
+void AsyncShaderCompiler::RecordCompletion(Clock::time_point queue_time)
+{
+  const u64 latency_us = static_cast<u64>(
+      std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - queue_time).count());
+  m_completed_total.fetch_add(1, std::memory_order_relaxed);
+  m_total_latency_us.fetch_add(latency_us, std::memory_order_relaxed);
+
+  u64 max_latency_us = m_max_latency_us.load(std::memory_order_relaxed);
+  while (latency_us > max_latency_us &&
+         !m_max_latency_us.compare_exchange_weak(max_latency_us, latency_us,
+                                                 std::memory_order_relaxed))
   {
-    std::lock_guard<std::mutex> guard(m_pending_work_lock);
-    m_pending_work.emplace(priority, std::move(item));
-    m_worker_thread_wake.notify_one();
   }
 }
 
 void AsyncShaderCompiler::RetrieveWorkItems()
 {
-  std::deque<WorkItemPtr> completed_work;
+  CompletedItem* completed = m_completed_work.exchange(nullptr, std::memory_order_acquire);
+
+  // Reverse the list to retrieve the items in the order they were completed.
+  CompletedItem* ordered = nullptr;
+  while (completed)
   {
-    std::lock_guard<std::mutex> guard(m_completed_work_lock);
-    m_completed_work.swap(completed_work);
+    CompletedItem* next = completed->next;
+    completed->next = ordered;
+    ordered = completed;
+    completed = next;
   }
 
-  while (!completed_work.empty())
+  while (ordered)
   {
-    completed_work.front()->Retrieve();
-    completed_work.pop_front();
+    std::unique_ptr<CompletedItem> current(std::exchange(ordered, ordered->next));
+    current->item->Retrieve();
   }
 }
 
 bool AsyncShaderCompiler::HasPendingWork()
 {
-  std::lock_guard<std::mutex> guard(m_pending_work_lock);
-  return !m_pending_work.empty() || m_busy_workers.load() != 0;
+  return m_pending_count.load() != 0 || m_busy_workers.load() != 0;
 }
 
 bool AsyncShaderCompiler::HasCompletedWork()
 {
-  std::lock_guard<std::mutex> guard(m_completed_work_lock);
-  return !m_completed_work.empty();
+  return m_completed_work.load(std::memory_order_relaxed) != nullptr;
+}
+
+AsyncShaderCompiler::Counters AsyncShaderCompiler::GetCounters() const
+{
+  const u64 completed_total = m_completed_total.load(std::memory_order_relaxed);
+  const u64 total_latency_us = m_total_latency_us.load(std::memory_order_relaxed);
+  return Counters{
+      m_pending_count.load(std::memory_order_relaxed),
+      m_busy_workers.load(std::memory_order_relaxed),
+      m_queued_total.load(std::memory_order_relaxed),
+      completed_total,
+      completed_total != 0 ? total_latency_us / completed_total : 0,
+      m_max_latency_us.load(std::memory_order_relaxed),
+  };
 }
 
 bool AsyncShaderCompiler::WaitUntilCompletion(
@@ -85,13 +186,7 @@ bool AsyncShaderCompiler::WaitUntilCompletion(
   }
 
   // Grab the number of pending items. We use this to work out how many are left.
-  size_t total_items;
-  {
-    // Safe to hold both locks here, since nowhere else does.
-    std::lock_guard<std::mutex> pending_guard(m_pending_work_lock);
-    std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
-    total_items = m_completed_work.size() + m_pending_work.size() + m_busy_workers.load() + 1;
-  }
+  const size_t total_items = m_pending_count.load() + m_busy_workers.load() + 1;
 
   // Update progress while the compiles complete.
   for (;;)
@@ -99,14 +194,10 @@ bool AsyncShaderCompiler::WaitUntilCompletion(
     if (Core::GetState() == Core::State::Stopping)
       return false;
 
-    size_t remaining_items;
-    {
-      std::lock_guard<std::mutex> pending_guard(m_pending_work_lock);
-      if (m_pending_work.empty() && !m_busy_workers.load())
-        break;
-      remaining_items = m_pending_work.size();
-    }
+    if (!HasPendingWork())
+      break;
 
+    const size_t remaining_items = std::min(m_pending_count.load(), total_items);
     progress_callback(total_items - remaining_items, total_items);
     std::this_thread::sleep_for(CHECK_INTERVAL);
   }
@@ -118,6 +209,19 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
   if (num_worker_threads == 0)
     return true;
 
+  // The queues have to exist before any worker starts looking at them. Work left over by previous
+  // worker threads is spread over the new queues right away.
+  m_worker_queues.clear();
+  for (u32 i = 0; i < num_worker_threads; i++)
+    m_worker_queues.push_back(std::make_unique<WorkerQueue>());
+  for (size_t i = 0; i < m_orphaned_work.size(); i++)
+  {
+    auto& [bucket, queued_item] = m_orphaned_work[i];
+    m_worker_queues[i % num_worker_threads]->buckets[bucket].push_back(std::move(queued_item));
+  }
+  m_orphaned_work.clear();
+  m_next_worker_queue = 0;
+
   for (u32 i = 0; i < num_worker_threads; i++)
   {
     void* thread_param = nullptr;
@@ -129,7 +233,7 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
 
     m_worker_thread_start_result.store(false);
 
-    std::thread thr(&AsyncShaderCompiler::WorkerThreadEntryPoint, this, thread_param);
+    std::thread thr(&AsyncShaderCompiler::WorkerThreadEntryPoint, this, thread_param, size_t(i));
     m_init_event.Wait();
 
     if (!m_worker_thread_start_result.load())
@@ -142,7 +246,14 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
     m_worker_threads.push_back(std::move(thr));
   }
 
-  return HasWorkerThreads();
+  if (!HasWorkerThreads())
+  {
+    OrphanQueuedWork();
+    return false;
+  }
+
+  // Queues of workers which failed to start still get emptied by the others.
+  return true;
 }
 
 bool AsyncShaderCompiler::ResizeWorkerThreads(u32 num_worker_threads)
@@ -166,7 +277,7 @@ void AsyncShaderCompiler::StopWorkerThreads()
 
   // Signal worker threads to stop, and wake all of them.
   {
-    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    std::lock_guard<std::mutex> guard(m_wake_lock);
     m_exit_flag.Set();
     m_worker_thread_wake.notify_all();
   }
@@ -176,6 +287,23 @@ void AsyncShaderCompiler::StopWorkerThreads()
     thr.join();
   m_worker_threads.clear();
   m_exit_flag.Clear();
+
+  OrphanQueuedWork();
+}
+
+void AsyncShaderCompiler::OrphanQueuedWork()
+{
+  // Keep the remaining work around for when worker threads get started again. It stays counted
+  // as pending in the meantime.
+  for (const auto& queue : m_worker_queues)
+  {
+    for (size_t bucket = 0; bucket < NUM_PRIORITY_BUCKETS; bucket++)
+    {
+      for (QueuedItem& queued_item : queue->buckets[bucket])
+        m_orphaned_work.emplace_back(bucket, std::move(queued_item));
+    }
+  }
+  m_worker_queues.clear();
 }
 
 bool AsyncShaderCompiler::WorkerThreadInitMainThread(void** param)
@@ -192,7 +320,7 @@ void AsyncShaderCompiler::WorkerThreadExit(void* param)
 {
 }
 
-void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
+void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param, size_t index)
 {
   Common::SetCurrentThreadName("AsyncShaderCompiler Worker");
 
@@ -208,35 +336,31 @@ void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
   m_worker_thread_start_result.store(true);
   m_init_event.Set();
 
-  WorkerThreadRun();
+  WorkerThreadRun(index);
 
   WorkerThreadExit(param);
 }
 
-void AsyncShaderCompiler::WorkerThreadRun()
+void AsyncShaderCompiler::WorkerThreadRun(size_t index)
 {
-  std::unique_lock<std::mutex> pending_lock(m_pending_work_lock);
   while (!m_exit_flag.IsSet())
   {
-    m_worker_thread_wake.wait(pending_lock);
-
-    while (!m_pending_work.empty() && !m_exit_flag.IsSet())
+    QueuedItem queued_item;
+    if (!TakeWorkItem(index, &queued_item))
     {
-      m_busy_workers++;
-      auto iter = m_pending_work.begin();
-      WorkItemPtr item(std::move(iter->second));
-      m_pending_work.erase(iter);
-      pending_lock.unlock();
-
-      if (item->Compile())
-      {
-        std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
-        m_completed_work.push_back(std::move(item));
-      }
+      std::unique_lock<std::mutex> wake_lock(m_wake_lock);
+      m_worker_thread_wake.wait(
+          wake_lock, [this] { return m_exit_flag.IsSet() || m_pending_count.load() != 0; });
+      continue;
+    }
 
-      pending_lock.lock();
-      m_busy_workers--;
+    if (queued_item.item->Compile())
+    {
+      RecordCompletion(queued_item.queue_time);
+      PushCompletedItem(std::move(queued_item.item));
     }
+
+    m_busy_workers.fetch_sub(1);
   }
 }
 
@@ -3,11 +3,12 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -20,6 +21,12 @@
 
 namespace VideoCommon
 {
+// Compiles work items on a pool of worker threads.
+//
+// Every worker has its own queue, split into buckets by priority, and workers which run out of
+// work steal from the others, so queueing hundreds of items at once doesn't make them fight over a
+// single lock. Compiled items are handed back through a lock-free list and retrieved on the thread
+// which queued them.
 class AsyncShaderCompiler
 {
 public:
@@ -42,12 +49,27 @@ public:
     return std::make_unique<T>(std::forward<Params>(params)...);
   }
 
+  struct Counters
+  {
+    // Items waiting for a worker
+    size_t pending;
+    size_t busy_workers;
+    u64 queued_total;
+    u64 completed_total;
+    // Time from queueing an item until it finished compiling
+    u64 average_latency_us;
+    u64 max_latency_us;
+  };
+
   // Queues a new work item to the compiler threads. The lower the priority, the sooner
-  // this work item will be compiled, relative to the other work items.
+  // this work item will be compiled, relative to the other work items. Priorities are grouped
+  // into buckets of PRIORITY_BUCKET_SIZE, and items of the same bucket are started roughly in the
+  // order they were queued.
   void QueueWorkItem(WorkItemPtr item, u32 priority);
   void RetrieveWorkItems();
   bool HasPendingWork();
   bool HasCompletedWork();
+  Counters GetCounters() const;
 
   // Calls progress_callback periodically, with completed_items, and total_items.
   // Returns false if interrupted.
@@ -65,8 +87,36 @@ protected:
   virtual void WorkerThreadExit(void* param);
 
 private:
-  void WorkerThreadEntryPoint(void* param);
-  void WorkerThreadRun();
+  static constexpr u32 PRIORITY_BUCKET_SIZE = 100;
+  static constexpr size_t NUM_PRIORITY_BUCKETS = 4;
+
+  using Clock = std::chrono::steady_clock;
+
+  struct QueuedItem
+  {
+    WorkItemPtr item;
+    Clock::time_point queue_time;
+  };
+
+  struct WorkerQueue
+  {
+    std::mutex lock;
+    std::array<std::deque<QueuedItem>, NUM_PRIORITY_BUCKETS> buckets;
+  };
+
+  struct CompletedItem
+  {
+    WorkItemPtr item;
+    CompletedItem* next;
+  };
+
+  void WorkerThreadEntryPoint(void* param, size_t index);
+  void WorkerThreadRun(size_t index);
+  bool TakeWorkItem(size_t index, QueuedItem* queued_item);
+  void PushQueuedItem(QueuedItem queued_item, size_t bucket);
+  void OrphanQueuedWork();
+  void PushCompletedItem(WorkItemPtr item);
+  void RecordCompletion(Clock::time_point queue_time);
 
   Common::Flag m_exit_flag;
   Common::Event m_init_event;
@@ -74,15 +124,25 @@ private:
   std::vector<std::thread> m_worker_threads;
   std::atomic_bool m_worker_thread_start_result{false};
 
-  // A multimap is used to store the work items. We can't use a priority_queue here, because
-  // there's no way to obtain a non-const reference, which we need for the unique_ptr.
-  std::multimap<u32, WorkItemPtr> m_pending_work;
-  std::mutex m_pending_work_lock;
+  // One queue for every worker thread. Only changed while no worker threads are running.
+  std::vector<std::unique_ptr<WorkerQueue>> m_worker_queues;
+  size_t m_next_worker_queue = 0;
+  // Items which were still queued when the worker threads were stopped, with their bucket.
+  std::vector<std::pair<size_t, QueuedItem>> m_orphaned_work;
+
+  // Only used for sleeping while there is no work.
+  std::mutex m_wake_lock;
   std::condition_variable m_worker_thread_wake;
+  std::atomic_size_t m_pending_count{0};
   std::atomic_size_t m_busy_workers{0};
 
-  std::deque<WorkItemPtr> m_completed_work;
-  std::mutex m_completed_work_lock;
+  // Singly linked list of compiled items, newest first.
+  std::atomic<CompletedItem*> m_completed_work{nullptr};
+
+  std::atomic<u64> m_queued_total{0};
+  std::atomic<u64> m_completed_total{0};
+  std::atomic<u64> m_total_latency_us{0};
+  std::atomic<u64> m_max_latency_us{0};
 };
 
 }  // namespace VideoCommon
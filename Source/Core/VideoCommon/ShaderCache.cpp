@@ -102,6 +102,12 @@ void ShaderCache::Reload()
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
+
+  [[maybe_unused]] const AsyncShaderCompiler::Counters counters =
+      m_async_shader_compiler->GetCounters();
+  SETSTAT(g_stats.num_shader_compiles_pending, counters.pending + counters.busy_workers);
+  SETSTAT(g_stats.shader_compile_latency_avg_us, counters.average_latency_us);
+  SETSTAT(g_stats.shader_compile_latency_max_us, counters.max_latency_us);
 }
 
 void ShaderCache::Shutdown()
@@ -124,7 +130,7 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
-    pipeline = g_gfx->CreatePipeline(*pipeline_config);
+    pipeline = CreateGXPipeline(uid, *pipeline_config);
   if (g_ActiveConfig.bShaderCache && !exists_in_cache)
     AppendGXPipelineUID(uid);
   return InsertGXPipeline(uid, std::move(pipeline));
@@ -156,7 +162,7 @@ const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineU
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
-    pipeline = g_gfx->CreatePipeline(*pipeline_config);
+    pipeline = CreateGXPipeline(uid, *pipeline_config);
   return InsertGXUberPipeline(uid, std::move(pipeline));
 }
 
@@ -262,8 +268,17 @@ void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type,
   };
 
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
+  const bool read_only = g_ActiveConfig.bShaderCacheReadOnly;
+  if (g_ActiveConfig.bShaderCacheLazyLoad)
+  {
+    // The shaders are created from the cache when they are first compiled.
+    const u32 count = cache.disk_cache.Open(filename, read_only);
+    INFO_LOG_FMT(VIDEO, "Opened {} with {} cached shaders", filename, count);
+    return;
+  }
+
   CacheReader reader(cache);
-  u32 count = cache.disk_cache.OpenAndRead(filename, reader);
+  u32 count = cache.disk_cache.OpenAndRead(filename, reader, read_only);
   INFO_LOG_FMT(VIDEO, "Loaded {} cached shaders from {}", count, filename);
 }
 
@@ -276,7 +291,7 @@ void ShaderCache::ClearShaderCache(T& cache)
 }
 
 template <typename KeyType, typename DiskKeyType, typename T>
-void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyType, u8>& disk_cache,
+void ShaderCache::LoadPipelineCache(T& cache, Common::IndexedDiskCache<DiskKeyType, u8>& disk_cache,
                                     APIType api_type, const char* type, bool include_gameid)
 {
   class CacheReader : public Common::LinearDiskCacheReader<DiskKeyType, u8>
@@ -317,15 +332,25 @@ void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyTyp
   };
 
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
+  const bool read_only = g_ActiveConfig.bShaderCacheReadOnly;
+  if (g_ActiveConfig.bShaderCacheLazyLoad)
+  {
+    // The cache data is passed to the backend when the pipelines are compiled.
+    const u32 count = disk_cache.Open(filename, read_only);
+    INFO_LOG_FMT(VIDEO, "Opened {} with {} cached pipelines", filename, count);
+    return;
+  }
+
   CacheReader reader(this, cache);
-  const u32 count = disk_cache.OpenAndRead(filename, reader);
+  const u32 count = disk_cache.OpenAndRead(filename, reader, read_only);
   INFO_LOG_FMT(VIDEO, "Loaded {} cached pipelines from {}", count, filename);
 
   // If any of the pipelines in the cache failed to create, it's likely because of a change of
   // driver version, or system configuration. In this case, when the UID cache picks up the pipeline
   // later on, we'll write a duplicate entry to the pipeline cache. There's also no point in keeping
-  // the old cache data around, so discard and recreate the disk cache.
-  if (reader.AnyFailed())
+  // the old cache data around, so discard and recreate the disk cache. A read-only cache may be
+  // in use by other instances, which might still be able to use it.
+  if (reader.AnyFailed() && !read_only)
   {
     WARN_LOG_FMT(VIDEO, "Failed to load one or more pipelines from cache '{}'. Discarding.",
                  filename);
@@ -430,8 +455,21 @@ void ShaderCache::CompileMissingPipelines()
   }
 }
 
+template <typename Uid>
+static std::unique_ptr<AbstractShader>
+CreateShaderFromDiskCache(ShaderStage stage, const Common::IndexedDiskCache<Uid, u8>& disk_cache,
+                          const Uid& uid)
+{
+  u32 binary_size;
+  const u8* binary = disk_cache.Lookup(uid, &binary_size);
+  return binary ? g_gfx->CreateShaderFromBinary(stage, binary, binary_size) : nullptr;
+}
+
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
 {
+  if (auto shader = CreateShaderFromDiskCache(ShaderStage::Vertex, m_vs_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
   return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
@@ -440,6 +478,9 @@ std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexSha
 std::unique_ptr<AbstractShader>
 ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) const
 {
+  if (auto shader = CreateShaderFromDiskCache(ShaderStage::Vertex, m_uber_vs_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       UberShader::GenVertexShader(m_api_type, m_host_config, uid.GetUidData());
   return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer(),
@@ -448,6 +489,9 @@ ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) con
 
 std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid) const
 {
+  if (auto shader = CreateShaderFromDiskCache(ShaderStage::Pixel, m_ps_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData(), {});
   return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
@@ -456,6 +500,9 @@ std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShade
 std::unique_ptr<AbstractShader>
 ShaderCache::CompilePixelUberShader(const UberShader::PixelShaderUid& uid) const
 {
+  if (auto shader = CreateShaderFromDiskCache(ShaderStage::Pixel, m_uber_ps_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       UberShader::GenPixelShader(m_api_type, m_host_config, uid.GetUidData(), {});
   return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer(),
@@ -552,11 +599,15 @@ const AbstractShader* ShaderCache::InsertPixelUberShader(const UberShader::Pixel
 
 const AbstractShader* ShaderCache::CreateGeometryShader(const GeometryShaderUid& uid)
 {
-  const ShaderCode source_code =
-      GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
   std::unique_ptr<AbstractShader> shader =
-      g_gfx->CreateShaderFromSource(ShaderStage::Geometry, source_code.GetBuffer(),
-                                    fmt::format("Geometry shader: {}", *uid.GetUidData()));
+      CreateShaderFromDiskCache(ShaderStage::Geometry, m_gs_cache.disk_cache, uid);
+  if (!shader)
+  {
+    const ShaderCode source_code =
+        GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
+    shader = g_gfx->CreateShaderFromSource(ShaderStage::Geometry, source_code.GetBuffer(),
+                                           fmt::format("Geometry shader: {}", *uid.GetUidData()));
+  }
 
   auto& entry = m_gs_cache.shader_map[uid];
   entry.pending = false;
@@ -869,6 +920,37 @@ ShaderCache::GetGXPipelineConfig(const GXUberPipelineUid& config_in)
                              AbstractPipelineUsage::GXUber);
 }
 
+template <typename DiskKeyType, typename KeyType>
+static std::unique_ptr<AbstractPipeline>
+CreatePipelineFromDiskCache(const Common::IndexedDiskCache<DiskKeyType, u8>& disk_cache,
+                            const KeyType& uid, const AbstractPipelineConfig& config)
+{
+  DiskKeyType disk_uid;
+  SerializePipelineUid(uid, disk_uid);
+
+  // Stale cache data is replaced once the pipeline has been created from scratch.
+  u32 data_size;
+  if (const u8* data = disk_cache.Lookup(disk_uid, &data_size))
+  {
+    if (auto pipeline = g_gfx->CreatePipeline(config, data, data_size))
+      return pipeline;
+  }
+  return g_gfx->CreatePipeline(config);
+}
+
+std::unique_ptr<AbstractPipeline>
+ShaderCache::CreateGXPipeline(const GXPipelineUid& uid, const AbstractPipelineConfig& config) const
+{
+  return CreatePipelineFromDiskCache(m_gx_pipeline_disk_cache, uid, config);
+}
+
+std::unique_ptr<AbstractPipeline>
+ShaderCache::CreateGXPipeline(const GXUberPipelineUid& uid,
+                              const AbstractPipelineConfig& config) const
+{
+  return CreatePipelineFromDiskCache(m_gx_uber_pipeline_disk_cache, uid, config);
+}
+
 const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& config,
                                                       std::unique_ptr<AbstractPipeline> pipeline)
 {
@@ -926,7 +1008,8 @@ void ShaderCache::LoadPipelineUIDCache()
   constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
   std::string filename =
       File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
-  if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
+  const bool read_only = g_ActiveConfig.bShaderCacheReadOnly;
+  if (m_gx_pipeline_uid_cache_file.Open(filename, read_only ? "rb" : "rb+"))
   {
     // If an existing case exists, validate the version before reading entries.
     u32 existing_magic;
@@ -972,8 +1055,12 @@ void ShaderCache::LoadPipelineUIDCache()
       m_gx_pipeline_uid_cache_file.Close();
   }
 
+  // New UIDs aren't recorded when the cache is read-only.
+  if (read_only)
+    m_gx_pipeline_uid_cache_file.Close();
+
   // If the file is not open, it means it was either corrupted or didn't exist.
-  if (!m_gx_pipeline_uid_cache_file.IsOpen())
+  if (!read_only && !m_gx_pipeline_uid_cache_file.IsOpen())
   {
     if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
     {
@@ -1182,7 +1269,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     bool Compile() override
     {
       if (config)
-        pipeline = g_gfx->CreatePipeline(*config);
+        pipeline = shader_cache->CreateGXPipeline(uid, *config);
       return true;
     }
 
@@ -1257,7 +1344,7 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
     bool Compile() override
     {
       if (config)
-        UberPipeline = g_gfx->CreatePipeline(*config);
+        UberPipeline = shader_cache->CreateGXPipeline(uid, *config);
       return true;
     }
 
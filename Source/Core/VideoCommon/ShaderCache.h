@@ -15,7 +15,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
-#include "Common/LinearDiskCache.h"
+#include "Common/IndexedDiskCache.h"
 
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/AbstractShader.h"
@@ -155,6 +155,11 @@ private:
                       const BlendingState& blending_state, AbstractPipelineUsage usage);
   std::optional<AbstractPipelineConfig> GetGXPipelineConfig(const GXPipelineUid& uid);
   std::optional<AbstractPipelineConfig> GetGXPipelineConfig(const GXUberPipelineUid& uid);
+  // Passes the pipeline cache data from the disk cache to the backend, if there is any.
+  std::unique_ptr<AbstractPipeline> CreateGXPipeline(const GXPipelineUid& uid,
+                                                     const AbstractPipelineConfig& config) const;
+  std::unique_ptr<AbstractPipeline> CreateGXPipeline(const GXUberPipelineUid& uid,
+                                                     const AbstractPipelineConfig& config) const;
   const AbstractPipeline* InsertGXPipeline(const GXPipelineUid& config,
                                            std::unique_ptr<AbstractPipeline> pipeline);
   const AbstractPipeline* InsertGXUberPipeline(const GXUberPipelineUid& config,
@@ -176,7 +181,7 @@ private:
   template <typename T>
   void ClearShaderCache(T& cache);
   template <typename KeyType, typename DiskKeyType, typename T>
-  void LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyType, u8>& disk_cache,
+  void LoadPipelineCache(T& cache, Common::IndexedDiskCache<DiskKeyType, u8>& disk_cache,
                          APIType api_type, const char* type, bool include_gameid);
   template <typename T, typename Y>
   void ClearPipelineCache(T& cache, Y& disk_cache);
@@ -216,7 +221,7 @@ private:
       bool pending = false;
     };
     std::map<Uid, Shader> shader_map;
-    Common::LinearDiskCache<Uid, u8> disk_cache;
+    Common::IndexedDiskCache<Uid, u8> disk_cache;
   };
   ShaderModuleCache<VertexShaderUid> m_vs_cache;
   ShaderModuleCache<GeometryShaderUid> m_gs_cache;
@@ -229,8 +234,8 @@ private:
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
   File::IOFile m_gx_pipeline_uid_cache_file;
-  Common::LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
-  Common::LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
+  Common::IndexedDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
+  Common::IndexedDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
   // EFB copy to VRAM/RAM pipelines
   std::map<TextureConversionShaderGen::TCShaderUid, std::unique_ptr<AbstractPipeline>>
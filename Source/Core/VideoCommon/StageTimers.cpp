@@ -0,0 +1,49 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/StageTimers.h"
+
+namespace StageTimers
+{
+std::atomic<bool> g_enabled = false;
+
+// Atomic because the stages run on the GPU thread in dual core mode, while the totals are taken
+// on the CPU thread
+static std::array<std::atomic<u64>, NUM_STAGES> s_nanoseconds{};
+static std::array<std::atomic<u64>, NUM_STAGES> s_calls{};
+
+const char* GetStageName(Stage stage)
+{
+  static constexpr std::array<const char*, NUM_STAGES> names = {
+      "opcode_decoder",
+      "run_vertices",
+      "texture_cache",
+      "flush",
+  };
+  return names[static_cast<size_t>(stage)];
+}
+
+void SetEnabled(bool enabled)
+{
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void AddTime(Stage stage, std::chrono::steady_clock::duration time)
+{
+  const size_t index = static_cast<size_t>(stage);
+  const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+  s_nanoseconds[index].fetch_add(static_cast<u64>(nanoseconds), std::memory_order_relaxed);
+  s_calls[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+Totals TakeTotals()
+{
+  Totals totals;
+  for (size_t i = 0; i < NUM_STAGES; ++i)
+  {
+    totals[i].nanoseconds = s_nanoseconds[i].exchange(0, std::memory_order_relaxed);
+    totals[i].calls = s_calls[i].exchange(0, std::memory_order_relaxed);
+  }
+  return totals;
+}
+}  // namespace StageTimers
@@ -0,0 +1,70 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+// Measures the time spent in a few stages of the video pipeline, for benchmarks like
+// dolphin-fifo-bench. It's off unless enabled, and then a timer only costs a relaxed load.
+namespace StageTimers
+{
+enum class Stage
+{
+  // OpcodeDecoder::RunFifo, which includes the time of the other stages
+  OpcodeDecoder,
+  // VertexLoaderManager::RunVertices
+  RunVertices,
+  // TextureCacheBase::Load and TextureCacheBase::CopyRenderTargetToTexture
+  TextureCache,
+  // VertexManagerBase::Flush, which includes texture loads
+  Flush,
+};
+
+constexpr size_t NUM_STAGES = static_cast<size_t>(Stage::Flush) + 1;
+
+struct StageTotal
+{
+  u64 nanoseconds = 0;
+  u64 calls = 0;
+};
+using Totals = std::array<StageTotal, NUM_STAGES>;
+
+extern std::atomic<bool> g_enabled;
+
+const char* GetStageName(Stage stage);
+
+void SetEnabled(bool enabled);
+void AddTime(Stage stage, std::chrono::steady_clock::duration time);
+// Returns the totals since the last call and resets them
+Totals TakeTotals();
+
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(Stage stage, bool active = true)
+      : m_stage(stage), m_enabled(active && g_enabled.load(std::memory_order_relaxed))
+  {
+    if (m_enabled)
+      m_start = std::chrono::steady_clock::now();
+  }
+  ~ScopedTimer()
+  {
+    if (m_enabled)
+      AddTime(m_stage, std::chrono::steady_clock::now() - m_start);
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  Stage m_stage;
+  bool m_enabled;
+  std::chrono::steady_clock::time_point m_start{};
+};
+}  // namespace StageTimers
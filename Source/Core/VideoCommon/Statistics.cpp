@@ -94,6 +94,9 @@ void Statistics::Display() const
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
   draw_statistic("vshaders alive", "%d", num_vertex_shaders_alive);
+  draw_statistic("Shader compiles pending", "%d", num_shader_compiles_pending);
+  draw_statistic("Shader compile latency", "%d us avg, %d us max", shader_compile_latency_avg_us,
+                 shader_compile_latency_max_us);
   draw_statistic("shaders changes", "%d", this_frame.num_shader_changes);
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
@@ -15,6 +15,10 @@ struct Statistics
   int num_vertex_shaders_created = 0;
   int num_vertex_shaders_alive = 0;
 
+  int num_shader_compiles_pending = 0;
+  int shader_compile_latency_avg_us = 0;
+  int shader_compile_latency_max_us = 0;
+
   int num_textures_created = 0;
   int num_textures_uploaded = 0;
   int num_textures_alive = 0;
@@ -47,6 +47,7 @@
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/ShaderCache.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureConversionShader.h"
@@ -74,7 +75,7 @@ TCacheEntry::TCacheEntry(std::unique_ptr<AbstractTexture> tex,
 TCacheEntry::~TCacheEntry()
 {
   for (auto& reference : references)
-    reference->references.erase(this);
+    std::erase(reference->references, this);
   ASSERT_MSG(VIDEO, g_texture_cache, "Texture cache destroyed before TCacheEntry was destroyed");
   g_texture_cache->ReleaseToPool(this);
 }
@@ -139,10 +140,10 @@ void TextureCacheBase::Invalidate()
 
   for (auto& bind : m_bound_textures)
     bind.reset();
-  m_textures_by_hash.clear();
+  m_textures_by_hash.Clear();
   m_textures_by_address.clear();
 
-  m_texture_pool.clear();
+  m_texture_pool.Clear();
 }
 
 void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
@@ -214,23 +215,11 @@ void TextureCacheBase::Cleanup(int _frameCount)
     }
   }
 
-  TexPool::iterator iter2 = m_texture_pool.begin();
-  TexPool::iterator tcend2 = m_texture_pool.end();
-  while (iter2 != tcend2)
-  {
-    if (iter2->second.frameCount == FRAMECOUNT_INVALID)
-    {
-      iter2->second.frameCount = _frameCount;
-    }
-    if (_frameCount > TEXTURE_POOL_KILL_THRESHOLD + iter2->second.frameCount)
-    {
-      iter2 = m_texture_pool.erase(iter2);
-    }
-    else
-    {
-      ++iter2;
-    }
-  }
+  m_texture_pool.EraseIf([_frameCount](const TextureConfig&, TexPoolEntry& pool_entry) {
+    if (pool_entry.frameCount == FRAMECOUNT_INVALID)
+      pool_entry.frameCount = _frameCount;
+    return _frameCount > TEXTURE_POOL_KILL_THRESHOLD + pool_entry.frameCount;
+  });
 }
 
 bool TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -432,7 +421,7 @@ void TextureCacheBase::ScaleTextureCacheEntryTo(RcTcacheEntry& entry, u32 new_wi
   // At this point new_texture has the old texture in it,
   // we can potentially reuse this, so let's move it back to the pool
   auto config = new_texture->texture->GetConfig();
-  m_texture_pool.emplace(
+  m_texture_pool.Insert(
       config, TexPoolEntry(std::move(new_texture->texture), std::move(new_texture->framebuffer)));
 }
 
@@ -618,14 +607,13 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
         textures_by_address_list.emplace_back(it.first, id);
       }
     }
-    for (const auto& it : m_textures_by_hash)
-    {
-      if (ShouldSaveEntry(it.second))
+    m_textures_by_hash.ForEach([&](u64 hash, const RcTcacheEntry& entry) {
+      if (ShouldSaveEntry(entry))
       {
-        const u32 id = AddCacheEntryToMap(it.second);
-        textures_by_hash_list.emplace_back(it.first, id);
+        const u32 id = AddCacheEntryToMap(entry);
+        textures_by_hash_list.emplace_back(hash, id);
       }
-    }
+    });
     for (u32 i = 0; i < m_bound_textures.size(); i++)
     {
       const auto& tentry = m_bound_textures[i];
@@ -717,7 +705,6 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
     auto tex = DeserializeTexture(p);
     auto entry =
         std::make_shared<TCacheEntry>(std::move(tex->texture), std::move(tex->framebuffer));
-    entry->textures_by_hash_iter = m_textures_by_hash.end();
     entry->DoState(p);
     if (entry->texture && commit_state)
       id_map.emplace(i, entry);
@@ -762,7 +749,7 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     auto& entry = GetEntry(id);
     if (entry)
-      entry->textures_by_hash_iter = m_textures_by_hash.emplace(hash, entry);
+      entry->textures_by_hash_handle = m_textures_by_hash.Insert(hash, entry);
   }
 
   // Clear bound textures
@@ -854,7 +841,7 @@ RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(RcTcacheEntry& entry_to_
   {
     auto& entry = iter.first->second;
     if (entry != entry_to_update && entry->IsCopy() &&
-        entry->references.count(entry_to_update.get()) == 0 &&
+        !entry->HasReference(entry_to_update.get()) &&
         entry->OverlapsMemoryRange(entry_to_update->addr, entry_to_update->size_in_bytes) &&
         entry->memory_stride == numBlocksX * block_size)
     {
@@ -1246,6 +1233,8 @@ private:
 
 TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
+  StageTimers::ScopedTimer timer(StageTimers::Stage::TextureCache);
+
   if (auto entry = LoadImpl(texture_info, false))
   {
     if (!DidLinkedAssetsChange(*entry))
@@ -1545,25 +1534,32 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
       std::max(texture_info.GetTextureSize(), palette_size) <=
           (u32)textureCacheSafetyColorSampleSize * 8)
   {
-    auto hash_range = m_textures_by_hash.equal_range(full_hash);
-    TexHashCache::iterator hash_iter = hash_range.first;
-    while (hash_iter != hash_range.second)
-    {
-      RcTcacheEntry& entry = hash_iter->second;
-      // All parameters, except the address, need to match here
+    // All parameters, except the address, need to match here. Partial texture updates can
+    // invalidate other entries, so the candidates are collected before updating any of them.
+    m_hash_lookup_candidates.clear();
+    m_textures_by_hash.ForEachEqual(full_hash, [&](TexHashCache::Handle handle,
+                                                   const RcTcacheEntry& entry) {
       if (entry->format == full_format && entry->native_levels >= texture_info.GetLevelCount() &&
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
-        entry = DoPartialTextureUpdates(hash_iter->second, texture_info.GetTlutAddress(),
-                                        texture_info.GetTlutFormat());
-        if (entry)
-        {
-          entry->texture->FinishedRendering();
-          return entry;
-        }
+        m_hash_lookup_candidates.push_back(handle);
+      }
+      return true;
+    });
+    for (const TexHashCache::Handle handle : m_hash_lookup_candidates)
+    {
+      RcTcacheEntry* candidate = m_textures_by_hash.Get(handle);
+      if (!candidate)
+        continue;
+
+      RcTcacheEntry entry = DoPartialTextureUpdates(*candidate, texture_info.GetTlutAddress(),
+                                                    texture_info.GetTlutFormat());
+      if (entry)
+      {
+        entry->texture->FinishedRendering();
+        return entry;
       }
-      ++hash_iter;
     }
   }
 
@@ -1834,7 +1830,7 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
       std::max(texture_info.GetTextureSize(), creation_info.palette_size) <=
           (u32)safety_color_sample_size * 8)
   {
-    entry->textures_by_hash_iter = m_textures_by_hash.emplace(creation_info.full_hash, entry);
+    entry->textures_by_hash_handle = m_textures_by_hash.Insert(creation_info.full_hash, entry);
   }
 
   const TextureAndTLUTFormat full_format(texture_info.GetTextureFormat(),
@@ -2185,6 +2181,8 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     float gamma, bool clamp_top, bool clamp_bottom,
     const CopyFilterCoefficients::Values& filter_coefficients)
 {
+  StageTimers::ScopedTimer timer(StageTimers::Stage::TextureCache);
+
   // Emulation methods:
   //
   // - EFB to RAM:
@@ -2516,11 +2514,8 @@ void TextureCacheBase::CopyRenderTargetToTexture(
 
       // Do not load textures by hash, if they were at least partly overwritten by an efb copy.
       // In this case, comparing the hash is not enough to check, if two textures are identical.
-      if (overlapping_entry->textures_by_hash_iter != m_textures_by_hash.end())
-      {
-        m_textures_by_hash.erase(overlapping_entry->textures_by_hash_iter);
-        overlapping_entry->textures_by_hash_iter = m_textures_by_hash.end();
-      }
+      m_textures_by_hash.Erase(overlapping_entry->textures_by_hash_handle);
+      overlapping_entry->textures_by_hash_handle = {};
     }
     ++iter.first;
   }
@@ -2699,7 +2694,6 @@ RcTcacheEntry TextureCacheBase::AllocateCacheEntry(const TextureConfig& config)
 
   auto cacheEntry =
       std::make_shared<TCacheEntry>(std::move(alloc->texture), std::move(alloc->framebuffer));
-  cacheEntry->textures_by_hash_iter = m_textures_by_hash.end();
   cacheEntry->id = m_last_entry_id++;
   return cacheEntry;
 }
@@ -2707,11 +2701,11 @@ RcTcacheEntry TextureCacheBase::AllocateCacheEntry(const TextureConfig& config)
 std::optional<TextureCacheBase::TexPoolEntry>
 TextureCacheBase::AllocateTexture(const TextureConfig& config)
 {
-  TexPool::iterator iter = FindMatchingTextureFromPool(config);
-  if (iter != m_texture_pool.end())
+  const TexPool::Handle handle = FindMatchingTextureFromPool(config);
+  if (TexPoolEntry* pool_entry = m_texture_pool.Get(handle))
   {
-    auto entry = std::move(iter->second);
-    m_texture_pool.erase(iter);
+    TexPoolEntry entry = std::move(*pool_entry);
+    m_texture_pool.Erase(handle);
     return std::move(entry);
   }
 
@@ -2739,7 +2733,7 @@ TextureCacheBase::AllocateTexture(const TextureConfig& config)
   return TexPoolEntry(std::move(texture), std::move(framebuffer));
 }
 
-TextureCacheBase::TexPool::iterator
+TextureCacheBase::TexPool::Handle
 TextureCacheBase::FindMatchingTextureFromPool(const TextureConfig& config)
 {
   // Find a texture from the pool that does not have a frameCount of FRAMECOUNT_INVALID.
@@ -2747,11 +2741,10 @@ TextureCacheBase::FindMatchingTextureFromPool(const TextureConfig& config)
   // which potentially means that a driver has to maintain two copies of the texture anyway.
   // Render-target textures are fine through, as they have to be generated in a seperated pass.
   // As non-render-target textures are usually static, this should not matter much.
-  auto range = m_texture_pool.equal_range(config);
-  auto matching_iter = std::find_if(range.first, range.second, [](const auto& iter) {
-    return iter.first.IsRenderTarget() || iter.second.frameCount != FRAMECOUNT_INVALID;
+  const bool is_render_target = config.IsRenderTarget();
+  return m_texture_pool.FindIf(config, [is_render_target](const TexPoolEntry& entry) {
+    return is_render_target || entry.frameCount != FRAMECOUNT_INVALID;
   });
-  return matching_iter != range.second ? matching_iter : m_texture_pool.end();
 }
 
 TextureCacheBase::TexAddrCache::iterator TextureCacheBase::GetTexCacheIter(TCacheEntry* entry)
@@ -2794,11 +2787,8 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
 
   RcTcacheEntry& entry = iter->second;
 
-  if (entry->textures_by_hash_iter != m_textures_by_hash.end())
-  {
-    m_textures_by_hash.erase(entry->textures_by_hash_iter);
-    entry->textures_by_hash_iter = m_textures_by_hash.end();
-  }
+  m_textures_by_hash.Erase(entry->textures_by_hash_handle);
+  entry->textures_by_hash_handle = {};
 
   // If this is a pending EFB copy, we don't want to flush it here.
   // Why? Because let's say a game is rendering a bloom-type effect, using EFB copies to essentially
@@ -2838,8 +2828,8 @@ void TextureCacheBase::ReleaseToPool(TCacheEntry* entry)
   if (!entry->texture)
     return;
   auto config = entry->texture->GetConfig();
-  m_texture_pool.emplace(config,
-                         TexPoolEntry(std::move(entry->texture), std::move(entry->framebuffer)));
+  m_texture_pool.Insert(config,
+                        TexPoolEntry(std::move(entry->texture), std::move(entry->framebuffer)));
 }
 
 bool TextureCacheBase::CreateUtilityTextures()
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
 #include <fmt/format.h>
@@ -13,12 +14,12 @@
 #include <string_view>
 #include <tuple>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
+#include "Common/FlatHashMultimap.h"
 #include "Common/MathUtil.h"
 
 #include "VideoCommon/AbstractTexture.h"
@@ -151,14 +152,15 @@ struct TCacheEntry
   // used to delete textures which haven't been used for TEXTURE_KILL_THRESHOLD frames
   int frameCount = FRAMECOUNT_INVALID;
 
-  // Keep an iterator to the entry in m_textures_by_hash, so it does not need to be searched when
+  // Keep a handle to the entry in m_textures_by_hash, so it does not need to be searched when
   // removing the cache entry
-  std::multimap<u64, std::shared_ptr<TCacheEntry>>::iterator textures_by_hash_iter;
+  Common::FlatHashMultimapHandle textures_by_hash_handle;
 
   // This is used to keep track of both:
   //   * efb copies used by this partially updated texture
   //   * partially updated textures which refer to this efb copy
-  std::unordered_set<TCacheEntry*> references;
+  // There are rarely more than a few, so a vector is faster to search than a set.
+  std::vector<TCacheEntry*> references;
 
   // Pending EFB copy
   std::unique_ptr<AbstractStagingTexture> pending_efb_copy;
@@ -203,8 +205,15 @@ struct TCacheEntry
   void CreateReference(TCacheEntry* other_entry)
   {
     // References are two-way, so they can easily be destroyed later
-    this->references.emplace(other_entry);
-    other_entry->references.emplace(this);
+    if (HasReference(other_entry))
+      return;
+    this->references.push_back(other_entry);
+    other_entry->references.push_back(this);
+  }
+
+  bool HasReference(const TCacheEntry* other_entry) const
+  {
+    return std::find(references.begin(), references.end(), other_entry) != references.end();
   }
 
   // Acquiring a content lock will lock the current contents and prevent texture cache from
@@ -335,9 +344,9 @@ protected:
 
 private:
   using TexAddrCache = std::multimap<u32, RcTcacheEntry>;
-  using TexHashCache = std::multimap<u64, RcTcacheEntry>;
+  using TexHashCache = Common::FlatHashMultimap<u64, RcTcacheEntry>;
 
-  using TexPool = std::unordered_multimap<TextureConfig, TexPoolEntry>;
+  using TexPool = Common::FlatHashMultimap<TextureConfig, TexPoolEntry>;
 
   static bool DidLinkedAssetsChange(const TCacheEntry& entry);
 
@@ -367,7 +376,7 @@ private:
 
   RcTcacheEntry AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
-  TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
+  TexPool::Handle FindMatchingTextureFromPool(const TextureConfig& config);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
   // Return all possible overlapping textures. As addr+size of the textures is not
@@ -415,6 +424,9 @@ private:
   // It's valid for textures to be in here after they've been invalidated
   std::array<RcTcacheEntry, 8> m_bound_textures{};
 
+  // Scratch space for GetTexture, to avoid allocating on every lookup by hash
+  std::vector<TexHashCache::Handle> m_hash_lookup_candidates;
+
   TexPool m_texture_pool;
   u64 m_last_entry_id = 0;
 
@@ -33,6 +33,7 @@
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureInfo.h"
@@ -437,6 +438,8 @@ void VertexManagerBase::Flush()
   if (m_is_flushed)
     return;
 
+  StageTimers::ScopedTimer timer(StageTimers::Stage::Flush);
+
   m_is_flushed = true;
 
   if (m_draw_counter == 0)
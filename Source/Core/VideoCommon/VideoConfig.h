@@ -117,6 +117,10 @@ struct VideoConfig final
   float widescreen_heuristic_widescreen_ratio = 0.f;
   bool bCrop = false;  // Aspect ratio controls.
   bool bShaderCache = false;
+  // Create cached shaders and pipelines when they are first needed instead of at startup.
+  bool bShaderCacheLazyLoad = false;
+  // Use the shader cache without writing to it, e.g. when several instances share it.
+  bool bShaderCacheReadOnly = false;
 
   // Enhancements
   u32 iMultisamples = 0;
@@ -0,0 +1,289 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+#include <enet/enet.h>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/ENet.h"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// Much longer than the latency of loopback, so packets that only go out when the sending thread
+// times out are easy to tell apart.
+constexpr u32 SERVICE_TIMEOUT_MS = 1000;
+constexpr int PACKET_COUNT = 200;
+
+// Only bounds how long a broken test can hang. Nothing is timed against it.
+constexpr u32 RECEIVE_TIMEOUT_MS = 5000;
+
+// Counts the wakeup datagrams that are waiting on the socket of a host. A marker datagram is sent
+// after them, so that this doesn't have to wait to make sure that no more arrive.
+int CountWakeups(ENetHost* host)
+{
+  ENetAddress address;
+  enet_socket_get_address(host->socket, &address);
+  address.host = 0x0100007f;  // localhost
+
+  u8 marker[2] = {0xff, 0xff};
+  ENetBuffer buffer;
+  buffer.data = marker;
+  buffer.dataLength = sizeof(marker);
+  enet_socket_send(host->socket, &address, &buffer, 1);
+
+  int wakeups = 0;
+  while (true)
+  {
+    enet_uint32 condition = ENET_SOCKET_WAIT_RECEIVE;
+    if (enet_socket_wait(host->socket, &condition, RECEIVE_TIMEOUT_MS) != 0 ||
+        !(condition & ENET_SOCKET_WAIT_RECEIVE))
+    {
+      ADD_FAILURE() << "The marker datagram didn't arrive";
+      return wakeups;
+    }
+
+    u8 data[2] = {};
+    buffer.data = data;
+    buffer.dataLength = sizeof(data);
+    const int length = enet_socket_receive(host->socket, nullptr, &buffer, 1);
+    if (length == 1 && data[0] == 0)
+      ++wakeups;
+    else if (length == 2)
+      return wakeups;
+  }
+}
+
+// A stand-in for the I/O thread of NetPlayClient and NetPlayServer, which can't be run without a
+// whole netplay session: packets are queued from another thread, which then wakes this one up to
+// send them.
+class Sender
+{
+public:
+  Sender(ENetHost* host, ENetPeer* peer) : m_host(host), m_peer(peer)
+  {
+    m_thread = std::thread(&Sender::ThreadFunc, this);
+  }
+
+  ~Sender()
+  {
+    m_running = false;
+    Common::ENet::WakeupThread(m_host);
+    m_thread.join();
+  }
+
+  void SendAsync(sf::Packet&& packet)
+  {
+    {
+      std::lock_guard lk(m_lock);
+      m_queue.push(std::move(packet));
+    }
+    m_wakeup.Request(m_host);
+  }
+
+private:
+  void ThreadFunc()
+  {
+    while (m_running)
+    {
+      ENetEvent event;
+      const int net = enet_host_service(m_host, &event, SERVICE_TIMEOUT_MS);
+      m_wakeup.Reset();
+      {
+        std::lock_guard lk(m_lock);
+        for (; !m_queue.empty(); m_queue.pop())
+          Common::ENet::SendPacket(m_peer, m_queue.front(), 0);
+      }
+      if (net > 0 && event.type == ENET_EVENT_TYPE_RECEIVE)
+        enet_packet_destroy(event.packet);
+      enet_host_flush(m_host);
+    }
+  }
+
+  ENetHost* m_host;
+  ENetPeer* m_peer;
+  Common::ENet::HostWakeup m_wakeup;
+  std::mutex m_lock;
+  std::queue<sf::Packet> m_queue;
+  std::atomic_bool m_running = true;
+  std::thread m_thread;
+};
+
+class ENetLoopbackTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_EQ(enet_initialize(), 0);
+
+    ENetAddress address{};
+    address.host = 0x0100007f;  // localhost
+    address.port = 0;
+    m_receiver.reset(enet_host_create(&address, 1, 1, 0, 0));
+    m_sender.reset(enet_host_create(nullptr, 1, 1, 0, 0));
+    ASSERT_TRUE(m_receiver && m_sender);
+    m_receiver->intercept = Common::ENet::InterceptCallback;
+    m_sender->intercept = Common::ENet::InterceptCallback;
+
+    enet_socket_get_address(m_receiver->socket, &address);
+    address.host = 0x0100007f;
+    m_peer = enet_host_connect(m_sender.get(), &address, 1, 0);
+    ASSERT_NE(m_peer, nullptr);
+
+    bool sender_connected = false;
+    bool receiver_connected = false;
+    for (int i = 0; i < 100 && !(sender_connected && receiver_connected); ++i)
+    {
+      ENetEvent event;
+      if (enet_host_service(m_sender.get(), &event, 10) > 0 &&
+          event.type == ENET_EVENT_TYPE_CONNECT)
+      {
+        sender_connected = true;
+      }
+      if (enet_host_service(m_receiver.get(), &event, 10) > 0 &&
+          event.type == ENET_EVENT_TYPE_CONNECT)
+      {
+        receiver_connected = true;
+      }
+    }
+    ASSERT_TRUE(sender_connected && receiver_connected);
+  }
+
+  void TearDown() override
+  {
+    m_sender.reset();
+    m_receiver.reset();
+    enet_deinitialize();
+  }
+
+  // Returns how long it took to receive the packet, or nullopt if it didn't arrive.
+  std::optional<Clock::duration> Receive(Clock::time_point sent)
+  {
+    const auto deadline = sent + std::chrono::milliseconds(SERVICE_TIMEOUT_MS * 3);
+    while (Clock::now() < deadline)
+    {
+      ENetEvent event;
+      if (enet_host_service(m_receiver.get(), &event, 1) > 0 &&
+          event.type == ENET_EVENT_TYPE_RECEIVE)
+      {
+        const auto elapsed = Clock::now() - sent;
+        enet_packet_destroy(event.packet);
+        return elapsed;
+      }
+    }
+    return std::nullopt;
+  }
+
+  Common::ENet::ENetHostPtr m_receiver;
+  Common::ENet::ENetHostPtr m_sender;
+  ENetPeer* m_peer = nullptr;
+};
+}  // namespace
+
+class HostWakeupTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_EQ(enet_initialize(), 0);
+
+    ENetAddress address{};
+    address.host = 0x0100007f;  // localhost
+    address.port = 0;
+    m_host.reset(enet_host_create(&address, 1, 1, 0, 0));
+    ASSERT_TRUE(m_host);
+  }
+
+  void TearDown() override
+  {
+    m_host.reset();
+    enet_deinitialize();
+  }
+
+  Common::ENet::ENetHostPtr m_host;
+};
+
+TEST_F(HostWakeupTest, RequestsShareOneWakeup)
+{
+  Common::ENet::HostWakeup wakeup;
+  for (int i = 0; i < 10; ++i)
+    wakeup.Request(m_host.get());
+
+  EXPECT_EQ(CountWakeups(m_host.get()), 1);
+}
+
+TEST_F(HostWakeupTest, ResetAllowsAnotherWakeup)
+{
+  Common::ENet::HostWakeup wakeup;
+  wakeup.Request(m_host.get());
+  wakeup.Request(m_host.get());
+  wakeup.Reset();
+  wakeup.Request(m_host.get());
+
+  EXPECT_EQ(CountWakeups(m_host.get()), 2);
+
+  // Resetting without a request in between doesn't send anything.
+  wakeup.Reset();
+  wakeup.Reset();
+  EXPECT_EQ(CountWakeups(m_host.get()), 0);
+}
+
+TEST_F(HostWakeupTest, ConcurrentRequestsShareOneWakeup)
+{
+  Common::ENet::HostWakeup wakeup;
+  std::atomic_bool go = false;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i)
+  {
+    threads.emplace_back([&] {
+      while (!go)
+        std::this_thread::yield();
+      for (int j = 0; j < 100; ++j)
+        wakeup.Request(m_host.get());
+    });
+  }
+  go = true;
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(CountWakeups(m_host.get()), 1);
+}
+
+// Measures the time from queuing a packet on one thread to receiving it over loopback, which is
+// what NetPlay adds to every pad packet before it reaches the network. Run with
+// --gtest_also_run_disabled_tests.
+TEST_F(ENetLoopbackTest, DISABLED_SendAsyncLatencyBenchmark)
+{
+  std::vector<double> latencies_us;
+  {
+    Sender sender(m_sender.get(), m_peer);
+    for (int i = 0; i < PACKET_COUNT; ++i)
+    {
+      sf::Packet packet;
+      packet << static_cast<u32>(i);
+
+      const Clock::time_point sent = Clock::now();
+      sender.SendAsync(std::move(packet));
+      const auto latency = Receive(sent);
+      ASSERT_TRUE(latency.has_value());
+      latencies_us.push_back(std::chrono::duration<double, std::micro>(*latency).count());
+    }
+  }
+
+  std::sort(latencies_us.begin(), latencies_us.end());
+  fmt::print("SendAsync loopback latency: median {:.0f} us, p99 {:.0f} us, max {:.0f} us\n",
+             latencies_us[latencies_us.size() / 2], latencies_us[latencies_us.size() * 99 / 100],
+             latencies_us.back());
+}
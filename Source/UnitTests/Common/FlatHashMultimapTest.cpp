@@ -0,0 +1,239 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FlatHashMultimap.h"
+
+namespace
+{
+// Puts every key into the same probe cluster, to exercise backward shift deletion.
+struct CollidingHash
+{
+  size_t operator()(u64) const { return 0; }
+};
+
+template <typename Map>
+std::vector<int> GetValues(Map& map, u64 key)
+{
+  std::vector<int> values;
+  map.ForEachEqual(key, [&](Common::FlatHashMultimapHandle, int value) {
+    values.push_back(value);
+    return true;
+  });
+  std::sort(values.begin(), values.end());
+  return values;
+}
+}  // namespace
+
+TEST(FlatHashMultimap, InsertFindErase)
+{
+  Common::FlatHashMultimap<u64, int> map;
+  const auto a = map.Insert(1, 10);
+  const auto b = map.Insert(1, 11);
+  const auto c = map.Insert(2, 20);
+  EXPECT_EQ(3u, map.size());
+  EXPECT_EQ(std::vector<int>({10, 11}), GetValues(map, 1));
+  EXPECT_EQ(std::vector<int>({20}), GetValues(map, 2));
+  EXPECT_TRUE(GetValues(map, 3).empty());
+
+  EXPECT_TRUE(map.Erase(a));
+  EXPECT_FALSE(map.Erase(a));
+  EXPECT_EQ(nullptr, map.Get(a));
+  EXPECT_EQ(11, *map.Get(b));
+  EXPECT_EQ(std::vector<int>({11}), GetValues(map, 1));
+
+  // The freed element is reused, but the old handle must not refer to it.
+  const auto d = map.Insert(3, 30);
+  EXPECT_EQ(a.index, d.index);
+  EXPECT_EQ(nullptr, map.Get(a));
+  EXPECT_EQ(30, *map.Get(d));
+
+  map.Clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(nullptr, map.Get(c));
+  EXPECT_EQ(nullptr, map.Get(d));
+  EXPECT_FALSE(map.Get(map.Insert(2, 21)) == nullptr);
+  EXPECT_EQ(std::vector<int>({21}), GetValues(map, 2));
+}
+
+TEST(FlatHashMultimap, FindIfAndEraseIf)
+{
+  Common::FlatHashMultimap<u64, int> map;
+  for (int i = 0; i < 100; i++)
+    map.Insert(i % 10, i);
+
+  const auto handle = map.FindIf(3, [](int value) { return value > 50; });
+  ASSERT_NE(nullptr, map.Get(handle));
+  EXPECT_EQ(3, *map.Get(handle) % 10);
+  EXPECT_GT(*map.Get(handle), 50);
+  EXPECT_FALSE(map.FindIf(3, [](int value) { return value > 100; }).IsValid());
+
+  map.EraseIf([](u64 key, int) { return key % 2 == 0; });
+  EXPECT_EQ(50u, map.size());
+  EXPECT_TRUE(GetValues(map, 4).empty());
+  EXPECT_EQ(10u, GetValues(map, 5).size());
+}
+
+TEST(FlatHashMultimap, MatchesStdMultimap)
+{
+  Common::FlatHashMultimap<u64, int> map;
+  Common::FlatHashMultimap<u64, int, CollidingHash> colliding_map;
+  std::multimap<u64, int> reference;
+  std::vector<std::pair<Common::FlatHashMultimapHandle, Common::FlatHashMultimapHandle>> handles;
+  std::vector<std::multimap<u64, int>::iterator> reference_iters;
+
+  std::mt19937 rng(1234);
+  for (int i = 0; i < 20000; i++)
+  {
+    if (reference_iters.empty() || rng() % 3 != 0)
+    {
+      const u64 key = rng() % 64;
+      handles.emplace_back(map.Insert(key, i), colliding_map.Insert(key, i));
+      reference_iters.push_back(reference.emplace(key, i));
+    }
+    else
+    {
+      const size_t victim = rng() % reference_iters.size();
+      EXPECT_TRUE(map.Erase(handles[victim].first));
+      EXPECT_TRUE(colliding_map.Erase(handles[victim].second));
+      reference.erase(reference_iters[victim]);
+      handles[victim] = handles.back();
+      handles.pop_back();
+      reference_iters[victim] = reference_iters.back();
+      reference_iters.pop_back();
+    }
+
+    if (i % 1000 == 0)
+    {
+      for (u64 key = 0; key < 64; key++)
+      {
+        std::vector<int> expected;
+        const auto range = reference.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it)
+          expected.push_back(it->second);
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(expected, GetValues(map, key));
+        ASSERT_EQ(expected, GetValues(colliding_map, key));
+      }
+    }
+  }
+  EXPECT_EQ(reference.size(), map.size());
+  EXPECT_EQ(reference.size(), colliding_map.size());
+}
+
+// Microbenchmark comparing the texture cache's hash index against the node-based containers it
+// replaced, run with --gtest_also_run_disabled_tests. The workload mimics a scene that keeps
+// creating and dropping small dynamic textures while looking up many more by hash.
+TEST(FlatHashMultimap, DISABLED_TextureCacheBenchmark)
+{
+  constexpr size_t LIVE_TEXTURES = 4096;
+  constexpr size_t OPERATIONS = 4000000;
+
+  std::mt19937_64 rng(42);
+  std::vector<u64> hashes(LIVE_TEXTURES * 4);
+  for (u64& hash : hashes)
+    hash = rng();
+
+  const auto run = [&](const char* name, auto&& insert, auto&& lookup, auto&& erase) {
+    std::mt19937 op_rng(7);
+    const auto start = std::chrono::steady_clock::now();
+    size_t found = 0;
+    for (size_t i = 0; i < OPERATIONS; i++)
+    {
+      const size_t slot = op_rng() % hashes.size();
+      const u64 hash = hashes[slot];
+      switch (op_rng() % 8)
+      {
+      case 0:
+        insert(slot, hash, i);
+        break;
+      case 1:
+        erase(slot, hash);
+        break;
+      default:
+        found += lookup(hash);
+        break;
+      }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    fmt::print("{}: {} ns per operation ({} found)\n", name,
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / OPERATIONS,
+               found);
+  };
+
+  {
+    Common::FlatHashMultimap<u64, std::shared_ptr<size_t>> map;
+    // Like the texture cache, which keeps the handle in the cache entry.
+    std::vector<std::vector<Common::FlatHashMultimapHandle>> handles(hashes.size());
+    run(
+        "FlatHashMultimap",
+        [&](size_t slot, u64 hash, size_t i) {
+          handles[slot].push_back(map.Insert(hash, std::make_shared<size_t>(i)));
+        },
+        [&](u64 hash) {
+          size_t count = 0;
+          map.ForEachEqual(hash, [&](auto, const auto& value) {
+            count += *value != 0;
+            return true;
+          });
+          return count;
+        },
+        [&](size_t slot, u64) {
+          auto& list = handles[slot];
+          if (!list.empty())
+          {
+            map.Erase(list.back());
+            list.pop_back();
+          }
+        });
+  }
+
+  {
+    std::multimap<u64, std::shared_ptr<size_t>> map;
+    run(
+        "std::multimap",
+        [&](size_t, u64 hash, size_t i) { map.emplace(hash, std::make_shared<size_t>(i)); },
+        [&](u64 hash) {
+          size_t count = 0;
+          const auto range = map.equal_range(hash);
+          for (auto it = range.first; it != range.second; ++it)
+            count += *it->second != 0;
+          return count;
+        },
+        [&](size_t, u64 hash) {
+          const auto it = map.find(hash);
+          if (it != map.end())
+            map.erase(it);
+        });
+  }
+
+  {
+    std::unordered_multimap<u64, std::shared_ptr<size_t>> map;
+    run(
+        "std::unordered_multimap",
+        [&](size_t, u64 hash, size_t i) { map.emplace(hash, std::make_shared<size_t>(i)); },
+        [&](u64 hash) {
+          size_t count = 0;
+          const auto range = map.equal_range(hash);
+          for (auto it = range.first; it != range.second; ++it)
+            count += *it->second != 0;
+          return count;
+        },
+        [&](size_t, u64 hash) {
+          const auto it = map.find(hash);
+          if (it != map.end())
+            map.erase(it);
+        });
+  }
+}
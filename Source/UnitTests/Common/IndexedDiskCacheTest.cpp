@@ -0,0 +1,292 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/IndexedDiskCache.h"
+
+using Cache = Common::IndexedDiskCache<u64, u8>;
+
+namespace
+{
+constexpr u64 ENTRY_COUNT = 50;
+
+// Every value is different, both in size and in contents.
+std::vector<u8> MakeValue(u64 key, u8 variant = 0)
+{
+  return std::vector<u8>(key % 37 + 1, static_cast<u8>(key * 3 + variant));
+}
+
+class Reader : public Common::LinearDiskCacheReader<u64, u8>
+{
+public:
+  void Read(const u64& key, const u8* value, u32 value_size) override
+  {
+    entries.emplace_back(key, std::vector<u8>(value, value + value_size));
+  }
+
+  std::vector<std::pair<u64, std::vector<u8>>> entries;
+};
+
+void ExpectValue(const Cache& cache, u64 key, const std::vector<u8>& expected)
+{
+  u32 size = 0;
+  const u8* value = cache.Lookup(key, &size);
+  ASSERT_NE(value, nullptr) << "key " << key;
+  EXPECT_EQ(expected, std::vector<u8>(value, value + size)) << "key " << key;
+}
+}  // namespace
+
+class IndexedDiskCacheTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_dir = File::CreateTempDir();
+    ASSERT_FALSE(m_dir.empty());
+    m_path = m_dir + "/cache.cache";
+    m_journal_path = m_path + ".journal";
+  }
+
+  void TearDown() override { File::DeleteDirRecursively(m_dir); }
+
+  void Fill(u64 count)
+  {
+    Cache cache;
+    cache.Open(m_path);
+    for (u64 key = 0; key < count; ++key)
+    {
+      const std::vector<u8> value = MakeValue(key);
+      cache.Append(key, value.data(), static_cast<u32>(value.size()));
+    }
+  }
+
+  // Leaves a journal behind with the given entries, as if the emulator crashed before closing
+  // the cache.
+  void MakeStaleJournal(u64 count)
+  {
+    const std::string backup = m_dir + "/journal.bak";
+    {
+      Cache cache;
+      cache.Open(m_path);
+      for (u64 key = 0; key < count; ++key)
+      {
+        const std::vector<u8> value = MakeValue(key);
+        cache.Append(key, value.data(), static_cast<u32>(value.size()));
+      }
+      cache.Sync();
+      ASSERT_TRUE(File::CopyRegularFile(m_journal_path, backup));
+    }
+    ASSERT_TRUE(File::Delete(m_path));
+    ASSERT_TRUE(File::Rename(backup, m_journal_path));
+  }
+
+  std::string m_dir;
+  std::string m_path;
+  std::string m_journal_path;
+};
+
+TEST_F(IndexedDiskCacheTest, RoundTrip)
+{
+  Fill(ENTRY_COUNT);
+  EXPECT_TRUE(File::Exists(m_path));
+  EXPECT_FALSE(File::Exists(m_journal_path));
+
+  Cache cache;
+  EXPECT_EQ(ENTRY_COUNT, cache.Open(m_path, true));
+  for (u64 key = 0; key < ENTRY_COUNT; ++key)
+    ExpectValue(cache, key, MakeValue(key));
+
+  u32 size;
+  EXPECT_EQ(cache.Lookup(ENTRY_COUNT, &size), nullptr);
+  EXPECT_FALSE(cache.Contains(ENTRY_COUNT));
+  EXPECT_TRUE(cache.Contains(0));
+  cache.Close();
+
+  // Reading everything gives the entries in the order they were added.
+  Reader reader;
+  EXPECT_EQ(ENTRY_COUNT, cache.OpenAndRead(m_path, reader, true));
+  ASSERT_EQ(ENTRY_COUNT, reader.entries.size());
+  for (u64 key = 0; key < ENTRY_COUNT; ++key)
+  {
+    EXPECT_EQ(key, reader.entries[key].first);
+    EXPECT_EQ(MakeValue(key), reader.entries[key].second);
+  }
+}
+
+TEST_F(IndexedDiskCacheTest, CompactionReplacesValues)
+{
+  Fill(ENTRY_COUNT);
+
+  {
+    Cache cache;
+    EXPECT_EQ(ENTRY_COUNT, cache.Open(m_path));
+
+    // Storing a value that is already there doesn't start a journal.
+    const std::vector<u8> same = MakeValue(5);
+    cache.Append(5, same.data(), static_cast<u32>(same.size()));
+    cache.Sync();
+    EXPECT_FALSE(File::Exists(m_journal_path));
+
+    for (u64 key = 0; key < ENTRY_COUNT + 10; key += 2)
+    {
+      const std::vector<u8> value = MakeValue(key, 1);
+      cache.Append(key, value.data(), static_cast<u32>(value.size()));
+    }
+  }
+  EXPECT_FALSE(File::Exists(m_journal_path));
+
+  Cache cache;
+  EXPECT_EQ(ENTRY_COUNT + 5, cache.Open(m_path, true));
+  for (u64 key = 0; key < ENTRY_COUNT + 10; ++key)
+  {
+    if (key % 2 == 0)
+      ExpectValue(cache, key, MakeValue(key, 1));
+    else if (key < ENTRY_COUNT)
+      ExpectValue(cache, key, MakeValue(key));
+    else
+      EXPECT_FALSE(cache.Contains(key));
+  }
+}
+
+TEST_F(IndexedDiskCacheTest, ReadOnlyDoesNotWrite)
+{
+  Fill(ENTRY_COUNT);
+
+  Cache cache;
+  cache.Open(m_path, true);
+  const std::vector<u8> value = MakeValue(ENTRY_COUNT);
+  cache.Append(ENTRY_COUNT, value.data(), static_cast<u32>(value.size()));
+  cache.Close();
+
+  EXPECT_FALSE(File::Exists(m_journal_path));
+  EXPECT_EQ(ENTRY_COUNT, cache.Open(m_path, true));
+  EXPECT_FALSE(cache.Contains(ENTRY_COUNT));
+}
+
+TEST_F(IndexedDiskCacheTest, StaleJournalIsMergedOnOpen)
+{
+  MakeStaleJournal(ENTRY_COUNT);
+
+  // Only a writable cache merges the journal.
+  Cache cache;
+  EXPECT_EQ(0u, cache.Open(m_path, true));
+  EXPECT_TRUE(File::Exists(m_journal_path));
+
+  EXPECT_EQ(ENTRY_COUNT, cache.Open(m_path));
+  EXPECT_FALSE(File::Exists(m_journal_path));
+  for (u64 key = 0; key < ENTRY_COUNT; ++key)
+    ExpectValue(cache, key, MakeValue(key));
+}
+
+TEST_F(IndexedDiskCacheTest, TruncatedJournal)
+{
+  MakeStaleJournal(ENTRY_COUNT);
+
+  // Cut the last record short, as a crash in the middle of writing it would.
+  const u64 size = File::GetSize(m_journal_path);
+  {
+    File::IOFile journal(m_journal_path, "r+b");
+    ASSERT_TRUE(journal.Resize(size - 3));
+  }
+
+  Cache cache;
+  EXPECT_EQ(ENTRY_COUNT - 1, cache.Open(m_path));
+  for (u64 key = 0; key < ENTRY_COUNT - 1; ++key)
+    ExpectValue(cache, key, MakeValue(key));
+  EXPECT_FALSE(cache.Contains(ENTRY_COUNT - 1));
+}
+
+TEST_F(IndexedDiskCacheTest, CorruptRecord)
+{
+  Fill(ENTRY_COUNT);
+
+  // Flip a byte in the value of one entry.
+  constexpr u64 CORRUPT_KEY = 20;
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(m_path, contents));
+  const std::vector<u8> value = MakeValue(CORRUPT_KEY);
+  const auto it = std::search(contents.begin(), contents.end(), value.begin(), value.end());
+  ASSERT_NE(it, contents.end());
+  *it ^= 1;
+  ASSERT_TRUE(File::WriteStringToFile(m_path, contents));
+
+  Cache cache;
+  cache.Open(m_path, true);
+  u32 size;
+  EXPECT_EQ(cache.Lookup(CORRUPT_KEY, &size), nullptr);
+  for (u64 key = 0; key < ENTRY_COUNT; ++key)
+  {
+    if (key != CORRUPT_KEY)
+      ExpectValue(cache, key, MakeValue(key));
+  }
+  cache.Close();
+
+  Reader reader;
+  EXPECT_EQ(ENTRY_COUNT - 1, cache.OpenAndRead(m_path, reader, true));
+}
+
+TEST_F(IndexedDiskCacheTest, TruncatedFile)
+{
+  Fill(ENTRY_COUNT);
+
+  {
+    File::IOFile file(m_path, "r+b");
+    ASSERT_TRUE(file.Resize(File::GetSize(m_path) - 1));
+  }
+
+  // The index doesn't fit anymore, so the whole file is ignored.
+  Cache cache;
+  EXPECT_EQ(0u, cache.Open(m_path, true));
+  EXPECT_FALSE(cache.Contains(0));
+
+  // Compacting salvages the records in front of the broken index.
+  cache.Open(m_path);
+  const std::vector<u8> value = MakeValue(ENTRY_COUNT);
+  cache.Append(ENTRY_COUNT, value.data(), static_cast<u32>(value.size()));
+  cache.Close();
+  EXPECT_EQ(ENTRY_COUNT + 1, cache.Open(m_path, true));
+  for (u64 key = 0; key <= ENTRY_COUNT; ++key)
+    ExpectValue(cache, key, MakeValue(key));
+}
+
+TEST_F(IndexedDiskCacheTest, OnlyOneWriter)
+{
+  Fill(ENTRY_COUNT);
+
+  Cache writer;
+  EXPECT_EQ(ENTRY_COUNT, writer.Open(m_path));
+  EXPECT_FALSE(writer.IsReadOnly());
+  const std::vector<u8> value = MakeValue(ENTRY_COUNT);
+  writer.Append(ENTRY_COUNT, value.data(), static_cast<u32>(value.size()));
+  writer.Sync();
+
+  // A second writer can still read, but neither writes nor compacts the journal.
+  Cache second;
+  EXPECT_EQ(ENTRY_COUNT, second.Open(m_path));
+  EXPECT_TRUE(second.IsReadOnly());
+  ExpectValue(second, 0, MakeValue(0));
+  const std::vector<u8> other_value = MakeValue(ENTRY_COUNT + 1);
+  second.Append(ENTRY_COUNT + 1, other_value.data(), static_cast<u32>(other_value.size()));
+  second.Close();
+  EXPECT_TRUE(File::Exists(m_journal_path));
+  EXPECT_FALSE(Cache::Compact(m_path));
+
+  writer.Close();
+  EXPECT_FALSE(File::Exists(m_journal_path));
+
+  // Once the first writer is gone, the cache can be written again.
+  Cache cache;
+  EXPECT_EQ(ENTRY_COUNT + 1, cache.Open(m_path));
+  EXPECT_FALSE(cache.IsReadOnly());
+  ExpectValue(cache, ENTRY_COUNT, value);
+  EXPECT_FALSE(cache.Contains(ENTRY_COUNT + 1));
+}
@@ -0,0 +1,91 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/CheatSearch.h"
+
+using Results = Cheats::SearchResults<u32>;
+
+namespace
+{
+Results::Page MakePage(u32 address, u32 valid_size, const std::vector<u32>& offsets, bool aligned)
+{
+  Results::Page page;
+  page.address = address;
+  page.valid_size = valid_size;
+  page.bits.resize(Results::GetBitsPerPage(aligned) / 64);
+  page.data.resize(Results::GetDataSize(aligned));
+  for (const u32 offset : offsets)
+  {
+    const u32 bit = aligned ? offset / sizeof(u32) : offset;
+    page.bits[bit / 64] |= u64{1} << (bit % 64);
+    // Big endian, with the low byte of the offset as the value
+    page.data[offset + 3] = static_cast<u8>(offset);
+  }
+  return page;
+}
+}  // namespace
+
+TEST(CheatSearch, ResultsAreIndexedAcrossPages)
+{
+  std::vector<Results::Page> pages;
+  pages.push_back(MakePage(0x80000000, Results::PAGE_SIZE, {0x10, 0x104, 0xFFC}, true));
+  pages.push_back(MakePage(0x80001000, Results::PAGE_SIZE, {}, true));
+  pages.push_back(MakePage(0x80005000, Results::PAGE_SIZE, {0x0, 0x800}, true));
+  const Results results(std::move(pages), true, true);
+
+  // Pages without results are dropped
+  EXPECT_EQ(2u, results.GetPages().size());
+  ASSERT_EQ(5u, results.GetCount());
+  EXPECT_EQ(5u, results.GetValidValueCount());
+
+  const std::vector<u32> addresses = {0x80000010, 0x80000104, 0x80000FFC, 0x80005000, 0x80005800};
+  for (size_t i = 0; i < addresses.size(); ++i)
+  {
+    const Cheats::SearchResult<u32> result = results.Get(i);
+    EXPECT_EQ(addresses[i], result.m_address);
+    EXPECT_EQ(addresses[i] & 0xFF, result.m_value);
+    EXPECT_EQ(Cheats::SearchResultValueState::ValueFromVirtualMemory, result.m_value_state);
+  }
+}
+
+TEST(CheatSearch, ValuesPastTheReadablePartOfAPageAreInaccessible)
+{
+  std::vector<Results::Page> pages;
+  // The last unaligned values of a page need the start of the next page
+  pages.push_back(MakePage(0x1000, Results::PAGE_SIZE, {0x0, 0xFFC, 0xFFD}, false));
+  pages.push_back(MakePage(0x2000, 0, {0x20}, false));
+  const Results results(std::move(pages), false, false);
+
+  ASSERT_EQ(4u, results.GetCount());
+  EXPECT_EQ(2u, results.GetValidValueCount());
+  EXPECT_EQ(Cheats::SearchResultValueState::ValueFromPhysicalMemory, results.Get(1).m_value_state);
+  EXPECT_EQ(Cheats::SearchResultValueState::AddressNotAccessible, results.Get(2).m_value_state);
+  EXPECT_EQ(0x1FFDu, results.Get(2).m_address);
+  EXPECT_EQ(Cheats::SearchResultValueState::AddressNotAccessible, results.Get(3).m_value_state);
+}
+
+TEST(CheatSearch, SliceKeepsResultsInRange)
+{
+  std::vector<Results::Page> pages;
+  std::vector<u32> offsets;
+  for (u32 offset = 0; offset < Results::PAGE_SIZE; offset += 0x40)
+    offsets.push_back(offset);
+  for (u32 address = 0x80000000; address < 0x80003000; address += Results::PAGE_SIZE)
+    pages.push_back(MakePage(address, Results::PAGE_SIZE, offsets, true));
+  const Results results(std::move(pages), true, true);
+  ASSERT_EQ(offsets.size() * 3, results.GetCount());
+
+  const Results slice = results.Slice(offsets.size() - 2, offsets.size() * 2 + 5);
+  ASSERT_EQ(offsets.size() + 7, slice.GetCount());
+  EXPECT_EQ(3u, slice.GetPages().size());
+  for (size_t i = 0; i < slice.GetCount(); ++i)
+    EXPECT_EQ(results.Get(offsets.size() - 2 + i).m_address, slice.Get(i).m_address);
+
+  EXPECT_EQ(0u, results.Slice(10, 10).GetCount());
+  EXPECT_EQ(results.GetCount(), results.Slice(0, results.GetCount() + 100).GetCount());
+}
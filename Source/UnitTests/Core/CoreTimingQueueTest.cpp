@@ -0,0 +1,182 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/CoreTimingQueue.h"
+
+using namespace CoreTiming;
+
+namespace
+{
+constexpr size_t TYPE_COUNT = 16;
+
+class EventQueueTest : public testing::Test
+{
+protected:
+  EventQueueTest()
+  {
+    for (size_t i = 0; i < TYPE_COUNT; ++i)
+    {
+      m_names[i] = fmt::format("Event{}", i);
+      m_types[i] = EventType{nullptr, &m_names[i]};
+    }
+  }
+
+  Event MakeEvent(s64 time, size_t type) { return Event{time, m_fifo_order++, 0, &m_types[type]}; }
+
+  std::array<std::string, TYPE_COUNT> m_names;
+  std::array<EventType, TYPE_COUNT> m_types{};
+  u64 m_fifo_order = 0;
+};
+
+// Pushes, pops and removes events like CoreTimingManager does while the emulated clock runs,
+// doing the same to every queue.
+template <size_t N>
+void RunWorkload(std::array<EventQueue*, N> queues, std::array<EventType, TYPE_COUNT>& types,
+                 u64& fifo_order, u32 seed, int steps,
+                 const std::function<void(const std::array<Event, N>&)>& on_pop)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> op_distribution(0, 9);
+  std::uniform_int_distribution<size_t> type_distribution(0, TYPE_COUNT - 1);
+  // Mostly short delays like SI/VI/DSP events, sometimes far away or in the past.
+  std::uniform_int_distribution<s64> near_distribution(-50, 20000);
+  std::uniform_int_distribution<s64> far_distribution(0, s64(1) << 36);
+
+  s64 now = 0;
+  for (int step = 0; step < steps; ++step)
+  {
+    const int op = op_distribution(rng);
+    if (op < 5)
+    {
+      const s64 delay = op == 0 ? far_distribution(rng) : near_distribution(rng);
+      const Event event{now + delay, fifo_order++, static_cast<u64>(step),
+                        &types[type_distribution(rng)]};
+      for (EventQueue* queue : queues)
+        queue->Push(event);
+    }
+    else if (op < 8)
+    {
+      if (queues[0]->IsEmpty())
+        continue;
+
+      std::array<Event, N> first;
+      for (size_t i = 0; i < N; ++i)
+      {
+        first[i] = queues[i]->GetFirst();
+        queues[i]->PopFirst();
+      }
+      now = std::max(now, first[0].time);
+      on_pop(first);
+    }
+    else
+    {
+      const EventType* type = &types[type_distribution(rng)];
+      for (EventQueue* queue : queues)
+        queue->RemoveAll(type);
+    }
+  }
+}
+}  // namespace
+
+TEST_F(EventQueueTest, OrderByTimeThenFifoOrder)
+{
+  TimingWheelEventQueue queue;
+  queue.Push(MakeEvent(300, 0));
+  queue.Push(MakeEvent(100, 1));
+  queue.Push(MakeEvent(300, 2));
+  queue.Push(MakeEvent(100000, 3));
+  queue.Push(MakeEvent(s64(1) << 40, 4));
+  queue.Push(MakeEvent(-5, 5));
+
+  const std::array<size_t, 6> expected_types{5, 1, 0, 2, 3, 4};
+  for (size_t type : expected_types)
+  {
+    ASSERT_FALSE(queue.IsEmpty());
+    EXPECT_EQ(&m_types[type], queue.GetFirst().type);
+    queue.PopFirst();
+  }
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST_F(EventQueueTest, RemoveAll)
+{
+  TimingWheelEventQueue queue;
+  queue.Push(MakeEvent(10, 0));
+  queue.Push(MakeEvent(5000, 1));
+  queue.Push(MakeEvent(20, 0));
+  queue.Push(MakeEvent(s64(1) << 40, 0));
+  queue.RemoveAll(&m_types[0]);
+
+  ASSERT_FALSE(queue.IsEmpty());
+  EXPECT_EQ(&m_types[1], queue.GetFirst().type);
+  queue.PopFirst();
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST_F(EventQueueTest, SetEventsSortsEvents)
+{
+  TimingWheelEventQueue queue;
+  queue.SetEvents({MakeEvent(70000, 0), MakeEvent(3, 1), MakeEvent(70000, 2)});
+
+  EXPECT_EQ(3u, queue.GetEvents().size());
+  EXPECT_EQ(&m_types[1], queue.GetFirst().type);
+  queue.PopFirst();
+  EXPECT_EQ(&m_types[0], queue.GetFirst().type);
+  queue.PopFirst();
+  EXPECT_EQ(&m_types[2], queue.GetFirst().type);
+}
+
+// Netplay and movies rely on every implementation handing out events in the same order.
+TEST_F(EventQueueTest, TimingWheelMatchesHeap)
+{
+  HeapEventQueue heap;
+  TimingWheelEventQueue wheel;
+  size_t pops = 0;
+  RunWorkload<2>({&heap, &wheel}, m_types, m_fifo_order, 1234, 200000,
+                 [&pops](const std::array<Event, 2>& first) {
+                   ++pops;
+                   EXPECT_EQ(first[0].time, first[1].time);
+                   EXPECT_EQ(first[0].fifo_order, first[1].fifo_order);
+                   EXPECT_EQ(first[0].type, first[1].type);
+                 });
+
+  EXPECT_GT(pops, 0u);
+  EXPECT_EQ(heap.GetEvents().size(), wheel.GetEvents().size());
+}
+
+// Microbenchmark, run with --gtest_also_run_disabled_tests.
+TEST_F(EventQueueTest, DISABLED_Benchmark)
+{
+  constexpr int STEPS = 5000000;
+  for (EventQueueType type : {EventQueueType::Heap, EventQueueType::TimingWheel})
+  {
+    std::unique_ptr<EventQueue> queue = CreateEventQueue(type);
+
+    // Keep a realistic amount of events pending.
+    for (size_t i = 0; i < 64; ++i)
+      queue->Push(MakeEvent(static_cast<s64>(i * 1000), i % TYPE_COUNT));
+
+    const auto start = std::chrono::steady_clock::now();
+    RunWorkload<1>({queue.get()}, m_types, m_fifo_order, 5678, STEPS,
+                   [](const std::array<Event, 1>&) {});
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    fmt::print("{}: {} ns per operation\n",
+               type == EventQueueType::Heap ? "Heap" : "Timing wheel",
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / STEPS);
+  }
+}
@@ -0,0 +1,284 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+
+#define AX_GC
+#include "Core/HW/DSPHLE/UCodes/AXVoice.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceKernels.h"
+
+namespace
+{
+// The scalar loops that AX used before they were vectorized. The vectorized ones must match them
+// exactly, since audio affects emulation through the DSP and netplay depends on it.
+namespace Reference
+{
+void MixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta, s16* dpop)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= *volume;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);
+
+    out[i] += (s16)sample;
+    *volume += volume_delta;
+
+    *dpop = (s16)sample;
+  }
+}
+
+template <typename Volume>
+u16 ApplyVolumeEnvelope(s16* samples, u32 count, u16 cur_volume, u16 cur_volume_delta)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 volume = (Volume)cur_volume;
+    const s32 sample = ((s32)samples[i] * volume) >> 15;
+    samples[i] = std::clamp(sample, -32767, 32767);
+    cur_volume += cur_volume_delta;
+  }
+  return cur_volume;
+}
+
+u32 ResampleAudio(const std::vector<s16>& input, s16* output, u32 count, s16* last_samples,
+                  u32 curr_pos, u32 ratio, bool polyphase, const s16* coeffs)
+{
+  u32 read_samples_count = 0;
+  s16 temp[4];
+  u32 idx = 0;
+
+  temp[idx++ & 3] = last_samples[0];
+  temp[idx++ & 3] = last_samples[1];
+  temp[idx++ & 3] = last_samples[2];
+  temp[idx++ & 3] = last_samples[3];
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    curr_pos += ratio;
+    while (curr_pos >= 0x10000)
+    {
+      temp[idx++ & 3] = input[read_samples_count++];
+      curr_pos -= 0x10000;
+    }
+
+    if (polyphase)
+    {
+      u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
+      const s16* c = &coeffs[curr_pos_frac];
+
+      s64 t0 = temp[idx++ & 3];
+      s64 t1 = temp[idx++ & 3];
+      s64 t2 = temp[idx++ & 3];
+      s64 t3 = temp[idx++ & 3];
+
+      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
+
+      output[i] = MathUtil::SaturatingCast<s16>(samp);
+    }
+    else
+    {
+      u16 curr_frac = curr_pos & 0xFFFF;
+      u16 inv_curr_frac = -curr_frac;
+
+      s16 sample;
+      if (curr_frac)
+      {
+        s32 s0 = temp[idx++ & 3];
+        s32 s1 = temp[idx++ & 3];
+
+        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
+        idx += 2;
+      }
+      else
+      {
+        sample = temp[idx++ & 3];
+        idx += 3;
+      }
+
+      output[i] = sample;
+    }
+  }
+
+  last_samples[3] = temp[--idx & 3];
+  last_samples[2] = temp[--idx & 3];
+  last_samples[1] = temp[--idx & 3];
+  last_samples[0] = temp[--idx & 3];
+  return curr_pos;
+}
+}  // namespace Reference
+
+// Mixer and resampler settings taken from the parameter blocks of a few games, plus edge cases
+// for the volume wrapping around and for the largest products.
+struct VoiceParams
+{
+  u16 volume;
+  u16 volume_delta;
+  u32 ratio;
+  u16 cur_addr_frac;
+};
+
+constexpr std::array<VoiceParams, 8> VOICE_PARAMS{{
+    {0x7FFF, 0x0000, 0x00010000, 0x0000},  // Full volume, no resampling
+    {0x4000, 0x0040, 0x0000AC44, 0x2B1A},  // Fade in, 32 kHz to 48 kHz-ish
+    {0x6000, 0xFFC0, 0x00008000, 0x8000},  // Fade out, half speed
+    {0xFFFF, 0x0001, 0x00018000, 0xFFFF},  // Wraps around on the second sample
+    {0x8000, 0x0000, 0x00055555, 0x0001},  // Wii Remote speaker ratio
+    {0x0001, 0x7FFF, 0x00001000, 0x0F00},  // Large steps, heavy upsampling
+    {0x8000, 0x8000, 0x0003FFFF, 0x7FFF},  // Alternates between -32768 and 0 when signed
+    {0x0000, 0x0000, 0x00000001, 0x0000},  // Muted, barely moving
+}};
+
+std::vector<s16> RandomSamples(std::mt19937& rng, size_t count)
+{
+  std::vector<s16> samples(count);
+  for (s16& sample : samples)
+  {
+    // Plenty of extremes, since that's where overflows would show up
+    switch (rng() % 4)
+    {
+    case 0:
+      sample = rng() % 2 ? 32767 : -32768;
+      break;
+    default:
+      sample = static_cast<s16>(rng());
+      break;
+    }
+  }
+  return samples;
+}
+
+// Runs a test once for every implementation that the host CPU supports.
+template <typename Function>
+void ForEachImplementation(Function function)
+{
+  function();
+
+#ifdef _M_X86_64
+  if (cpu_info.bAVX2)
+  {
+    cpu_info.bAVX2 = false;
+    function();
+    cpu_info.bAVX2 = true;
+  }
+#endif
+}
+}  // namespace
+
+TEST(AXVoice, MixAddMatchesReference)
+{
+  ForEachImplementation([] {
+    std::mt19937 rng(1);
+    for (const VoiceParams& params : VOICE_PARAMS)
+    {
+      for (u32 count = 0; count <= DSP::HLE::AXKernels::MAX_SAMPLE_COUNT; ++count)
+      {
+        const std::vector<s16> input = RandomSamples(rng, count);
+        std::vector<int> expected_out(count);
+        for (int& value : expected_out)
+          value = static_cast<s32>(rng()) >> 8;
+        std::vector<int> out = expected_out;
+
+        for (const bool ramp : {false, true})
+        {
+          u16 expected_volume = params.volume;
+          s16 expected_dpop = 0x1234;
+          Reference::MixAdd(expected_out.data(), input.data(), count, &expected_volume,
+                            ramp ? params.volume_delta : 0, &expected_dpop);
+
+          DSP::HLE::VolumeData volume_data{params.volume, params.volume_delta};
+          s16 dpop = 0x1234;
+          DSP::HLE::MixAdd(out.data(), input.data(), count, &volume_data, &dpop, ramp);
+
+          ASSERT_EQ(expected_out, out);
+          ASSERT_EQ(expected_volume, volume_data.volume);
+          ASSERT_EQ(expected_dpop, dpop);
+        }
+      }
+    }
+  });
+}
+
+TEST(AXVoice, VolumeEnvelopeMatchesReference)
+{
+  ForEachImplementation([] {
+    std::mt19937 rng(2);
+    for (const VoiceParams& params : VOICE_PARAMS)
+    {
+      for (u32 count = 0; count <= DSP::HLE::AXKernels::MAX_SAMPLE_COUNT; ++count)
+      {
+        const std::vector<s16> input = RandomSamples(rng, count);
+
+        for (const bool signed_volume : {false, true})
+        {
+          std::vector<s16> expected = input;
+          const u16 expected_volume =
+              signed_volume ? Reference::ApplyVolumeEnvelope<s16>(expected.data(), count,
+                                                                  params.volume,
+                                                                  params.volume_delta) :
+                              Reference::ApplyVolumeEnvelope<u16>(expected.data(), count,
+                                                                  params.volume,
+                                                                  params.volume_delta);
+
+          std::vector<s16> samples = input;
+          const u16 volume = DSP::HLE::AXKernels::ApplyVolumeEnvelope(
+              samples.data(), count, params.volume, params.volume_delta, signed_volume);
+
+          ASSERT_EQ(expected, samples);
+          ASSERT_EQ(expected_volume, volume);
+        }
+      }
+    }
+  });
+}
+
+TEST(AXVoice, ResamplingMatchesReference)
+{
+  ForEachImplementation([] {
+    std::mt19937 rng(3);
+
+    // Not the coefficients from the DSP ROM, but random ones that include the extremes
+    const std::vector<s16> coeffs = RandomSamples(rng, 0x200);
+
+    for (const VoiceParams& params : VOICE_PARAMS)
+    {
+      for (const bool polyphase : {false, true})
+      {
+        for (const u32 count : {1u, 7u, 18u, 32u, 95u, 96u})
+        {
+          const u64 input_count = ((u64(params.ratio) * count + params.cur_addr_frac) >> 16) + 1;
+          const std::vector<s16> input = RandomSamples(rng, input_count);
+          const std::vector<s16> initial_last_samples = RandomSamples(rng, 4);
+
+          std::vector<s16> expected(count);
+          std::vector<s16> expected_last_samples = initial_last_samples;
+          const u32 expected_pos = Reference::ResampleAudio(
+              input, expected.data(), count, expected_last_samples.data(), params.cur_addr_frac,
+              params.ratio, polyphase, coeffs.data());
+
+          std::vector<s16> output(count);
+          std::vector<s16> last_samples = initial_last_samples;
+          const u32 pos = DSP::HLE::ResampleAudio(
+              [&input](u32 i) { return input[i]; }, output.data(), count, last_samples.data(),
+              params.cur_addr_frac, params.ratio,
+              polyphase ? DSP::HLE::SRCTYPE_POLYPHASE : DSP::HLE::SRCTYPE_LINEAR,
+              coeffs.data());
+
+          ASSERT_EQ(expected, output);
+          ASSERT_EQ(expected_last_samples, last_samples);
+          ASSERT_EQ(expected_pos, pos);
+        }
+      }
+    }
+  });
+}
@@ -0,0 +1,217 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DVD/DVDPrefetcher.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeDisc.h"
+
+namespace
+{
+constexpr u64 BLOCK_SIZE = DVD::DVDPrefetcher::BLOCK_SIZE;
+constexpr u64 DISC_SIZE = 512 * BLOCK_SIZE;
+
+u8 GetDiscByte(u64 offset)
+{
+  // Lets DiscIO::CreateDisc recognize the fake disc as a GameCube disc
+  constexpr u8 GAMECUBE_MAGIC[] = {0xC2, 0x33, 0x9F, 0x3D};
+  if (offset >= 0x1C && offset < 0x20)
+    return GAMECUBE_MAGIC[offset - 0x1C];
+
+  return static_cast<u8>((offset * 0x9E3779B97F4A7C15ULL) >> 56);
+}
+
+// Records the reads made by the prefetcher's workers, so that the tests can wait for them.
+class WorkerReadLog
+{
+public:
+  void Add(u64 offset)
+  {
+    {
+      std::lock_guard lock(m_mutex);
+      m_offsets.insert(offset);
+    }
+    m_changed.notify_all();
+  }
+
+  bool WaitFor(u64 offset)
+  {
+    std::unique_lock lock(m_mutex);
+    return m_changed.wait_for(lock, std::chrono::seconds(10),
+                              [&] { return m_offsets.contains(offset); });
+  }
+
+  bool Contains(u64 offset)
+  {
+    std::lock_guard lock(m_mutex);
+    return m_offsets.contains(offset);
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_changed;
+  std::set<u64> m_offsets;
+};
+
+class FakeBlobReader final : public DiscIO::BlobReader
+{
+public:
+  FakeBlobReader(std::shared_ptr<WorkerReadLog> log, bool is_worker)
+      : m_log(std::move(log)), m_is_worker(is_worker)
+  {
+  }
+
+  DiscIO::BlobType GetBlobType() const override { return DiscIO::BlobType::PLAIN; }
+  std::unique_ptr<BlobReader> CopyReader() const override
+  {
+    return std::make_unique<FakeBlobReader>(m_log, true);
+  }
+  u64 GetRawSize() const override { return DISC_SIZE; }
+  u64 GetDataSize() const override { return DISC_SIZE; }
+  DiscIO::DataSizeType GetDataSizeType() const override { return DiscIO::DataSizeType::Accurate; }
+  u64 GetBlockSize() const override { return 0; }
+  bool HasFastRandomAccessInBlock() const override { return true; }
+  std::string GetCompressionMethod() const override { return {}; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override
+  {
+    if (offset + size > DISC_SIZE)
+      return false;
+
+    for (u64 i = 0; i < size; ++i)
+      out_ptr[i] = GetDiscByte(offset + i);
+
+    if (m_is_worker)
+      m_log->Add(offset);
+    return true;
+  }
+
+private:
+  std::shared_ptr<WorkerReadLog> m_log;
+  bool m_is_worker;
+};
+
+class DVDPrefetcherTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_log = std::make_shared<WorkerReadLog>();
+    m_disc = DiscIO::CreateDisc(std::make_unique<FakeBlobReader>(m_log, false));
+    ASSERT_NE(m_disc, nullptr);
+    m_prefetcher = DVD::DVDPrefetcher::Create(*m_disc);
+    ASSERT_NE(m_prefetcher, nullptr);
+  }
+
+  void ReadAndVerify(u64 offset, u32 length)
+  {
+    std::vector<u8> buffer(length);
+    ASSERT_TRUE(
+        m_prefetcher->Read(*m_disc, offset, length, buffer.data(), DiscIO::PARTITION_NONE));
+    for (u32 i = 0; i < length; ++i)
+      ASSERT_EQ(buffer[i], GetDiscByte(offset + i)) << "at offset " << offset + i;
+  }
+
+  // Reads whole blocks in order. Only the first two reads can miss, since the sequence isn't
+  // recognized before the second one.
+  void StreamBlocks(u64 first_block, u64 count)
+  {
+    for (u64 block = first_block; block < first_block + count; ++block)
+    {
+      if (block >= first_block + 2)
+      {
+        ASSERT_TRUE(m_log->WaitFor(block * BLOCK_SIZE));
+      }
+      ReadAndVerify(block * BLOCK_SIZE, BLOCK_SIZE);
+    }
+  }
+
+  std::shared_ptr<WorkerReadLog> m_log;
+  std::unique_ptr<DiscIO::VolumeDisc> m_disc;
+  std::unique_ptr<DVD::DVDPrefetcher> m_prefetcher;
+};
+}  // namespace
+
+TEST_F(DVDPrefetcherTest, SequentialReadsArePrefetched)
+{
+  StreamBlocks(16, 32);
+
+  const DVD::DVDPrefetcher::Statistics stats = m_prefetcher->GetStatistics();
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.hits, 30u);
+}
+
+TEST_F(DVDPrefetcherTest, UnalignedSequentialReads)
+{
+  // Reads that straddle block boundaries are served partly from the cache and partly from disc.
+  constexpr u32 LENGTH = 0x30000;
+  for (u64 offset = 0x1000; offset < 0x1000 + 16 * LENGTH; offset += LENGTH)
+  {
+    ReadAndVerify(offset, LENGTH);
+    if (offset == 0x1000)
+      continue;
+
+    // The first block of the next read may have been read from disc along with this one, but the
+    // last block can only come from the workers.
+    const u64 next_end = offset + 2 * LENGTH;
+    ASSERT_TRUE(m_log->WaitFor((next_end - 1) / BLOCK_SIZE * BLOCK_SIZE));
+  }
+
+  EXPECT_GT(m_prefetcher->GetStatistics().hits, 0u);
+}
+
+TEST_F(DVDPrefetcherTest, StridedReadsArePrefetched)
+{
+  constexpr u64 STRIDE = 5 * BLOCK_SIZE;
+  constexpr u32 LENGTH = 0x800;
+
+  // The stride is learned once the same distance has been seen twice in a row.
+  ReadAndVerify(10 * BLOCK_SIZE, LENGTH);
+  ReadAndVerify(10 * BLOCK_SIZE + STRIDE, LENGTH);
+  ReadAndVerify(10 * BLOCK_SIZE + 2 * STRIDE, LENGTH);
+
+  const u64 next_offset = 10 * BLOCK_SIZE + 3 * STRIDE;
+  ASSERT_TRUE(m_log->WaitFor(next_offset));
+  ReadAndVerify(next_offset, LENGTH);
+
+  // Nothing between the strided reads should have been prefetched.
+  EXPECT_FALSE(m_log->Contains(next_offset - BLOCK_SIZE));
+
+  const DVD::DVDPrefetcher::Statistics stats = m_prefetcher->GetStatistics();
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.hits, 1u);
+}
+
+TEST_F(DVDPrefetcherTest, UsedBlocksAreEvictedFirst)
+{
+  // Leaves 16 prefetched blocks after the end of the stream that haven't been used yet.
+  StreamBlocks(16, 32);
+  for (u64 block = 48; block < 64; ++block)
+    ASSERT_TRUE(m_log->WaitFor(block * BLOCK_SIZE));
+
+  // Streaming elsewhere needs more blocks than the cache can hold, so blocks must be evicted.
+  StreamBlocks(256, 128);
+  const DVD::DVDPrefetcher::Statistics before = m_prefetcher->GetStatistics();
+
+  // The blocks that were prefetched but never used should still be there.
+  for (u64 block = 48; block < 64; ++block)
+    ReadAndVerify(block * BLOCK_SIZE, BLOCK_SIZE);
+
+  const DVD::DVDPrefetcher::Statistics after = m_prefetcher->GetStatistics();
+  EXPECT_EQ(after.hits - before.hits, 16u);
+  EXPECT_EQ(after.misses, before.misses);
+  EXPECT_EQ(after.unused_blocks, 0u);
+}
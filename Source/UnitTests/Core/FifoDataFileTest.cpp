@@ -0,0 +1,194 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest-spi.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+
+namespace
+{
+// Layout of the frame list in a DFF file
+constexpr u64 FRAME_LIST_OFFSET = 128;
+constexpr u64 FRAME_INFO_SIZE = 64;
+constexpr u64 COMPRESSION_OFFSET = 32;
+constexpr u64 UNCOMPRESSED_SIZE_OFFSET = 40;
+
+constexpr u32 FRAME_COUNT = 5;
+// This frame is random, so it doesn't shrink when compressed and is stored as is.
+constexpr u32 RANDOM_FRAME = 2;
+
+FifoFrameInfo MakeFrame(u32 index)
+{
+  std::mt19937 rng(index);
+  const auto byte = [&rng, index](size_t i) {
+    return static_cast<u8>(index == RANDOM_FRAME ? rng() : i % 16);
+  };
+
+  FifoFrameInfo frame;
+  frame.fifoData.resize(4096 + index * 100);
+  for (size_t i = 0; i < frame.fifoData.size(); ++i)
+    frame.fifoData[i] = byte(i);
+  frame.fifoStart = index * 0x1000;
+  frame.fifoEnd = frame.fifoStart + static_cast<u32>(frame.fifoData.size());
+
+  for (u32 i = 0; i < index; ++i)
+  {
+    MemoryUpdate update;
+    update.fifoPosition = i * 256;
+    update.address = 0x80001000 + i * 0x100;
+    update.data.resize(512 + i);
+    for (size_t j = 0; j < update.data.size(); ++j)
+      update.data[j] = byte(j);
+    update.type = MemoryUpdate::Type::TextureMap;
+    frame.memoryUpdates.push_back(std::move(update));
+  }
+
+  return frame;
+}
+
+void ExpectFrame(const FifoFrameInfo& frame, u32 index)
+{
+  const FifoFrameInfo expected = MakeFrame(index);
+  EXPECT_EQ(expected.fifoData, frame.fifoData);
+  EXPECT_EQ(expected.fifoStart, frame.fifoStart);
+  EXPECT_EQ(expected.fifoEnd, frame.fifoEnd);
+  ASSERT_EQ(expected.memoryUpdates.size(), frame.memoryUpdates.size());
+  for (size_t i = 0; i < expected.memoryUpdates.size(); ++i)
+  {
+    EXPECT_EQ(expected.memoryUpdates[i].fifoPosition, frame.memoryUpdates[i].fifoPosition);
+    EXPECT_EQ(expected.memoryUpdates[i].address, frame.memoryUpdates[i].address);
+    EXPECT_EQ(expected.memoryUpdates[i].data, frame.memoryUpdates[i].data);
+    EXPECT_EQ(expected.memoryUpdates[i].type, frame.memoryUpdates[i].type);
+  }
+}
+
+u8 ReadCompression(File::IOFile& file, u32 frame)
+{
+  u8 compression = 0xff;
+  file.Seek(FRAME_LIST_OFFSET + frame * FRAME_INFO_SIZE + COMPRESSION_OFFSET,
+            File::SeekOrigin::Begin);
+  file.ReadBytes(&compression, sizeof(compression));
+  return compression;
+}
+}  // namespace
+
+class FifoDataFileTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Config::Init();
+    m_dir = File::CreateTempDir();
+    ASSERT_FALSE(m_dir.empty());
+    m_path = m_dir + "/test.dff";
+  }
+
+  void TearDown() override
+  {
+    File::DeleteDirRecursively(m_dir);
+    Config::Shutdown();
+  }
+
+  void Save(bool compress)
+  {
+    Config::SetCurrent(Config::MAIN_FIFOPLAYER_COMPRESS_FRAMES, compress);
+
+    FifoDataFile file;
+    for (u32 i = 0; i < FRAME_COUNT; ++i)
+      file.AddFrame(MakeFrame(i));
+    ASSERT_TRUE(file.Save(m_path));
+  }
+
+  std::string m_dir;
+  std::string m_path;
+};
+
+TEST_F(FifoDataFileTest, RoundTrip)
+{
+  Save(false);
+
+  {
+    File::IOFile file(m_path, "rb");
+    for (u32 i = 0; i < FRAME_COUNT; ++i)
+      EXPECT_EQ(0, ReadCompression(file, i)) << "frame " << i;
+  }
+
+  const std::unique_ptr<FifoDataFile> loaded = FifoDataFile::Load(m_path, false);
+  ASSERT_TRUE(loaded);
+  ASSERT_EQ(FRAME_COUNT, loaded->GetFrameCount());
+  for (u32 i = 0; i < FRAME_COUNT; ++i)
+    ExpectFrame(*loaded->GetFrame(i), i);
+}
+
+TEST_F(FifoDataFileTest, CompressedRoundTrip)
+{
+  Save(true);
+
+  {
+    File::IOFile file(m_path, "rb");
+    for (u32 i = 0; i < FRAME_COUNT; ++i)
+      EXPECT_EQ(i == RANDOM_FRAME ? 0 : 1, ReadCompression(file, i)) << "frame " << i;
+  }
+
+  const std::unique_ptr<FifoDataFile> loaded = FifoDataFile::Load(m_path, false);
+  ASSERT_TRUE(loaded);
+  ASSERT_EQ(FRAME_COUNT, loaded->GetFrameCount());
+
+  // Out of order, to not just get frames from the cache
+  for (u32 i : {4, 0, 2, 3, 1, 4})
+    ExpectFrame(*loaded->GetFrame(i), i);
+}
+
+TEST_F(FifoDataFileTest, WrongUncompressedSize)
+{
+  Save(true);
+
+  {
+    // Claim that the first frame decompresses to more than it does.
+    File::IOFile file(m_path, "r+b");
+    u32 size = 0;
+    file.Seek(FRAME_LIST_OFFSET + UNCOMPRESSED_SIZE_OFFSET, File::SeekOrigin::Begin);
+    file.ReadBytes(&size, sizeof(size));
+    size += 1000;
+    file.Seek(FRAME_LIST_OFFSET + UNCOMPRESSED_SIZE_OFFSET, File::SeekOrigin::Begin);
+    file.WriteBytes(&size, sizeof(size));
+  }
+
+  const std::unique_ptr<FifoDataFile> loaded = FifoDataFile::Load(m_path, false);
+  ASSERT_TRUE(loaded);
+
+  // A frame that can't be read is empty, and doesn't keep the others from being read.
+  const auto frame = loaded->GetFrame(0);
+  EXPECT_TRUE(frame->fifoData.empty());
+  EXPECT_TRUE(frame->memoryUpdates.empty());
+  ExpectFrame(*loaded->GetFrame(1), 1);
+}
+
+TEST_F(FifoDataFileTest, HugeUncompressedSize)
+{
+  Save(true);
+
+  {
+    File::IOFile file(m_path, "r+b");
+    const u32 size = 0xffffffff;
+    file.Seek(FRAME_LIST_OFFSET + FRAME_INFO_SIZE + UNCOMPRESSED_SIZE_OFFSET,
+              File::SeekOrigin::Begin);
+    file.WriteBytes(&size, sizeof(size));
+  }
+
+  // The file is rejected before anything is allocated for the frame.
+  std::unique_ptr<FifoDataFile> loaded;
+  EXPECT_NONFATAL_FAILURE(loaded = FifoDataFile::Load(m_path, false), "");
+  EXPECT_FALSE(loaded);
+}
@@ -0,0 +1,191 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Core/MovieInputLog.h"
+
+using Movie::InputLog;
+using Movie::InputLogFile;
+
+namespace
+{
+std::vector<u8> RandomInput(std::mt19937& rng, size_t size)
+{
+  std::vector<u8> input(size);
+  for (u8& byte : input)
+  {
+    // Mostly repeated bytes like real pad input, so that some chunks get compressed
+    byte = rng() % 4 == 0 ? static_cast<u8>(rng()) : 0x80;
+  }
+  return input;
+}
+
+// Records input in pieces of varying size, like a mix of GC controller and Wii Remote input
+InputLog RecordInput(const std::vector<u8>& input)
+{
+  InputLog log;
+  std::mt19937 rng(0);
+  u64 offset = 0;
+  u64 frame = 0;
+  while (offset < input.size())
+  {
+    const size_t size = std::min<size_t>(1 + rng() % 23, input.size() - offset);
+    log.Write(offset, input.data() + offset, size, frame++);
+    offset += size;
+  }
+  return log;
+}
+
+std::vector<u8> ReadAll(const InputLog& log)
+{
+  std::vector<u8> data(log.GetSize());
+  EXPECT_TRUE(log.Read(0, data.data(), data.size()));
+  return data;
+}
+}  // namespace
+
+TEST(MovieInputLog, ReadsAcrossChunks)
+{
+  std::mt19937 rng(1);
+  const std::vector<u8> input = RandomInput(rng, InputLog::CHUNK_SIZE * 3 + 123);
+  const InputLog log = RecordInput(input);
+
+  EXPECT_EQ(input.size(), log.GetSize());
+  EXPECT_EQ(input, ReadAll(log));
+
+  u8 bytes[16];
+  const u64 offset = InputLog::CHUNK_SIZE * 2 - 5;
+  ASSERT_TRUE(log.Read(offset, bytes, sizeof(bytes)));
+  EXPECT_TRUE(std::equal(bytes, bytes + sizeof(bytes), input.begin() + offset));
+
+  EXPECT_TRUE(log.Read(input.size(), bytes, 0));
+  EXPECT_FALSE(log.Read(input.size() - 8, bytes, sizeof(bytes)));
+}
+
+TEST(MovieInputLog, RecordingOverExistingInputTruncates)
+{
+  std::mt19937 rng(2);
+  const std::vector<u8> input = RandomInput(rng, InputLog::CHUNK_SIZE * 2 + 40);
+  InputLog log = RecordInput(input);
+
+  // Like loading a savestate in read-write mode and recording from there
+  const u64 offset = InputLog::CHUNK_SIZE - 3;
+  const std::vector<u8> new_input = RandomInput(rng, 8);
+  log.Truncate(offset);
+  log.Write(offset, new_input.data(), new_input.size(), 0);
+
+  std::vector<u8> expected(input.begin(), input.begin() + offset);
+  expected.insert(expected.end(), new_input.begin(), new_input.end());
+  EXPECT_EQ(expected, ReadAll(log));
+}
+
+TEST(MovieInputLog, FileRoundTrip)
+{
+  std::mt19937 rng(3);
+  const std::vector<u8> input = RandomInput(rng, InputLog::CHUNK_SIZE * 4 + 1000);
+  const InputLog log = RecordInput(input);
+
+  for (const bool chunked : {false, true})
+  {
+    File::IOFile file(std::tmpfile());
+    ASSERT_TRUE(file.WriteBytes("header", 6));
+    ASSERT_TRUE(chunked ? log.WriteChunked(file) : log.WriteFlat(file));
+    ASSERT_TRUE(file.Seek(6, File::SeekOrigin::Begin));
+
+    InputLogFile input_file;
+    ASSERT_TRUE(input_file.Open(&file, chunked));
+    EXPECT_EQ(input.size(), input_file.GetSize());
+    EXPECT_EQ(std::nullopt, log.FindMismatch(input_file, log.GetSize()));
+
+    InputLog loaded;
+    ASSERT_TRUE(loaded.CopyFrom(input_file, input_file.GetSize()));
+    EXPECT_EQ(input, ReadAll(loaded));
+  }
+}
+
+TEST(MovieInputLog, FindsFirstMismatch)
+{
+  std::mt19937 rng(4);
+  const std::vector<u8> input = RandomInput(rng, InputLog::CHUNK_SIZE * 3 + 77);
+  const InputLog saved_log = RecordInput(input);
+
+  for (const bool chunked : {false, true})
+  {
+    File::IOFile file(std::tmpfile());
+    ASSERT_TRUE(chunked ? saved_log.WriteChunked(file) : saved_log.WriteFlat(file));
+    ASSERT_TRUE(file.Seek(0, File::SeekOrigin::Begin));
+    InputLogFile input_file;
+    ASSERT_TRUE(input_file.Open(&file, chunked));
+
+    InputLog log = RecordInput(input);
+    const u64 offset = InputLog::CHUNK_SIZE * 2 + 9;
+    const u8 changed = input[offset] ^ 1;
+    log.Write(offset, &changed, 1, 0);
+
+    EXPECT_EQ(std::nullopt, log.FindMismatch(input_file, offset));
+    EXPECT_EQ(offset, log.FindMismatch(input_file, log.GetSize()));
+
+    // Copying from the file repairs the log
+    ASSERT_TRUE(log.CopyFrom(input_file, log.GetSize()));
+    EXPECT_EQ(input, ReadAll(log));
+  }
+}
+
+TEST(MovieInputLog, RejectsCorruptedChunks)
+{
+  std::mt19937 rng(5);
+  std::vector<u8> input(InputLog::CHUNK_SIZE * 2);
+  for (u8& byte : input)
+    byte = static_cast<u8>(rng());
+  const InputLog log = RecordInput(input);
+
+  File::IOFile file(std::tmpfile());
+  ASSERT_TRUE(log.WriteChunked(file));
+
+  // Random input doesn't compress, so the first chunk is stored as it is after the header
+  const u8 corrupted = input[100] ^ 0xFF;
+  ASSERT_TRUE(file.Seek(24 + 100, File::SeekOrigin::Begin));
+  ASSERT_TRUE(file.WriteBytes(&corrupted, 1));
+
+  ASSERT_TRUE(file.Seek(0, File::SeekOrigin::Begin));
+  InputLogFile input_file;
+  ASSERT_TRUE(input_file.Open(&file, true));
+  EXPECT_EQ(nullptr, input_file.ReadChunk(0));
+  EXPECT_NE(nullptr, input_file.ReadChunk(1));
+}
+
+TEST(MovieInputLog, RejectsBadChunkCount)
+{
+  std::mt19937 rng(6);
+  const InputLog log = RecordInput(RandomInput(rng, InputLog::CHUNK_SIZE * 2 + 10));
+
+  // A count that doesn't match the input size, and one that doesn't fit in the file
+  for (const u32 chunk_count : {2u, 4u, 0xFFFFFFFFu})
+  {
+    File::IOFile file(std::tmpfile());
+    ASSERT_TRUE(log.WriteChunked(file));
+    ASSERT_TRUE(file.Seek(4, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.WriteArray(&chunk_count, 1));
+
+    ASSERT_TRUE(file.Seek(0, File::SeekOrigin::Begin));
+    InputLogFile input_file;
+    EXPECT_FALSE(input_file.Open(&file, true)) << chunk_count;
+  }
+
+  // An index that would extend past the end of the file
+  File::IOFile file(std::tmpfile());
+  ASSERT_TRUE(log.WriteChunked(file));
+  ASSERT_TRUE(file.Resize(file.GetSize() - 1));
+  ASSERT_TRUE(file.Seek(0, File::SeekOrigin::Begin));
+  InputLogFile input_file;
+  EXPECT_FALSE(input_file.Open(&file, true));
+}
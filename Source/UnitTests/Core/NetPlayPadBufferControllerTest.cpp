@@ -0,0 +1,111 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayPadBufferController.h"
+
+using NetPlay::PadBufferController;
+
+namespace
+{
+constexpr double FRAME_TIME_MS = 16.0;
+constexpr NetPlay::PlayerId LOCAL_PID = 1;
+constexpr NetPlay::PlayerId REMOTE_PID = 2;
+
+// Enough samples of the same ping for the smoothed deviation to settle near 0.
+void AddSteadyPings(PadBufferController* controller, u32 local_ping, u32 remote_ping)
+{
+  for (int i = 0; i < 40; ++i)
+  {
+    controller->AddPingSample(LOCAL_PID, true, local_ping);
+    controller->AddPingSample(REMOTE_PID, false, remote_ping);
+  }
+}
+}  // namespace
+
+TEST(NetPlayPadBufferController, KeepsInitialSizeWithoutPings)
+{
+  PadBufferController controller;
+  controller.Reset(5);
+  EXPECT_EQ(controller.Update(FRAME_TIME_MS, false), 5u);
+
+  controller.AddPingSample(LOCAL_PID, true, 40);
+  EXPECT_EQ(controller.Update(FRAME_TIME_MS, false), 5u);
+}
+
+TEST(NetPlayPadBufferController, GrowsImmediately)
+{
+  PadBufferController controller;
+  controller.Reset(1);
+
+  // A few samples are needed before the estimate is used.
+  for (u32 i = 0; i + 1 < PadBufferController::MIN_SAMPLES; ++i)
+  {
+    controller.AddPingSample(LOCAL_PID, true, 40);
+    controller.AddPingSample(REMOTE_PID, false, 40);
+  }
+  EXPECT_EQ(controller.Update(FRAME_TIME_MS, false), 1u);
+
+  // A steady 40 ms is 2.5 frames.
+  controller.AddPingSample(LOCAL_PID, true, 40);
+  controller.AddPingSample(REMOTE_PID, false, 40);
+  EXPECT_EQ(controller.Update(FRAME_TIME_MS, false), 4u);
+
+  // A late ping moves the remote estimate to 47.5 ms with a deviation of 15 ms:
+  // (40 + 47.5) / 2 ms + 4 * 15 ms is 6.5 frames.
+  controller.AddPingSample(REMOTE_PID, false, 100);
+  EXPECT_EQ(controller.Update(FRAME_TIME_MS, false), 8u);
+}
+
+TEST(NetPlayPadBufferController, ShrinksAfterDelay)
+{
+  PadBufferController controller;
+  AddSteadyPings(&controller, 40, 40);
+  controller.Reset(10);
+
+  for (u32 i = 0; i + 1 < PadBufferController::SHRINK_DELAY_FRAMES; ++i)
+    ASSERT_EQ(controller.Update(FRAME_TIME_MS, false), 10u);
+  EXPECT_EQ(controller.Update(FRAME_TIME_MS, false), 9u);
+
+  for (u32 i = 0; i < PadBufferController::SHRINK_DELAY_FRAMES * 10; ++i)
+    controller.Update(FRAME_TIME_MS, false);
+  EXPECT_EQ(controller.GetStats().buffer, 4u);
+}
+
+TEST(NetPlayPadBufferController, StallsAddMargin)
+{
+  PadBufferController controller;
+  AddSteadyPings(&controller, 40, 40);
+  controller.Reset(4);
+
+  EXPECT_EQ(controller.Update(FRAME_TIME_MS, true), 5u);
+  EXPECT_EQ(controller.GetStats().margin, 1u);
+
+  for (int i = 0; i < 10; ++i)
+    controller.Update(FRAME_TIME_MS, true);
+  EXPECT_EQ(controller.GetStats().margin, PadBufferController::MAX_MARGIN);
+  EXPECT_EQ(controller.GetStats().buffer, 4u + PadBufferController::MAX_MARGIN);
+
+  for (u32 i = 0; i < PadBufferController::MARGIN_DECAY_FRAMES; ++i)
+    controller.Update(FRAME_TIME_MS, false);
+  EXPECT_EQ(controller.GetStats().margin, PadBufferController::MAX_MARGIN - 1);
+}
+
+TEST(NetPlayPadBufferController, UsesSlowestPlayer)
+{
+  PadBufferController controller;
+  AddSteadyPings(&controller, 20, 20);
+  for (int i = 0; i < 40; ++i)
+    controller.AddPingSample(3, false, 132);
+  controller.Reset(1);
+
+  // (20 + 132) / 2 ms is 4.75 frames.
+  EXPECT_EQ(controller.Update(FRAME_TIME_MS, false), 6u);
+  EXPECT_EQ(controller.GetStats().worst_rtt, 132u);
+
+  controller.RemovePlayer(3);
+  controller.Reset(1);
+  EXPECT_EQ(controller.Update(FRAME_TIME_MS, false), 3u);
+}
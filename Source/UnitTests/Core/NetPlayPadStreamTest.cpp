@@ -0,0 +1,182 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayPadStream.h"
+#include "InputCommon/GCPadStatus.h"
+
+using NetPlay::PadStreamDecoder;
+using NetPlay::PadStreamEncoder;
+
+namespace
+{
+GCPadStatus MakeStatus(u32 entry)
+{
+  GCPadStatus status;
+  status.button = static_cast<u16>(entry);
+  // Only change some of the fields, so that not every entry is written in full.
+  if (entry % 3 == 0)
+    status.stickX = static_cast<u8>(entry * 7);
+  if (entry % 5 == 0)
+    status.triggerLeft = static_cast<u8>(entry);
+  status.isConnected = entry % 11 != 0;
+  return status;
+}
+
+bool operator==(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return a.button == b.button && a.stickX == b.stickX && a.stickY == b.stickY &&
+         a.substickX == b.substickX && a.substickY == b.substickY &&
+         a.triggerLeft == b.triggerLeft && a.triggerRight == b.triggerRight &&
+         a.analogA == b.analogA && a.analogB == b.analogB && a.isConnected == b.isConnected;
+}
+
+void PushEntries(PadStreamEncoder* encoder, u32 count)
+{
+  for (u32 i = 0; i < count; ++i)
+    encoder->Push(MakeStatus(encoder->GetNextEntry()));
+}
+
+void ExpectEntries(const std::vector<GCPadStatus>& entries, u32 first_entry)
+{
+  for (u32 i = 0; i < entries.size(); ++i)
+    EXPECT_TRUE(entries[i] == MakeStatus(first_entry + i)) << "entry " << first_entry + i;
+}
+}  // namespace
+
+TEST(NetPlayPadStream, RoundTrip)
+{
+  PadStreamEncoder encoder;
+  PadStreamDecoder decoder;
+  std::vector<GCPadStatus> entries;
+
+  for (u32 batch = 0; batch < 20; ++batch)
+  {
+    PushEntries(&encoder, 3);
+
+    sf::Packet packet;
+    encoder.WriteRecent(packet);
+    bool entries_missing = true;
+    ASSERT_TRUE(decoder.Read(packet, &entries, &entries_missing));
+    EXPECT_FALSE(entries_missing);
+    EXPECT_TRUE(packet.endOfPacket());
+  }
+
+  ASSERT_EQ(60u, entries.size());
+  ExpectEntries(entries, 0);
+  EXPECT_EQ(60u, decoder.GetNextEntry());
+}
+
+TEST(NetPlayPadStream, RedundancyCoversLostBatches)
+{
+  PadStreamEncoder encoder;
+  PadStreamDecoder decoder;
+  std::vector<GCPadStatus> entries;
+  bool entries_missing = false;
+
+  // A batch repeats the last REDUNDANT_ENTRIES entries, so losing batches that add up to fewer
+  // entries than that doesn't leave a gap.
+  PushEntries(&encoder, 2);
+  sf::Packet lost;
+  encoder.WriteRecent(lost);
+  PushEntries(&encoder, 2);
+
+  sf::Packet packet;
+  encoder.WriteRecent(packet);
+  ASSERT_TRUE(decoder.Read(packet, &entries, &entries_missing));
+  EXPECT_FALSE(entries_missing);
+  ASSERT_EQ(4u, entries.size());
+  ExpectEntries(entries, 0);
+
+  // Reading the lost batch late doesn't add anything.
+  entries.clear();
+  ASSERT_TRUE(decoder.Read(lost, &entries, &entries_missing));
+  EXPECT_FALSE(entries_missing);
+  EXPECT_TRUE(entries.empty());
+}
+
+TEST(NetPlayPadStream, GapIsDetectedAndFilled)
+{
+  PadStreamEncoder encoder;
+  PadStreamDecoder decoder;
+  std::vector<GCPadStatus> entries;
+  bool entries_missing = false;
+
+  PushEntries(&encoder, 4);
+  sf::Packet first;
+  encoder.WriteRecent(first);
+  ASSERT_TRUE(decoder.Read(first, &entries, &entries_missing));
+  ASSERT_EQ(4u, entries.size());
+
+  // More entries than a batch repeats are lost.
+  PushEntries(&encoder, PadStreamEncoder::REDUNDANT_ENTRIES + 2);
+
+  sf::Packet packet;
+  encoder.WriteRecent(packet);
+  entries.clear();
+  ASSERT_TRUE(decoder.Read(packet, &entries, &entries_missing));
+  EXPECT_TRUE(entries_missing);
+  EXPECT_TRUE(entries.empty());
+  EXPECT_EQ(4u, decoder.GetNextEntry());
+  EXPECT_TRUE(decoder.CanCatchUp());
+
+  // The answer to the request starts at the first missing entry.
+  sf::Packet answer;
+  EXPECT_TRUE(encoder.Write(answer, decoder.GetNextEntry()));
+  ASSERT_TRUE(decoder.Read(answer, &entries, &entries_missing));
+  EXPECT_FALSE(entries_missing);
+  ASSERT_EQ(PadStreamEncoder::REDUNDANT_ENTRIES + 2, entries.size());
+  ExpectEntries(entries, 4);
+  EXPECT_EQ(encoder.GetNextEntry(), decoder.GetNextEntry());
+}
+
+TEST(NetPlayPadStream, HistoryOverflow)
+{
+  PadStreamEncoder encoder;
+  PadStreamDecoder decoder;
+  std::vector<GCPadStatus> entries;
+  bool entries_missing = false;
+
+  PushEntries(&encoder, PadStreamEncoder::HISTORY_SIZE + 10);
+
+  // Entries that have left the history can't be written anymore, so the answer starts at the
+  // oldest one left.
+  sf::Packet answer;
+  EXPECT_FALSE(encoder.Write(answer, 0));
+  ASSERT_TRUE(decoder.Read(answer, &entries, &entries_missing));
+  EXPECT_TRUE(entries_missing);
+  EXPECT_TRUE(entries.empty());
+  EXPECT_FALSE(decoder.CanCatchUp());
+
+  // Entries that are still there can be, all the way to the newest.
+  sf::Packet packet;
+  EXPECT_TRUE(encoder.Write(packet, 10));
+  decoder.Reset(10);
+  ASSERT_TRUE(decoder.Read(packet, &entries, &entries_missing));
+  EXPECT_FALSE(entries_missing);
+  ASSERT_EQ(PadStreamEncoder::HISTORY_SIZE, entries.size());
+  ExpectEntries(entries, 10);
+  EXPECT_TRUE(decoder.CanCatchUp());
+}
+
+TEST(NetPlayPadStream, MalformedPacket)
+{
+  PadStreamEncoder encoder;
+  PadStreamDecoder decoder;
+  std::vector<GCPadStatus> entries;
+  bool entries_missing = false;
+
+  PushEntries(&encoder, 4);
+  sf::Packet packet;
+  encoder.WriteRecent(packet);
+
+  // Cut off the last entry.
+  sf::Packet truncated;
+  truncated.append(packet.getData(), packet.getDataSize() - 1);
+  EXPECT_FALSE(decoder.Read(truncated, &entries, &entries_missing));
+}
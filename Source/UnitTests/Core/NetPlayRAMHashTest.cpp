@@ -0,0 +1,144 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayRAMHash.h"
+
+using NetPlay::RAMHashDigest;
+using NetPlay::RAMHashTree;
+
+namespace
+{
+constexpr size_t BLOCK_SIZE = RAMHashTree::BLOCK_SIZE;
+constexpr u32 HASH_SLICES = RAMHashTree::HASH_SLICES;
+
+// Two regions, the second of which ends in the middle of a page.
+struct Memory
+{
+  Memory() : first(BLOCK_SIZE * 20), second(BLOCK_SIZE * 3 + 100)
+  {
+    for (size_t i = 0; i < first.size(); ++i)
+      first[i] = static_cast<u8>(i * 7);
+    for (size_t i = 0; i < second.size(); ++i)
+      second[i] = static_cast<u8>(i * 13);
+  }
+
+  std::vector<std::span<u8>> GetRegions() { return {first, second}; }
+
+  std::vector<u8> first;
+  std::vector<u8> second;
+};
+}  // namespace
+
+TEST(NetPlayRAMHash, SameMemorySameDigest)
+{
+  Memory a, b;
+  RAMHashTree tree_a, tree_b;
+
+  for (u32 frame = 0; frame < HASH_SLICES * 2; ++frame)
+  {
+    const RAMHashDigest& digest_a = tree_a.Update(a.GetRegions(), frame);
+    const RAMHashDigest& digest_b = tree_b.Update(b.GetRegions(), frame);
+    EXPECT_EQ(digest_a.root, digest_b.root);
+    EXPECT_EQ(digest_a.region_roots, digest_b.region_roots);
+    ASSERT_EQ(2u, digest_a.region_roots.size());
+  }
+}
+
+TEST(NetPlayRAMHash, ChangeShowsUpWithinHashSlices)
+{
+  Memory a, b;
+  RAMHashTree tree_a, tree_b;
+
+  tree_a.Update(a.GetRegions(), 0);
+  tree_b.Update(b.GetRegions(), 0);
+
+  // Change the last byte of the partial page at the end of the second region.
+  b.second.back() ^= 1;
+
+  std::optional<u32> differing_frame;
+  for (u32 frame = 1; frame <= HASH_SLICES; ++frame)
+  {
+    const RAMHashDigest& digest_a = tree_a.Update(a.GetRegions(), frame);
+    const RAMHashDigest& digest_b = tree_b.Update(b.GetRegions(), frame);
+    EXPECT_EQ(digest_a.region_roots[0], digest_b.region_roots[0]);
+    if (digest_a.root != digest_b.root)
+    {
+      EXPECT_NE(digest_a.region_roots[1], digest_b.region_roots[1]);
+      differing_frame = frame;
+      break;
+    }
+  }
+  ASSERT_TRUE(differing_frame);
+
+  // Only the block with the change differs.
+  const std::optional<std::vector<u64>> blocks_a = tree_a.GetBlockHashes(*differing_frame, 1);
+  const std::optional<std::vector<u64>> blocks_b = tree_b.GetBlockHashes(*differing_frame, 1);
+  ASSERT_TRUE(blocks_a);
+  ASSERT_TRUE(blocks_b);
+  ASSERT_EQ(4u, blocks_a->size());
+  ASSERT_EQ(4u, blocks_b->size());
+  for (size_t i = 0; i < 3; ++i)
+    EXPECT_EQ((*blocks_a)[i], (*blocks_b)[i]) << "block " << i;
+  EXPECT_NE((*blocks_a)[3], (*blocks_b)[3]);
+
+  // Once the block is hashed again, the memory matches again.
+  b.second.back() ^= 1;
+  u32 frame = *differing_frame + 1;
+  for (; frame < *differing_frame + HASH_SLICES; ++frame)
+  {
+    tree_a.Update(a.GetRegions(), frame);
+    tree_b.Update(b.GetRegions(), frame);
+  }
+  EXPECT_EQ(tree_a.Update(a.GetRegions(), frame).root, tree_b.Update(b.GetRegions(), frame).root);
+}
+
+TEST(NetPlayRAMHash, History)
+{
+  Memory memory;
+  RAMHashTree tree;
+
+  for (u32 frame = 0; frame <= RAMHashTree::HISTORY_SIZE; ++frame)
+    tree.Update(memory.GetRegions(), frame);
+
+  EXPECT_FALSE(tree.GetBlockHashes(0, 0));
+  EXPECT_FALSE(tree.GetBlockHashes(1, 2));
+  const std::optional<std::vector<u64>> blocks = tree.GetBlockHashes(1, 0);
+  ASSERT_TRUE(blocks);
+  EXPECT_EQ(20u, blocks->size());
+
+  // Block indices don't carry over to another layout.
+  memory.second.resize(BLOCK_SIZE);
+  tree.Update(memory.GetRegions(), RAMHashTree::HISTORY_SIZE + 1);
+  EXPECT_FALSE(tree.GetBlockHashes(RAMHashTree::HISTORY_SIZE, 0));
+  EXPECT_TRUE(tree.GetBlockHashes(RAMHashTree::HISTORY_SIZE + 1, 0));
+}
+
+TEST(NetPlayRAMHash, CompareDigests)
+{
+  const RAMHashDigest a{1, {10, 20, 30}};
+  const RAMHashDigest b{2, {10, 21, 30}};
+  const RAMHashDigest c{3, {10, 20, 31}};
+
+  EXPECT_FALSE(NetPlay::CompareRAMHashDigests(std::vector{a, a, a}));
+
+  // The player that differs from everyone else is blamed.
+  const std::vector<RAMHashDigest> outlier{a, a, b, a};
+  const std::optional<NetPlay::RAMHashMismatch> mismatch = NetPlay::CompareRAMHashDigests(outlier);
+  ASSERT_TRUE(mismatch);
+  EXPECT_EQ(2u, mismatch->blamed);
+  EXPECT_EQ(1, mismatch->region);
+
+  // Without an outlier, the first player is compared to the first one that differs.
+  const std::vector<RAMHashDigest> split{c, c, a, a};
+  const std::optional<NetPlay::RAMHashMismatch> first = NetPlay::CompareRAMHashDigests(split);
+  ASSERT_TRUE(first);
+  EXPECT_EQ(0u, first->blamed);
+  EXPECT_EQ(2, first->region);
+}
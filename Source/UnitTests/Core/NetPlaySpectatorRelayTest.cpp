@@ -0,0 +1,124 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/SFMLHelper.h"
+#include "Core/NetPlayProto.h"
+#include "Core/NetPlaySpectatorRelay.h"
+
+using NetPlay::MessageID;
+using NetPlay::SpectatorRelay;
+
+namespace
+{
+constexpr u32 GAME = 1234;
+
+sf::Packet MakeBatch(u32 value)
+{
+  sf::Packet packet;
+  packet << MessageID::PadDataBatch;
+  packet << value;
+  return packet;
+}
+
+void AddBatches(SpectatorRelay* relay, u32 first, u32 count)
+{
+  for (u32 value = first; value < first + count; ++value)
+    relay->Add(MakeBatch(value));
+}
+
+// Returns the values of the batches in the messages, checking their layout on the way.
+std::vector<u32> ReadMessages(std::vector<sf::Packet> messages)
+{
+  std::vector<u32> values;
+  for (sf::Packet& message : messages)
+  {
+    MessageID mid;
+    u8 count = 0;
+    message >> mid >> count;
+    EXPECT_EQ(mid, MessageID::SpectatorPadData);
+    EXPECT_LE(count, SpectatorRelay::MAX_BATCHES_PER_MESSAGE);
+
+    for (u8 i = 0; i < count; ++i)
+    {
+      u32 value = 0;
+      message >> value;
+      values.push_back(value);
+    }
+    EXPECT_TRUE(message.endOfPacket());
+  }
+  return values;
+}
+
+std::vector<u32> Range(u32 first, u32 count)
+{
+  std::vector<u32> values;
+  for (u32 value = first; value < first + count; ++value)
+    values.push_back(value);
+  return values;
+}
+}  // namespace
+
+TEST(NetPlaySpectatorRelay, WaitsForIntervalOrFullMessage)
+{
+  SpectatorRelay relay;
+  relay.SetGame(GAME);
+
+  EXPECT_TRUE(relay.TakeMessages().empty());
+
+  AddBatches(&relay, 0, 3);
+  EXPECT_TRUE(relay.TakeMessages().empty());
+  EXPECT_LE(relay.GetTimeUntilNextMessage(), SpectatorRelay::BATCH_INTERVAL);
+
+  AddBatches(&relay, 3, SpectatorRelay::MAX_BATCHES_PER_MESSAGE - 3);
+  EXPECT_EQ(ReadMessages(relay.TakeMessages()), Range(0, SpectatorRelay::MAX_BATCHES_PER_MESSAGE));
+
+  EXPECT_TRUE(relay.TakeMessages().empty());
+}
+
+TEST(NetPlaySpectatorRelay, SplitsLargeBacklog)
+{
+  SpectatorRelay relay;
+  relay.SetGame(GAME);
+
+  const u32 count = SpectatorRelay::MAX_BATCHES_PER_MESSAGE * 2 + 5;
+  AddBatches(&relay, 0, count);
+
+  const std::vector<sf::Packet> messages = relay.TakeMessages();
+  EXPECT_EQ(messages.size(), 3u);
+  EXPECT_EQ(ReadMessages(messages), Range(0, count));
+}
+
+TEST(NetPlaySpectatorRelay, LogKeepsNewestBatches)
+{
+  SpectatorRelay relay;
+  relay.SetGame(GAME);
+
+  const u32 count = SpectatorRelay::LOG_SIZE + 100;
+  AddBatches(&relay, 0, count);
+
+  EXPECT_EQ(ReadMessages(relay.GetLogMessages()), Range(100, SpectatorRelay::LOG_SIZE));
+
+  // Sending what's pending doesn't drop it from the log.
+  relay.TakeMessages();
+  EXPECT_EQ(ReadMessages(relay.GetLogMessages()), Range(100, SpectatorRelay::LOG_SIZE));
+}
+
+TEST(NetPlaySpectatorRelay, NewGameClearsLog)
+{
+  SpectatorRelay relay;
+  relay.SetGame(GAME);
+  AddBatches(&relay, 0, 10);
+
+  relay.SetGame(GAME);
+  EXPECT_EQ(ReadMessages(relay.GetLogMessages()), Range(0, 10));
+
+  relay.SetGame(GAME + 1);
+  EXPECT_TRUE(relay.GetLogMessages().empty());
+  EXPECT_TRUE(relay.TakeMessages().empty());
+}
@@ -0,0 +1,292 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+
+namespace
+{
+JitBlock& AddBlock(std::deque<JitBlock>& blocks, u32 physical_address, u32 instruction_count,
+                   CPUEmuFeatureFlags feature_flags = FEATURE_FLAG_MSR_IR)
+{
+  JitBlock& block = blocks.emplace_back();
+  block.effectiveAddress = physical_address | 0x80000000;
+  block.physicalAddress = physical_address;
+  block.feature_flags = feature_flags;
+  for (u32 i = 0; i < instruction_count; ++i)
+    block.physical_addresses.push_back(physical_address + i * 4);
+  return block;
+}
+
+std::vector<JitBlock*> FindOverlapping(const JitBlockPhysicalIndex& index, u32 address, u32 length)
+{
+  std::vector<JitBlock*> blocks;
+  index.FindOverlapping(address, length, blocks);
+  std::sort(blocks.begin(), blocks.end());
+  return blocks;
+}
+
+// One line of an invalidation trace. Blocks are compiled with "b <physical address> <instruction
+// count>" and ranges invalidated with "i <address> <length>", all numbers in hex.
+struct TraceEntry
+{
+  bool invalidate;
+  u32 address;
+  u32 length;
+};
+
+std::vector<TraceEntry> LoadTrace(const char* path)
+{
+  std::vector<TraceEntry> trace;
+  std::ifstream file(path);
+  std::string type;
+  u32 address, length;
+  while (file >> type >> std::hex >> address >> length)
+    trace.push_back({type == "i", address, length});
+  return trace;
+}
+
+// Resembles a game streaming code into a few MiB of RAM: blocks get compiled all over the place and
+// every so often a DMA or an icbi invalidates some of them.
+std::vector<TraceEntry> GenerateTrace(size_t size)
+{
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<u32> address_distribution(0, 0x3FFFFF);
+  std::uniform_int_distribution<u32> instruction_distribution(1, 64);
+  std::uniform_int_distribution<int> op_distribution(0, 15);
+
+  std::vector<TraceEntry> trace;
+  trace.reserve(size);
+  while (trace.size() < size)
+  {
+    const u32 address = address_distribution(rng) & ~3u;
+    const int op = op_distribution(rng);
+    if (op == 0)
+      trace.push_back({true, address & ~0x1Fu, 0x8000});
+    else if (op < 4)
+      trace.push_back({true, address & ~0x1Fu, 0x20});
+    else
+      trace.push_back({false, address, instruction_distribution(rng)});
+  }
+  return trace;
+}
+}  // namespace
+
+TEST(JitBlockPhysicalIndex, FindEntry)
+{
+  std::deque<JitBlock> blocks;
+  JitBlockPhysicalIndex index;
+  JitBlock& a = AddBlock(blocks, 0x1000, 4);
+  JitBlock& b = AddBlock(blocks, 0x1004, 4);
+  JitBlock& c = AddBlock(blocks, 0x1000, 4, FEATURE_FLAG_MSR_DR);
+  index.AddEntry(a);
+  index.AddEntry(b);
+  index.AddEntry(c);
+
+  EXPECT_EQ(&a, index.FindEntry(0x1000, 0x80001000, FEATURE_FLAG_MSR_IR));
+  EXPECT_EQ(&b, index.FindEntry(0x1004, 0x80001004, FEATURE_FLAG_MSR_IR));
+  EXPECT_EQ(&c, index.FindEntry(0x1000, 0x80001000, FEATURE_FLAG_MSR_DR));
+  EXPECT_EQ(nullptr, index.FindEntry(0x1000, 0x1000, FEATURE_FLAG_MSR_IR));
+  EXPECT_EQ(nullptr, index.FindEntry(0x2000, 0x80002000, FEATURE_FLAG_MSR_IR));
+
+  index.RemoveEntry(a);
+  EXPECT_EQ(nullptr, index.FindEntry(0x1000, 0x80001000, FEATURE_FLAG_MSR_IR));
+  EXPECT_EQ(&b, index.FindEntry(0x1004, 0x80001004, FEATURE_FLAG_MSR_IR));
+  EXPECT_EQ(&c, index.FindEntry(0x1000, 0x80001000, FEATURE_FLAG_MSR_DR));
+
+  index.Clear();
+  EXPECT_EQ(nullptr, index.FindEntry(0x1004, 0x80001004, FEATURE_FLAG_MSR_IR));
+}
+
+TEST(JitBlockPhysicalIndex, FindOverlapping)
+{
+  std::deque<JitBlock> blocks;
+  JitBlockPhysicalIndex index;
+  // Spans several ranges and a page boundary.
+  JitBlock& a = AddBlock(blocks, 0xF80, 0x80);
+  JitBlock& b = AddBlock(blocks, 0x1100, 2);
+  // Jumps over a range, like a block following a branch.
+  JitBlock& c = AddBlock(blocks, 0x2000, 1);
+  c.physical_addresses.push_back(0x2400);
+  // At the very end of the address space.
+  JitBlock& d = AddBlock(blocks, 0xFFFFFFF0, 4);
+  for (JitBlock& block : blocks)
+    index.AddRange(block);
+
+  using Blocks = std::vector<JitBlock*>;
+  auto sorted = [](Blocks result) {
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+  EXPECT_EQ(sorted({&a}), FindOverlapping(index, 0xF00, 0x100));
+  EXPECT_EQ(sorted({&a, &b}), FindOverlapping(index, 0x0, 0x2000));
+  EXPECT_EQ(sorted({&a, &b, &c}), FindOverlapping(index, 0x0, 0x10000));
+  EXPECT_EQ(Blocks{}, FindOverlapping(index, 0x1180, 0x80));
+  EXPECT_EQ(Blocks{}, FindOverlapping(index, 0x2100, 0x200));
+  EXPECT_EQ(sorted({&c}), FindOverlapping(index, 0x2400, 4));
+  EXPECT_EQ(sorted({&d}), FindOverlapping(index, 0xFFFFFF00, 0x100));
+  EXPECT_EQ(sorted({&d}), FindOverlapping(index, 0xFFFFFF00, 0x200));
+  EXPECT_EQ(sorted({&d}), FindOverlapping(index, 0xFFFFFFFC, 0xFFFFFFFF));
+  EXPECT_EQ(Blocks{}, FindOverlapping(index, 0x1108, 0));
+
+  index.RemoveRange(a);
+  EXPECT_EQ(sorted({&b}), FindOverlapping(index, 0x0, 0x2000));
+  index.RemoveRange(c);
+  EXPECT_EQ(Blocks{}, FindOverlapping(index, 0x2400, 4));
+}
+
+TEST(JitBlockPhysicalIndex, MatchesBruteForce)
+{
+  std::deque<JitBlock> blocks;
+  std::vector<JitBlock*> live;
+  JitBlockPhysicalIndex index;
+
+  for (const TraceEntry& entry : GenerateTrace(20000))
+  {
+    if (!entry.invalidate)
+    {
+      // Like the block cache, only compile blocks that don't exist yet.
+      if (index.FindEntry(entry.address, entry.address | 0x80000000, FEATURE_FLAG_MSR_IR))
+        continue;
+
+      JitBlock& block = AddBlock(blocks, entry.address, entry.length);
+      index.AddEntry(block);
+      index.AddRange(block);
+      live.push_back(&block);
+      continue;
+    }
+
+    std::vector<JitBlock*> expected;
+    for (JitBlock* block : live)
+    {
+      if (block->OverlapsPhysicalRange(entry.address, entry.length))
+        expected.push_back(block);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    const std::vector<JitBlock*> found = FindOverlapping(index, entry.address, entry.length);
+    ASSERT_EQ(expected, found);
+
+    for (JitBlock* block : found)
+    {
+      index.RemoveRange(*block);
+      index.RemoveEntry(*block);
+      std::erase(live, block);
+    }
+  }
+
+  for (JitBlock* block : live)
+  {
+    EXPECT_EQ(block, index.FindEntry(block->physicalAddress, block->effectiveAddress,
+                                     block->feature_flags));
+  }
+}
+
+// Microbenchmark comparing the index against the ordered maps it replaced, run with
+// --gtest_also_run_disabled_tests. A recorded trace can be passed in the JIT_CACHE_TRACE
+// environment variable.
+TEST(JitBlockPhysicalIndex, DISABLED_Benchmark)
+{
+  const char* trace_path = std::getenv("JIT_CACHE_TRACE");
+  const std::vector<TraceEntry> trace = trace_path ? LoadTrace(trace_path) : GenerateTrace(1000000);
+  ASSERT_FALSE(trace.empty());
+
+  std::vector<JitBlock*> scratch;
+
+  {
+    std::deque<JitBlock> blocks;
+    JitBlockPhysicalIndex index;
+    const auto start = std::chrono::steady_clock::now();
+    for (const TraceEntry& entry : trace)
+    {
+      if (!entry.invalidate)
+      {
+        JitBlock& block = AddBlock(blocks, entry.address, entry.length);
+        index.AddEntry(block);
+        index.AddRange(block);
+        continue;
+      }
+
+      index.FindOverlapping(entry.address, entry.length, scratch);
+      for (JitBlock* block : scratch)
+      {
+        index.RemoveRange(*block);
+        index.RemoveEntry(*block);
+      }
+      scratch.clear();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    fmt::print("Physical index: {} ns per operation\n",
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() /
+                   trace.size());
+  }
+
+  {
+    std::deque<JitBlock> blocks;
+    std::multimap<u32, JitBlock*> entries;
+    std::map<u32, std::vector<JitBlock*>> ranges;
+    const auto start = std::chrono::steady_clock::now();
+    for (const TraceEntry& entry : trace)
+    {
+      if (!entry.invalidate)
+      {
+        JitBlock& block = AddBlock(blocks, entry.address, entry.length);
+        entries.emplace(block.physicalAddress, &block);
+        for (u32 address : block.physical_addresses)
+        {
+          std::vector<JitBlock*>& range = ranges[address & ~0xFFu];
+          if (std::find(range.begin(), range.end(), &block) == range.end())
+            range.push_back(&block);
+        }
+        continue;
+      }
+
+      auto it = ranges.lower_bound(entry.address & ~0xFFu);
+      const auto end = ranges.lower_bound(entry.address + entry.length);
+      for (; it != end; ++it)
+      {
+        for (JitBlock* block : it->second)
+        {
+          if (block->OverlapsPhysicalRange(entry.address, entry.length) &&
+              std::find(scratch.begin(), scratch.end(), block) == scratch.end())
+          {
+            scratch.push_back(block);
+          }
+        }
+      }
+      for (JitBlock* block : scratch)
+      {
+        for (u32 address : block->physical_addresses)
+          std::erase(ranges[address & ~0xFFu], block);
+        auto [first, last] = entries.equal_range(block->physicalAddress);
+        for (; first != last; ++first)
+        {
+          if (first->second == block)
+          {
+            entries.erase(first);
+            break;
+          }
+        }
+      }
+      scratch.clear();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    fmt::print("Ordered maps: {} ns per operation\n",
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() /
+                   trace.size());
+  }
+}
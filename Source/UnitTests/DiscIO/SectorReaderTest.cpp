@@ -0,0 +1,238 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Blob.h"
+
+namespace
+{
+u8 GetDiscByte(u64 offset)
+{
+  return static_cast<u8>((offset * 0x9E3779B97F4A7C15ULL) >> 56);
+}
+
+class FakeSectorReader final : public DiscIO::SectorReader
+{
+public:
+  FakeSectorReader(u64 size, int block_size, int chunk_blocks = 1, u32 decode_rounds = 0)
+      : m_size(size), m_decode_rounds(decode_rounds)
+  {
+    SetSectorSize(block_size);
+    SetChunkSize(chunk_blocks);
+  }
+
+  DiscIO::BlobType GetBlobType() const override { return DiscIO::BlobType::GCZ; }
+  std::unique_ptr<BlobReader> CopyReader() const override { return nullptr; }
+  u64 GetRawSize() const override { return m_size; }
+  u64 GetDataSize() const override { return m_size; }
+  DiscIO::DataSizeType GetDataSizeType() const override { return DiscIO::DataSizeType::Accurate; }
+  u64 GetBlockSize() const override { return GetSectorSize(); }
+  bool HasFastRandomAccessInBlock() const override { return false; }
+  std::string GetCompressionMethod() const override { return {}; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool GetBlock(u64 block_num, u8* out) override
+  {
+    const u64 offset = block_num * GetSectorSize();
+    if (offset + GetSectorSize() > m_size)
+      return false;
+
+    for (int i = 0; i < GetSectorSize(); ++i)
+      out[i] = GetDiscByte(offset + i);
+
+    // Stands in for the cost of inflating a block
+    for (u32 round = 0; round < m_decode_rounds; ++round)
+    {
+      for (int i = 0; i < GetSectorSize(); ++i)
+        m_checksum = m_checksum * 31 + out[i];
+    }
+
+    ++m_blocks_decoded;
+    return true;
+  }
+
+  u64 GetBlocksDecoded() const { return m_blocks_decoded; }
+  u64 GetBatchCalls() const { return m_batch_calls; }
+
+protected:
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override
+  {
+    ++m_batch_calls;
+    return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+  }
+
+private:
+  u64 m_size;
+  u32 m_decode_rounds;
+  u32 m_checksum = 0;
+  u64 m_blocks_decoded = 0;
+  u64 m_batch_calls = 0;
+};
+
+struct TraceEntry
+{
+  u64 offset;
+  u64 size;
+};
+
+// Loads a trace of "<offset> <size>" lines, both in hexadecimal.
+std::vector<TraceEntry> LoadTrace(const std::string& path)
+{
+  std::vector<TraceEntry> trace;
+  std::ifstream file(path);
+  TraceEntry entry;
+  while (file >> std::hex >> entry.offset >> entry.size)
+    trace.push_back(entry);
+  return trace;
+}
+
+// Loading-screen-like access: whole files read sequentially in 32 KiB requests, with small
+// scattered reads of a few hot files (like the FST and shared archives) in between.
+std::vector<TraceEntry> GenerateTrace(u64 disc_size)
+{
+  constexpr u64 REQUEST_SIZE = 0x8000;
+  std::mt19937_64 rng(1);
+  std::vector<u64> hot_offsets(8);
+  for (u64& offset : hot_offsets)
+    offset = rng() % (disc_size - 0x100000) & ~u64(0x7FFF);
+
+  std::vector<TraceEntry> trace;
+  for (int file = 0; file < 400; ++file)
+  {
+    const u64 file_size = (rng() % 0x100000) + REQUEST_SIZE;
+    const u64 file_offset = rng() % (disc_size - file_size) & ~u64(0x7FFF);
+    for (u64 offset = 0; offset < file_size; offset += REQUEST_SIZE)
+    {
+      trace.push_back({file_offset + offset, std::min(REQUEST_SIZE, file_size - offset)});
+      if (rng() % 4 == 0)
+      {
+        const u64 hot = hot_offsets[rng() % hot_offsets.size()] + rng() % 0x40000;
+        trace.push_back({hot, 0x800});
+      }
+    }
+  }
+  return trace;
+}
+}  // namespace
+
+TEST(SectorReader, ReadsMatchSource)
+{
+  for (const int chunk_blocks : {1, 4})
+  {
+    for (const u64 capacity :
+         {u64(0), u64(0x10000), DiscIO::SectorReader::DEFAULT_CACHE_CAPACITY})
+    {
+      constexpr u64 DISC_SIZE = 0x200000;
+      FakeSectorReader reader(DISC_SIZE, 0x4000, chunk_blocks);
+      reader.SetCacheCapacity(capacity);
+
+      std::mt19937 rng(chunk_blocks);
+      std::vector<u8> buffer;
+      std::vector<u8> expected;
+      for (int i = 0; i < 500; ++i)
+      {
+        const u64 size = rng() % 0x30000 + 1;
+        const u64 offset = rng() % (DISC_SIZE - size + 1);
+        buffer.assign(size, 0);
+        expected.resize(size);
+        for (u64 j = 0; j < size; ++j)
+          expected[j] = GetDiscByte(offset + j);
+
+        ASSERT_TRUE(reader.Read(offset, size, buffer.data()));
+        ASSERT_EQ(expected, buffer);
+      }
+
+      EXPECT_FALSE(reader.Read(DISC_SIZE - 1, 2, buffer.data()));
+    }
+  }
+}
+
+TEST(SectorReader, BatchesContiguousMisses)
+{
+  FakeSectorReader reader(0x100000, 0x4000);
+  std::vector<u8> buffer(0x28000);
+
+  ASSERT_TRUE(reader.Read(0x8000, 0x20000, buffer.data()));
+  EXPECT_EQ(1u, reader.GetBatchCalls());
+  EXPECT_EQ(8u, reader.GetBlocksDecoded());
+  EXPECT_EQ(8u, reader.GetCacheStatistics().misses);
+
+  // The blocks on either side are missing. They aren't adjacent, so each is read by itself,
+  // and the blocks in between aren't read again.
+  ASSERT_TRUE(reader.Read(0x4000, 0x28000, buffer.data()));
+  EXPECT_EQ(3u, reader.GetBatchCalls());
+  EXPECT_EQ(10u, reader.GetBlocksDecoded());
+  EXPECT_EQ(8u, reader.GetCacheStatistics().hits);
+  EXPECT_EQ(10u, reader.GetCacheStatistics().misses);
+}
+
+TEST(SectorReader, KeepsReusedChunksDuringScans)
+{
+  // Room for 8 blocks
+  FakeSectorReader reader(0x400000, 0x4000);
+  reader.SetCacheCapacity(0x20000);
+  std::vector<u8> buffer(0x4000);
+
+  // Make block 0 hot, then stream through the disc while touching it once per sweep of the
+  // clock hand. It must never be decoded again.
+  ASSERT_TRUE(reader.Read(0, 0x800, buffer.data()));
+  for (u64 block = 1; block < 0x100; ++block)
+  {
+    if (block % 4 == 0)
+    {
+      ASSERT_TRUE(reader.Read(0, 0x800, buffer.data()));
+    }
+    ASSERT_TRUE(reader.Read(block * 0x4000, 0x4000, buffer.data()));
+  }
+  EXPECT_EQ(0x100u, reader.GetBlocksDecoded());
+}
+
+// Replays a DVD access trace against several cache sizes, run with
+// --gtest_also_run_disabled_tests. A recorded trace can be passed in with the DOLPHIN_DVD_TRACE
+// environment variable, otherwise a synthetic loading screen is used.
+TEST(SectorReader, DISABLED_TraceReplayBenchmark)
+{
+  constexpr u64 DISC_SIZE = 0x57058000;  // Size of a GameCube disc
+  constexpr int BLOCK_SIZE = 0x4000;     // Default GCZ block size
+
+  const char* trace_path = std::getenv("DOLPHIN_DVD_TRACE");
+  const std::vector<TraceEntry> trace =
+      trace_path ? LoadTrace(trace_path) : GenerateTrace(DISC_SIZE);
+  ASSERT_FALSE(trace.empty());
+
+  // The first capacity matches the 32 fixed cache lines SectorReader used to have
+  for (const u64 capacity : {u64(32 * BLOCK_SIZE), u64(0x100000),
+                             DiscIO::SectorReader::DEFAULT_CACHE_CAPACITY, u64(0x1000000)})
+  {
+    FakeSectorReader reader(DISC_SIZE, BLOCK_SIZE, 1, 4);
+    reader.SetCacheCapacity(capacity);
+
+    std::vector<u8> buffer;
+    const auto start = std::chrono::steady_clock::now();
+    for (const TraceEntry& entry : trace)
+    {
+      buffer.resize(entry.size);
+      reader.Read(entry.offset, entry.size, buffer.data());
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const DiscIO::SectorReader::CacheStatistics& stats = reader.GetCacheStatistics();
+    fmt::print("{:>5} KiB cache: {:5.1f}% hit rate, {} blocks decoded, {} ms\n", capacity / 1024,
+               100.0 * stats.hits / std::max<u64>(1, stats.hits + stats.misses),
+               reader.GetBlocksDecoded(),
+               std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+  }
+}